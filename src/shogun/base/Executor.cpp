@@ -0,0 +1,301 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/Executor.h>
+#include <shogun/base/TaskScheduler.h>
+#include <shogun/io/SGIO.h>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+using namespace shogun;
+
+namespace
+{
+	/** task running on the current thread */
+	thread_local TaskState* t_task = nullptr;
+} // namespace
+
+TaskState::TaskState(
+    std::function<void()> work, std::function<void()> on_cancel)
+    : m_work(std::move(work)), m_on_cancel(std::move(on_cancel)),
+      m_status(TASK_PENDING), m_progress(0.0), m_cancel_requested(false)
+{
+}
+
+void TaskState::on_progress(float64_t fraction)
+{
+	m_progress.store(fraction, std::memory_order_relaxed);
+}
+
+void TaskState::run()
+{
+	std::function<void()> work;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_status.load(std::memory_order_relaxed) != TASK_PENDING)
+			return;
+		work = std::move(m_work);
+		m_status.store(TASK_RUNNING, std::memory_order_release);
+	}
+
+	auto& listener = ProgressListener::current();
+	auto previous = listener;
+	listener = this;
+	auto previous_task = t_task;
+	t_task = this;
+	std::exception_ptr exception;
+	try
+	{
+		work();
+	}
+	catch (...)
+	{
+		exception = std::current_exception();
+	}
+	listener = previous;
+	t_task = previous_task;
+	// release what the computation holds, e.g. its machine and data
+	work = nullptr;
+
+	std::function<void()> on_cancel;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exception = exception;
+		if (!exception)
+			m_progress.store(1.0, std::memory_order_relaxed);
+		on_cancel = std::move(m_on_cancel);
+		m_status.store(
+		    exception ? TASK_FAILED : TASK_FINISHED, std::memory_order_release);
+	}
+	m_done.notify_all();
+}
+
+TaskState* TaskState::current()
+{
+	return t_task;
+}
+
+bool TaskState::cancel()
+{
+	std::function<void()> on_cancel;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto status = m_status.load(std::memory_order_relaxed);
+		if (is_done(status))
+			return false;
+
+		m_cancel_requested.store(true, std::memory_order_relaxed);
+		if (status == TASK_PENDING)
+		{
+			m_work = nullptr;
+			m_on_cancel = nullptr;
+			m_status.store(TASK_CANCELLED, std::memory_order_release);
+			m_done.notify_all();
+			return true;
+		}
+		on_cancel = m_on_cancel;
+	}
+
+	if (on_cancel)
+		on_cancel();
+	return true;
+}
+
+void TaskState::wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]() { return is_done(get_status()); });
+}
+
+bool TaskState::wait_for(std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_done.wait_for(
+	    lock, timeout, [this]() { return is_done(get_status()); });
+}
+
+void TaskState::check()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	switch (m_status.load(std::memory_order_relaxed))
+	{
+	case TASK_FAILED:
+		std::rethrow_exception(m_exception);
+	case TASK_CANCELLED:
+		throw ShogunException("Task was cancelled before it started");
+	case TASK_PENDING:
+	case TASK_RUNNING:
+		throw ShogunException("Task is not done");
+	case TASK_FINISHED:
+		break;
+	}
+}
+
+Executor::Executor(
+    std::function<int32_t()> num_threads, TaskScheduler* scheduler)
+    : m_num_threads(std::move(num_threads)), m_scheduler(scheduler),
+      m_num_threads_used(0), m_num_idle(0), m_stop(false)
+{
+}
+
+Executor::~Executor()
+{
+	std::vector<std::shared_ptr<TaskState>> tasks;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		tasks.assign(m_pending.begin(), m_pending.end());
+		tasks.insert(tasks.end(), m_running.begin(), m_running.end());
+		m_pending.clear();
+	}
+	for (const auto& task : tasks)
+		task->cancel();
+
+	m_work_available.notify_all();
+	m_deadline_added.notify_all();
+	for (auto& worker : m_workers)
+		worker.join();
+	if (m_watchdog.joinable())
+		m_watchdog.join();
+}
+
+int32_t Executor::get_num_running() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_running.size();
+}
+
+int32_t Executor::get_num_pending() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_pending.size();
+}
+
+int32_t Executor::get_max_running() const
+{
+	return std::max(1, m_num_threads());
+}
+
+void Executor::share_threads()
+{
+	if (!m_scheduler)
+		return;
+	// each task calls into the scheduler on its own thread, the threads
+	// given to the tasks beyond their own are the workers
+	int32_t num_running = m_running.size();
+	m_scheduler->set_num_threads_of_tasks(
+	    num_running > 0 ? m_num_threads_used - num_running + 1 : 0);
+}
+
+void Executor::enqueue(
+    const std::shared_ptr<TaskState>& task, std::chrono::milliseconds timeout)
+{
+	require(
+	    timeout.count() >= 0, "Timeout ({} ms) must not be negative",
+	    timeout.count());
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		require(!m_stop, "Executor is shutting down");
+
+		m_pending.push_back(task);
+		if (m_num_idle == 0 && (int32_t)m_workers.size() < get_max_running())
+		{
+			m_workers.emplace_back(&Executor::run_worker, this);
+			SG_DEBUG("started worker {} of the executor", m_workers.size());
+		}
+
+		if (timeout.count() > 0)
+		{
+			m_deadlines.emplace(
+			    std::chrono::steady_clock::now() + timeout, task);
+			if (!m_watchdog.joinable())
+				m_watchdog = std::thread(&Executor::run_watchdog, this);
+		}
+	}
+	m_work_available.notify_one();
+	if (timeout.count() > 0)
+		m_deadline_added.notify_one();
+}
+
+void Executor::run_worker()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		++m_num_idle;
+		m_work_available.wait(lock, [this]() {
+			return m_stop ||
+			       (!m_pending.empty() && m_num_threads_used < get_max_running());
+		});
+		--m_num_idle;
+		if (m_stop)
+			return;
+
+		auto task = std::move(m_pending.front());
+		m_pending.pop_front();
+		if (task->get_status() != TASK_PENDING)
+			continue;
+
+		m_running.push_back(task);
+		// share the free threads with the tasks that wait to start along
+		// with this one, a task starts only while a thread is free
+		auto num_free = get_max_running() - m_num_threads_used;
+		auto num_starting = std::max<int32_t>(
+		    1, std::min<int32_t>(num_free, m_pending.size() + 1));
+		auto num_threads = std::max<int32_t>(1, num_free / num_starting);
+		m_num_threads_used += num_threads;
+		share_threads();
+		lock.unlock();
+
+#ifdef HAVE_OPENMP
+		// the number of threads of OpenMP regions is a setting of the
+		// calling thread, so it applies to this task only
+		omp_set_num_threads(num_threads);
+#endif
+		SG_DEBUG("running task with {} threads", num_threads);
+		task->run();
+
+		lock.lock();
+		m_num_threads_used -= num_threads;
+		m_running.erase(std::find(m_running.begin(), m_running.end(), task));
+		share_threads();
+		// pending tasks may start on the threads given back
+		if (!m_pending.empty())
+			m_work_available.notify_all();
+	}
+}
+
+void Executor::run_watchdog()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_stop)
+	{
+		if (m_deadlines.empty())
+			m_deadline_added.wait(lock);
+		else
+			m_deadline_added.wait_until(lock, m_deadlines.begin()->first);
+
+		std::vector<std::shared_ptr<TaskState>> expired;
+		auto now = std::chrono::steady_clock::now();
+		while (!m_deadlines.empty() && m_deadlines.begin()->first <= now)
+		{
+			if (auto task = m_deadlines.begin()->second.lock())
+				expired.push_back(std::move(task));
+			m_deadlines.erase(m_deadlines.begin());
+		}
+
+		lock.unlock();
+		for (const auto& task : expired)
+		{
+			if (task->cancel())
+				SG_DEBUG("cancelled task after its timeout");
+		}
+		lock.lock();
+	}
+}
@@ -0,0 +1,313 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __EXECUTOR_H__
+#define __EXECUTOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/macros.h>
+#include <shogun/base/progress.h>
+#include <shogun/lib/common.h>
+#include <shogun/lib/exception/ShogunException.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shogun
+{
+
+class TaskScheduler;
+
+/** status of a task submitted to an Executor */
+enum ETaskStatus
+{
+	/** waiting for a free worker */
+	TASK_PENDING = 0,
+	/** running on a worker */
+	TASK_RUNNING = 1,
+	/** finished, possibly stopped early by cancel() */
+	TASK_FINISHED = 2,
+	/** cancelled before it started */
+	TASK_CANCELLED = 3,
+	/** finished by throwing an exception */
+	TASK_FAILED = 4
+};
+
+/** @brief State of a task shared by the Executor running it and the
+ * TaskFuture of its result.
+ *
+ * While the task runs, the state is the ProgressListener of the worker, so
+ * that the outermost progress bar of the task reports its progress.
+ */
+class TaskState : public ProgressListener
+{
+public:
+	/** constructor
+	 *
+	 * @param work computation, stores its result itself
+	 * @param on_cancel asks the running computation to stop, may be empty
+	 */
+	TaskState(std::function<void()> work, std::function<void()> on_cancel);
+
+	virtual void on_progress(float64_t fraction);
+
+	/** run the computation on the calling thread unless it was cancelled */
+	void run();
+
+	/** cancel the task: a pending task is dropped, a running task is asked
+	 * to stop and finishes with what it computed so far
+	 *
+	 * @return whether the task was pending or running
+	 */
+	bool cancel();
+
+	/** block until the task finished, failed or was cancelled */
+	void wait();
+
+	/** block until the task is done or the timeout expires
+	 *
+	 * @return whether the task is done
+	 */
+	bool wait_for(std::chrono::milliseconds timeout);
+
+	/** throw if the task failed or was cancelled before it started */
+	void check();
+
+	/** @return status of the task */
+	ETaskStatus get_status() const
+	{
+		return m_status.load(std::memory_order_acquire);
+	}
+
+	/** @return fraction of the task that is done, in [0, 1] */
+	float64_t get_progress() const
+	{
+		return m_progress.load(std::memory_order_relaxed);
+	}
+
+	/** @return whether cancel() was called while the task was pending or
+	 * running
+	 */
+	bool is_cancel_requested() const
+	{
+		return m_cancel_requested.load(std::memory_order_relaxed);
+	}
+
+	/** @return task running on the calling thread, nullptr outside of
+	 * tasks
+	 */
+	static TaskState* current();
+
+private:
+	static bool is_done(ETaskStatus status)
+	{
+		return status != TASK_PENDING && status != TASK_RUNNING;
+	}
+
+	std::function<void()> m_work;
+	std::function<void()> m_on_cancel;
+	std::exception_ptr m_exception;
+	std::atomic<ETaskStatus> m_status;
+	std::atomic<float64_t> m_progress;
+	std::atomic<bool> m_cancel_requested;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_done;
+
+	SG_DELETE_COPY_AND_ASSIGN(TaskState);
+};
+
+/** @brief Handle of the result of a task submitted to an Executor.
+ *
+ * Unlike std::future, it reports the progress of the task and can cancel
+ * it. Copies refer to the same task.
+ *
+ *     auto trained = svm->train_async(feats, std::chrono::minutes(5));
+ *     while (!trained.wait_for(std::chrono::seconds(1)))
+ *         io::print("{:.0f}%\n", 100 * trained.get_progress());
+ *     trained.get();
+ */
+template <class T>
+class TaskFuture
+{
+public:
+	/** constructor
+	 *
+	 * @param state state of the task
+	 * @param result slot the task stores its result in
+	 */
+	TaskFuture(std::shared_ptr<TaskState> state, std::shared_ptr<T> result)
+	    : m_state(std::move(state)), m_result(std::move(result))
+	{
+	}
+
+	/** wait for the task and return its result, rethrows the exception
+	 * of a failed task and throws ShogunException if the task was
+	 * cancelled before it started
+	 */
+	T get() const
+	{
+		m_state->wait();
+		m_state->check();
+		return *m_result;
+	}
+
+	/** block until the task is done */
+	void wait() const
+	{
+		m_state->wait();
+	}
+
+	/** block until the task is done or the timeout expires
+	 *
+	 * @return whether the task is done
+	 */
+	bool wait_for(std::chrono::milliseconds timeout) const
+	{
+		return m_state->wait_for(timeout);
+	}
+
+	/** @return whether get() returns without blocking */
+	bool is_ready() const
+	{
+		auto status = get_status();
+		return status != TASK_PENDING && status != TASK_RUNNING;
+	}
+
+	/** @see TaskState::cancel */
+	bool cancel() const
+	{
+		return m_state->cancel();
+	}
+
+	/** @return status of the task */
+	ETaskStatus get_status() const
+	{
+		return m_state->get_status();
+	}
+
+	/** @return fraction of the task that is done, in [0, 1] */
+	float64_t get_progress() const
+	{
+		return m_state->get_progress();
+	}
+
+private:
+	std::shared_ptr<TaskState> m_state;
+	std::shared_ptr<T> m_result;
+};
+
+/** @brief Pool of worker threads shared by asynchronous computations such
+ * as Machine::train_async().
+ *
+ * The running tasks share the threads of the environment
+ * (ShogunEnv::get_num_threads()): a starting task gets an even share of
+ * the threads that are free among the tasks that wait to start, at least
+ * one, and further tasks wait in submission order until a running task
+ * gives its threads back. A task that started alone keeps all of them
+ * until it is done. Workers are started on demand.
+ *
+ * A task's share is the thread count of its OpenMP regions. The parallel
+ * regions of a TaskScheduler given to the constructor run on the tasks'
+ * own threads and on as many workers as the shares hold beyond them.
+ * Hence the OpenMP regions of the tasks together, as well as their
+ * scheduler regions together, never use more threads than the
+ * environment has. An OpenMP region of one task that overlaps with
+ * scheduler regions of others may exceed it by the threads of the OpenMP
+ * region.
+ */
+class Executor
+{
+public:
+	/** constructor
+	 *
+	 * @param num_threads returns the number of threads tasks may use
+	 * @param scheduler scheduler of the parallel regions of the tasks,
+	 * which runs on the threads given to the running tasks, may be null
+	 */
+	explicit Executor(
+	    std::function<int32_t()> num_threads,
+	    TaskScheduler* scheduler = nullptr);
+
+	/** destructor, cancels pending and running tasks and waits for the
+	 * workers
+	 */
+	~Executor();
+
+	/** run a computation on a worker
+	 *
+	 * @param work computation
+	 * @param on_cancel asks the running computation to stop, e.g.
+	 * StoppableSGObject::stop_computation()
+	 * @param timeout cancel the task if it is not done after this long,
+	 * counted from submission, zero for no timeout
+	 * @return handle of the result
+	 */
+	template <class T>
+	TaskFuture<T> submit(
+	    std::function<T()> work, std::function<void()> on_cancel = nullptr,
+	    std::chrono::milliseconds timeout = std::chrono::milliseconds::zero())
+	{
+		auto result = std::make_shared<T>();
+		auto state = std::make_shared<TaskState>(
+		    [result, work = std::move(work)]() { *result = work(); },
+		    std::move(on_cancel));
+		enqueue(state, timeout);
+		return TaskFuture<T>(state, result);
+	}
+
+	/** @return number of tasks that are running */
+	int32_t get_num_running() const;
+
+	/** @return number of tasks that wait for a worker */
+	int32_t get_num_pending() const;
+
+private:
+	void enqueue(
+	    const std::shared_ptr<TaskState>& task,
+	    std::chrono::milliseconds timeout);
+
+	void run_worker();
+
+	void run_watchdog();
+
+	int32_t get_max_running() const;
+
+	/** tell the scheduler the threads of the running tasks */
+	void share_threads();
+
+	std::function<int32_t()> m_num_threads;
+	TaskScheduler* m_scheduler;
+	/** sum of the threads given to the running tasks */
+	int32_t m_num_threads_used;
+
+	mutable std::mutex m_mutex;
+	/** signals workers that a task can start or the executor stops */
+	std::condition_variable m_work_available;
+	/** signals the watchdog that a deadline was added */
+	std::condition_variable m_deadline_added;
+	std::deque<std::shared_ptr<TaskState>> m_pending;
+	std::vector<std::shared_ptr<TaskState>> m_running;
+	std::multimap<
+	    std::chrono::steady_clock::time_point, std::weak_ptr<TaskState>>
+	    m_deadlines;
+	std::vector<std::thread> m_workers;
+	int32_t m_num_idle;
+	std::thread m_watchdog;
+	bool m_stop;
+
+	SG_DELETE_COPY_AND_ASSIGN(Executor);
+};
+}
+
+#endif // __EXECUTOR_H__
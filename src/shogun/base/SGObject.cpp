@@ -455,6 +455,8 @@ void SGObject::subscribe(const std::shared_ptr<ParameterObserver>& obs)
 	rxcpp::subscription subscription =
 	    m_observable_params
 	        ->filter([obs](std::shared_ptr<ObservedValue> v) {
+		        if (!obs->samples(v->get_step()))
+			        return false;
 		        auto p = v->get_params().find(v->get<std::string>("name"));
 		        return obs->observes(v->get<std::string>("name")) &&
 		               obs->observes(p->second->get_properties());
@@ -463,6 +465,7 @@ void SGObject::subscribe(const std::shared_ptr<ParameterObserver>& obs)
 	        .subscribe(sub);
 
 	// Insert the subscription in the list
+	m_observers[m_next_subscription_index] = obs;
 	m_subscriptions.insert(
 	    std::make_pair<int64_t, rxcpp::subscription>(
 	        std::move(m_next_subscription_index), std::move(subscription)));
@@ -487,6 +490,7 @@ void SGObject::unsubscribe(const std::shared_ptr<ParameterObserver>& obs)
 
 	it->second.unsubscribe();
 	m_subscriptions.erase(index);
+	m_observers.erase(index);
 
 	obs->put("subscription_id", static_cast<int64_t>(-1));
 }
@@ -496,6 +500,13 @@ void SGObject::observe(std::shared_ptr<ObservedValue> value) const
 	m_subscriber_params->on_next(value);
 }
 
+bool SGObject::is_sampled(int64_t step) const
+{
+	return std::any_of(
+	    m_observers.begin(), m_observers.end(),
+	    [step](const auto& observer) { return observer.second->samples(step); });
+}
+
 void SGObject::register_observable(
     std::string_view name, std::string_view description)
 {
@@ -1105,6 +1105,14 @@ protected:
 	 */
 	void observe(std::shared_ptr<ObservedValue> value) const;
 
+	/**
+	 * Whether any subscribed observer samples values of a step, see
+	 * ParameterObserver::samples().
+	 * @param step step of the value
+	 * @return true if a value of this step is observed
+	 */
+	bool is_sampled(int64_t step) const;
+
 	/**
 	 * Observe a parameter value given custom properties for the Any.
 	 * If no observer is attached this command will do nothing.
@@ -1120,8 +1128,8 @@ protected:
 		const int64_t step, std::string_view name, const T& value,
 		const AnyParameterProperties properties) const
 	{
-		// If there are no observers attached, do not create/emit anything.
-		if (get_num_subscriptions() == 0)
+		// If no observer samples this step, do not create/emit anything.
+		if (get_num_subscriptions() == 0 || !is_sampled(step))
 			return;
 
 		auto obs = std::make_shared<ObservedValueTemplated<T>>(
@@ -1158,6 +1166,9 @@ protected:
 	template <class T>
 	void observe(const int64_t step, std::string_view name) const
 	{
+		if (get_num_subscriptions() == 0 || !is_sampled(step))
+			return;
+
 		auto param = this->get_parameter(BaseTag(name));
 		auto cloned = any_cast<T>(param.get_value());
 		this->observe(
@@ -1214,6 +1225,9 @@ protected:
 
 		/** List of subscription for this SGObject */
 		std::map<int64_t, rxcpp::subscription> m_subscriptions;
+
+		/** Observers of the subscriptions, by subscription index */
+		std::map<int64_t, std::shared_ptr<ParameterObserver>> m_observers;
 		int64_t m_next_subscription_index;
 	};
 
@@ -5,7 +5,9 @@
  *          Viktor Gal, Giovanni De Toni, Heiko Strathmann, Bjoern Esser
  */
 
+#include <shogun/base/Executor.h>
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/io/fs/FileSystem.h>
 #include <shogun/io/fs/FileSystemRegistry.h>
 
@@ -36,6 +38,11 @@ ShogunEnv::ShogunEnv()
 	sg_io = std::make_unique<io::SGIO>();
 	sg_linalg = std::make_unique<SGLinalg>();
 	sg_signal = std::make_unique<Signal>();
+	sg_scheduler = std::make_unique<TaskScheduler>(
+	    [this]() { return get_num_threads(); });
+	// asynchronous tasks share the threads with their parallel regions
+	sg_executor = std::make_unique<Executor>(
+	    [this]() { return get_num_threads(); }, sg_scheduler.get());
 
 	sg_fequals_epsilon = 0.0;
 	sg_fequals_tolerant = false;
@@ -47,6 +54,10 @@ ShogunEnv::ShogunEnv()
 
 ShogunEnv::~ShogunEnv()
 {
+	// tasks still running use the signal handler and the scheduler
+	sg_executor.reset();
+	sg_scheduler.reset();
+
 	delete Signal::m_subscriber;
 	delete Signal::m_observable;
 	delete Signal::m_subject;
@@ -131,6 +142,16 @@ Signal* ShogunEnv::signal()
 	return sg_signal.get();
 }
 
+Executor* ShogunEnv::executor()
+{
+	return sg_executor.get();
+}
+
+TaskScheduler* ShogunEnv::scheduler()
+{
+	return sg_scheduler.get();
+}
+
 SGLinalg* ShogunEnv::linalg()
 {
 	return sg_linalg.get();
@@ -24,6 +24,8 @@ namespace shogun
 	}
 	class SGLinalg;
 	class Signal;
+	class Executor;
+	class TaskScheduler;
 
 	class ShogunEnv : public io::FileSystemRegistry, public Parallel, public Version
 	{
@@ -79,6 +81,18 @@ namespace shogun
 		 * @return linalg object
 		 */
 		Signal* signal();
+
+		/** get the global executor of asynchronous computations
+		 *
+		 * @return executor object
+		 */
+		Executor* executor();
+
+		/** get the global scheduler of parallel regions
+		 *
+		 * @return scheduler object
+		 */
+		TaskScheduler* scheduler();
 #endif
 
 	private:
@@ -95,6 +109,8 @@ namespace shogun
 		std::unique_ptr<SGLinalg> sg_linalg;
 		float64_t sg_fequals_epsilon;
 		bool sg_fequals_tolerant;
+		std::unique_ptr<Executor> sg_executor;
+		std::unique_ptr<TaskScheduler> sg_scheduler;
 	};
 
 	static inline ShogunEnv* env()
@@ -0,0 +1,322 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/TaskScheduler.h>
+#include <shogun/io/SGIO.h>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+using namespace shogun;
+
+namespace
+{
+	/** scheduler the current thread is a worker of */
+	thread_local const TaskScheduler* t_scheduler = nullptr;
+	/** index of the current worker */
+	thread_local int32_t t_index = -1;
+
+	/** number of unsuccessful searches for tasks before sleeping */
+	constexpr int32_t num_spins = 64;
+} // namespace
+
+TaskGroup::TaskGroup(TaskScheduler* scheduler)
+    : m_scheduler(scheduler), m_pending(0), m_queued(0), m_failed(false)
+{
+	require(m_scheduler, "Scheduler of task group must be set");
+}
+
+TaskGroup::~TaskGroup()
+{
+	if (m_pending.load(std::memory_order_acquire) > 0)
+		m_scheduler->wait_for(*this);
+}
+
+void TaskGroup::run(std::function<void()> function)
+{
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+	m_scheduler->spawn(new TaskScheduler::Task{std::move(function), this});
+}
+
+void TaskGroup::wait()
+{
+	m_scheduler->wait_for(*this);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_exception)
+	{
+		auto exception = m_exception;
+		m_exception = nullptr;
+		m_failed.store(false, std::memory_order_relaxed);
+		std::rethrow_exception(exception);
+	}
+}
+
+void TaskGroup::fail(std::exception_ptr exception)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_exception)
+		m_exception = exception;
+	m_failed.store(true, std::memory_order_relaxed);
+}
+
+void TaskGroup::finish()
+{
+	auto scheduler = m_scheduler;
+	if (m_pending.fetch_sub(1) == 1)
+		scheduler->wake_waiting();
+}
+
+TaskScheduler::TaskScheduler(std::function<int32_t()> num_threads)
+    : m_num_threads(std::move(num_threads)), m_num_threads_of_tasks(0),
+      m_num_workers(0),
+      m_num_queued(0), m_num_sleeping(0), m_num_waiting(0), m_stop(false)
+{
+	m_max_workers = std::max<int32_t>(255, std::thread::hardware_concurrency());
+	m_queues.reset(new TaskQueue[m_max_workers + 1]);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		m_stop.store(true);
+	}
+	m_wake_up.notify_all();
+	m_activate.notify_all();
+	for (auto& worker : m_workers)
+		worker.join();
+
+	for (int32_t i = 0; i <= m_max_workers; ++i)
+	{
+		for (auto task : m_queues[i].tasks)
+			delete task;
+	}
+}
+
+void TaskScheduler::set_num_threads_of_tasks(int32_t num_threads)
+{
+	auto previous = m_num_threads_of_tasks.exchange(num_threads);
+	// workers beyond the previous number of threads may run tasks again
+	if (previous > 0 && (num_threads == 0 || num_threads > previous))
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		m_activate.notify_all();
+	}
+}
+
+bool TaskScheduler::is_worker() const
+{
+	return t_scheduler == this;
+}
+
+void TaskScheduler::spawn(Task* task)
+{
+	auto index = is_worker() ? t_index : m_max_workers;
+	// count the task first, once queued it may run and its group be gone
+	task->group->m_queued.fetch_add(1);
+	{
+		auto& queue = m_queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(task);
+	}
+	m_num_queued.fetch_add(1);
+
+	if (m_num_workers.load(std::memory_order_relaxed) <
+	    std::min(get_num_threads() - 1, m_max_workers))
+		start_workers();
+	wake_one();
+	wake_waiting();
+}
+
+void TaskScheduler::execute(Task* task)
+{
+	auto group = task->group;
+	if (!group->is_failed())
+	{
+#ifdef HAVE_OPENMP
+		// the scheduler provides the parallelism of tasks, also on a
+		// waiting thread whose own setting is restored afterwards
+		auto num_omp_threads = omp_get_max_threads();
+		omp_set_num_threads(1);
+#endif
+		try
+		{
+			task->function();
+		}
+		catch (...)
+		{
+			group->fail(std::current_exception());
+		}
+#ifdef HAVE_OPENMP
+		omp_set_num_threads(num_omp_threads);
+#endif
+	}
+	delete task;
+	group->finish();
+}
+
+TaskScheduler::Task*
+TaskScheduler::find_task(int32_t self, const TaskGroup* group)
+{
+	if (m_num_queued.load(std::memory_order_relaxed) == 0)
+		return nullptr;
+	if (group && group->m_queued.load(std::memory_order_relaxed) == 0)
+		return nullptr;
+
+	auto is_eligible = [group](const Task* task) {
+		return !group || task->group == group;
+	};
+	auto take = [this, &is_eligible](TaskQueue& queue, bool newest) -> Task* {
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		auto& tasks = queue.tasks;
+		Task* task;
+		if (newest)
+		{
+			auto it = std::find_if(tasks.rbegin(), tasks.rend(), is_eligible);
+			if (it == tasks.rend())
+				return nullptr;
+			task = *it;
+			tasks.erase(std::next(it).base());
+		}
+		else
+		{
+			auto it = std::find_if(tasks.begin(), tasks.end(), is_eligible);
+			if (it == tasks.end())
+				return nullptr;
+			task = *it;
+			tasks.erase(it);
+		}
+		task->group->m_queued.fetch_sub(1, std::memory_order_relaxed);
+		m_num_queued.fetch_sub(1, std::memory_order_relaxed);
+		return task;
+	};
+
+	if (self >= 0)
+	{
+		if (auto task = take(m_queues[self], true))
+			return task;
+	}
+	if (auto task = take(m_queues[m_max_workers], false))
+		return task;
+
+	auto num_workers = m_num_workers.load(std::memory_order_acquire);
+	auto first = self >= 0 ? self + 1 : 0;
+	for (int32_t i = 0; i < num_workers; ++i)
+	{
+		auto victim = (first + i) % num_workers;
+		if (victim == self)
+			continue;
+		if (auto task = take(m_queues[victim], false))
+			return task;
+	}
+	return nullptr;
+}
+
+void TaskScheduler::wait_for(TaskGroup& group)
+{
+	auto self = is_worker() ? t_index : -1;
+	int32_t spins = 0;
+	while (group.m_pending.load(std::memory_order_acquire) > 0)
+	{
+		if (auto task = find_task(self, &group))
+		{
+			execute(task);
+			spins = 0;
+			continue;
+		}
+		if (++spins < num_spins)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleep_mutex);
+		m_num_waiting.fetch_add(1);
+		m_group_changed.wait(lock, [&group]() {
+			return group.m_pending.load() == 0 || group.m_queued.load() > 0;
+		});
+		m_num_waiting.fetch_sub(1);
+		spins = 0;
+	}
+}
+
+void TaskScheduler::wake_one()
+{
+	if (m_num_sleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		m_wake_up.notify_one();
+	}
+}
+
+void TaskScheduler::wake_waiting()
+{
+	if (m_num_waiting.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		m_group_changed.notify_all();
+	}
+}
+
+void TaskScheduler::start_workers()
+{
+	std::lock_guard<std::mutex> lock(m_workers_mutex);
+	auto num_workers =
+	    std::min<int32_t>(get_num_threads() - 1, m_max_workers);
+	for (auto i = (int32_t)m_workers.size(); i < num_workers; ++i)
+	{
+		m_workers.emplace_back(&TaskScheduler::run_worker, this, i);
+		m_num_workers.store(i + 1, std::memory_order_release);
+	}
+	SG_DEBUG("scheduler runs {} workers", m_workers.size());
+
+	// workers beyond a previous number of threads may run tasks again
+	std::lock_guard<std::mutex> sleep_lock(m_sleep_mutex);
+	m_activate.notify_all();
+}
+
+void TaskScheduler::run_worker(int32_t index)
+{
+	t_scheduler = this;
+	t_index = index;
+
+	int32_t spins = 0;
+	while (!m_stop.load(std::memory_order_relaxed))
+	{
+		if (!is_active(index))
+		{
+			if (m_num_queued.load() > 0)
+				wake_one();
+			std::unique_lock<std::mutex> lock(m_sleep_mutex);
+			m_activate.wait_for(lock, std::chrono::milliseconds(100), [&]() {
+				return m_stop.load() || is_active(index);
+			});
+			continue;
+		}
+
+		if (auto task = find_task(index, nullptr))
+		{
+			execute(task);
+			spins = 0;
+			continue;
+		}
+		if (++spins < num_spins)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleep_mutex);
+		m_num_sleeping.fetch_add(1);
+		m_wake_up.wait(lock, [this]() {
+			return m_stop.load() || m_num_queued.load() > 0;
+		});
+		m_num_sleeping.fetch_sub(1);
+		spins = 0;
+	}
+}
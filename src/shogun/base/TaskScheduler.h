@@ -0,0 +1,322 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __TASK_SCHEDULER_H__
+#define __TASK_SCHEDULER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/macros.h>
+#include <shogun/lib/common.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shogun
+{
+
+class TaskScheduler;
+
+/** @brief Set of tasks run by a TaskScheduler that are waited for
+ * together.
+ *
+ * Tasks may run tasks of their own groups, to any depth. A thread waiting
+ * for a group runs queued tasks of that group meanwhile, so nested groups
+ * neither block threads nor start new ones. It does not run tasks of other
+ * groups, which would inherit the state of the thread such as a
+ * ScopedAllocator, a SingleThreadedRefCountScope or the ProgressListener
+ * set up by the caller of wait().
+ *
+ *     TaskGroup group(env()->scheduler());
+ *     group.run([&]() { left = train(left_data); });
+ *     group.run([&]() { right = train(right_data); });
+ *     group.wait();
+ */
+class TaskGroup
+{
+public:
+	/** constructor
+	 *
+	 * @param scheduler scheduler running the tasks
+	 */
+	explicit TaskGroup(TaskScheduler* scheduler);
+
+	/** destructor, waits for the tasks and drops their exceptions */
+	~TaskGroup();
+
+	/** queue a task
+	 *
+	 * @param function task, must stay callable until wait() returns
+	 */
+	void run(std::function<void()> function);
+
+	/** wait for all tasks queued so far and rethrow the first exception
+	 * thrown by one of them; tasks that did not start when it was thrown
+	 * are skipped
+	 */
+	void wait();
+
+private:
+	friend class TaskScheduler;
+
+	/** store the exception of a task */
+	void fail(std::exception_ptr exception);
+
+	/** count a task as done, the group may be destroyed right after */
+	void finish();
+
+	/** @return whether a task threw */
+	bool is_failed() const
+	{
+		return m_failed.load(std::memory_order_relaxed);
+	}
+
+	TaskScheduler* m_scheduler;
+	/** number of tasks queued or running */
+	std::atomic<int64_t> m_pending;
+	/** number of tasks queued */
+	std::atomic<int64_t> m_queued;
+	std::atomic<bool> m_failed;
+	std::mutex m_mutex;
+	std::exception_ptr m_exception;
+
+	SG_DELETE_COPY_AND_ASSIGN(TaskGroup);
+};
+
+/** @brief Work-stealing task runtime shared by the parallel regions of the
+ * library.
+ *
+ * The scheduler runs tasks on env()->get_num_threads() threads: workers it
+ * starts on demand and the threads waiting for a TaskGroup, which run
+ * tasks of that group only. Each worker has a
+ * queue of its own, to which tasks it spawns are added and from which it
+ * takes the newest task. Idle threads steal the oldest task of another
+ * queue, which tends to be the largest piece of work left. Parallel regions
+ * nested into tasks thus share the same threads, rather than multiplying
+ * them as nested OpenMP regions do or running serially.
+ *
+ * OpenMP regions inside tasks run with a single thread, on the workers as
+ * well as on waiting threads.
+ */
+class TaskScheduler
+{
+public:
+	/** constructor
+	 *
+	 * @param num_threads returns the number of threads to run tasks on,
+	 * including the waiting thread
+	 */
+	explicit TaskScheduler(std::function<int32_t()> num_threads);
+
+	/** destructor, waits for the workers to finish their current task */
+	~TaskScheduler();
+
+	/** @return number of threads tasks run on */
+	int32_t get_num_threads() const
+	{
+		auto num_threads = std::max(1, m_num_threads());
+		auto num_threads_of_tasks =
+		    m_num_threads_of_tasks.load(std::memory_order_relaxed);
+		if (num_threads_of_tasks > 0)
+			return std::min(num_threads, num_threads_of_tasks);
+		return num_threads;
+	}
+
+	/** share the threads with the running tasks of an Executor
+	 *
+	 * @param num_threads number of threads to run tasks on while the
+	 * executor runs tasks, counting the threads of the tasks as one
+	 * since each waits for its own regions; zero when no task runs
+	 */
+	void set_num_threads_of_tasks(int32_t num_threads);
+
+	/** call body(i) for each i in [begin, end) in parallel
+	 *
+	 * The range is split in halves recursively, down to chunks of grain
+	 * indices that are run in order.
+	 *
+	 * @param begin first index
+	 * @param end index after the last
+	 * @param body function of an index
+	 * @param grain number of indices run by a task at least, zero to
+	 * split into about eight chunks per thread
+	 */
+	template <class F>
+	void parallel_for(index_t begin, index_t end, F&& body, index_t grain = 0)
+	{
+		if (begin >= end)
+			return;
+		grain = get_grain(end - begin, grain);
+		if (end - begin <= grain || get_num_threads() == 1)
+		{
+			for (auto i = begin; i < end; ++i)
+				body(i);
+			return;
+		}
+
+		TaskGroup group(this);
+		split_for(group, begin, end, grain, body);
+		group.wait();
+	}
+
+	/** reduce the values map(i) for each i in [begin, end) in parallel
+	 *
+	 * Each chunk of grain indices is reduced in order starting from
+	 * identity, then the results of the chunks are combined in order, so
+	 * the result does not depend on the threads for a fixed grain.
+	 *
+	 * @param begin first index
+	 * @param end index after the last
+	 * @param identity neutral element of combine
+	 * @param map function of an index
+	 * @param combine associative function of two values
+	 * @param grain number of indices per chunk, zero to split into about
+	 * eight chunks per thread
+	 * @return combined value
+	 */
+	template <class T, class Map, class Combine>
+	T parallel_reduce(
+	    index_t begin, index_t end, T identity, Map&& map, Combine&& combine,
+	    index_t grain = 0)
+	{
+		if (begin >= end)
+			return identity;
+		grain = get_grain(end - begin, grain);
+
+		auto num_chunks = (end - begin + grain - 1) / grain;
+		std::vector<T> partial(num_chunks, identity);
+		parallel_for(
+		    0, num_chunks,
+		    [&](index_t chunk) {
+			    auto chunk_end = std::min<index_t>(
+			        end, begin + (chunk + 1) * grain);
+			    T& value = partial[chunk];
+			    for (auto i = begin + chunk * grain; i < chunk_end; ++i)
+				    value = combine(value, map(i));
+		    },
+		    1);
+
+		T result = identity;
+		for (const auto& value : partial)
+			result = combine(result, value);
+		return result;
+	}
+
+	/** @return whether the calling thread is a worker of this scheduler */
+	bool is_worker() const;
+
+private:
+	friend class TaskGroup;
+
+	/** task of a group */
+	struct Task
+	{
+		std::function<void()> function;
+		TaskGroup* group;
+	};
+
+	/** tasks of a thread, stolen from the front */
+	struct alignas(64) TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<Task*> tasks;
+	};
+
+	template <class F>
+	void split_for(
+	    TaskGroup& group, index_t begin, index_t end, index_t grain, F& body)
+	{
+		while (end - begin > grain)
+		{
+			auto middle = begin + (end - begin) / 2;
+			group.run([this, &group, middle, end, grain, &body]() {
+				split_for(group, middle, end, grain, body);
+			});
+			end = middle;
+		}
+		for (auto i = begin; i < end; ++i)
+			body(i);
+	}
+
+	index_t get_grain(index_t size, index_t grain) const
+	{
+		if (grain > 0)
+			return grain;
+		return std::max<index_t>(1, size / (8 * get_num_threads()));
+	}
+
+	/** queue a task of a group */
+	void spawn(Task* task);
+
+	/** run a task and count it as done */
+	void execute(Task* task);
+
+	/** @return a task to run, from the own queue first, or nullptr
+	 *
+	 * @param self index of the queue of the calling worker, -1 for other
+	 * threads
+	 * @param group group of the task, nullptr for any group
+	 */
+	Task* find_task(int32_t self, const TaskGroup* group);
+
+	/** run tasks until the group is done */
+	void wait_for(TaskGroup& group);
+
+	/** wake a worker sleeping for tasks */
+	void wake_one();
+
+	/** wake the threads sleeping for a group */
+	void wake_waiting();
+
+	/** @return whether the worker may run tasks */
+	bool is_active(int32_t index) const
+	{
+		return index < get_num_threads() - 1;
+	}
+
+	void start_workers();
+
+	void run_worker(int32_t index);
+
+	std::function<int32_t()> m_num_threads;
+	/** number of threads while an Executor runs tasks, zero otherwise */
+	std::atomic<int32_t> m_num_threads_of_tasks;
+
+	/** queues of the workers, followed by the queue of other threads */
+	std::unique_ptr<TaskQueue[]> m_queues;
+	int32_t m_max_workers;
+	std::atomic<int32_t> m_num_workers;
+	/** number of tasks in all queues */
+	std::atomic<int64_t> m_num_queued;
+
+	std::mutex m_workers_mutex;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_sleep_mutex;
+	/** signals workers that a task was queued */
+	std::condition_variable m_wake_up;
+	/** signals threads waiting for a group that a task was queued or a
+	 * group is done */
+	std::condition_variable m_group_changed;
+	/** signals workers beyond the number of threads that it changed */
+	std::condition_variable m_activate;
+	/** number of workers sleeping for tasks */
+	std::atomic<int32_t> m_num_sleeping;
+	/** number of threads sleeping for a group */
+	std::atomic<int32_t> m_num_waiting;
+	std::atomic<bool> m_stop;
+
+	SG_DELETE_COPY_AND_ASSIGN(TaskScheduler);
+};
+}
+
+#endif // __TASK_SCHEDULER_H__
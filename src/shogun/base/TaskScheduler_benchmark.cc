@@ -0,0 +1,125 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/base/ShogunEnv.h"
+#include "shogun/base/TaskScheduler.h"
+
+#include <cmath>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+namespace shogun
+{
+
+/* Nested parallel regions as in cross-validation of a bagged model whose
+ * kernel rows are computed in parallel: few outer tasks, each with many
+ * inner items. Outer parallelism alone leaves threads idle, nested OpenMP
+ * regions start outer times inner threads.
+ */
+static constexpr index_t num_outer = 3;
+static constexpr index_t num_middle = 4;
+static constexpr index_t num_inner = 2048;
+
+static float64_t work_item(index_t i)
+{
+	float64_t result = 0;
+	for (index_t k = 0; k < 64; ++k)
+		result += std::sqrt(float64_t(i + k));
+	return result;
+}
+
+static void TaskScheduler_Nested(benchmark::State& st)
+{
+	env()->set_num_threads(st.range(0));
+	auto scheduler = env()->scheduler();
+	auto plus = [](float64_t a, float64_t b) { return a + b; };
+
+	for (auto _ : st)
+	{
+		std::vector<float64_t> results(num_outer * num_middle);
+		scheduler->parallel_for(
+		    0, num_outer,
+		    [&](index_t outer) {
+			    scheduler->parallel_for(
+			        0, num_middle,
+			        [&](index_t middle) {
+				        results[outer * num_middle + middle] =
+				            scheduler->parallel_reduce(
+				                0, num_inner, 0.0, work_item, plus);
+			        },
+			        1);
+		    },
+		    1);
+		benchmark::DoNotOptimize(results.data());
+	}
+}
+
+static void TaskScheduler_OuterOnly(benchmark::State& st)
+{
+	env()->set_num_threads(st.range(0));
+	auto scheduler = env()->scheduler();
+
+	for (auto _ : st)
+	{
+		std::vector<float64_t> results(num_outer * num_middle);
+		scheduler->parallel_for(
+		    0, num_outer,
+		    [&](index_t outer) {
+			    for (index_t middle = 0; middle < num_middle; ++middle)
+			    {
+				    float64_t sum = 0;
+				    for (index_t i = 0; i < num_inner; ++i)
+					    sum += work_item(i);
+				    results[outer * num_middle + middle] = sum;
+			    }
+		    },
+		    1);
+		benchmark::DoNotOptimize(results.data());
+	}
+}
+
+#ifdef HAVE_OPENMP
+static void OpenMP_Nested(benchmark::State& st)
+{
+	env()->set_num_threads(st.range(0));
+	omp_set_max_active_levels(3);
+
+	for (auto _ : st)
+	{
+		std::vector<float64_t> results(num_outer * num_middle);
+#pragma omp parallel for
+		for (index_t outer = 0; outer < num_outer; ++outer)
+		{
+#pragma omp parallel for
+			for (index_t middle = 0; middle < num_middle; ++middle)
+			{
+				float64_t sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+				for (index_t i = 0; i < num_inner; ++i)
+					sum += work_item(i);
+				results[outer * num_middle + middle] = sum;
+			}
+		}
+		benchmark::DoNotOptimize(results.data());
+	}
+	omp_set_max_active_levels(1);
+}
+#endif
+
+#define ADD_THREAD_ARGS(WHAT)                                                  \
+	WHAT->RangeMultiplier(2)                                                   \
+	    ->Range(1, 16)                                                         \
+	    ->UseRealTime()                                                        \
+	    ->Unit(benchmark::kMicrosecond);
+
+ADD_THREAD_ARGS(BENCHMARK(TaskScheduler_Nested))
+ADD_THREAD_ARGS(BENCHMARK(TaskScheduler_OuterOnly))
+#ifdef HAVE_OPENMP
+ADD_THREAD_ARGS(BENCHMARK(OpenMP_Nested))
+#endif
+}
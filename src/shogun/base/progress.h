@@ -36,10 +36,12 @@
 #ifndef __SG_PROGRESS_H__
 #define __SG_PROGRESS_H__
 
+#include <atomic>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include <shogun/base/range.h>
 #include <shogun/io/SGIO.h>
@@ -71,6 +73,33 @@ namespace shogun
 		UTF8
 	};
 
+	/**
+	 * @class Receives the progress of the computation on the thread it is
+	 * installed on, e.g. a task run by an Executor.
+	 */
+	class ProgressListener
+	{
+	public:
+		virtual ~ProgressListener()
+		{
+		}
+
+		/**
+		 * Called whenever the outermost progress bar of the computation
+		 * advances, possibly from several threads at once.
+		 * @param fraction fraction of the progress bar that is done, in
+		 * [0, 1].
+		 */
+		virtual void on_progress(float64_t fraction) = 0;
+
+		/** @return listener of the current thread, may be null. */
+		static ProgressListener*& current()
+		{
+			static thread_local ProgressListener* listener = nullptr;
+			return listener;
+		}
+	};
+
 	/**
 	 * @class Printer class that displays the progress bar.
 	 */
@@ -91,11 +120,17 @@ namespace shogun
 		      m_prefix(prefix), m_mode(mode), m_columns_num(0), m_rows_num(0),
 		      m_last_progress(0), m_last_progress_time(0),
 		      m_progress_start_time(Time::get_curtime()),
-		      m_current_value(min_value)
+		      m_current_value(min_value),
+		      m_listener(ProgressListener::current()),
+		      m_thread(std::this_thread::get_id())
 		{
+			// only the outermost progress bar reports to the listener
+			ProgressListener::current() = nullptr;
 		}
 		~ProgressPrinter()
 		{
+			if (m_listener && m_thread == std::this_thread::get_id())
+				ProgressListener::current() = m_listener;
 		}
 
 		/**
@@ -114,6 +149,9 @@ namespace shogun
 				lock.unlock();
 				return;
 			}
+			// this call completes the step of the current value
+			notify_listener(
+			    m_current_value.load() + 1, m_min_value, m_max_value);
 			print_progress_impl();
 			if (m_current_value.load() - m_min_value ==
 			    m_max_value - m_min_value)
@@ -137,6 +175,7 @@ namespace shogun
 				lock.unlock();
 				return;
 			}
+			notify_listener(val, min_val, max_val);
 			print_progress_absolute_impl(current_val, val, min_val, max_val);
 			if (val - m_min_value == m_max_value - m_min_value)
 			{
@@ -164,6 +203,17 @@ namespace shogun
 		}
 
 	private:
+		/** Report the fraction of [min_value, max_value] done to the
+		 * listener, if any. */
+		void notify_listener(
+		    float64_t value, float64_t min_value, float64_t max_value) const
+		{
+			if (!m_listener || max_value <= min_value)
+				return;
+			m_listener->on_progress(Math::clamp(
+			    (value - min_value) / (max_value - min_value), 0.0, 1.0));
+		}
+
 		/**
 		 * Logic implementation of the progress bar.
 		 */
@@ -429,6 +479,10 @@ namespace shogun
 		mutable float64_t m_progress_start_time;
 		/** Current value */
 		mutable std::atomic<int64_t> m_current_value;
+		/** Listener of the thread that created the progress bar */
+		ProgressListener* m_listener;
+		/** Thread that created the progress bar */
+		std::thread::id m_thread;
 		/** Lock for multithreaded operations **/
 		mutable Lock lock;
 	};
@@ -28,6 +28,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/lapack.h>
 
@@ -654,6 +655,7 @@ int32_t SVMLight::optimize_to_convergence(int32_t* docs, int32_t* label, int32_t
 	   iteration++)
   {
 #endif
+	  SG_TRACE_SCOPE("SVMLight::iteration");
 	  COMPUTATION_CONTROLLERS
 	  if(use_kernel_cache)
 		  kernel->set_time(iteration);  /* for lru cache */
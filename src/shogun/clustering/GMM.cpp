@@ -11,13 +11,17 @@
 #include <shogun/clustering/GMM.h>
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -146,38 +150,12 @@ float64_t GMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chang
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
-	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
+	SGMatrix<float64_t> data=dotdata->get_feature_matrix();
 	auto pb = SG_PROGRESS(range(max_iter));
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
-		log_likelihood_cur=0;
-
-		for (int32_t i=0; i<num_vectors; i++)
-		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i] = std::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i * m_components.size() + j] = std::exp(
-				    logPxy[index_t(i * m_components.size() + j)] - logPx[i]);
-			}
-		}
+		log_likelihood_cur=expectation_step(data, alpha);
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
 			break;
@@ -349,6 +327,219 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 	return cur_likelihood;
 }
 
+float64_t GMM::train_minibatch_em(
+	std::shared_ptr<StreamingDenseFeatures<float64_t>> stream,
+	int32_t batch_size, int32_t num_epochs, float64_t min_cov,
+	float64_t forgetting_rate)
+{
+	require(stream, "No stream to train on.");
+	require(batch_size>0, "Batch size ({}) must be positive.", batch_size);
+	require(forgetting_rate>0.5 && forgetting_rate<=1,
+		"Forgetting rate ({}) must be in (0.5, 1].", forgetting_rate);
+
+	int32_t num_components=m_components.size();
+	SGVector<float64_t> stat_weights(num_components);
+	linalg::zero(stat_weights);
+	std::vector<SGVector<float64_t>> stat_means(num_components);
+	std::vector<SGMatrix<float64_t>> stat_covs(num_components);
+
+	int32_t num_steps=0;
+	float64_t log_likelihood=0;
+
+	stream->start_parser();
+	for (auto epoch : SG_PROGRESS(range(num_epochs)))
+	{
+		if (epoch>0)
+			stream->reset_stream();
+
+		log_likelihood=0;
+		index_t num_seen=0;
+		while (true)
+		{
+			auto batch=stream->get_streamed_features(batch_size)
+				->as<DenseFeatures<float64_t>>();
+			SGMatrix<float64_t> data=batch->get_feature_matrix();
+			if (data.num_cols==0)
+				break;
+
+			/* initialize with EM on the first mini-batch if necessary */
+			if (m_components[0]->get_mean().vector==NULL)
+			{
+				auto all_features=features;
+				set_features(batch);
+				train_em(min_cov);
+				set_features(all_features);
+			}
+
+			SGMatrix<float64_t> alpha(data.num_cols, num_components);
+			float64_t batch_log_likelihood=expectation_step(data, alpha);
+			log_likelihood+=batch_log_likelihood;
+			num_seen+=data.num_cols;
+
+			float64_t step=std::pow(num_steps+1, -forgetting_rate);
+			stepwise_maximization(data, alpha, step, min_cov, stat_weights,
+				stat_means, stat_covs);
+
+			this->observe<float64_t>(num_steps, "log_likelihood",
+				"Log Likelihood", batch_log_likelihood / data.num_cols);
+			num_steps++;
+
+			/* stream is exhausted */
+			if (data.num_cols<batch_size)
+				break;
+		}
+
+		if (num_seen>0)
+			log_likelihood/=num_seen;
+	}
+	stream->end_parser();
+
+	return log_likelihood;
+}
+
+float64_t GMM::expectation_step(SGMatrix<float64_t> data, SGMatrix<float64_t> alpha)
+{
+	int32_t num_vectors=data.num_cols;
+	int32_t num_components=m_components.size();
+	ASSERT(alpha.num_rows==num_vectors && alpha.num_cols==num_components)
+
+	/* log densities of all points, one component at a time */
+	std::vector<SGVector<float64_t>> logPxy(num_components);
+	SGVector<float64_t> log_coef(num_components);
+	for (int32_t j=0; j<num_components; j++)
+	{
+		logPxy[j]=m_components[j]->compute_log_PDF(data);
+		log_coef[j]=std::log(m_coefficients[j]);
+	}
+
+	/* responsibilities via log-sum-exp */
+	float64_t log_likelihood=0;
+	#pragma omp parallel for schedule(static) reduction(+:log_likelihood)
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		float64_t* alpha_i=alpha.matrix+index_t(i)*num_components;
+		float64_t max_log=-std::numeric_limits<float64_t>::infinity();
+		for (int32_t j=0; j<num_components; j++)
+		{
+			alpha_i[j]=logPxy[j][i]+log_coef[j];
+			max_log=Math::max(max_log, alpha_i[j]);
+		}
+
+		float64_t sum=0;
+		for (int32_t j=0; j<num_components; j++)
+			sum+=std::exp(alpha_i[j]-max_log);
+
+		float64_t logPx=max_log+std::log(sum);
+		for (int32_t j=0; j<num_components; j++)
+			alpha_i[j]=std::exp(alpha_i[j]-logPx);
+
+		log_likelihood+=logPx;
+	}
+
+	return log_likelihood;
+}
+
+void GMM::stepwise_maximization(SGMatrix<float64_t> data,
+	SGMatrix<float64_t> alpha, float64_t step, float64_t min_cov,
+	SGVector<float64_t> stat_weights,
+	std::vector<SGVector<float64_t>>& stat_means,
+	std::vector<SGMatrix<float64_t>>& stat_covs)
+{
+	int32_t num_dim=data.num_rows;
+	int32_t num_components=m_components.size();
+	float64_t scale=step/data.num_cols;
+
+	Eigen::Map<const Eigen::MatrixXd> points(data.matrix, num_dim, data.num_cols);
+	/* alpha stores the responsibilities of a point contiguously */
+	Eigen::Map<const Eigen::MatrixXd> resp(alpha.matrix, num_components, data.num_cols);
+	Eigen::MatrixXd batch_means=points*resp.transpose();
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t j=0; j<num_components; j++)
+	{
+		ECovType cov_type=m_components[j]->get_cov_type();
+		if (stat_means[j].vlen==0)
+		{
+			stat_means[j]=SGVector<float64_t>(num_dim);
+			stat_means[j].zero();
+			stat_covs[j]=SGMatrix<float64_t>(num_dim, cov_type==FULL ? num_dim : 1);
+			stat_covs[j].zero();
+		}
+
+		typename SGVector<float64_t>::EigenVectorXtMap stat_mean=stat_means[j];
+		typename SGMatrix<float64_t>::EigenMatrixXtMap stat_cov=stat_covs[j];
+
+		stat_weights[j]=(1-step)*stat_weights[j]+scale*resp.row(j).sum();
+		stat_mean=(1-step)*stat_mean+scale*batch_means.col(j);
+		if (cov_type==FULL)
+		{
+			stat_cov=(1-step)*stat_cov+
+				scale*(points*resp.row(j).asDiagonal()*points.transpose());
+		}
+		else
+		{
+			stat_cov=(1-step)*stat_cov+
+				scale*(points.cwiseAbs2()*resp.row(j).transpose());
+		}
+
+		if (stat_weights[j]<=0)
+			continue;
+
+		SGVector<float64_t> mean(num_dim);
+		typename SGVector<float64_t>::EigenVectorXtMap mean_eig=mean;
+		mean_eig=stat_mean/stat_weights[j];
+		m_components[j]->set_mean(mean);
+
+		switch (cov_type)
+		{
+			case FULL:
+			{
+				SGMatrix<float64_t> cov(num_dim, num_dim);
+				typename SGMatrix<float64_t>::EigenMatrixXtMap cov_eig=cov;
+				cov_eig=stat_cov/stat_weights[j]-mean_eig*mean_eig.transpose();
+
+				SGVector<float64_t> d0(num_dim);
+				SGMatrix<float64_t> u(num_dim, num_dim);
+				linalg::eigen_solver_symmetric(cov, d0, u);
+
+				for (auto& v: d0)
+					v=Math::max(min_cov, v);
+
+				m_components[j]->set_d(d0);
+				m_components[j]->set_u(u);
+				break;
+			}
+			case DIAG:
+			{
+				SGVector<float64_t> d0(num_dim);
+				for (int32_t k=0; k<num_dim; k++)
+				{
+					d0[k]=stat_cov(k, 0)/stat_weights[j]-mean[k]*mean[k];
+					d0[k]=Math::max(min_cov, d0[k]);
+				}
+
+				m_components[j]->set_d(d0);
+				break;
+			}
+			case SPHERICAL:
+			{
+				SGVector<float64_t> d0(1);
+				d0[0]=0;
+				for (int32_t k=0; k<num_dim; k++)
+					d0[0]+=stat_cov(k, 0)/stat_weights[j]-mean[k]*mean[k];
+
+				d0[0]=Math::max(min_cov, d0[0]/num_dim);
+				m_components[j]->set_d(d0);
+				break;
+			}
+		}
+	}
+
+	float64_t weight_sum=linalg::sum(stat_weights);
+	for (int32_t j=0; j<num_components; j++)
+		m_coefficients[j]=stat_weights[j]/weight_sum;
+}
+
 void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_cov, int32_t max_em_iter, float64_t min_change)
 {
 	auto dotdata=features->as<DotFeatures>();
@@ -18,6 +18,8 @@
 
 namespace shogun
 {
+template <class T> class StreamingDenseFeatures;
+
 /** @brief Gaussian Mixture Model interface.
  *
  * Takes input of number of Gaussians to fit and a covariance type to use.
@@ -25,7 +27,8 @@ namespace shogun
  * Split-Merge Expectation-Maximization algorithms. To estimate the GMM
  * parameters, the train(...) method has to be run to set the training data
  * and then either train_em(...) or train_smem(...) to do the actual
- * estimation.
+ * estimation. Data that does not fit into memory can be streamed through
+ * train_minibatch_em(...).
  * The EM algorithm is described here:
  * http://en.wikipedia.org/wiki/Expectation-maximization_algorithm
  * The SMEM algorithm is described here:
@@ -88,6 +91,26 @@ class GMM : public RandomMixin<Distribution>
 				float64_t min_cov=1e-9, int32_t max_em_iter=1000,
 				float64_t min_change=1e-9);
 
+		/** learn model using stepwise EM on mini-batches read from a
+		 * stream, for data that does not fit into memory. Every
+		 * mini-batch is blended into running sufficient statistics with
+		 * step size \f$(t+1)^{-\kappa}\f$, from which the parameters are
+		 * re-estimated. If the components are not initialized yet, EM is
+		 * run on the first mini-batch.
+		 *
+		 * @param stream streaming dense features
+		 * @param batch_size number of vectors per mini-batch
+		 * @param num_epochs number of passes over the stream
+		 * @param min_cov minimum covariance
+		 * @param forgetting_rate \f$\kappa\f$, in (0.5, 1]
+		 *
+		 * @return average log likelihood of the last epoch
+		 */
+		float64_t train_minibatch_em(
+				std::shared_ptr<StreamingDenseFeatures<float64_t>> stream,
+				int32_t batch_size=10000, int32_t num_epochs=1,
+				float64_t min_cov=1e-9, float64_t forgetting_rate=0.6);
+
 		/** maximum likelihood estimation
 		 *
 		 * @param alpha point assignment
@@ -238,6 +261,36 @@ class GMM : public RandomMixin<Distribution>
 		void partial_em(int32_t comp1, int32_t comp2, int32_t comp3,
 				float64_t min_cov, int32_t max_em_iter, float64_t min_change);
 
+		/** E-step on a block of points: computes the log densities of all
+		 * components for all points, followed by a log-sum-exp pass over
+		 * the points in parallel
+		 *
+		 * @param data points, one per column
+		 * @param alpha responsibilities (num_points x num_components),
+		 * stored point by point
+		 *
+		 * @return log likelihood of data
+		 */
+		float64_t expectation_step(SGMatrix<float64_t> data, SGMatrix<float64_t> alpha);
+
+		/** blends the sufficient statistics of a mini-batch into the
+		 * running ones and re-estimates the parameters from them
+		 *
+		 * @param data points of the mini-batch, one per column
+		 * @param alpha responsibilities as computed by expectation_step
+		 * @param step step size
+		 * @param min_cov minimum covariance
+		 * @param stat_weights running sum of the responsibilities
+		 * @param stat_means running responsibility weighted sums of points
+		 * @param stat_covs running responsibility weighted sums of the
+		 * outer products (FULL) or squares (DIAG, SPHERICAL) of points
+		 */
+		void stepwise_maximization(SGMatrix<float64_t> data,
+				SGMatrix<float64_t> alpha, float64_t step, float64_t min_cov,
+				SGVector<float64_t> stat_weights,
+				std::vector<SGVector<float64_t>>& stat_means,
+				std::vector<SGMatrix<float64_t>>& stat_covs);
+
 	protected:
 		/** Mixture components */
 		std::vector<std::shared_ptr<Gaussian>> m_components;
@@ -13,19 +13,44 @@
 #include <shogun/labels/Labels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct pair
+namespace
 {
-	/** index 1 */
-	int32_t idx1;
-	/** index 2 */
-	int32_t idx2;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/** position of the distance of points i and j in a condensed distance
+ * matrix of n points, which stores the upper triangle row by row */
+inline int64_t condensed_index(int64_t n, int64_t i, int64_t j)
+{
+	if (i>j)
+		std::swap(i, j);
+	return n*i-i*(i+1)/2+j-i-1;
+}
+
+/** root of x in a union-find forest, with path compression */
+int32_t find_root(std::vector<int32_t>& parent, int32_t x)
+{
+	int32_t root=x;
+	while (parent[root]!=root)
+		root=parent[root];
+
+	while (parent[x]!=root)
+	{
+		int32_t next=parent[x];
+		parent[x]=root;
+		x=next;
+	}
+	return root;
+}
+
+}
 
 Hierarchical::Hierarchical()
 : DistanceMachine()
@@ -54,6 +79,7 @@ void Hierarchical::init()
 	pairs_len = 0;
 	merge_distance = NULL;
 	merge_distance_len = 0;
+	m_linkage = HL_SINGLE;
 }
 
 void Hierarchical::register_parameters()
@@ -64,6 +90,10 @@ void Hierarchical::register_parameters()
 	watch_param("table_size", &table_size);
 	watch_param("pairs", &pairs, &pairs_len);
 	watch_param("merge_distance", &merge_distance, &merge_distance_len);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_linkage, "linkage", "Linkage criterion",
+	    ParameterProperties::HYPER,
+	    SG_OPTIONS(HL_SINGLE, HL_COMPLETE, HL_AVERAGE, HL_WARD));
 }
 
 Hierarchical::~Hierarchical()
@@ -91,8 +121,6 @@ bool Hierarchical::train_machine(std::shared_ptr<Features> data)
 	int32_t num=lhs->get_num_vectors();
 	ASSERT(num>0)
 
-	const int32_t num_pairs=num*(num-1)/2;
-
 	SG_FREE(merge_distance);
 	merge_distance=SG_MALLOC(float64_t, num);
 	merge_distance_len=num;
@@ -107,76 +135,234 @@ bool Hierarchical::train_machine(std::shared_ptr<Features> data)
 	pairs=SG_MALLOC(int32_t, 2*num);
 	SGVector<int32_t>::fill_vector(pairs, 2*num, -1);
 
-	pair* index=SG_MALLOC(pair, num_pairs);
-	float64_t* distances=SG_MALLOC(float64_t, num_pairs);
+	std::vector<std::pair<int32_t, int32_t>> merge_pairs;
+	std::vector<float64_t> merge_dists;
+	merge_pairs.reserve(num);
+	merge_dists.reserve(num);
+
+	if (m_linkage==HL_SINGLE)
+		single_linkage(num, merge_pairs, merge_dists);
+	else
+		nn_chain_linkage(num, merge_pairs, merge_dists);
+
+	/* all supported linkages are reducible, so sorting the merges by
+	 * distance yields a valid merge sequence. The stable sort keeps
+	 * merges of equal distance in the order they were found, which puts
+	 * every merge after the ones creating its clusters */
+	std::vector<int32_t> order(merge_dists.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+		return merge_dists[a]<merge_dists[b];
+	});
+
+	/* clusters are numbered by the points 0..num-1 and num+l for the
+	 * cluster created in the l-th merge */
+	std::vector<int32_t> parent(2*num-1);
+	std::iota(parent.begin(), parent.end(), 0);
 
-	int32_t offs=0;
-	for (auto i : SG_PROGRESS(range(0, num)))
+	int32_t l=0;
+	for (; l<int32_t(order.size()) && (num-l)>=merges; l++)
 	{
-		for (int32_t j=i+1; j<num; j++)
-		{
-			distances[offs] = distance->distance(i, j);
-			index[offs].idx1 = i;
-			index[offs].idx2 = j;
-			offs++; // offs=i*(i+1)/2+j
-		}
+		const auto& merge=merge_pairs[order[l]];
+		int32_t c1=find_root(parent, merge.first);
+		int32_t c2=find_root(parent, merge.second);
+
+		pairs[2*l]=Math::min(c1, c2);
+		pairs[2*l+1]=Math::max(c1, c2);
+		merge_distance[l]=merge_dists[order[l]];
+
+		int32_t c=num+l;
+		parent[c1]=c;
+		parent[c2]=c;
+#ifdef DEBUG_HIERARCHICAL
+		io::print("l={:04} c1={:+04} c2={:+04d} c={:+04d} dist={:6.6f}\n", l, c1, c2, c, merge_distance[l]);
+#endif
 	}
 
-	Math::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
-	//Math::display_vector(distances, (num-1)*num/2, "dists");
+	for (int32_t m=0; m<num; m++)
+		assignment[m]=find_root(parent, m);
 
-	auto pb = SG_PROGRESS(range(0, num_pairs - 1));
-	int32_t k=-1;
-	int32_t l=0;
-	for (; l<num && (num-l)>=merges && k<num_pairs-1; l++)
-	{
-		while (k<num_pairs-1)
-		{
-			k++;
+	table_size=l-1;
+	ASSERT(table_size>0)
 
-			int32_t i=index[k].idx1;
-			int32_t j=index[k].idx2;
-			int32_t c1=assignment[i];
-			int32_t c2=assignment[j];
+	return true;
+}
 
-			if (c1==c2)
-				continue;
+void Hierarchical::single_linkage(int32_t num,
+	std::vector<std::pair<int32_t, int32_t>>& merge_pairs,
+	std::vector<float64_t>& merge_dists)
+{
+	/* Prim's algorithm: the edges of the minimum spanning tree are the
+	 * single linkage merges. Only the distance of every point to the
+	 * tree is kept. */
+	SGVector<float64_t> min_dist(num);
+	min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	SGVector<int32_t> nearest(num);
+	nearest.zero();
+
+	/* points not in the tree yet */
+	std::vector<int32_t> remaining(num-1);
+	std::iota(remaining.begin(), remaining.end(), 1);
+
+	/* whether the point at position p is closer to the tree than at q,
+	 * ties are broken by point index for reproducibility */
+	auto closer=[&](int32_t p, int32_t q) {
+		int32_t i=remaining[p];
+		int32_t j=remaining[q];
+		return min_dist[i]<min_dist[j] || (min_dist[i]==min_dist[j] && i<j);
+	};
+
+	int32_t current=0;
+	auto pb = SG_PROGRESS(range(0, num-1));
+	for (int32_t step=0; step<num-1; step++)
+	{
+		const int32_t num_remaining=remaining.size();
+		int32_t best=-1;
 
-			pb.print_progress();
+		#pragma omp parallel
+		{
+			int32_t local_best=-1;
 
-			if (c1<c2)
-			{
-				pairs[2*l]=c1;
-				pairs[2*l+1]=c2;
-			}
-			else
+			#pragma omp for schedule(static)
+			for (int32_t p=0; p<num_remaining; p++)
 			{
-				pairs[2*l]=c2;
-				pairs[2*l+1]=c1;
+				int32_t j=remaining[p];
+				float64_t dist=distance->distance(current, j);
+				if (dist<min_dist[j])
+				{
+					min_dist[j]=dist;
+					nearest[j]=current;
+				}
+
+				if (local_best<0 || closer(p, local_best))
+					local_best=p;
 			}
-			merge_distance[l]=distances[k];
 
-			int32_t c=num+l;
-			for (int32_t m=0; m<num; m++)
+			#pragma omp critical (Hierarchical_single_linkage)
 			{
-				if (assignment[m] == c1 || assignment[m] == c2)
-					assignment[m] = c;
+				if (local_best>=0 && (best<0 || closer(local_best, best)))
+					best=local_best;
 			}
-#ifdef DEBUG_HIERARCHICAL
-			io::print("l={:04} i={:04d} j={:04d} c1={:+04} c2={:+04d} c={:+04d} dist={:6.6f}\n", l,i,j, c1,c2,c, merge_distance[l]);
-#endif
-			break;
 		}
+
+		current=remaining[best];
+		merge_pairs.emplace_back(nearest[current], current);
+		merge_dists.push_back(min_dist[current]);
+
+		remaining[best]=remaining.back();
+		remaining.pop_back();
+		pb.print_progress();
 	}
 	pb.complete();
+}
 
-	table_size=l-1;
-	ASSERT(table_size>0)
-	SG_FREE(distances);
-	SG_FREE(index);
+void Hierarchical::nn_chain_linkage(int32_t num,
+	std::vector<std::pair<int32_t, int32_t>>& merge_pairs,
+	std::vector<float64_t>& merge_dists)
+{
+	const int64_t n=num;
+	std::vector<float64_t> dists(n*(n-1)/2);
+
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int32_t i=0; i<num-1; i++)
+	{
+		int64_t offs=condensed_index(n, i, i+1);
+		for (int32_t j=i+1; j<num; j++)
+			dists[offs++]=distance->distance(i, j);
+	}
 
+	/* every active cluster is stored at the index of one of its points */
+	std::vector<int32_t> cluster_size(num, 1);
+	std::vector<char> active(num, 1);
+	std::vector<int32_t> chain;
+	chain.reserve(num);
+	int32_t first_active=0;
 
-	return true;
+	auto pb = SG_PROGRESS(range(0, num-1));
+	for (int32_t step=0; step<num-1; step++)
+	{
+		if (chain.empty())
+		{
+			while (!active[first_active])
+				first_active++;
+			chain.push_back(first_active);
+		}
+
+		/* grow the chain of nearest neighbours until it ends in a pair of
+		 * reciprocal nearest neighbours */
+		int32_t a, b;
+		float64_t min_dist;
+		while (true)
+		{
+			a=chain.back();
+			int32_t prev=chain.size()>1 ? chain[chain.size()-2] : -1;
+
+			/* the previous element wins ties, which rules out cycles */
+			b=prev;
+			min_dist=prev>=0 ? dists[condensed_index(n, a, prev)] :
+				std::numeric_limits<float64_t>::infinity();
+			for (int32_t x=0; x<num; x++)
+			{
+				if (!active[x] || x==a)
+					continue;
+
+				float64_t dist=dists[condensed_index(n, a, x)];
+				if (dist<min_dist || b<0)
+				{
+					min_dist=dist;
+					b=x;
+				}
+			}
+
+			if (b==prev)
+				break;
+			chain.push_back(b);
+		}
+		chain.pop_back();
+		chain.pop_back();
+
+		merge_pairs.emplace_back(a, b);
+		merge_dists.push_back(min_dist);
+
+		/* Lance-Williams update of the distances to the merged cluster,
+		 * which is stored at b */
+		const float64_t size_a=cluster_size[a];
+		const float64_t size_b=cluster_size[b];
+		#pragma omp parallel for schedule(static)
+		for (int32_t x=0; x<num; x++)
+		{
+			if (!active[x] || x==a || x==b)
+				continue;
+
+			const float64_t dist_a=dists[condensed_index(n, a, x)];
+			float64_t& dist_b=dists[condensed_index(n, b, x)];
+			switch (m_linkage)
+			{
+				case HL_COMPLETE:
+					dist_b=Math::max(dist_a, dist_b);
+					break;
+				case HL_AVERAGE:
+					dist_b=(size_a*dist_a+size_b*dist_b)/(size_a+size_b);
+					break;
+				case HL_WARD:
+				{
+					const float64_t size_x=cluster_size[x];
+					dist_b=std::sqrt(Math::max(((size_a+size_x)*dist_a*dist_a+
+						(size_b+size_x)*dist_b*dist_b-size_x*min_dist*min_dist)/
+						(size_a+size_b+size_x), 0.0));
+					break;
+				}
+				case HL_SINGLE:
+					dist_b=Math::min(dist_a, dist_b);
+					break;
+			}
+		}
+
+		active[a]=0;
+		cluster_size[b]+=cluster_size[a];
+		pb.print_progress();
+	}
+	pb.complete();
 }
 
 bool Hierarchical::load(FILE* srcfile)
@@ -201,16 +387,16 @@ int32_t Hierarchical::get_merges()
 
 SGVector<int32_t> Hierarchical::get_assignment()
 {
-	return SGVector<int32_t>(assignment,table_size, false);
+	return SGVector<int32_t>(assignment,assignment_len, false);
 }
 
 SGVector<float64_t> Hierarchical::get_merge_distances()
 {
-	return SGVector<float64_t>(merge_distance,merges, false);
+	return SGVector<float64_t>(merge_distance,table_size+1, false);
 }
 
 SGMatrix<int32_t> Hierarchical::get_cluster_pairs()
 {
-	return SGMatrix<int32_t>(pairs,2,merges, false);
+	return SGMatrix<int32_t>(pairs,2,table_size+1, false);
 }
 
@@ -15,23 +15,47 @@
 #include <shogun/distance/Distance.h>
 #include <shogun/machine/DistanceMachine.h>
 
+#include <utility>
+#include <vector>
+
 namespace shogun
 {
 class DistanceMachine;
 
-/** @brief Agglomerative hierarchical single linkage clustering.
+/** linkage criteria of hierarchical clustering */
+enum EHierarchicalLinkage
+{
+	/** minimum distance of the elements */
+	HL_SINGLE,
+	/** maximum distance of the elements */
+	HL_COMPLETE,
+	/** average distance of the elements */
+	HL_AVERAGE,
+	/** increase of the within cluster variance, for Euclidean distances */
+	HL_WARD
+};
+
+/** @brief Agglomerative hierarchical clustering.
  *
  * Starting with each object being assigned to its own cluster clusters are
- * iteratively merged.  Here the clusters are merged whose elements have
- * minimum distance, i.e.  the clusters A and B that obtain
+ * iteratively merged.  With single linkage (default), the clusters are merged
+ * whose elements have minimum distance, i.e.  the clusters A and B that obtain
  *
  * \f[
  * \min\{d({\bf x},{\bf x'}): {\bf x}\in {\cal A},{\bf x'}\in {\cal B}\}
  * \f]
  *
- * are merged.
+ * are merged. Complete, average and Ward linkage are supported as well.
+ *
+ * Single linkage is computed from a minimum spanning tree (Prim's algorithm)
+ * in O(n) memory, without storing the distances. The other linkages use
+ * the nearest-neighbour chain algorithm with Lance-Williams updates on a
+ * condensed distance matrix of n(n-1)/2 entries. Both take O(n^2) time and
+ * compute the distances in parallel.
  *
- * cf e.g. http://en.wikipedia.org/wiki/Data_clustering*/
+ * cf e.g. http://en.wikipedia.org/wiki/Data_clustering
+ * cf. D. Muellner, Modern hierarchical, agglomerative clustering algorithms,
+ * arXiv:1109.2378, 2011 */
 class Hierarchical : public DistanceMachine
 {
 	public:
@@ -79,6 +103,24 @@ class Hierarchical : public DistanceMachine
 			merges=m;
 		}
 
+		/** set linkage
+		 *
+		 * @param linkage new linkage criterion
+		 */
+		void set_linkage(EHierarchicalLinkage linkage)
+		{
+			m_linkage=linkage;
+		}
+
+		/** get linkage
+		 *
+		 * @return linkage criterion
+		 */
+		EHierarchicalLinkage get_linkage() const
+		{
+			return m_linkage;
+		}
+
 		/** get merges
 		 *
 		 * @return merges
@@ -126,6 +168,25 @@ class Hierarchical : public DistanceMachine
 		/** Register all parameters (aka this class' attributes) */
 		void register_parameters();
 
+		/** single linkage merges from a minimum spanning tree
+		 *
+		 * @param num number of points
+		 * @param merge_pairs the points whose clusters are merged
+		 * @param merge_dists distances at which they are merged
+		 */
+		void single_linkage(int32_t num, std::vector<std::pair<int32_t, int32_t>>& merge_pairs,
+				std::vector<float64_t>& merge_dists);
+
+		/** complete, average or Ward linkage merges via nearest-neighbour
+		 * chains, in the order they were found
+		 *
+		 * @param num number of points
+		 * @param merge_pairs the points whose clusters are merged
+		 * @param merge_dists distances at which they are merged
+		 */
+		void nn_chain_linkage(int32_t num, std::vector<std::pair<int32_t, int32_t>>& merge_pairs,
+				std::vector<float64_t>& merge_dists);
+
 	protected:
 		/// the number of merges in hierarchical clustering
 		int32_t merges;
@@ -147,6 +208,9 @@ class Hierarchical : public DistanceMachine
 		/// distance at which pair i/j was added
 		float64_t* merge_distance;
 		int32_t merge_distance_len;
+
+		/// linkage criterion
+		EHierarchicalLinkage m_linkage;
 };
 }
 #endif
@@ -6,6 +6,8 @@
  *          Bjoern Esser, parijat
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/base/progress.h>
 #include <shogun/clustering/KMeans.h>
 #include <shogun/distance/Distance.h>
@@ -13,33 +15,135 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
+#include <vector>
 
 using namespace Eigen;
 using namespace shogun;
 
+namespace
+{
+
+/** Euclidean distance of two dim dimensional vectors */
+inline float64_t euclidean_distance(
+	const float64_t* a, const float64_t* b, int32_t dim)
+{
+	float64_t result=0;
+	for (int32_t i=0; i<dim; i++)
+	{
+		const float64_t diff=a[i]-b[i];
+		result+=diff*diff;
+	}
+	return std::sqrt(result);
+}
+
+/** Recomputes the centers as means of their assigned points. Every thread
+ * accumulates a contiguous chunk of points into its own sums, which are
+ * reduced in a fixed order afterwards, so there is no contention on the
+ * centers and the result does not depend on the thread scheduling.
+ * Clusters without points get a zero center.
+ */
+void update_centers(
+	SGMatrix<float64_t> data, SGVector<int32_t> assignments,
+	SGMatrix<float64_t> centers, SGVector<int64_t> weights)
+{
+	const int32_t dim=data.num_rows;
+	const index_t num_vectors=data.num_cols;
+	const int32_t num_centers=centers.num_cols;
+	const int32_t num_chunks=Math::max(
+		Math::min(env()->get_num_threads(), num_vectors), 1);
+
+	std::vector<SGMatrix<float64_t>> chunk_sums(num_chunks);
+	std::vector<SGVector<int64_t>> chunk_weights(num_chunks);
+
+	#pragma omp parallel for schedule(static, 1)
+	for (int32_t c=0; c<num_chunks; c++)
+	{
+		SGMatrix<float64_t> sums(dim, num_centers);
+		SGVector<int64_t> counts(num_centers);
+		sums.zero();
+		counts.zero();
+
+		const index_t begin=int64_t(num_vectors)*c/num_chunks;
+		const index_t end=int64_t(num_vectors)*(c+1)/num_chunks;
+		for (index_t i=begin; i<end; i++)
+		{
+			const int32_t cluster_i=assignments[i];
+			const float64_t* vec=data.get_column_vector(i);
+			float64_t* sum=sums.get_column_vector(cluster_i);
+			for (int32_t j=0; j<dim; j++)
+				sum[j]+=vec[j];
+			++counts[cluster_i];
+		}
+
+		chunk_sums[c]=sums;
+		chunk_weights[c]=counts;
+	}
+
+	#pragma omp parallel for schedule(static)
+	for (int32_t i=0; i<num_centers; i++)
+	{
+		float64_t* center=centers.get_column_vector(i);
+		std::fill(center, center+dim, 0.0);
+		weights[i]=0;
+
+		for (int32_t c=0; c<num_chunks; c++)
+		{
+			const float64_t* sum=chunk_sums[c].get_column_vector(i);
+			for (int32_t j=0; j<dim; j++)
+				center[j]+=sum[j];
+			weights[i]+=chunk_weights[c][i];
+		}
+
+		if (weights[i]!=0)
+		{
+			const float64_t scale=1.0/weights[i];
+			for (int32_t j=0; j<dim; j++)
+				center[j]*=scale;
+		}
+	}
+}
+
+}
 
 namespace shogun
 {
 
 KMeans::KMeans():KMeansBase()
 {
+	init();
 }
 
 KMeans::KMeans(int32_t k_i, std::shared_ptr<Distance> d_i, bool use_kmpp_i):KMeansBase(k_i, std::move(d_i), use_kmpp_i)
 {
+	init();
 }
 
 KMeans::KMeans(int32_t k_i, std::shared_ptr<Distance> d_i, SGMatrix<float64_t> centers_i):KMeansBase(k_i, std::move(d_i), centers_i)
 {
+	init();
 }
 
 KMeans::~KMeans()
 {
 }
 
+void KMeans::init()
+{
+	m_algorithm=KMA_HAMERLY;
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_algorithm, "algorithm",
+	    "Algorithm to run the iterations with",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(KMA_LLOYD, KMA_HAMERLY, KMA_ELKAN));
+}
+
 void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 {
 	auto lhs =
@@ -49,6 +153,9 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 	int32_t dim=lhs->get_num_features();
 
 	auto rhs_cache = distance->get_rhs();
+	SGMatrix<float64_t> data;
+	if (!fixed_centers)
+		data=lhs->get_feature_matrix();
 
 	SGVector<int32_t> cluster_assignments=SGVector<int32_t>(lhs_size);
 	cluster_assignments.zero();
@@ -98,13 +205,14 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 			if (min_cluster!=cluster_assignments_i)
 			{
 				changed++;
-#pragma omp atomic
-				++weights_set[min_cluster];
-#pragma omp atomic
-				--weights_set[cluster_assignments_i];
 
+				/* the weights are only needed for the online update
+				 * here, the batch update step recomputes them */
 				if(fixed_centers)
 				{
+					++weights_set[min_cluster];
+					--weights_set[cluster_assignments_i];
+
 					SGVector<float64_t>vec=lhs->get_feature_vector(i);
 					float64_t temp_min = 1.0 / weights_set[min_cluster];
 
@@ -146,43 +254,245 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 
 		/* Update Step : Calculate new means */
 		if (!fixed_centers)
+			update_centers(data, cluster_assignments, centers, weights_set);
+
+		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
+
+		if (iter%(max_iter/10) == 0)
+			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
+	}
+	distance->reset_precompute();
+	distance->replace_rhs(rhs_cache);
+
+
+}
+
+void KMeans::bounded_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
+{
+	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	SGMatrix<float64_t> data=lhs->get_feature_matrix();
+	const index_t lhs_size=data.num_cols;
+	const int32_t dim=data.num_rows;
+	const bool elkan=m_algorithm==KMA_ELKAN;
+	const float64_t inf=std::numeric_limits<float64_t>::infinity();
+
+	SGVector<int32_t> cluster_assignments(lhs_size);
+	SGVector<int64_t> weights_set(num_centers);
+
+	/* upper bound of the distance of each point to its center */
+	SGVector<float64_t> upper(lhs_size);
+	/* lower bound of the distance of each point to every other center
+	 * (Elkan) or to the second closest center (Hamerly) */
+	SGMatrix<float64_t> lower(elkan ? num_centers : 1, lhs_size);
+	/* center to center distances, only kept for Elkan */
+	SGMatrix<float64_t> center_dists;
+	if (elkan)
+		center_dists=SGMatrix<float64_t>(num_centers, num_centers);
+	/* half the distance of each center to its closest other center */
+	SGVector<float64_t> half_separation(num_centers);
+	/* how far each center moved in the last update */
+	SGVector<float64_t> moved(num_centers);
+	SGMatrix<float64_t> old_centers(dim, num_centers);
+
+	/* initial assignment computes all distances */
+#pragma omp parallel for schedule(static)
+	for (index_t i=0; i<lhs_size; i++)
+	{
+		const float64_t* vec=data.get_column_vector(i);
+		float64_t* low=lower.get_column_vector(i);
+		int32_t min_cluster=0;
+		float64_t min_dist=inf;
+		float64_t second_dist=inf;
+
+		for (int32_t j=0; j<num_centers; j++)
 		{
-			centers.zero();
+			float64_t dist=euclidean_distance(
+				vec, centers.get_column_vector(j), dim);
+			if (elkan)
+				low[j]=dist;
 
-			for (int32_t i=0; i<lhs_size; i++)
+			if (dist<min_dist)
 			{
-				int32_t cluster_i=cluster_assignments[i];
-
-				auto vec = lhs->get_feature_vector(i);
-				linalg::add_col_vec(centers, cluster_i, vec, centers);
-				lhs->free_feature_vector(vec, i);
+				second_dist=min_dist;
+				min_dist=dist;
+				min_cluster=j;
 			}
+			else if (dist<second_dist)
+				second_dist=dist;
+		}
+
+		cluster_assignments[i]=min_cluster;
+		upper[i]=min_dist;
+		if (!elkan)
+			low[0]=second_dist;
+	}
 
-			for (int32_t i=0; i<num_centers; i++)
+	for (auto iter : SG_PROGRESS(range(max_iter)))
+	{
+		if (iter==max_iter-1)
+			io::warn("KMeans clustering has reached maximum number of ( {} ) iterations without having converged. \
+				   	Terminating. ", iter);
+
+		int32_t changed=lhs_size;
+		if (iter>0)
+		{
+			auto scheduler=env()->scheduler();
+			scheduler->parallel_for(0, num_centers, [&](index_t j)
 			{
-				if (weights_set[i]!=0)
+				const float64_t* center=centers.get_column_vector(j);
+				float64_t min_dist=inf;
+				for (int32_t l=0; l<num_centers; l++)
+				{
+					if (l==j)
+						continue;
+
+					float64_t dist=euclidean_distance(
+						center, centers.get_column_vector(l), dim);
+					if (elkan)
+						center_dists(l, j)=dist;
+					min_dist=Math::min(min_dist, dist);
+				}
+				half_separation[j]=0.5*min_dist;
+			}, 16);
+
+			/* Assigment step : only points whose bounds do not rule
+			 * out a closer center are looked at */
+			changed=scheduler->parallel_reduce(0, lhs_size, 0, [&](index_t i)
+			{
+				const int32_t cluster_assignments_i=cluster_assignments[i];
+				if (upper[i]<=half_separation[cluster_assignments_i])
+					return 0;
+
+				const float64_t* vec=data.get_column_vector(i);
+				float64_t* low=lower.get_column_vector(i);
+				int32_t min_cluster=cluster_assignments_i;
+
+				if (elkan)
+				{
+					const float64_t* center_dist=
+						center_dists.get_column_vector(cluster_assignments_i);
+					bool tight=false;
+					for (int32_t j=0; j<num_centers; j++)
+					{
+						if (j==min_cluster || upper[i]<=low[j] ||
+							upper[i]<=0.5*center_dist[j])
+							continue;
+
+						if (!tight)
+						{
+							upper[i]=euclidean_distance(
+								vec, centers.get_column_vector(min_cluster), dim);
+							low[min_cluster]=upper[i];
+							tight=true;
+							if (upper[i]<=low[j] || upper[i]<=0.5*center_dist[j])
+								continue;
+						}
+
+						float64_t dist=euclidean_distance(
+							vec, centers.get_column_vector(j), dim);
+						low[j]=dist;
+						if (dist<upper[i])
+						{
+							upper[i]=dist;
+							min_cluster=j;
+							center_dist=center_dists.get_column_vector(j);
+						}
+					}
+				}
+				else
 				{
-					auto col = centers.get_column(i);
-					linalg::scale(col, col, 1.0 / weights_set[i]);
+					const float64_t bound=
+						Math::max(half_separation[cluster_assignments_i], low[0]);
+					if (upper[i]<=bound)
+						return 0;
+
+					upper[i]=euclidean_distance(
+						vec, centers.get_column_vector(cluster_assignments_i), dim);
+					if (upper[i]<=bound)
+						return 0;
+
+					float64_t min_dist=inf;
+					float64_t second_dist=inf;
+					for (int32_t j=0; j<num_centers; j++)
+					{
+						float64_t dist=euclidean_distance(
+							vec, centers.get_column_vector(j), dim);
+						if (dist<min_dist)
+						{
+							second_dist=min_dist;
+							min_dist=dist;
+							min_cluster=j;
+						}
+						else if (dist<second_dist)
+							second_dist=dist;
+					}
+					upper[i]=min_dist;
+					low[0]=second_dist;
 				}
+
+				if (min_cluster==cluster_assignments_i)
+					return 0;
+
+				cluster_assignments[i]=min_cluster;
+				return 1;
+			}, [](int32_t a, int32_t b) { return a+b; }, 1024);
+		}
+		if(changed==0)
+			break;
+
+		/* Update Step : Calculate new means and move the bounds along */
+		sg_memcpy(old_centers.matrix, centers.matrix,
+			sizeof(float64_t)*int64_t(dim)*num_centers);
+		update_centers(data, cluster_assignments, centers, weights_set);
+
+		int32_t most_moved=0;
+		for (int32_t j=0; j<num_centers; j++)
+		{
+			moved[j]=euclidean_distance(
+				old_centers.get_column_vector(j), centers.get_column_vector(j), dim);
+			if (moved[j]>moved[most_moved])
+				most_moved=j;
+		}
+		float64_t second_moved=0;
+		for (int32_t j=0; j<num_centers; j++)
+		{
+			if (j!=most_moved)
+				second_moved=Math::max(second_moved, moved[j]);
+		}
+
+#pragma omp parallel for schedule(static)
+		for (index_t i=0; i<lhs_size; i++)
+		{
+			const int32_t cluster_i=cluster_assignments[i];
+			float64_t* low=lower.get_column_vector(i);
+			upper[i]+=moved[cluster_i];
+			if (elkan)
+			{
+				for (int32_t j=0; j<num_centers; j++)
+					low[j]=Math::max(low[j]-moved[j], 0.0);
 			}
+			else
+				low[0]-=cluster_i==most_moved ? second_moved : moved[most_moved];
 		}
 
 		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
 
-		if (iter%(max_iter/10) == 0)
+		if (max_iter>=10 && iter%(max_iter/10) == 0)
 			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
 	}
-	distance->reset_precompute();
-	distance->replace_rhs(rhs_cache);
-
-
 }
 
 bool KMeans::train_machine(std::shared_ptr<Features> data)
 {
 	initialize_training(data);
-	Lloyd_KMeans(cluster_centers, k);
+
+	/* the bounds rely on the triangle inequality of the distance and
+	 * only make sense for the batch update of the centers */
+	if (m_algorithm!=KMA_LLOYD && !fixed_centers &&
+		distance->get_distance_type()==D_EUCLIDEAN)
+		bounded_KMeans(cluster_centers, k);
+	else
+		Lloyd_KMeans(cluster_centers, k);
 	compute_cluster_variances();
 	auto cluster_centres =
 		std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
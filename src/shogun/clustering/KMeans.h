@@ -21,6 +21,17 @@ namespace shogun
 {
 class KMeansBase;
 
+/** algorithms to run the KMeans iterations with */
+enum EKMeansAlgorithm
+{
+	/** Lloyd's algorithm, computes all point to center distances */
+	KMA_LLOYD,
+	/** Hamerly's algorithm, keeps one upper and one lower bound per point */
+	KMA_HAMERLY,
+	/** Elkan's algorithm, keeps one upper and k lower bounds per point */
+	KMA_ELKAN
+};
+
 /** @brief KMeans clustering,  partitions the data into k (a-priori specified) clusters.
  *
  * It minimizes
@@ -35,6 +46,15 @@ class KMeansBase;
  *
  * To use mini-batch based training was see KMeansMiniBatch 
  *
+ * With a EuclideanDistance, the iterations can be accelerated with the
+ * triangle inequality bounds of Hamerly (KMA_HAMERLY) or Elkan (KMA_ELKAN),
+ * which skip most of the point to center distance computations and yield
+ * the same clustering as Lloyd's algorithm (up to ties). Hamerly's
+ * algorithm needs O(n) extra memory and suits many clusters, Elkan's needs
+ * O(nk) and prunes more for few clusters in high dimensions.
+ *
+ * cf. G. Hamerly, Making k-means even faster, SDM 2010
+ * cf. C. Elkan, Using the triangle inequality to accelerate k-means, ICML 2003
  * cf. http://en.wikipedia.org/wiki/K-means_algorithm
  * cf. http://en.wikipedia.org/wiki/Lloyd's_algorithm
  *
@@ -67,8 +87,26 @@ class KMeans : public KMeansBase
 		/** @return object name */
 		virtual const char* get_name() const { return "KMeans"; }		
 
+		/** set algorithm
+		 *
+		 * @param algorithm algorithm to run the iterations with
+		 */
+		void set_algorithm(EKMeansAlgorithm algorithm)
+		{
+			m_algorithm = algorithm;
+		}
+
+		/** @return algorithm */
+		EKMeansAlgorithm get_algorithm() const
+		{
+			return m_algorithm;
+		}
+
 	private:
 
+		/** register parameters */
+		void init();
+
 		/** train k-means
 		 *
 		 * @param data training data (parameter can be avoided if distance or
@@ -82,6 +120,14 @@ class KMeans : public KMeansBase
 		/** Lloyd's KMeans training method
 		 */
 		void Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** KMeans training method that prunes distance computations with
+		 * Hamerly's or Elkan's bounds, depending on the algorithm set
+		 */
+		void bounded_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** algorithm to run the iterations with */
+		EKMeansAlgorithm m_algorithm;
 };
 }
 #endif
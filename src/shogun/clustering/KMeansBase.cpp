@@ -16,6 +16,7 @@
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 using namespace Eigen;
@@ -158,9 +159,11 @@ void KMeansBase::initialize_training(const std::shared_ptr<Features>& data)
 	require(lhs_size>0, "Lhs features should not be empty");
 	require(dimensions>0, "Lhs features should have more than zero dimensions");
 
-	/* if kmeans++ to be used */
+	/* if kmeans++ or k-means|| to be used */
 	if (use_kmeanspp)
 		initial_centers = kmeanspp();
+	else if (use_kmeans_parallel)
+		initial_centers = kmeans_parallel();
 
 	R=SGVector<float64_t>(k);
 
@@ -292,6 +295,127 @@ SGMatrix<float64_t> KMeansBase::kmeanspp()
 	return centers;
 }
 
+SGMatrix<float64_t> KMeansBase::kmeans_parallel()
+{
+	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	int32_t lhs_size=lhs->get_num_vectors();
+	const float64_t oversampling=oversampling_factor*k;
+
+	distance->precompute_lhs();
+	distance->precompute_rhs();
+
+	/* First candidate is chosen at random */
+	std::vector<int32_t> candidates;
+	UniformIntDistribution<int32_t> uniform_int_dist(0, lhs_size-1);
+	candidates.push_back(uniform_int_dist(m_prng));
+
+	/* squared distance of each point to its closest candidate */
+	SGVector<float64_t> min_dist(lhs_size);
+	SGVector<int32_t> closest(lhs_size);
+	closest.zero();
+#pragma omp parallel for schedule(static)
+	for (int32_t i=0; i<lhs_size; i++)
+		min_dist[i]=Math::sq(distance->distance(i, candidates[0]));
+
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
+	for (int32_t round=0; round<kmeans_parallel_rounds; round++)
+	{
+		float64_t cost=linalg::sum(min_dist);
+		if (cost<=0)
+			break;
+
+		/* sample serially so that the candidates do not depend on the
+		 * number of threads, the distance updates below dominate */
+		int32_t first_new=candidates.size();
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			if (uniform_real_dist(m_prng)*cost<oversampling*min_dist[i])
+				candidates.push_back(i);
+		}
+		int32_t num_candidates=candidates.size();
+
+#pragma omp parallel for schedule(static)
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			for (int32_t c=first_new; c<num_candidates; c++)
+			{
+				float64_t dist=Math::sq(distance->distance(i, candidates[c]));
+				if (dist<min_dist[i])
+				{
+					min_dist[i]=dist;
+					closest[i]=c;
+				}
+			}
+		}
+	}
+
+	int32_t num_candidates=candidates.size();
+	SGMatrix<float64_t> centers(dimensions, k);
+	auto set_center=[&](int32_t i, int32_t point) {
+		SGVector<float64_t> vec=lhs->get_feature_vector(point);
+		for (int32_t j=0; j<dimensions; j++)
+			centers(j, i)=vec[j];
+		lhs->free_feature_vector(vec, point);
+	};
+
+	if (num_candidates<=k)
+	{
+		/* not enough distinct candidates, fill up with random points */
+		for (int32_t i=0; i<k; i++)
+			set_center(i, i<num_candidates ? candidates[i] : uniform_int_dist(m_prng));
+
+		distance->reset_precompute();
+		return centers;
+	}
+
+	/* weight candidates by the number of points closest to them */
+	SGVector<float64_t> weights(num_candidates);
+	weights.zero();
+	for (int32_t i=0; i<lhs_size; i++)
+		weights[closest[i]]+=1;
+
+	/* weighted k-means++ on the candidates */
+	auto sample=[&](const SGVector<float64_t>& mass) {
+		float64_t prob=uniform_real_dist(m_prng)*linalg::sum(mass);
+		float64_t temp_sum=0;
+		for (int32_t c=0; c<num_candidates; c++)
+		{
+			temp_sum+=mass[c];
+			if (mass[c]>0 && prob<=temp_sum)
+				return c;
+		}
+		return num_candidates-1;
+	};
+
+	SGVector<float64_t> cand_min_dist(num_candidates);
+	SGVector<float64_t> mass(num_candidates);
+	int32_t chosen=sample(weights);
+	set_center(0, candidates[chosen]);
+#pragma omp parallel for schedule(static)
+	for (int32_t c=0; c<num_candidates; c++)
+		cand_min_dist[c]=Math::sq(distance->distance(candidates[c], candidates[chosen]));
+
+	for (int32_t i=1; i<k; i++)
+	{
+		for (int32_t c=0; c<num_candidates; c++)
+			mass[c]=weights[c]*cand_min_dist[c];
+
+		chosen=sample(mass);
+		set_center(i, candidates[chosen]);
+
+#pragma omp parallel for schedule(static)
+		for (int32_t c=0; c<num_candidates; c++)
+		{
+			cand_min_dist[c]=Math::min(cand_min_dist[c],
+				Math::sq(distance->distance(candidates[c], candidates[chosen])));
+		}
+	}
+
+	distance->reset_precompute();
+
+	return centers;
+}
+
 void KMeansBase::init()
 {
 	max_iter = 300;
@@ -299,6 +423,9 @@ void KMeansBase::init()
 	dimensions = 0;
 	fixed_centers = false;
 	use_kmeanspp = false;
+	use_kmeans_parallel = false;
+	kmeans_parallel_rounds = 5;
+	oversampling_factor = 2.0;
 	initial_centers = SGMatrix<float64_t>();
 	SG_ADD(
 	    &max_iter, "max_iter", "Maximum number of iterations",
@@ -317,6 +444,18 @@ void KMeansBase::init()
 	SG_ADD(
 	    &use_kmeanspp, "kmeanspp", "Whether to use kmeans++",
 	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	    &use_kmeans_parallel, "kmeans_parallel",
+	    "Whether to use k-means|| for initialization",
+	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	    &kmeans_parallel_rounds, "kmeans_parallel_rounds",
+	    "Number of sampling rounds of k-means||",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &oversampling_factor, "oversampling_factor",
+	    "Expected number of candidates per k-means|| round relative to k",
+	    ParameterProperties::SETTING);
 	watch_method("cluster_centers", &KMeansBase::get_cluster_centers);
 	SG_ADD(
 	    &initial_centers, "initial_centers", "Initial centers",
@@ -90,6 +90,21 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 			return false;
 		}
 
+		/** set whether to initialize the centers with k-means||
+		 *
+		 * @param kmeans_parallel true to use k-means||
+		 */
+		void set_use_kmeans_parallel(bool kmeans_parallel)
+		{
+			use_kmeans_parallel = kmeans_parallel;
+		}
+
+		/** @return whether the centers are initialized with k-means|| */
+		bool get_use_kmeans_parallel() const
+		{
+			return use_kmeans_parallel;
+		}
+
 	protected:
 		/** Initialize training for KMeans algorithms */
 		void initialize_training(const std::shared_ptr<Features>& data=NULL);
@@ -100,6 +115,18 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		*/
 		SGMatrix<float64_t> kmeanspp();
 
+		/** k-means|| algorithm to initialize cluster centers. In a few
+		 * rounds, every point is sampled independently with probability
+		 * proportional to its squared distance to the candidates so far,
+		 * which parallelizes over the points. The weighted candidates are
+		 * then reduced to k centers with k-means++.
+		 *
+		 * cf. B. Bahmani et al., Scalable K-Means++, VLDB 2012
+		 *
+		 * @return initial cluster centers: matrix (k columns, dim rows)
+		 */
+		SGMatrix<float64_t> kmeans_parallel();
+
 		/**
 		 * Init the model (register params)
 		 */
@@ -135,6 +162,16 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		/** Flag to check if kmeans++ has to be used */
 		bool use_kmeanspp;
 
+		/** Flag to check if k-means|| has to be used */
+		bool use_kmeans_parallel;
+
+		/** Number of sampling rounds of k-means|| */
+		int32_t kmeans_parallel_rounds;
+
+		/** Expected number of candidates sampled per k-means|| round,
+		 * relative to k */
+		float64_t oversampling_factor;
+
 		/** Cluster centers */
 		SGMatrix<float64_t> cluster_centers;
 };
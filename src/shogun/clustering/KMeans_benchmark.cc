@@ -0,0 +1,113 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/clustering/KMeans.h"
+#include "shogun/distance/EuclideanDistance.h"
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/mathematics/NormalDistribution.h"
+#include <random>
+
+namespace shogun
+{
+
+class KMeansFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal_dist;
+
+		index_t num_clusters = st.range(0);
+		index_t num_dim = st.range(1);
+
+		/* points scattered around num_clusters random centers */
+		SGMatrix<float64_t> centers(num_dim, num_clusters);
+		for (index_t i = 0; i < num_dim * num_clusters; i++)
+			centers.matrix[i] = 10 * normal_dist(prng);
+
+		SGMatrix<float64_t> mat(num_dim, num_vecs);
+		for (index_t i = 0; i < num_vecs; i++)
+		{
+			for (index_t j = 0; j < num_dim; j++)
+				mat(j, i) = centers(j, i % num_clusters) + normal_dist(prng);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(mat);
+
+		initial_centers = SGMatrix<float64_t>(num_dim, num_clusters);
+		for (index_t i = 0; i < num_clusters; i++)
+		{
+			for (index_t j = 0; j < num_dim; j++)
+				initial_centers(j, i) = mat(j, 3 * i + 1);
+		}
+	}
+
+	void TearDown(const ::benchmark::State&) { features.reset(); }
+
+	void train(EKMeansAlgorithm algorithm, const ::benchmark::State& st)
+	{
+		auto distance =
+		    std::make_shared<EuclideanDistance>(features, features);
+		auto kmeans =
+		    std::make_shared<KMeans>(st.range(0), distance, initial_centers);
+		kmeans->set_algorithm(algorithm);
+		kmeans->train(features);
+	}
+
+	static constexpr index_t num_vecs = 20000;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	SGMatrix<float64_t> initial_centers;
+};
+
+#define ADD_KMEANS_ARGS(WHAT)                                                  \
+	WHAT->RangeMultiplier(4)                                                   \
+	    ->Ranges({{16, 1024}, {2, 128}})                                       \
+	    ->Unit(benchmark::kMillisecond);
+
+#define KMEANS_BENCHMARK(NAME, ALGORITHM)                                      \
+	BENCHMARK_DEFINE_F(KMeansFixture, NAME)(benchmark::State & st)            \
+	{                                                                          \
+		for (auto _ : st)                                                      \
+			train(ALGORITHM, st);                                              \
+	}                                                                          \
+	ADD_KMEANS_ARGS(BENCHMARK_REGISTER_F(KMeansFixture, NAME))
+
+KMEANS_BENCHMARK(KMeans_Lloyd, KMA_LLOYD)
+KMEANS_BENCHMARK(KMeans_Hamerly, KMA_HAMERLY)
+KMEANS_BENCHMARK(KMeans_Elkan, KMA_ELKAN)
+
+static void KMeans_Init(benchmark::State& st)
+{
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+	const index_t num_vecs = 100000;
+	const index_t num_dim = 16;
+
+	SGMatrix<float64_t> mat(num_dim, num_vecs);
+	for (index_t i = 0; i < num_dim * num_vecs; i++)
+		mat.matrix[i] = normal_dist(prng);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(mat);
+
+	for (auto _ : st)
+	{
+		auto distance =
+		    std::make_shared<EuclideanDistance>(features, features);
+		auto kmeans = std::make_shared<KMeans>(st.range(0), distance);
+		kmeans->set_use_kmeans_parallel(st.range(1));
+		kmeans->put("kmeanspp", !st.range(1));
+		kmeans->put("max_iter", 1);
+		kmeans->train(features);
+	}
+}
+BENCHMARK(KMeans_Init)
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({256, 0})
+    ->Args({256, 1})
+    ->Unit(benchmark::kMillisecond);
+}
@@ -80,12 +80,24 @@ std::shared_ptr<Features> HashedDocConverter::transform(std::shared_ptr<Features
 	auto s_features = std::static_pointer_cast<StringFeatures<char>>(features);
 
 	int32_t dim = Math::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	const index_t num_vectors = s_features->get_num_vectors();
+	SGSparseMatrix<float64_t> matrix(dim, num_vectors);
+
+	/* the tokenizer keeps state, so every thread hashes its documents
+	 * with a converter of its own */
+	#pragma omp parallel
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+		auto local_converter = std::make_shared<HashedDocConverter>(
+			std::shared_ptr<Tokenizer>(tokenizer->get_copy()), num_bits,
+			should_normalize, ngrams, tokens_to_skip);
+
+		#pragma omp for schedule(dynamic, 16)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			SGVector<char> doc = s_features->get_feature_vector(vec_idx);
+			matrix[vec_idx] = local_converter->apply(doc);
+			s_features->free_feature_vector(doc, vec_idx);
+		}
 	}
 
 	return std::make_shared<SparseFeatures<float64_t>>(matrix);
@@ -94,10 +106,10 @@ std::shared_ptr<Features> HashedDocConverter::transform(std::shared_ptr<Features
 SGSparseVector<float64_t> HashedDocConverter::apply(SGVector<char> document)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
 	/** the array will contain all the hashes generated from the tokens */
 	std::vector<uint32_t> hashed_indices;
-	hashed_indices.reserve(array_size);
+	hashed_indices.reserve(
+		document.size() * ((ngrams-1)*(tokens_to_skip+1) + 1));
 
 	/** this vector will maintain the current n+k active tokens
 	 * in a circular manner */
@@ -58,6 +58,7 @@ std::shared_ptr<DenseFeatures<float64_t>> Isomap::embed_distance(std::shared_ptr
 	}
 	parameters.n_neighbors = m_k;
 	parameters.target_dimension = m_target_dim;
+	parameters.randomized_eigendecomposition = m_randomized;
 	parameters.distance = distance.get();
 	return tapkee_embed(parameters);
 }
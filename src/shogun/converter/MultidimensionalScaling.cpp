@@ -23,6 +23,7 @@ MultidimensionalScaling::MultidimensionalScaling() : EmbeddingConverter()
 	m_eigenvalues = SGVector<float64_t>();
 	m_landmark_number = 3;
 	m_landmark = false;
+	m_randomized = false;
 
 	init();
 }
@@ -34,6 +35,8 @@ void MultidimensionalScaling::init()
 	    "indicates if landmark approximation should be used");
 	SG_ADD(&m_landmark_number, "landmark_number",
 	    "the number of landmarks for approximation", ParameterProperties::HYPER);
+	SG_ADD(&m_randomized, "randomized",
+	    "indicates if randomized eigendecomposition should be used");
 }
 
 MultidimensionalScaling::~MultidimensionalScaling()
@@ -68,6 +71,16 @@ bool MultidimensionalScaling::get_landmark() const
 	return m_landmark;
 }
 
+void MultidimensionalScaling::set_randomized(bool randomized)
+{
+	m_randomized = randomized;
+}
+
+bool MultidimensionalScaling::get_randomized() const
+{
+	return m_randomized;
+}
+
 const char* MultidimensionalScaling::get_name() const
 {
 	return "MultidimensionalScaling";
@@ -90,6 +103,7 @@ std::shared_ptr<DenseFeatures<float64_t>> MultidimensionalScaling::embed_distanc
 		parameters.method = SHOGUN_MULTIDIMENSIONAL_SCALING;
 	}
 	parameters.target_dimension = m_target_dim;
+	parameters.randomized_eigendecomposition = m_randomized;
 	parameters.distance = distance.get();
 	return tapkee_embed(parameters);
 }
@@ -107,6 +107,18 @@ public:
 	 */
 	bool get_landmark() const;
 
+	/** setter for randomized eigendecomposition, which approximates the
+	 * leading eigenvectors with a randomized range finder in
+	 * O(n^2 target_dim) instead of a full eigendecomposition
+	 * @param randomized true if the randomized eigensolver should be used
+	 */
+	void set_randomized(bool randomized);
+
+	/** getter for randomized eigendecomposition
+	 * @return true if the randomized eigensolver is used
+	 */
+	bool get_randomized() const;
+
 /// HELPERS
 protected:
 
@@ -122,6 +134,9 @@ protected:
 	/** use landmark approximation? */
 	bool m_landmark;
 
+	/** use randomized eigendecomposition? */
+	bool m_randomized;
+
 	/** number of landmarks */
 	int32_t m_landmark_number;
 
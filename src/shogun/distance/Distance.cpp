@@ -10,6 +10,8 @@
  */
 
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/base/progress.h>
 #include <shogun/io/File.h>
 #include <shogun/io/SGIO.h>
@@ -26,13 +28,8 @@
 #include <unistd.h>
 #endif
 
-#ifdef HAVE_OPENMP
-#include <omp.h>
-
 #include <utility>
 
-#endif
-
 using namespace shogun;
 
 Distance::Distance() : SGObject()
@@ -276,7 +273,6 @@ SGMatrix<T> Distance::get_distance_matrix()
 	int32_t n=get_num_vec_rhs();
 
 	int64_t total_num = int64_t(m)*n;
-	int64_t total=0;
 
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
 	bool symmetric= (lhs && lhs==rhs && m==n);
@@ -285,61 +281,26 @@ SGMatrix<T> Distance::get_distance_matrix()
 
 	result=SG_MALLOC(T, total_num);
 
-	PRange<int64_t> pb = PRange<int64_t>(
-	    range(total_num), "PROGRESS: ", UTF8, []() { return true; });
-	int32_t num_threads;
-	int64_t step;
-	#pragma omp parallel shared(num_threads, step)
+	auto pb = SG_PROGRESS(range(m));
+	// rows of a symmetric matrix get shorter, idle threads steal the
+	// remaining rows
+	env()->scheduler()->parallel_for(0, m, [&](index_t i)
 	{
-#ifdef HAVE_OPENMP
-		#pragma omp single
-		{
-			num_threads=omp_get_num_threads();
-			step=total_num/num_threads;
-			num_threads--;
-		}
-		int32_t thread_num=omp_get_thread_num();
-#else
-		num_threads=0;
-		step=total_num;
-		int32_t thread_num=0;
-#endif
-		bool verbose=(thread_num == 0);
+		int32_t j_start=0;
 
-		int32_t start=compute_row_start(thread_num*step, n, symmetric);
-		int32_t end=(thread_num==num_threads) ? m : compute_row_start((thread_num+1)*step, n, symmetric);
+		if (symmetric)
+			j_start=i;
 
-		for (int32_t i=start; i<end; i++)
+		for (int32_t j=j_start; j<n; j++)
 		{
-			int32_t j_start=0;
-
-			if (symmetric)
-				j_start=i;
+			float64_t v=this->distance(i,j);
+			result[i+j*m]=v;
 
-			for (int32_t j=j_start; j<n; j++)
-			{
-				float64_t v=this->distance(i,j);
-				result[i+j*m]=v;
-
-				if (symmetric && i!=j)
-					result[j+i*m]=v;
-
-				if (verbose)
-				{
-					total++;
-
-					if (symmetric && i!=j)
-						total++;
-
-					pb.print_progress();
-
-					// TODO: replace with new signal
-					// if (Signal::cancel_computations())
-					//	break;
-				}
-			}
+			if (symmetric && i!=j)
+				result[j+i*m]=v;
 		}
-	}
+		pb.print_progress();
+	});
 	pb.complete();
 
 	return SGMatrix<T>(result,m,n,true);
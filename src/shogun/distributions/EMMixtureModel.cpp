@@ -31,6 +31,7 @@
 #include <shogun/distributions/EMMixtureModel.h>
 #include <shogun/distributions/Distribution.h>
 #include <shogun/mathematics/Math.h>
+#include <vector>
 
 using namespace shogun;
 
@@ -43,26 +44,34 @@ EMMixtureModel::~EMMixtureModel()
 
 float64_t EMMixtureModel::expectation_step()
 {
+	int32_t num_vectors=data.alpha.num_rows;
+	int32_t num_components=data.alpha.num_cols;
+
+	// log likelihoods of all data points, one component at a time
+	std::vector<SGVector<float64_t>> log_likelihoods(num_components);
+	for (int32_t j=0;j<num_components;j++)
+		log_likelihoods[j]=data.components[j]->get_log_likelihood();
+
 	float64_t log_likelihood=0;
-	// for each data point
-	for (int32_t i=0;i<data.alpha.num_rows;i++)
+	#pragma omp parallel reduction(+:log_likelihood)
 	{
-		SGVector<float64_t> alpha_ij(data.alpha.num_cols);
-		// for each component
-		for (int32_t j=0;j<data.alpha.num_cols;j++)
-		{
-			auto jth_component=data.components[j];
-			alpha_ij[j] = std::log(data.weights[j]) +
-			              jth_component->get_log_likelihood_example(i);
+		SGVector<float64_t> alpha_ij(num_components);
 
-		};
+		// for each data point
+		#pragma omp for schedule(static)
+		for (int32_t i=0;i<num_vectors;i++)
+		{
+			// for each component
+			for (int32_t j=0;j<num_components;j++)
+				alpha_ij[j]=std::log(data.weights[j])+log_likelihoods[j][i];
 
-		float64_t normalize=Math::log_sum_exp(alpha_ij);
-		log_likelihood+=normalize;
+			float64_t normalize=Math::log_sum_exp(alpha_ij);
+			log_likelihood+=normalize;
 
-		// fill row of alpha
-		for (int32_t j=0;j<data.alpha.num_cols;j++)
-			data.alpha(i, j) = std::exp(alpha_ij[j] - normalize);
+			// fill row of alpha
+			for (int32_t j=0;j<num_components;j++)
+				data.alpha(i, j) = std::exp(alpha_ij[j] - normalize);
+		}
 	}
 
 	return log_likelihood;
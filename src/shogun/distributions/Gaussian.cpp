@@ -7,6 +7,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/distributions/Gaussian.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -14,6 +15,8 @@
 #include <shogun/mathematics/lapack.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+
 using namespace shogun;
 using namespace linalg;
 
@@ -248,7 +251,7 @@ float64_t Gaussian::compute_log_PDF(SGVector<float64_t> point)
 		    CblasRowMajor, CblasNoTrans, m_d.vlen, m_d.vlen, 1, m_u.matrix,
 		    m_d.vlen, difference, 1, 0, temp_holder, 1);
 #else
-		linalg::dgemv<float64_t>(1, m_u, false, difference, 0, temp_holder);
+		linalg::dgemv<float64_t>(1, m_u, true, difference, 0, temp_holder);
 #endif
 
 		for (int32_t i=0; i<m_d.vlen; i++)
@@ -268,6 +271,71 @@ float64_t Gaussian::compute_log_PDF(SGVector<float64_t> point)
 	return -0.5 * answer;
 }
 
+SGVector<float64_t> Gaussian::compute_log_PDF(SGMatrix<float64_t> points)
+{
+	ASSERT(m_mean.vector && m_d.vector)
+	require(points.num_rows == m_mean.vlen,
+		"Dimension of points ({}) must match the dimension of the mean ({})",
+		points.num_rows, m_mean.vlen);
+
+	const index_t dim = m_mean.vlen;
+	const index_t num_points = points.num_cols;
+	const index_t block_size = 1024;
+	SGVector<float64_t> result(num_points);
+
+	typename SGVector<float64_t>::EigenVectorXtMap mean = m_mean;
+	typename SGVector<float64_t>::EigenVectorXtMap d = m_d;
+
+	// (x-mean)^T cov^-1 (x-mean) = ||W (x-mean)||^2 with the whitening
+	// matrix W = diag(d)^-1/2 U^T, or the scaling s = d^-1/2 if cov is
+	// diagonal
+	Eigen::MatrixXd whitening;
+	Eigen::VectorXd white_mean;
+	Eigen::VectorXd scaling;
+	if (m_cov_type == FULL)
+	{
+		typename SGMatrix<float64_t>::EigenMatrixXtMap u = m_u;
+		whitening = d.cwiseSqrt().cwiseInverse().asDiagonal() * u.transpose();
+		white_mean = whitening * mean;
+	}
+	else if (m_cov_type == DIAG)
+		scaling = d.cwiseSqrt().cwiseInverse();
+	else
+		scaling = Eigen::VectorXd::Constant(dim, 1.0 / std::sqrt(m_d[0]));
+
+	#pragma omp parallel for schedule(static)
+	for (index_t start = 0; start < num_points; start += block_size)
+	{
+		index_t len = std::min(block_size, num_points - start);
+		Eigen::Map<const Eigen::MatrixXd> block(
+			points.matrix + start * dim, dim, len);
+
+		Eigen::MatrixXd white;
+		if (m_cov_type == FULL)
+			white = (whitening * block).colwise() - white_mean;
+		else
+			white = (block.colwise() - mean).array().colwise() * scaling.array();
+
+		for (index_t i = 0; i < len; ++i)
+			result[start + i] = -0.5 * (m_constant + white.col(i).squaredNorm());
+	}
+
+	return result;
+}
+
+SGVector<float64_t> Gaussian::get_log_likelihood()
+{
+	ASSERT(features)
+	if (features->get_feature_class() == C_DENSE &&
+		features->get_feature_type() == F_DREAL)
+	{
+		return compute_log_PDF(
+			features->as<DenseFeatures<float64_t>>()->get_feature_matrix());
+	}
+
+	return Distribution::get_log_likelihood();
+}
+
 SGVector<float64_t> Gaussian::get_mean()
 {
 	return m_mean;
@@ -360,13 +428,8 @@ void Gaussian::decompose_cov(SGMatrix<float64_t> cov)
 		m_d.vector = SGMatrix<float64_t>::compute_eigenvectors(
 		    m_u.matrix, cov.num_rows, cov.num_rows);
 #else
-		// FIXME use eigenvectors computeation warpper by micmn
-		typename SGMatrix<float64_t>::EigenMatrixXtMap eig = m_u;
-		typename SGVector<float64_t>::EigenVectorXtMap eigenvalues_eig = m_d;
-
-		Eigen::EigenSolver<typename SGMatrix<float64_t>::EigenMatrixXt> solver(
-		    eig);
-		eigenvalues_eig = solver.eigenvalues().real();
+		// m_u holds the eigenvectors in its columns, as in the LAPACK case
+		linalg::eigen_solver_symmetric(cov, m_d, m_u);
 #endif
 		break;
 	}
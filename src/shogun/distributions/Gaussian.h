@@ -122,6 +122,22 @@ class Gaussian : public RandomMixin<Distribution>
 		 */
 		virtual float64_t compute_log_PDF(SGVector<float64_t> point);
 
+		/** compute log PDF of a block of points at once. The points are
+		 * whitened with a single matrix product per block of columns and
+		 * the blocks are processed in parallel.
+		 *
+		 * @param points matrix with one point per column
+		 * @return computed log PDF of each point
+		 */
+		SGVector<float64_t> compute_log_PDF(SGMatrix<float64_t> points);
+
+		/** compute log likelihood for each example, using the blocked
+		 * compute_log_PDF for dense features
+		 *
+		 * @return log likelihood vector
+		 */
+		virtual SGVector<float64_t> get_log_likelihood();
+
 		/** get mean
 		 *
 		 * @return mean
@@ -6,6 +6,8 @@
  *          Leon Kuchenbecker
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/base/progress.h>
 #include <shogun/evaluation/CrossValidation.h>
 #include <shogun/evaluation/CrossValidationStorage.h>
@@ -95,8 +97,9 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 
 	SGVector<float64_t> results(num_subsets);
 
-	#pragma omp parallel for shared(results)
-	for (auto i = 0; i<num_subsets; ++i)
+	// folds may train machines that are parallel themselves, the
+	// scheduler runs both on the same threads
+	env()->scheduler()->parallel_for(0, num_subsets, [&](index_t i)
 	{
 		// only need to clone hyperparameters and settings of machine
 		// model parameters are inferred/learned during training
@@ -123,7 +126,7 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 
 		results[i] = evaluation_criterion->evaluate(result_labels, labels_test);
 		io::info("Result of cross-validation fold {}/{} is {}", i+1, num_subsets, results[i]);
-	}
+	}, 1);
 
 	/* build arithmetic mean of results */
 	float64_t mean = Statistics::mean(results);
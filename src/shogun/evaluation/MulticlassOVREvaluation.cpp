@@ -7,6 +7,7 @@
 #include <shogun/evaluation/MulticlassOVREvaluation.h>
 #include <shogun/evaluation/ROCEvaluation.h>
 #include <shogun/evaluation/PRCEvaluation.h>
+#include <shogun/evaluation/StreamingROCEvaluation.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Statistics.h>
 
@@ -53,7 +54,8 @@ float64_t MulticlassOVREvaluation::evaluate(std::shared_ptr<Labels> predicted, s
 			all(i,j) = confs[j];
 		}
 	}
-	if (std::dynamic_pointer_cast<ROCEvaluation>(m_binary_evaluation) || std::dynamic_pointer_cast<PRCEvaluation>(m_binary_evaluation))
+	if (std::dynamic_pointer_cast<ROCEvaluation>(m_binary_evaluation) || std::dynamic_pointer_cast<PRCEvaluation>(m_binary_evaluation) ||
+		std::dynamic_pointer_cast<StreamingROCEvaluation>(m_binary_evaluation))
 	{
 		for (int32_t i=0; i<m_num_graph_results; i++)
 			m_graph_results[i].~SGMatrix<float64_t>();
@@ -85,6 +87,11 @@ float64_t MulticlassOVREvaluation::evaluate(std::shared_ptr<Labels> predicted, s
 			new (&m_graph_results[c]) SGMatrix<float64_t>();
 			m_graph_results[c] = (std::static_pointer_cast<PRCEvaluation>(m_binary_evaluation))->get_PRC();
 		}
+		if (std::dynamic_pointer_cast<StreamingROCEvaluation>(m_binary_evaluation))
+		{
+			new (&m_graph_results[c]) SGMatrix<float64_t>();
+			m_graph_results[c] = (std::static_pointer_cast<StreamingROCEvaluation>(m_binary_evaluation))->get_ROC();
+		}
 	}
 	return Statistics::mean(m_last_results);
 }
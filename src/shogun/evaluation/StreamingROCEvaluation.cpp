@@ -0,0 +1,358 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/StreamingROCEvaluation.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace shogun;
+
+namespace
+{
+
+/** examples of the same score (exact mode) or bin (approximate mode) */
+struct ScoreGroup
+{
+	/** smallest score of the group */
+	float64_t threshold;
+	/** number of positive examples */
+	int64_t num_positive;
+	/** number of negative examples */
+	int64_t num_negative;
+};
+
+/** sorts chunks in parallel and merges them pairwise, also in parallel */
+template <class T, class Compare>
+void parallel_sort(std::vector<T>& v, Compare comp)
+{
+	const int64_t length=v.size();
+	const int64_t num_chunks=Math::max(
+		Math::min(int64_t(env()->get_num_threads()), length/(int64_t(1)<<16)),
+		int64_t(1));
+	auto chunk_begin=[&](int64_t c) {
+		return v.begin()+length*Math::min(c, num_chunks)/num_chunks;
+	};
+
+	#pragma omp parallel for schedule(static, 1)
+	for (int64_t c=0; c<num_chunks; c++)
+		std::sort(chunk_begin(c), chunk_begin(c+1), comp);
+
+	for (int64_t width=1; width<num_chunks; width*=2)
+	{
+		#pragma omp parallel for schedule(static, 1)
+		for (int64_t c=0; c<num_chunks; c+=2*width)
+		{
+			if (c+width<num_chunks)
+			{
+				std::inplace_merge(chunk_begin(c), chunk_begin(c+width),
+					chunk_begin(c+2*width), comp);
+			}
+		}
+	}
+}
+
+}
+
+StreamingROCEvaluation::StreamingROCEvaluation() : BinaryClassEvaluation()
+{
+	init();
+}
+
+StreamingROCEvaluation::StreamingROCEvaluation(bool approximate, int32_t num_bin_bits)
+	: BinaryClassEvaluation()
+{
+	init();
+	require(num_bin_bits >= 0 && num_bin_bits <= 52,
+		"Number of bin bits ({}) must be in [0, 52].", num_bin_bits);
+	m_approximate = approximate;
+	m_num_bin_bits = num_bin_bits;
+}
+
+StreamingROCEvaluation::~StreamingROCEvaluation()
+{
+}
+
+void StreamingROCEvaluation::init()
+{
+	m_approximate = false;
+	m_num_bin_bits = 12;
+	m_num_positive = 0;
+	m_num_negative = 0;
+	m_computed = false;
+	m_auROC = 0.0;
+	m_auROC_error = 0.0;
+	m_auPRC = 0.0;
+
+	SG_ADD(&m_approximate, "approximate",
+		"Whether to keep score histograms only", ParameterProperties::SETTING);
+	SG_ADD(&m_num_bin_bits, "num_bin_bits",
+		"Number of mantissa bits of the score bins", ParameterProperties::SETTING);
+	watch_method("auROC", &StreamingROCEvaluation::get_auROC);
+	watch_method("auROC_error_bound", &StreamingROCEvaluation::get_auROC_error_bound);
+	watch_method("ROC", &StreamingROCEvaluation::get_ROC);
+	watch_method("auPRC", &StreamingROCEvaluation::get_auPRC);
+	watch_method("PRC", &StreamingROCEvaluation::get_PRC);
+	watch_method("thresholds", &StreamingROCEvaluation::get_thresholds);
+}
+
+float64_t StreamingROCEvaluation::evaluate(std::shared_ptr<Labels> predicted, std::shared_ptr<Labels> ground_truth)
+{
+	reset();
+	add(std::move(predicted), std::move(ground_truth));
+	return get_auROC();
+}
+
+void StreamingROCEvaluation::add(std::shared_ptr<Labels> predicted, std::shared_ptr<Labels> ground_truth)
+{
+	require(predicted, "No predicted labels provided.");
+	require(ground_truth, "No ground truth labels provided.");
+	require(
+	    predicted->get_label_type() == LT_BINARY,
+	    "Given predicted labels ({}) must be binary ({}).",
+	    predicted->get_label_type(), LT_BINARY);
+	require(
+	    ground_truth->get_label_type() == LT_BINARY,
+	    "Given ground truth labels ({}) must be binary ({}).",
+	    ground_truth->get_label_type(), LT_BINARY);
+	ground_truth->ensure_valid();
+
+	add(binary_labels(predicted)->get_values(),
+		binary_labels(ground_truth)->get_labels());
+}
+
+void StreamingROCEvaluation::add(SGVector<float64_t> scores, SGVector<float64_t> labels)
+{
+	require(scores.vlen == labels.vlen,
+		"Number of scores ({}) and labels ({}) must match.",
+		scores.vlen, labels.vlen);
+
+	m_computed = false;
+	for (index_t i = 0; i < labels.vlen; i++)
+	{
+		if (labels[i] > 0)
+			m_num_positive++;
+		else
+			m_num_negative++;
+	}
+
+	if (!m_approximate)
+	{
+		m_scores.reserve(m_scores.size() + scores.vlen);
+		for (index_t i = 0; i < scores.vlen; i++)
+			m_scores.emplace_back(scores[i], labels[i] > 0);
+		return;
+	}
+
+	// histogram chunks of the batch in parallel, the number of bins is
+	// small compared to the batch so merging them is cheap
+	const int32_t num_chunks = Math::max(
+		Math::min(env()->get_num_threads(), scores.vlen / 4096), 1);
+	std::vector<std::unordered_map<uint64_t, std::pair<int64_t, int64_t>>>
+		chunk_bins(num_chunks);
+
+	#pragma omp parallel for schedule(static, 1)
+	for (int32_t c = 0; c < num_chunks; c++)
+	{
+		auto& bins = chunk_bins[c];
+		const index_t begin = int64_t(scores.vlen) * c / num_chunks;
+		const index_t end = int64_t(scores.vlen) * (c + 1) / num_chunks;
+		for (index_t i = begin; i < end; i++)
+		{
+			auto& counts = bins[bin_of(scores[i])];
+			if (labels[i] > 0)
+				counts.first++;
+			else
+				counts.second++;
+		}
+	}
+
+	for (const auto& bins : chunk_bins)
+	{
+		for (const auto& bin : bins)
+		{
+			auto& counts = m_bins[bin.first];
+			counts.first += bin.second.first;
+			counts.second += bin.second.second;
+		}
+	}
+}
+
+void StreamingROCEvaluation::merge(const std::shared_ptr<StreamingROCEvaluation>& other)
+{
+	require(other, "No evaluation to merge provided.");
+	require(
+	    other->m_approximate == m_approximate &&
+	        other->m_num_bin_bits == m_num_bin_bits,
+	    "Evaluations to merge must use the same mode and bins.");
+
+	m_computed = false;
+	m_num_positive += other->m_num_positive;
+	m_num_negative += other->m_num_negative;
+	m_scores.insert(m_scores.end(), other->m_scores.begin(), other->m_scores.end());
+	for (const auto& bin : other->m_bins)
+	{
+		auto& counts = m_bins[bin.first];
+		counts.first += bin.second.first;
+		counts.second += bin.second.second;
+	}
+}
+
+void StreamingROCEvaluation::reset()
+{
+	m_computed = false;
+	m_num_positive = 0;
+	m_num_negative = 0;
+	m_scores.clear();
+	m_bins.clear();
+}
+
+uint64_t StreamingROCEvaluation::bin_of(float64_t score) const
+{
+	// map the bits of the score to an unsigned integer of the same order
+	uint64_t bits;
+	std::memcpy(&bits, &score, sizeof(bits));
+	const uint64_t sign = uint64_t(1) << 63;
+	const uint64_t key = (bits & sign) ? ~bits : (bits | sign);
+	return key >> (52 - m_num_bin_bits);
+}
+
+float64_t StreamingROCEvaluation::bin_threshold(uint64_t bin) const
+{
+	const uint64_t sign = uint64_t(1) << 63;
+	const uint64_t key = bin << (52 - m_num_bin_bits);
+	const uint64_t bits = (key & sign) ? (key & ~sign) : ~key;
+	float64_t score;
+	std::memcpy(&score, &bits, sizeof(score));
+	return score;
+}
+
+void StreamingROCEvaluation::compute() const
+{
+	if (m_computed)
+		return;
+
+	// assure both number of positive and negative examples is >0
+	require(
+	    m_num_positive > 0,
+	    "{}: Number of positive labels is zero, ROC fails!", get_name());
+	require(
+	    m_num_negative > 0,
+	    "{}: Number of negative labels is zero, ROC fails!", get_name());
+
+	// group examples by score descending
+	std::vector<ScoreGroup> groups;
+	if (!m_approximate)
+	{
+		parallel_sort(m_scores, [](const std::pair<float64_t, bool>& a,
+		                         const std::pair<float64_t, bool>& b) {
+			return a.first > b.first;
+		});
+
+		for (const auto& score : m_scores)
+		{
+			if (groups.empty() || groups.back().threshold != score.first)
+				groups.push_back({score.first, 0, 0});
+
+			if (score.second)
+				groups.back().num_positive++;
+			else
+				groups.back().num_negative++;
+		}
+	}
+	else
+	{
+		std::vector<std::pair<uint64_t, std::pair<int64_t, int64_t>>> bins(
+			m_bins.begin(), m_bins.end());
+		std::sort(bins.begin(), bins.end(), [](const auto& a, const auto& b) {
+			return a.first > b.first;
+		});
+
+		groups.reserve(bins.size());
+		for (const auto& bin : bins)
+		{
+			groups.push_back(
+				{bin_threshold(bin.first), bin.second.first, bin.second.second});
+		}
+	}
+
+	const int32_t num_groups = groups.size();
+	const float64_t pos_count = m_num_positive;
+	const float64_t neg_count = m_num_negative;
+
+	m_ROC_graph = SGMatrix<float64_t>(2, num_groups + 1);
+	m_PRC_graph = SGMatrix<float64_t>(2, num_groups);
+	m_thresholds = SGVector<float64_t>(num_groups);
+	m_auROC_error = 0.0;
+
+	float64_t tp = 0.0;
+	float64_t fp = 0.0;
+	for (int32_t j = 0; j < num_groups; j++)
+	{
+		// ROC point before the threshold is passed
+		m_ROC_graph(0, j) = fp / neg_count;
+		m_ROC_graph(1, j) = tp / pos_count;
+
+		tp += groups[j].num_positive;
+		fp += groups[j].num_negative;
+
+		// precision (x) and recall (y) once it is passed
+		m_PRC_graph(0, j) = tp / (tp + fp);
+		m_PRC_graph(1, j) = tp / pos_count;
+		m_thresholds[j] = groups[j].threshold;
+
+		if (m_approximate)
+		{
+			m_auROC_error += 0.5 * float64_t(groups[j].num_positive) *
+			                 groups[j].num_negative / (pos_count * neg_count);
+		}
+	}
+
+	// add (1,1) to ROC curve
+	m_ROC_graph(0, num_groups) = 1.0;
+	m_ROC_graph(1, num_groups) = 1.0;
+
+	m_auROC = Math::area_under_curve(m_ROC_graph.matrix, num_groups + 1, false);
+	m_auPRC = Math::area_under_curve(m_PRC_graph.matrix, num_groups, true);
+
+	m_computed = true;
+}
+
+float64_t StreamingROCEvaluation::get_auROC() const
+{
+	compute();
+	return m_auROC;
+}
+
+float64_t StreamingROCEvaluation::get_auROC_error_bound() const
+{
+	compute();
+	return m_auROC_error;
+}
+
+SGMatrix<float64_t> StreamingROCEvaluation::get_ROC() const
+{
+	compute();
+	return m_ROC_graph;
+}
+
+float64_t StreamingROCEvaluation::get_auPRC() const
+{
+	compute();
+	return m_auPRC;
+}
+
+SGMatrix<float64_t> StreamingROCEvaluation::get_PRC() const
+{
+	compute();
+	return m_PRC_graph;
+}
+
+SGVector<float64_t> StreamingROCEvaluation::get_thresholds() const
+{
+	compute();
+	return m_thresholds;
+}
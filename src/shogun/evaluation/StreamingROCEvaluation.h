@@ -0,0 +1,193 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef STREAMINGROCEVALUATION_H_
+#define STREAMINGROCEVALUATION_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/evaluation/BinaryClassEvaluation.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace shogun
+{
+
+class Labels;
+
+/** @brief Class StreamingROCEvaluation accumulates (score, label) pairs
+ * batch by batch and evaluates ROC, PRC and the areas under them
+ * (auROC, auPRC) over everything added so far.
+ *
+ * In exact mode, all pairs are kept and sorted in parallel once the curves
+ * are requested, ties of scores are treated as in ROCEvaluation.
+ *
+ * In approximate mode, only positive and negative counts per score bin are
+ * kept. Bins have a constant relative width of 2^-num_bin_bits (they
+ * keep the sign, exponent and num_bin_bits leading mantissa bits of a
+ * score), so memory is bounded by the dynamic range of the scores rather
+ * than their number and no score range has to be known in advance. Pairs
+ * of a positive and a negative example that share a bin are counted as
+ * ties, so the auROC differs from the exact one by at most
+ * get_auROC_error_bound().
+ *
+ * Accumulators can be merged, e.g. to combine the evaluations of
+ * several workers.
+ *
+ * Only the mode and the number of bin bits are registered parameters. The
+ * accumulated scores, bins and counts are not, so serialization, clone()
+ * and equals() ignore them and a deserialized or cloned evaluation starts
+ * empty. Use merge() to copy an accumulator.
+ */
+class StreamingROCEvaluation: public BinaryClassEvaluation
+{
+public:
+	/** constructor */
+	StreamingROCEvaluation();
+
+	/** constructor
+	 * @param approximate whether to keep score histograms only
+	 * @param num_bin_bits number of mantissa bits of the bins
+	 */
+	StreamingROCEvaluation(bool approximate, int32_t num_bin_bits=12);
+
+	/** destructor */
+	virtual ~StreamingROCEvaluation();
+
+	/** get name */
+	virtual const char* get_name() const { return "StreamingROCEvaluation"; };
+
+	/** reset, add a single batch and evaluate auROC
+	 * @param predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 * @return auROC
+	 */
+	virtual float64_t evaluate(std::shared_ptr<Labels> predicted, std::shared_ptr<Labels> ground_truth);
+
+	virtual EEvaluationDirection get_evaluation_direction() const
+	{
+		return ED_MAXIMIZE;
+	}
+
+	/** add a batch of predictions
+	 * @param predicted binary labels with values
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add(std::shared_ptr<Labels> predicted, std::shared_ptr<Labels> ground_truth);
+
+	/** add a batch of scores
+	 * @param scores predicted scores
+	 * @param labels ground truth, positive if > 0
+	 */
+	void add(SGVector<float64_t> scores, SGVector<float64_t> labels);
+
+	/** add everything accumulated by another evaluation
+	 * @param other evaluation with the same mode and bins
+	 */
+	void merge(const std::shared_ptr<StreamingROCEvaluation>& other);
+
+	/** remove everything added so far */
+	void reset();
+
+	/** @return number of examples added so far */
+	int64_t get_num_examples() const
+	{
+		return m_num_positive + m_num_negative;
+	}
+
+	/** get auROC
+	 * @return area under ROC (auROC)
+	 */
+	float64_t get_auROC() const;
+
+	/** get bound of the difference of auROC and the exact auROC, which
+	 * is zero in exact mode
+	 * @return auROC error bound
+	 */
+	float64_t get_auROC_error_bound() const;
+
+	/** get ROC
+	 * @return ROC graph matrix
+	 */
+	SGMatrix<float64_t> get_ROC() const;
+
+	/** get auPRC
+	 * @return area under PRC (auPRC)
+	 */
+	float64_t get_auPRC() const;
+
+	/** get PRC
+	 * precision is dim0 (x)
+	 * recall is dim1 (y)
+	 * @return PRC graph matrix
+	 */
+	SGMatrix<float64_t> get_PRC() const;
+
+	/** get thresholds corresponding to the distinct scores (exact mode)
+	 * or bins (approximate mode), descending
+	 * @return thresholds
+	 */
+	SGVector<float64_t> get_thresholds() const;
+
+private:
+	/** init */
+	void init();
+
+	/** computes the curves from the accumulated data if necessary */
+	void compute() const;
+
+	/** @return bin of score */
+	uint64_t bin_of(float64_t score) const;
+
+	/** @return smallest score of bin */
+	float64_t bin_threshold(uint64_t bin) const;
+
+private:
+	/** whether to keep score histograms only */
+	bool m_approximate;
+
+	/** number of mantissa bits of the bins */
+	int32_t m_num_bin_bits;
+
+	/** scores and labels added in exact mode, sorted lazily, not
+	 * registered */
+	mutable std::vector<std::pair<float64_t, bool>> m_scores;
+
+	/** positive and negative counts per bin in approximate mode, not
+	 * registered */
+	std::unordered_map<uint64_t, std::pair<int64_t, int64_t>> m_bins;
+
+	/** number of positive examples */
+	int64_t m_num_positive;
+
+	/** number of negative examples */
+	int64_t m_num_negative;
+
+	/** indicator of the curves being up to date */
+	mutable bool m_computed;
+
+	/** 2-d array used to store ROC graph */
+	mutable SGMatrix<float64_t> m_ROC_graph;
+
+	/** 2-d array used to store PRC graph */
+	mutable SGMatrix<float64_t> m_PRC_graph;
+
+	/** thresholds of the points on the graphs */
+	mutable SGVector<float64_t> m_thresholds;
+
+	/** area under ROC graph */
+	mutable float64_t m_auROC;
+
+	/** auROC error bound */
+	mutable float64_t m_auROC_error;
+
+	/** area under PRC graph */
+	mutable float64_t m_auPRC;
+};
+
+}
+
+#endif /* STREAMINGROCEVALUATION_H_ */
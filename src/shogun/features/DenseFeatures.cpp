@@ -10,12 +10,14 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <algorithm>
 #include <string.h>
+#include <type_traits>
 
 #define ASSERT_FLOATING_POINT                                                  \
 	switch (get_feature_type())                                                \
@@ -277,6 +279,19 @@ SGMatrix<ST> DenseFeatures<ST>::get_feature_matrix() const
 	return target;
 }
 
+template <class ST>
+SGMatrixView<ST> DenseFeatures<ST>::get_feature_matrix_view() const
+{
+	if (!feature_matrix.matrix)
+		return SGMatrixView<ST>(get_feature_matrix());
+
+	if (!m_subset_stack->has_subsets())
+		return SGMatrixView<ST>(feature_matrix);
+
+	return SGMatrixView<ST>(
+		feature_matrix, m_subset_stack->get_last_subset()->get_subset_idx());
+}
+
 template <class ST>
 void DenseFeatures<ST>::copy_feature_matrix(SGMatrix<ST>& target, index_t column_offset) const
 {
@@ -632,6 +647,83 @@ DenseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 	return result;
 }
 
+template <class ST>
+void DenseFeatures<ST>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if constexpr (!std::is_same<ST, float64_t>::value)
+	{
+		DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+	else
+	{
+		if (!feature_matrix.matrix)
+		{
+			DotFeatures::dense_dot_range(
+			    output, start, stop, alphas, vec, dim, b);
+			return;
+		}
+
+		ASSERT(output)
+		ASSERT(start >= 0)
+		ASSERT(start < stop)
+		ASSERT(stop <= get_num_vectors())
+		require(
+		    dim >= num_features,
+		    "Dense vector dimension ({}) must be at least the number of "
+		    "features ({}).",
+		    dim, num_features);
+
+		const int32_t num_vectors_range = stop - start;
+		const int32_t num_threads = env()->get_num_threads();
+		const int32_t block_size =
+		    (num_vectors_range + num_threads - 1) / num_threads;
+
+		Eigen::Map<const Eigen::VectorXd> w(vec, num_features);
+		// vectors of a subset are read in place through the view
+		auto features_view = get_feature_matrix_view();
+
+		#pragma omp parallel for schedule(static) num_threads(num_threads)
+		for (int32_t t = 0; t < num_threads; t++)
+		{
+			const int32_t block_start = t * block_size;
+			const int32_t block_stop =
+			    Math::min(block_start + block_size, num_vectors_range);
+			if (block_start >= block_stop)
+				continue;
+
+			Eigen::Map<Eigen::VectorXd> out(
+			    output + block_start, block_stop - block_start);
+
+			if (features_view.is_contiguous())
+			{
+				Eigen::Map<const Eigen::MatrixXd> X(
+				    feature_matrix.matrix +
+				        int64_t(start + block_start) * num_features,
+				    num_features, block_stop - block_start);
+				out.noalias() = X.transpose() * w;
+			}
+			else
+			{
+				for (int32_t i = block_start; i < block_stop; i++)
+				{
+					out[i - block_start] =
+					    Eigen::Map<const Eigen::VectorXd>(
+					        features_view.get_column_vector(start + i),
+					        num_features)
+					        .dot(w);
+				}
+			}
+			if (alphas)
+				out.array() *= Eigen::Map<const Eigen::ArrayXd>(
+				    alphas + block_start, block_stop - block_start);
+			out.array() += b;
+		}
+	}
+}
+
 template<class ST> bool DenseFeatures<ST>::is_equal(std::shared_ptr<DenseFeatures> rhs)
 {
 	if ( num_features != rhs->num_features || num_vectors != rhs->num_vectors )
@@ -735,8 +827,19 @@ template< class ST > std::shared_ptr<DenseFeatures< ST >> DenseFeatures< ST >::o
 template <typename ST>
 SGVector<ST> DenseFeatures<ST>::sum() const
 {
-	// TODO optimize non batch mode, but get_feature_vector is non const :(
-	SGVector<ST> result = linalg::rowwise_sum(get_feature_matrix());
+	auto features_view = get_feature_matrix_view();
+	if (features_view.is_contiguous())
+		return linalg::rowwise_sum(features_view.get_matrix());
+
+	// vectors of a subset are summed in place
+	SGVector<ST> result(num_features);
+	result.zero();
+	for (index_t i = 0; i < features_view.num_cols; i++)
+	{
+		const ST* vec = features_view.get_column_vector(i);
+		for (index_t j = 0; j < num_features; j++)
+			result[j] += vec[j];
+	}
 	return result;
 }
 
@@ -784,8 +887,20 @@ SGVector<ST> DenseFeatures<ST>::dot(const SGVector<ST>& other) const
 		                                   "must match provided vector's size "
 		                                   "({}).",
 		get_num_features(), other.size());
-	// TODO optimize non batch mode, but get_feature_vector is non const :(
-	return linalg::matrix_prod(get_feature_matrix(), other, false);
+	auto features_view = get_feature_matrix_view();
+	if (features_view.is_contiguous())
+		return linalg::matrix_prod(features_view.get_matrix(), other, false);
+
+	// vectors of a subset are accumulated in place
+	SGVector<ST> result(num_features);
+	result.zero();
+	for (index_t i = 0; i < features_view.num_cols; i++)
+	{
+		const ST* vec = features_view.get_column_vector(i);
+		for (index_t j = 0; j < num_features; j++)
+			result[j] += vec[j] * other[i];
+	}
+	return result;
 }
 
 template class DenseFeatures<bool>;
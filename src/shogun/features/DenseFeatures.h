@@ -17,6 +17,7 @@
 #include <shogun/lib/Cache.h>
 #include <shogun/lib/DataType.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGMatrixView.h>
 #include <shogun/lib/common.h>
 #include <shogun/util/container_iterators.h>
 
@@ -193,6 +194,16 @@ public:
 	 */
 	SGMatrix<ST> get_feature_matrix() const;
 
+	/** Getter for a view on the feature matrix
+	 *
+	 * never copies for a feature matrix in memory, the subset is applied
+	 * by the view
+	 * a copy if vectors are computed on the fly
+	 *
+	 * @return view on the feature vectors
+	 */
+	SGMatrixView<ST> get_feature_matrix_view() const;
+
 	/** get the pointer to the feature matrix
 	 * num_feat,num_vectors are returned by reference
 	 *
@@ -347,6 +358,25 @@ public:
 	virtual float64_t
 	dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const;
 
+	/** Compute the dense dot products for a range of vectors.
+	 *
+	 * When the features are stored as an in-memory float64 matrix without
+	 * a subset, the range is evaluated as blocked matrix-vector products,
+	 * one contiguous block of columns per thread.
+	 * Otherwise falls back to DotFeatures::dense_dot_range.
+	 *
+	 * @param output result for the given vector range
+	 * @param start first index of vector range
+	 * @param stop last index of vector range (exclusive)
+	 * @param alphas scalars to multiply the results with (may be NULL)
+	 * @param vec dense vector to compute dot products with
+	 * @param dim length of the dense vector
+	 * @param b bias to add
+	 */
+	virtual void dense_dot_range(
+		float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+		float64_t* vec, int32_t dim, float64_t b) const;
+
 	/** add vector 1 multiplied with alpha to dense vector2
 	 *
 	 * possible with subset
@@ -0,0 +1,79 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/features/DotFeatures_benchmark.h"
+#include "shogun/features/SparseFeatures.h"
+#include "shogun/mathematics/NormalDistribution.h"
+#include "shogun/mathematics/UniformRealDistribution.h"
+#include <random>
+
+namespace shogun
+{
+
+class DenseDotFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal_dist;
+
+		index_t num_dim = st.range(0);
+		SGMatrix<float64_t> mat(num_dim, num_vecs);
+		for (index_t i = 0; i < num_dim * num_vecs; i++)
+			mat.matrix[i] = normal_dist(prng);
+
+		f = std::make_shared<DenseFeatures<float64_t>>(mat);
+		w = SGVector<float64_t>(num_dim);
+		w.range_fill(17.0);
+	}
+
+	void TearDown(const ::benchmark::State&) { f.reset(); }
+
+	static constexpr index_t num_vecs = 10000;
+	std::shared_ptr<DenseFeatures<float64_t>> f;
+	SGVector<float64_t> w;
+};
+
+class SparseDotFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		UniformRealDistribution<float64_t> uniform_dist(0.0, 1.0);
+
+		// 5% of the entries are non zero
+		index_t num_dim = st.range(0);
+		SGMatrix<float64_t> mat(num_dim, num_vecs);
+		for (index_t i = 0; i < num_dim * num_vecs; i++)
+		{
+			auto p = uniform_dist(prng);
+			mat.matrix[i] = p < 0.05 ? p : 0.0;
+		}
+
+		f = std::make_shared<SparseFeatures<float64_t>>(mat);
+		w = SGVector<float64_t>(num_dim);
+		w.range_fill(17.0);
+	}
+
+	void TearDown(const ::benchmark::State&) { f.reset(); }
+
+	static constexpr index_t num_vecs = 10000;
+	std::shared_ptr<SparseFeatures<float64_t>> f;
+	SGVector<float64_t> w;
+};
+
+#define ADD_DOTFEATURES_ARGS(WHAT)	\
+	WHAT->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond);
+
+ADD_DOTFEATURES_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(DenseDotFixture, DenseFeatures_DenseDot))
+ADD_DOTFEATURES_ARGS(DOTFEATURES_BENCHMARK_DENSEDOTRANGE(DenseDotFixture, DenseFeatures_DenseDotRange))
+ADD_DOTFEATURES_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(SparseDotFixture, SparseFeatures_DenseDot))
+ADD_DOTFEATURES_ARGS(DOTFEATURES_BENCHMARK_DENSEDOTRANGE(SparseDotFixture, SparseFeatures_DenseDotRange))
+
+}
@@ -33,5 +33,18 @@ BENCHMARK_DEFINE_F(FIXTURE, NAME)(benchmark::State& state)	\
 }															\
 BENCHMARK_REGISTER_F(FIXTURE, NAME)
 
+#define DOTFEATURES_BENCHMARK_DENSEDOTRANGE(FIXTURE, NAME)	\
+BENCHMARK_DEFINE_F(FIXTURE, NAME)(benchmark::State& state)	\
+{															\
+	index_t num_vectors = f->get_num_vectors();				\
+	SGVector<float64_t> out(num_vectors);					\
+	for (auto _ : state)									\
+	{														\
+		f->dense_dot_range(out.vector, 0, num_vectors,		\
+			nullptr, w.vector, w.vlen, 0.0);				\
+		benchmark::DoNotOptimize(out.vector);				\
+	}														\
+}															\
+BENCHMARK_REGISTER_F(FIXTURE, NAME)
 
 #endif /*  */
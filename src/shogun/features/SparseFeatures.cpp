@@ -493,6 +493,58 @@ float64_t SparseFeatures<complex128_t>::dot(
 	return 0.0;
 }
 
+template <class ST>
+void SparseFeatures<ST>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if (!sparse_feature_matrix.sparse_matrix)
+	{
+		DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	require(
+		dim >= get_num_features(),
+		"Dense vector dimension ({}) must be at least the number of "
+		"features ({}).", dim, get_num_features());
+
+	const SGSparseVector<ST>* vectors = sparse_feature_matrix.sparse_matrix;
+	const int32_t num_vectors = stop - start;
+
+	#pragma omp parallel for schedule(static)
+	for (int32_t i = 0; i < num_vectors; i++)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		if (i + 1 < num_vectors)
+			__builtin_prefetch(
+				vectors[m_subset_stack->subset_idx_conversion(i + start + 1)]
+					.features,
+				0, 1);
+#endif
+
+		const auto& sv =
+			vectors[m_subset_stack->subset_idx_conversion(i + start)];
+		float64_t result = 0;
+		for (int32_t j = 0; j < sv.num_feat_entries; j++)
+			result += vec[sv.features[j].feat_index] * sv.features[j].entry;
+
+		output[i] = alphas ? alphas[i] * result + b : result + b;
+	}
+}
+
+template <>
+void SparseFeatures<complex128_t>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	not_implemented(SOURCE_LOCATION);
+}
+
 template<class ST> void* SparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
 	if (vector_index>=get_num_vectors())
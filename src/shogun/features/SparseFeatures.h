@@ -393,6 +393,24 @@ template <class ST> class SparseFeatures : public DotFeatures
 		virtual float64_t
 		dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const;
 
+		/** compute the dense dot products for a range of vectors
+		 *
+		 * works directly on the in-memory sparse matrix and prefetches
+		 * the entries of the next vector while the current one is
+		 * processed; falls back to DotFeatures::dense_dot_range otherwise
+		 *
+		 * @param output result for the given vector range
+		 * @param start first index of vector range
+		 * @param stop last index of vector range (exclusive)
+		 * @param alphas scalars to multiply the results with (may be NULL)
+		 * @param vec dense vector to compute dot products with
+		 * @param dim length of the dense vector
+		 * @param b bias to add
+		 */
+		virtual void dense_dot_range(
+			float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+			float64_t* vec, int32_t dim, float64_t b) const;
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for sparse features */
 		struct sparse_feature_iterator
@@ -9,6 +9,7 @@
 #include <shogun/lib/Hash.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -31,6 +32,8 @@ HashedDocDotFeatures::HashedDocDotFeatures(const HashedDocDotFeatures& orig)
 {
 	init(orig.num_bits, orig.doc_collection, orig.tokenizer, orig.should_normalize,
 			orig.ngrams, orig.tokens_to_skip);
+	cache_offsets = orig.cache_offsets;
+	cache_entries = orig.cache_entries;
 }
 
 HashedDocDotFeatures::HashedDocDotFeatures(const std::shared_ptr<File>& loader)
@@ -84,6 +87,19 @@ float64_t HashedDocDotFeatures::dot(int32_t vec_idx1, std::shared_ptr<DotFeature
 
 	auto hddf = std::static_pointer_cast<HashedDocDotFeatures>(df);
 
+	if (!cache_offsets.empty() && !hddf->cache_offsets.empty())
+	{
+		SGSparseVector<float64_t> cv1(
+			const_cast<SGSparseVectorEntry<float64_t>*>(
+				&cache_entries[cache_offsets[vec_idx1]]),
+			cache_offsets[vec_idx1+1]-cache_offsets[vec_idx1], false);
+		SGSparseVector<float64_t> cv2(
+			const_cast<SGSparseVectorEntry<float64_t>*>(
+				&hddf->cache_entries[hddf->cache_offsets[vec_idx2]]),
+			hddf->cache_offsets[vec_idx2+1]-hddf->cache_offsets[vec_idx2], false);
+		return SGSparseVector<float64_t>::sparse_dot(cv1,cv2);
+	}
+
 	SGVector<char> sv1 = doc_collection->get_feature_vector(vec_idx1);
 	SGVector<char> sv2 = hddf->doc_collection->get_feature_vector(vec_idx2);
 
@@ -105,6 +121,14 @@ float64_t HashedDocDotFeatures::dot(
 {
 	ASSERT(vec2.size() == std::pow(2,num_bits))
 
+	if (!cache_offsets.empty())
+	{
+		float64_t result = 0;
+		for (index_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			result += cache_entries[i].entry * vec2[cache_entries[i].feat_index];
+		return result;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 
 	/** this vector will maintain the current n+k active tokens
@@ -119,7 +143,7 @@ float64_t HashedDocDotFeatures::dot(
 	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
 
 	float64_t result = 0;
-	auto local_tzer = tokenizer->get_copy();
+	std::shared_ptr<Tokenizer> local_tzer(tokenizer->get_copy());
 
 	/** Reading n+k-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
@@ -182,6 +206,13 @@ void HashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	if (abs_val)
 		alpha = Math::abs(alpha);
 
+	if (!cache_offsets.empty())
+	{
+		for (index_t i=cache_offsets[vec_idx1]; i<cache_offsets[vec_idx1+1]; i++)
+			vec2[cache_entries[i].feat_index] += alpha * cache_entries[i].entry;
+		return;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 	const float64_t value =
 		should_normalize ? alpha / std::sqrt((float64_t)sv.size()) : alpha;
@@ -197,7 +228,7 @@ void HashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	 * stored here to avoid creating new objects */
 	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
 
-	auto local_tzer = tokenizer->get_copy();
+	std::shared_ptr<Tokenizer> local_tzer(tokenizer->get_copy());
 
 	/** Reading n+k-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
@@ -251,6 +282,42 @@ void HashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 
 }
 
+void HashedDocDotFeatures::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if (cache_offsets.empty())
+	{
+		DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim == std::pow(2,num_bits))
+
+	const index_t* offsets = cache_offsets.data();
+	const SGSparseVectorEntry<float64_t>* entries = cache_entries.data();
+	const int32_t num_vectors = stop - start;
+
+	#pragma omp parallel for schedule(static)
+	for (int32_t i = 0; i < num_vectors; i++)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		if (i + 1 < num_vectors)
+			__builtin_prefetch(entries + offsets[i + start + 1], 0, 1);
+#endif
+
+		float64_t result = 0;
+		for (index_t j = offsets[i + start]; j < offsets[i + start + 1]; j++)
+			result += vec[entries[j].feat_index] * entries[j].entry;
+
+		output[i] = alphas ? alphas[i] * result + b : result + b;
+	}
+}
+
 uint32_t HashedDocDotFeatures::calculate_token_hash(char* token,
 		int32_t length, int32_t num_bits, uint32_t seed)
 {
@@ -262,10 +329,74 @@ void HashedDocDotFeatures::set_doc_collection(std::shared_ptr<StringFeatures<cha
 {
 
 	doc_collection = std::move(docs);
+	if (!cache_offsets.empty())
+		compute_hash_cache();
+}
+
+void HashedDocDotFeatures::set_cache_hashes(bool cache)
+{
+	if (cache)
+		compute_hash_cache();
+	else
+		free_hash_cache();
+}
+
+bool HashedDocDotFeatures::get_cache_hashes() const
+{
+	return !cache_offsets.empty();
+}
+
+void HashedDocDotFeatures::compute_hash_cache()
+{
+	require(doc_collection, "No document collection set");
+
+	const index_t num_vectors = doc_collection->get_num_vectors();
+	std::vector<SGSparseVector<float64_t>> hashed_docs(num_vectors);
+
+	/* the tokenizer keeps state, so every thread hashes its documents
+	 * with a converter of its own */
+	#pragma omp parallel
+	{
+		auto converter = std::make_shared<HashedDocConverter>(
+			std::shared_ptr<Tokenizer>(tokenizer->get_copy()), num_bits,
+			should_normalize, ngrams, tokens_to_skip);
+
+		#pragma omp for schedule(dynamic, 16)
+		for (index_t i=0; i<num_vectors; i++)
+		{
+			SGVector<char> sv = doc_collection->get_feature_vector(i);
+			hashed_docs[i] = converter->apply(sv);
+			doc_collection->free_feature_vector(sv, i);
+		}
+	}
+
+	cache_offsets.assign(num_vectors+1, 0);
+	for (index_t i=0; i<num_vectors; i++)
+		cache_offsets[i+1] = cache_offsets[i] + hashed_docs[i].num_feat_entries;
+
+	cache_entries.resize(cache_offsets[num_vectors]);
+	#pragma omp parallel for
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		std::copy(hashed_docs[i].features,
+			hashed_docs[i].features + hashed_docs[i].num_feat_entries,
+			cache_entries.begin() + cache_offsets[i]);
+	}
+}
+
+void HashedDocDotFeatures::free_hash_cache()
+{
+	cache_offsets.clear();
+	cache_offsets.shrink_to_fit();
+	cache_entries.clear();
+	cache_entries.shrink_to_fit();
 }
 
 int32_t HashedDocDotFeatures::get_nnz_features_for_vector(int32_t num) const
 {
+	if (!cache_offsets.empty())
+		return cache_offsets[num+1] - cache_offsets[num];
+
 	SGVector<char> sv = doc_collection->get_feature_vector(num);
 	int32_t num_nnz_features = sv.size();
 	doc_collection->free_feature_vector(sv, num);
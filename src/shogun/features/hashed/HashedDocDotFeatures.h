@@ -14,6 +14,8 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/Tokenizer.h>
 
+#include <vector>
+
 namespace shogun {
 template<class ST> class StringFeatures;
 template<class ST> class SGMatrix;
@@ -96,6 +98,24 @@ public:
 	 */
 	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false) const;
 
+	/** compute the dense dot products for a range of vectors
+	 *
+	 * in the cached mode, reads the CSR block of hashed documents directly
+	 * and prefetches the entries of the next document; re-hashes every
+	 * document through DotFeatures::dense_dot_range otherwise
+	 *
+	 * @param output result for the given vector range
+	 * @param start first index of vector range
+	 * @param stop last index of vector range (exclusive)
+	 * @param alphas scalars to multiply the results with (may be NULL)
+	 * @param vec dense vector to compute dot products with
+	 * @param dim length of the dense vector
+	 * @param b bias to add
+	 */
+	virtual void dense_dot_range(
+		float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+		float64_t* vec, int32_t dim, float64_t b) const;
+
 	/** get number of non-zero features in vector
 	 *
 	 * (in case accurate estimates are too expensive overestimating is OK)
@@ -144,6 +164,20 @@ public:
 	 */
 	void set_doc_collection(std::shared_ptr<StringFeatures<char>> docs);
 
+	/** Enable or disable the cached mode. When enabled, all documents are
+	 * tokenized and hashed once (in parallel) and the resulting
+	 * (index, value) pairs are kept in a compact CSR block that is read by
+	 * the dot products instead of re-hashing the documents on every call.
+	 * The cache is rebuilt from the new documents whenever the document
+	 * collection is replaced.
+	 *
+	 * @param cache whether to cache the hashed documents
+	 */
+	void set_cache_hashes(bool cache);
+
+	/** @return whether the hashed documents are cached */
+	bool get_cache_hashes() const;
+
 	virtual const char* get_name() const;
 
 	/** duplicate feature object
@@ -182,6 +216,12 @@ public:
 			int32_t num_bits, uint32_t seed);
 
 private:
+	/** hashes all documents of the collection into the CSR cache */
+	void compute_hash_cache();
+
+	/** drops the CSR cache */
+	void free_hash_cache();
+
 	void init(int32_t hash_bits, std::shared_ptr<StringFeatures<char>> docs, std::shared_ptr<Tokenizer> tzer,
 		bool normalize, int32_t n_grams, int32_t skips);
 
@@ -203,6 +243,13 @@ protected:
 
 	/** tokens to skip when combining tokens */
 	int32_t tokens_to_skip;
+
+	/** offsets of the documents in the hash cache, empty if not cached */
+	std::vector<index_t> cache_offsets;
+
+	/** hashed (index, value) pairs of all documents, sorted by index
+	 * within each document */
+	std::vector<SGSparseVectorEntry<float64_t>> cache_entries;
 };
 }
 
@@ -20,7 +20,7 @@ namespace shogun
 class HDFixture : public benchmark::Fixture
 {
 public:
-	void SetUp(const ::benchmark::State& st)
+	virtual void SetUp(const ::benchmark::State& st)
 	{
 		std::random_device rd;
 		std::mt19937_64 prng(rd());
@@ -50,10 +50,24 @@ public:
 	SGVector<float64_t> w;
 };
 
+class HDCachedFixture : public HDFixture
+{
+public:
+	void SetUp(const ::benchmark::State& st) override
+	{
+		HDFixture::SetUp(st);
+		f->set_cache_hashes(true);
+	}
+};
+
 #define ADD_HASHEDDOC_ARGS(WHAT)	\
 	WHAT->Arg(8)->Arg(10)->Arg(12)->Arg(16)->Arg(20)->Unit(benchmark::kMillisecond)
 
 
 ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(HDFixture, HashedDocDotFeatures_DenseDot));
 ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(HDFixture, HashedDocDotFeatures_AddDense));
+ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(HDCachedFixture, HashedDocDotFeatures_Cached_DenseDot));
+ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(HDCachedFixture, HashedDocDotFeatures_Cached_AddDense));
+ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_DENSEDOTRANGE(HDFixture, HashedDocDotFeatures_DenseDotRange));
+ADD_HASHEDDOC_ARGS(DOTFEATURES_BENCHMARK_DENSEDOTRANGE(HDCachedFixture, HashedDocDotFeatures_Cached_DenseDotRange));
 }
@@ -13,9 +13,18 @@
 #include <hdf5.h>
 
 #include <shogun/lib/memory.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/Compressor.h>
 #include <shogun/io/HDF5File.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
 using namespace shogun;
 
 HDF5File::HDF5File()
@@ -24,12 +33,20 @@ HDF5File::HDF5File()
 
 	get_boolean_type();
 	h5file = -1;
+	m_chunk_vectors = 0;
+	m_chunk_features = 0;
+	m_compression = HDF5_UNCOMPRESSED;
+	m_compression_level = 6;
 }
 
 HDF5File::HDF5File(char* fname, char rw, const char* name) : File()
 {
 	get_boolean_type();
 	H5Eset_auto2(H5E_DEFAULT, NULL, NULL);
+	m_chunk_vectors = 0;
+	m_chunk_features = 0;
+	m_compression = HDF5_UNCOMPRESSED;
+	m_compression_level = 6;
 
 	if (name)
 		set_variable_name(name);
@@ -445,4 +462,502 @@ void HDF5File::create_group_hierarchy()
 	}
 	SG_FREE(vname);
 }
+namespace
+{
+/** registered id of the LZ4 filter plugin */
+const H5Z_filter_t H5Z_FILTER_LZ4 = 32004;
+/** registered id of the Zstandard filter plugin */
+const H5Z_filter_t H5Z_FILTER_ZSTD = 32015;
+/** bytes per chunk if the chunk shape is not set */
+const size_t default_chunk_bytes = 1 << 20;
+
+/** @return dimensions of a dataset */
+std::vector<hsize_t> get_shape(hid_t h5file, const char* name)
+{
+	hid_t dataset = H5Dopen2(h5file, name, H5P_DEFAULT);
+	if (dataset<0)
+		error("Error opening data set '{}'", name);
+	hid_t dataspace = H5Dget_space(dataset);
+	std::vector<hsize_t> dims(std::max(H5Sget_simple_extent_ndims(dataspace), 0));
+	H5Sget_simple_extent_dims(dataspace, dims.data(), NULL);
+	H5Sclose(dataspace);
+	H5Dclose(dataset);
+	return dims;
+}
+
+/** @return whether name is a group written by write_sparse_vectors() */
+bool is_sparse_group(hid_t h5file, const char* name)
+{
+	return H5Aexists_by_name(h5file, name, "num_features", H5P_DEFAULT)>0;
+}
+
+/** @return number of features stored with a sparse group */
+int32_t read_num_features(hid_t h5file, const char* name)
+{
+	int32_t num_features=0;
+	hid_t attr=H5Aopen_by_name(h5file, name, "num_features", H5P_DEFAULT,
+			H5P_DEFAULT);
+	if (attr<0 || H5Aread(attr, H5T_NATIVE_INT32, &num_features)<0)
+		error("Error reading number of features of '{}'", name);
+	H5Aclose(attr);
+	return num_features;
+}
+}
+
+template <> hid_t HDF5File::get_native_type<bool>() const { return boolean_type; }
+template <> hid_t HDF5File::get_native_type<char>() const { return H5T_NATIVE_CHAR; }
+template <> hid_t HDF5File::get_native_type<int8_t>() const { return H5T_NATIVE_INT8; }
+template <> hid_t HDF5File::get_native_type<uint8_t>() const { return H5T_NATIVE_UINT8; }
+template <> hid_t HDF5File::get_native_type<int16_t>() const { return H5T_NATIVE_INT16; }
+template <> hid_t HDF5File::get_native_type<uint16_t>() const { return H5T_NATIVE_UINT16; }
+template <> hid_t HDF5File::get_native_type<int32_t>() const { return H5T_NATIVE_INT32; }
+template <> hid_t HDF5File::get_native_type<uint32_t>() const { return H5T_NATIVE_UINT32; }
+template <> hid_t HDF5File::get_native_type<int64_t>() const { return H5T_NATIVE_INT64; }
+template <> hid_t HDF5File::get_native_type<uint64_t>() const { return H5T_NATIVE_UINT64; }
+template <> hid_t HDF5File::get_native_type<float32_t>() const { return H5T_NATIVE_FLOAT; }
+template <> hid_t HDF5File::get_native_type<float64_t>() const { return H5T_NATIVE_DOUBLE; }
+template <> hid_t HDF5File::get_native_type<floatmax_t>() const { return H5T_NATIVE_LDOUBLE; }
+
+void HDF5File::set_chunk_shape(int32_t num_vectors, int32_t num_features)
+{
+	require(num_vectors>=0 && num_features>=0,
+			"Chunk shape ({}, {}) must not be negative", num_vectors,
+			num_features);
+	m_chunk_vectors=num_vectors;
+	m_chunk_features=num_features;
+}
+
+void HDF5File::set_compression(EHDF5Compression compression, int32_t level)
+{
+	m_compression=compression;
+	m_compression_level=level;
+}
+
+hid_t HDF5File::create_dataset_plist(int32_t ndims, const hsize_t* dims, size_t elem_size)
+{
+	hid_t plist=H5Pcreate(H5P_DATASET_CREATE);
+	if (plist<0)
+		error("Could not create hdf5 property list");
+
+	// chunks must not be empty and not exceed the dataset, so empty datasets
+	// stay contiguous
+	bool chunked=m_chunk_vectors>0 || m_compression!=HDF5_UNCOMPRESSED;
+	for (int32_t i=0; i<ndims; i++)
+		chunked=chunked && dims[i]>0;
+	if (!chunked)
+		return plist;
+
+	hsize_t chunk[2];
+	if (ndims==2)
+	{
+		chunk[1]=m_chunk_features>0 ? std::min<hsize_t>(m_chunk_features, dims[1]) : dims[1];
+		chunk[0]=m_chunk_vectors>0 ? m_chunk_vectors :
+			std::max<hsize_t>(default_chunk_bytes/(chunk[1]*elem_size), 1);
+	}
+	else
+		chunk[0]=std::max<hsize_t>(default_chunk_bytes/elem_size, 1);
+	chunk[0]=std::min(chunk[0], dims[0]);
+
+	herr_t status=H5Pset_chunk(plist, ndims, chunk);
+	switch (m_compression)
+	{
+		case HDF5_UNCOMPRESSED:
+			break;
+		case HDF5_GZIP:
+			if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)<=0)
+				error("HDF5 was built without the deflate filter");
+			status=std::min(status, H5Pset_deflate(plist, m_compression_level));
+			break;
+		case HDF5_LZ4:
+			if (H5Zfilter_avail(H5Z_FILTER_LZ4)<=0)
+				error("LZ4 filter plugin not found, set HDF5_PLUGIN_PATH");
+			status=std::min(status, H5Pset_filter(plist, H5Z_FILTER_LZ4,
+						H5Z_FLAG_MANDATORY, 0, NULL));
+			break;
+		case HDF5_ZSTD:
+			{
+				if (H5Zfilter_avail(H5Z_FILTER_ZSTD)<=0)
+					error("Zstandard filter plugin not found, set HDF5_PLUGIN_PATH");
+				unsigned int level=m_compression_level;
+				status=std::min(status, H5Pset_filter(plist, H5Z_FILTER_ZSTD,
+							H5Z_FLAG_MANDATORY, 1, &level));
+				break;
+			}
+	}
+	if (status<0)
+	{
+		H5Pclose(plist);
+		error("Could not set up chunked hdf5 dataset layout");
+	}
+
+	SG_DEBUG("Chunks of {}x{} elements for dataset of {}x{}", chunk[0],
+			ndims==2 ? chunk[1] : 1, dims[0], ndims==2 ? dims[1] : 1);
+	return plist;
+}
+
+void HDF5File::write_dataset(const char* name, hid_t type, int32_t ndims,
+		const hsize_t* dims, const void* data, size_t elem_size)
+{
+	hid_t dataspace=H5Screate_simple(ndims, dims, NULL);
+	if (dataspace<0)
+		error("Could not create hdf5 dataspace");
+	hid_t plist=create_dataset_plist(ndims, dims, elem_size);
+	hid_t dataset=H5Dcreate2(h5file, name, type, dataspace, H5P_DEFAULT,
+			plist, H5P_DEFAULT);
+	H5Pclose(plist);
+	if (dataset<0)
+	{
+		H5Sclose(dataspace);
+		error("Could not create hdf5 dataset - does"
+				" dataset '{}' already exist?", name);
+	}
+
+	herr_t status=0;
+	if (H5Sget_simple_extent_npoints(dataspace)>0)
+		status=H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+	H5Dclose(dataset);
+	H5Sclose(dataspace);
+	if (status<0)
+		error("Failed to write hdf5 dataset '{}'", name);
+}
+
+void HDF5File::read_dataset(const char* name, hid_t type, int32_t ndims,
+		const hsize_t* offset, const hsize_t* count, void* data,
+		size_t elem_size)
+{
+	hid_t dataset=H5Dopen2(h5file, name, H5P_DEFAULT);
+	if (dataset<0)
+		error("Error opening data set '{}'", name);
+
+	hsize_t num_elements=1;
+	for (int32_t i=0; i<ndims; i++)
+		num_elements*=count[i];
+
+	if (num_elements>0 &&
+			!read_chunks_parallel(dataset, type, ndims, offset, count, data, elem_size))
+	{
+		hid_t filespace=H5Dget_space(dataset);
+		hid_t memspace=H5Screate_simple(ndims, count, NULL);
+		herr_t status=H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset,
+				NULL, count, NULL);
+		if (status>=0)
+			status=H5Dread(dataset, type, memspace, filespace, H5P_DEFAULT, data);
+		H5Sclose(memspace);
+		H5Sclose(filespace);
+		if (status<0)
+		{
+			H5Dclose(dataset);
+			error("Error reading dataset '{}'", name);
+		}
+	}
+	H5Dclose(dataset);
+}
+
+bool HDF5File::read_chunks_parallel(hid_t dataset, hid_t type, int32_t ndims,
+		const hsize_t* offset, const hsize_t* count, void* data,
+		size_t elem_size)
+{
+#if H5_VERSION_GE(1,10,3) && defined(USE_GZIP)
+	// HDF5 decompresses chunks one after another, so deflated chunks are read
+	// raw and inflated by zlib on all threads
+	hid_t plist=H5Dget_create_plist(dataset);
+	hsize_t chunk[2]={1, 1};
+	bool usable=H5Pget_layout(plist)==H5D_CHUNKED &&
+		H5Pget_chunk(plist, ndims, chunk)==ndims &&
+		H5Pget_nfilters(plist)==1;
+	if (usable)
+	{
+		unsigned int flags, filter_config;
+		size_t num_values=0;
+		usable=H5Pget_filter2(plist, 0, &flags, &num_values, NULL, 0, NULL,
+				&filter_config)==H5Z_FILTER_DEFLATE;
+	}
+	H5Pclose(plist);
+
+	hid_t file_type=H5Dget_type(dataset);
+	usable=usable && H5Tequal(file_type, type)>0;
+	H5Tclose(file_type);
+	if (!usable)
+		return false;
+
+	const hsize_t rows_begin=offset[0], rows_end=offset[0]+count[0];
+	const hsize_t cols_begin=ndims==2 ? offset[1] : 0;
+	const hsize_t cols_end=ndims==2 ? offset[1]+count[1] : 1;
+	const hsize_t num_cols=cols_end-cols_begin;
+	const hsize_t chunk_cols=ndims==2 ? chunk[1] : 1;
+	const size_t chunk_bytes=chunk[0]*chunk_cols*elem_size;
+
+	struct RawChunk
+	{
+		hsize_t origin[2];
+		uint32_t filter_mask;
+		std::vector<uint8_t> bytes;
+	};
+	std::vector<RawChunk> chunks;
+	for (hsize_t r=rows_begin/chunk[0]*chunk[0]; r<rows_end; r+=chunk[0])
+	{
+		for (hsize_t c=cols_begin/chunk_cols*chunk_cols; c<cols_end; c+=chunk_cols)
+			chunks.push_back({{r, c}, 0, {}});
+	}
+	if (chunks.size()<2)
+		return false;
+
+	// reading is serialised by the library anyway, only decompression runs
+	// in parallel
+	memset(data, 0, count[0]*num_cols*elem_size);
+	for (auto& raw : chunks)
+	{
+		hsize_t storage_size=0;
+		if (H5Dget_chunk_storage_size(dataset, raw.origin, &storage_size)<0)
+			error("Error obtaining size of hdf5 chunk");
+		// chunks that were never written hold the fill value 0
+		if (storage_size==0)
+			continue;
+		raw.bytes.resize(storage_size);
+		if (H5Dread_chunk(dataset, H5P_DEFAULT, raw.origin, &raw.filter_mask,
+				raw.bytes.data())<0)
+			error("Error reading hdf5 chunk");
+	}
+
+	auto compressor=std::make_shared<Compressor>(GZIP);
+	std::string failure;
+	#pragma omp parallel for schedule(dynamic)
+	for (size_t i=0; i<chunks.size(); i++)
+	{
+		auto& raw=chunks[i];
+		if (raw.bytes.empty())
+			continue;
+
+		try
+		{
+			// the deflate filter is optional, so incompressible chunks are
+			// stored as they are, which the filter mask tells
+			std::vector<uint8_t> inflated;
+			const uint8_t* values=raw.bytes.data();
+			if (!(raw.filter_mask & 1))
+			{
+				inflated.resize(chunk_bytes);
+				uint64_t size=chunk_bytes;
+				compressor->decompress(raw.bytes.data(), raw.bytes.size(),
+						inflated.data(), size);
+				require(size==chunk_bytes, "Chunk has {} bytes, expected {}",
+						size, chunk_bytes);
+				values=inflated.data();
+			}
+			else
+				require(raw.bytes.size()==chunk_bytes,
+						"Chunk has {} bytes, expected {}", raw.bytes.size(),
+						chunk_bytes);
+
+			auto c_begin=std::max(raw.origin[1], cols_begin);
+			auto c_end=std::min(raw.origin[1]+chunk_cols, cols_end);
+			auto r_end=std::min(raw.origin[0]+chunk[0], rows_end);
+			for (auto r=std::max(raw.origin[0], rows_begin); r<r_end; r++)
+			{
+				sg_memcpy(
+					(uint8_t*) data+((r-rows_begin)*num_cols+c_begin-cols_begin)*elem_size,
+					values+((r-raw.origin[0])*chunk_cols+c_begin-raw.origin[1])*elem_size,
+					(c_end-c_begin)*elem_size);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			#pragma omp critical
+			failure=e.what();
+		}
+	}
+	if (!failure.empty())
+		error("Error decompressing hdf5 chunk: {}", failure);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+template <class T>
+void HDF5File::write_vectors(const SGMatrix<T>& matrix)
+{
+	if (h5file<0)
+		error("File invalid.");
+
+	create_group_hierarchy();
+
+	// the column-major matrix is the row-major dataset of one vector per row
+	hsize_t dims[2]={(hsize_t) matrix.num_cols, (hsize_t) matrix.num_rows};
+	write_dataset(variable_name, get_native_type<T>(), 2, dims, matrix.matrix,
+			sizeof(T));
+}
+
+template <class T>
+SGMatrix<T> HDF5File::read_vectors(index_t begin, index_t end)
+{
+	if (h5file<0)
+		error("File invalid.");
+
+	auto shape=get_shape(h5file, variable_name);
+	require(shape.size()==1 || shape.size()==2,
+			"Dataset '{}' has {} dimensions, expected 1 or 2", variable_name,
+			shape.size());
+	index_t num_vectors=shape[0];
+	index_t num_features=shape.size()==2 ? shape[1] : 1;
+	if (end<0)
+		end=num_vectors;
+	require(begin>=0 && begin<=end && end<=num_vectors,
+			"Range [{}, {}) exceeds the {} vectors of '{}'", begin, end,
+			num_vectors, variable_name);
+
+	SGMatrix<T> matrix(num_features, end-begin);
+	hsize_t offset[2]={(hsize_t) begin, 0};
+	hsize_t count[2]={(hsize_t) (end-begin), (hsize_t) num_features};
+	read_dataset(variable_name, get_native_type<T>(), shape.size(), offset,
+			count, matrix.matrix, sizeof(T));
+	return matrix;
+}
+
+template <class T>
+void HDF5File::write_sparse_vectors(const SGSparseMatrix<T>& matrix)
+{
+	if (h5file<0)
+		error("File invalid.");
+
+	create_group_hierarchy();
+
+	hid_t group=H5Gcreate2(h5file, variable_name, H5P_DEFAULT, H5P_DEFAULT,
+			H5P_DEFAULT);
+	if (group<0)
+	{
+		error("Could not create hdf5 group - does"
+				" group '{}' already exist?", variable_name);
+	}
+	int32_t num_features=matrix.num_features;
+	hid_t dataspace=H5Screate(H5S_SCALAR);
+	hid_t attr=H5Acreate2(group, "num_features", H5T_NATIVE_INT32, dataspace,
+			H5P_DEFAULT, H5P_DEFAULT);
+	herr_t status=attr<0 ? -1 : H5Awrite(attr, H5T_NATIVE_INT32, &num_features);
+	if (attr>=0)
+		H5Aclose(attr);
+	H5Sclose(dataspace);
+	H5Gclose(group);
+	if (status<0)
+		error("Failed to write hdf5 attribute");
+
+	SGVector<int64_t> indptr(matrix.num_vectors+1);
+	indptr[0]=0;
+	for (index_t i=0; i<matrix.num_vectors; i++)
+		indptr[i+1]=indptr[i]+matrix[i].num_feat_entries;
+
+	SGVector<int32_t> indices(indptr[matrix.num_vectors]);
+	SGVector<T> data(indptr[matrix.num_vectors]);
+	for (index_t i=0; i<matrix.num_vectors; i++)
+	{
+		const auto& vec=matrix[i];
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			indices[indptr[i]+j]=vec.features[j].feat_index;
+			data[indptr[i]+j]=vec.features[j].entry;
+		}
+	}
+
+	std::string prefix(variable_name);
+	hsize_t dims=indptr.vlen;
+	write_dataset((prefix+"/indptr").c_str(), H5T_NATIVE_INT64, 1, &dims,
+			indptr.vector, sizeof(int64_t));
+	dims=indices.vlen;
+	write_dataset((prefix+"/indices").c_str(), H5T_NATIVE_INT32, 1, &dims,
+			indices.vector, sizeof(int32_t));
+	write_dataset((prefix+"/data").c_str(), get_native_type<T>(), 1, &dims,
+			data.vector, sizeof(T));
+}
+
+template <class T>
+SGSparseMatrix<T> HDF5File::read_sparse_vectors(index_t begin, index_t end)
+{
+	if (h5file<0)
+		error("File invalid.");
+	if (!is_sparse_group(h5file, variable_name))
+		error("'{}' is not a group of sparse vectors", variable_name);
+
+	std::string prefix(variable_name);
+	index_t num_vectors=get_shape(h5file, (prefix+"/indptr").c_str())[0]-1;
+	if (end<0)
+		end=num_vectors;
+	require(begin>=0 && begin<=end && end<=num_vectors,
+			"Range [{}, {}) exceeds the {} vectors of '{}'", begin, end,
+			num_vectors, variable_name);
+
+	SGVector<int64_t> indptr(end-begin+1);
+	hsize_t offset=begin;
+	hsize_t count=indptr.vlen;
+	read_dataset((prefix+"/indptr").c_str(), H5T_NATIVE_INT64, 1, &offset,
+			&count, indptr.vector, sizeof(int64_t));
+
+	// the entries of the range are contiguous
+	offset=indptr[0];
+	count=indptr[end-begin]-indptr[0];
+	SGVector<int32_t> indices(count);
+	SGVector<T> data(count);
+	read_dataset((prefix+"/indices").c_str(), H5T_NATIVE_INT32, 1, &offset,
+			&count, indices.vector, sizeof(int32_t));
+	read_dataset((prefix+"/data").c_str(), get_native_type<T>(), 1, &offset,
+			&count, data.vector, sizeof(T));
+
+	SGSparseMatrix<T> matrix(read_num_features(h5file, variable_name), end-begin);
+	for (index_t i=0; i<end-begin; i++)
+	{
+		auto first=indptr[i]-indptr[0];
+		SGSparseVector<T> vec(indptr[i+1]-indptr[i]);
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			vec.features[j].feat_index=indices[first+j];
+			vec.features[j].entry=data[first+j];
+		}
+		matrix[i]=vec;
+	}
+	return matrix;
+}
+
+bool HDF5File::is_sparse()
+{
+	return is_sparse_group(h5file, variable_name);
+}
+
+index_t HDF5File::get_num_vectors()
+{
+	if (is_sparse_group(h5file, variable_name))
+	{
+		std::string indptr=std::string(variable_name)+"/indptr";
+		return get_shape(h5file, indptr.c_str())[0]-1;
+	}
+	auto shape=get_shape(h5file, variable_name);
+	return shape.empty() ? 0 : shape[0];
+}
+
+index_t HDF5File::get_num_features()
+{
+	if (is_sparse_group(h5file, variable_name))
+		return read_num_features(h5file, variable_name);
+	auto shape=get_shape(h5file, variable_name);
+	return shape.size()==2 ? shape[1] : 1;
+}
+
+#define INSTANTIATE_VECTORS(sg_type)												\
+template void HDF5File::write_vectors<sg_type>(const SGMatrix<sg_type>&);			\
+template SGMatrix<sg_type> HDF5File::read_vectors<sg_type>(index_t, index_t);		\
+template void HDF5File::write_sparse_vectors<sg_type>(const SGSparseMatrix<sg_type>&);	\
+template SGSparseMatrix<sg_type> HDF5File::read_sparse_vectors<sg_type>(index_t, index_t);
+INSTANTIATE_VECTORS(bool)
+INSTANTIATE_VECTORS(char)
+INSTANTIATE_VECTORS(int8_t)
+INSTANTIATE_VECTORS(uint8_t)
+INSTANTIATE_VECTORS(int16_t)
+INSTANTIATE_VECTORS(uint16_t)
+INSTANTIATE_VECTORS(int32_t)
+INSTANTIATE_VECTORS(uint32_t)
+INSTANTIATE_VECTORS(int64_t)
+INSTANTIATE_VECTORS(uint64_t)
+INSTANTIATE_VECTORS(float32_t)
+INSTANTIATE_VECTORS(float64_t)
+INSTANTIATE_VECTORS(floatmax_t)
+#undef INSTANTIATE_VECTORS
 #endif //  HDF5
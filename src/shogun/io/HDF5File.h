@@ -19,14 +19,34 @@
 namespace shogun
 {
 template <class ST> class SGVector;
+template <class ST> class SGMatrix;
 template <class ST> class SGSparseVector;
+template <class ST> class SGSparseMatrix;
 struct TSGDataType;
 
+/** filters to compress chunked HDF5 datasets with */
+enum EHDF5Compression
+{
+	/** no filter */
+	HDF5_UNCOMPRESSED,
+	/** deflate, built into HDF5 */
+	HDF5_GZIP,
+	/** LZ4, registered filter 32004, requires the HDF5 plugin */
+	HDF5_LZ4,
+	/** Zstandard, registered filter 32015, requires the HDF5 plugin */
+	HDF5_ZSTD
+};
+
 /** @brief A HDF5 File access class.
  *
  * This class allows reading and writing of vectors and matrices
  * in the hierarchical file format version 5.
  *
+ * Besides the File interface, which stores a matrix as one block, the
+ * write_vectors()/read_vectors() functions store one vector per row of a
+ * chunked and optionally compressed dataset. Ranges of vectors can then be
+ * read without loading the whole dataset, and chunks are decompressed in
+ * parallel where possible.
  */
 #define IGNORE_IN_CLASSLIST
 IGNORE_IN_CLASSLIST class HDF5File : public File
@@ -344,6 +364,74 @@ public:
 	{
 		not_implemented(SOURCE_LOCATION);
 	}
+
+	/** set the chunk shape of datasets written by write_vectors(), the
+	 * datasets of write_sparse_vectors() use chunks of about 1MB
+	 *
+	 * @param num_vectors vectors per chunk, 0 picks about 1MB per chunk
+	 * @param num_features features per chunk, 0 for all features
+	 */
+	void set_chunk_shape(int32_t num_vectors, int32_t num_features=0);
+
+	/** set the filter of datasets written by write_vectors() and
+	 * write_sparse_vectors(), which implies a chunked layout
+	 *
+	 * @param compression filter
+	 * @param level compression level (gzip 1-9, zstd 1-22), ignored by lz4
+	 */
+	void set_compression(EHDF5Compression compression, int32_t level=6);
+
+	/** write a matrix as a (num_vectors x num_features) dataset named by the
+	 * variable name, using the chunk shape and compression that are set
+	 *
+	 * @param matrix matrix with one vector per column
+	 */
+	template <class T>
+	void write_vectors(const SGMatrix<T>& matrix);
+
+	/** read a range of vectors of a dataset written by write_vectors(), or
+	 * of a 1-dimensional dataset (one feature per vector)
+	 *
+	 * Only the chunks overlapping the range are read.
+	 *
+	 * @param begin first vector
+	 * @param end one past the last vector, -1 for all remaining vectors
+	 * @return matrix with one vector per column
+	 */
+	template <class T>
+	SGMatrix<T> read_vectors(index_t begin=0, index_t end=-1);
+
+	/** write a sparse matrix in compressed sparse row form, as a group named
+	 * by the variable name with the datasets "indptr", "indices" and "data"
+	 *
+	 * @param matrix sparse matrix
+	 */
+	template <class T>
+	void write_sparse_vectors(const SGSparseMatrix<T>& matrix);
+
+	/** read a range of vectors of a group written by write_sparse_vectors()
+	 *
+	 * @param begin first vector
+	 * @param end one past the last vector, -1 for all remaining vectors
+	 * @return sparse matrix of the vectors
+	 */
+	template <class T>
+	SGSparseMatrix<T> read_sparse_vectors(index_t begin=0, index_t end=-1);
+
+	/** @return whether the variable name is a group written by
+	 * write_sparse_vectors()
+	 */
+	bool is_sparse();
+
+	/** @return number of vectors of the dense dataset or sparse group named by
+	 * the variable name
+	 */
+	index_t get_num_vectors();
+
+	/** @return number of features of the dense dataset or sparse group named
+	 * by the variable name
+	 */
+	index_t get_num_features();
 #endif // #ifndef SWIG // SWIG should skip this
 
 	/** @return object name */
@@ -376,11 +464,71 @@ protected:
 	/** create a group hierarchy in the hdf5 file h5file according to name */
 	void create_group_hierarchy();
 
+	/** @return hdf5 memory type of T */
+	template <class T>
+	hid_t get_native_type() const;
+
+	/** create the dataset creation property list for a dataset with the
+	 * given dimensions, from the chunk shape and compression
+	 *
+	 * @param ndims number of dimensions, 1 or 2
+	 * @param dims dimensions
+	 * @param elem_size bytes per element
+	 * @return property list, to be closed by the caller
+	 */
+	hid_t create_dataset_plist(int32_t ndims, const hsize_t* dims, size_t elem_size);
+
+	/** create and write a 1 or 2-dimensional dataset
+	 *
+	 * @param name dataset name
+	 * @param type hdf5 memory (and file) type
+	 * @param ndims number of dimensions
+	 * @param dims dimensions
+	 * @param data row-major data
+	 * @param elem_size bytes per element
+	 */
+	void write_dataset(const char* name, hid_t type, int32_t ndims,
+			const hsize_t* dims, const void* data, size_t elem_size);
+
+	/** read a hyperslab of a 1 or 2-dimensional dataset into row-major
+	 * memory
+	 *
+	 * @param name dataset name
+	 * @param type hdf5 memory type
+	 * @param ndims number of dimensions of offset and count
+	 * @param offset first element per dimension
+	 * @param count elements per dimension
+	 * @param data output of prod(count) elements
+	 * @param elem_size bytes per element
+	 */
+	void read_dataset(const char* name, hid_t type, int32_t ndims,
+			const hsize_t* offset, const hsize_t* count, void* data,
+			size_t elem_size);
+
+	/** read a hyperslab by reading the raw chunks and decompressing them in
+	 * parallel, for datasets without filters or with deflate only
+	 *
+	 * @return whether the chunks could be read this way, if not nothing was
+	 * written to data
+	 */
+	bool read_chunks_parallel(hid_t dataset, hid_t type, int32_t ndims,
+			const hsize_t* offset, const hsize_t* count, void* data,
+			size_t elem_size);
+
 protected:
 	/** hdf5 file handle */
 	hid_t h5file;
 	/** hdf5 type closest to 'bool' */
 	hid_t boolean_type;
+
+	/** vectors per chunk of written datasets, 0 for automatic */
+	int32_t m_chunk_vectors;
+	/** features per chunk of written datasets, 0 for all */
+	int32_t m_chunk_features;
+	/** filter of written datasets */
+	EHDF5Compression m_compression;
+	/** compression level */
+	int32_t m_compression_level;
 };
 }
 #endif //  HAVE_HDF5
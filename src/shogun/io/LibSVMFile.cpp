@@ -13,6 +13,7 @@
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/Trace.h>
 
 #include <algorithm>
 #include <vector>
@@ -150,6 +151,7 @@ GET_LABELED_SPARSE_MATRIX(read_ulong, uint64_t)
 	    int32_t& num_vec, SGVector<float64_t>*& multilabel,                    \
 	    int32_t& num_classes, bool load_labels)                                \
 	{                                                                          \
+		SG_TRACE_SCOPE("LibSVMFile::get_sparse_matrix");                       \
 		num_feat = 0;                                                          \
                                                                                \
 		io::info("counting line numbers in file {}.", filename);               \
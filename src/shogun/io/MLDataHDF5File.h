@@ -26,6 +26,10 @@ struct TSGDataType;
  * This class allows reading and writing of vectors and matrices
  * in the hierarchical file format version 5.
  *
+ * The data is downloaded from the mldata.org repository and read as a
+ * whole through the File interface. Chunked, compressed and partial
+ * reads are only offered by HDF5File (see HDF5File::write_vectors()),
+ * into which a loaded dataset can be converted.
  */
 #define IGNORE_IN_CLASSLIST
 IGNORE_IN_CLASSLIST class MLDataHDF5File : public File
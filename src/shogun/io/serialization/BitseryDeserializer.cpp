@@ -6,24 +6,75 @@
 #include <shogun/io/serialization/BitseryDeserializer.h>
 #include <shogun/io/serialization/BitseryVisitor.h>
 #include <shogun/io/ShogunErrc.h>
+#include <shogun/io/stream/ByteArrayInputStream.h>
 #include <shogun/util/converters.h>
 #include <shogun/base/class_list.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/io/stream/FileInputStream.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/util/system.h>
 
 #include <bitsery/bitsery.h>
 #include <bitsery/traits/string.h>
 
+#ifndef _MSC_VER
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace bitsery;
 using namespace shogun;
 using namespace shogun::io;
 using namespace std;
 
+/** out-of-line elements of a stream with sections */
+struct Section
+{
+	/** elements */
+	char* data;
+	/** bytes of the elements */
+	uint64_t bytes;
+	/** object keeping the elements alive */
+	shared_ptr<const void> owner;
+};
+
 template<class S>
 class BitseryReaderVisitor: public detail::BitseryVisitor<S, BitseryReaderVisitor<S>>
 {
 public:
-	BitseryReaderVisitor(S& s):
-		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s) {}
+	BitseryReaderVisitor(S& s, const vector<Section>* sections = nullptr):
+		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s),
+		m_reader(s), m_sections(sections) {}
+
+	bool on_contiguous(ContiguousArray* array) override
+	{
+		if (!m_sections)
+			return false;
+
+		uint8_t out_of_line;
+		m_reader.value1b(out_of_line);
+		if (!out_of_line)
+			return false;
+
+		uint64_t index;
+		m_reader.value8b(index);
+		require(index < m_sections->size(),
+			"Section {} does not exist, the stream has {} sections", index,
+			m_sections->size());
+		const auto& section = (*m_sections)[index];
+		require(section.bytes == array->size() * array->element_size(),
+			"Section {} has {} bytes, expected {} elements of {} bytes",
+			index, section.bytes, array->size(), array->element_size());
+
+		SG_DEBUG("reading {} bytes from section {}", section.bytes, index);
+		array->bind(section.data, section.owner);
+		return true;
+	}
 
 	void on_complex(S& s, complex128_t* v)
 	{
@@ -56,6 +107,10 @@ public:
 	}
 
 private:
+	S& m_reader;
+	/** out-of-line elements, nullptr for the plain format */
+	const vector<Section>* m_sections;
+
 	SG_DELETE_COPY_AND_ASSIGN(BitseryReaderVisitor);
 };
 
@@ -96,10 +151,8 @@ struct InputStreamAdapter
 };
 
 template<typename Reader>
-std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, const std::shared_ptr<SGObject>& _this = nullptr)
+std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, size_t obj_magic, const std::shared_ptr<SGObject>& _this = nullptr)
 {
-	size_t obj_magic;
-	reader.value8b(obj_magic);
 	if (obj_magic == detail::kNullObjectMagic)
 		return nullptr;
 
@@ -146,10 +199,169 @@ std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Rea
 	return obj;
 }
 
+template<typename Reader>
+std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, const std::shared_ptr<SGObject>& _this = nullptr)
+{
+	size_t obj_magic;
+	reader.value8b(obj_magic);
+	return object_reader(reader, visitor, obj_magic, _this);
+}
+
 using InputAdapter = AdapterReader<InputStreamAdapter, bitsery::DefaultConfig>;
 using BitseryDeser = BasicDeserializer<InputAdapter>;
 
-BitseryDeserializer::BitseryDeserializer() : Deserializer()
+/** header of a stream with sections, which follows kSectionedMagic */
+struct SectionLayout
+{
+	uint64_t flags;
+	uint64_t graph_bytes;
+	/** offset, bytes and checksum of each section */
+	vector<array<uint64_t, 3>> table;
+
+	/** @return bytes in front of the graph */
+	uint64_t header_bytes() const
+	{
+		return 4 * sizeof(uint64_t) + 3 * sizeof(uint64_t) * table.size();
+	}
+};
+
+SectionLayout read_layout(BitseryDeser& deser)
+{
+	SectionLayout layout;
+	uint64_t num_sections;
+	deser.value8b(layout.flags);
+	deser.value8b(num_sections);
+	deser.value8b(layout.graph_bytes);
+	require(
+		bool(layout.flags & detail::kSectionBigEndian) == utils::is_big_endian(),
+		"Sections were written on a machine of different byte order");
+
+	layout.table.resize(num_sections);
+	for (auto& entry : layout.table)
+	{
+		deser.value8b(entry[0]);
+		deser.value8b(entry[1]);
+		deser.value8b(entry[2]);
+	}
+	return layout;
+}
+
+void verify_checksums(const SectionLayout& layout, const vector<Section>& sections)
+{
+	if (!(layout.flags & detail::kSectionChecksums))
+		return;
+
+	vector<pair<const void*, uint64_t>> memory;
+	for (const auto& section : sections)
+		memory.emplace_back(section.data, section.bytes);
+	auto checksums = detail::section_checksums(memory);
+	for (size_t i = 0; i < sections.size(); ++i)
+	{
+		if (checksums[i] != layout.table[i][2])
+			error("Checksum mismatch of section {}, the stream is corrupt", i);
+	}
+}
+
+std::shared_ptr<SGObject> read_graph(const char* graph, uint64_t bytes,
+	const vector<Section>& sections, const std::shared_ptr<SGObject>& _this)
+{
+	InputStreamAdapter adapter { make_shared<ByteArrayInputStream>(graph, bytes) };
+	BitseryDeser deser {std::move(adapter)};
+	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser, addressof(sections));
+	return object_reader(deser, addressof(reader_visitor), _this);
+}
+
+/** read an object from a stream, where sections are read into buffers of
+ * their own that the vectors and matrices of the object use
+ */
+std::shared_ptr<SGObject> read_stream(const shared_ptr<InputStream>& stream,
+	const std::shared_ptr<SGObject>& _this, bool verify)
+{
+	InputStreamAdapter adapter { stream };
+	BitseryDeser deser {std::move(adapter)};
+	size_t magic;
+	deser.value8b(magic);
+	if (magic != detail::kSectionedMagic)
+	{
+		BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
+		return object_reader(deser, addressof(reader_visitor), magic, _this);
+	}
+
+	auto layout = read_layout(deser);
+	string graph;
+	if (auto ec = stream->read(&graph, layout.graph_bytes))
+		throw io::to_system_error(ec);
+
+	uint64_t position = layout.header_bytes() + layout.graph_bytes;
+	vector<Section> sections;
+	for (const auto& entry : layout.table)
+	{
+		auto buffer = make_shared<string>();
+		auto ec = stream->skip(entry[0] - position);
+		if (!ec)
+			ec = stream->read(buffer.get(), entry[1]);
+		if (ec)
+			throw io::to_system_error(ec);
+		sections.push_back({buffer->data(), entry[1], buffer});
+		position = entry[0] + entry[1];
+	}
+	if (verify)
+		verify_checksums(layout, sections);
+
+	return read_graph(graph.data(), graph.size(), sections, _this);
+}
+
+#ifndef _MSC_VER
+/** private mapping of a whole file, whose pages are copied on write */
+class MappedFile
+{
+public:
+	MappedFile(const string& path)
+	{
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			error("Could not open '{}': {}", path, strerror(errno));
+
+		struct stat st;
+		if (fstat(fd, &st) != 0)
+		{
+			close(fd);
+			error("Could not stat '{}': {}", path, strerror(errno));
+		}
+		m_size = st.st_size;
+		m_data = m_size ? mmap(nullptr, m_size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE, fd, 0) : nullptr;
+		close(fd);
+		if (m_data == MAP_FAILED)
+			error("Could not map '{}': {}", path, strerror(errno));
+	}
+
+	~MappedFile()
+	{
+		if (m_data)
+			munmap(m_data, m_size);
+	}
+
+	char* data() const
+	{
+		return static_cast<char*>(m_data);
+	}
+
+	uint64_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	void* m_data;
+	uint64_t m_size;
+
+	SG_DELETE_COPY_AND_ASSIGN(MappedFile);
+};
+#endif
+
+BitseryDeserializer::BitseryDeserializer() : Deserializer(),
+	m_verify_checksums(true)
 {
 }
 
@@ -159,16 +371,84 @@ BitseryDeserializer::~BitseryDeserializer()
 
 std::shared_ptr<SGObject> BitseryDeserializer::read_object()
 {
-	InputStreamAdapter adapter { stream() };
-	BitseryDeser deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
-	return object_reader(deser, addressof(reader_visitor));
+	SG_TRACE_SCOPE("BitseryDeserializer::read_object");
+	return read_stream(stream(), nullptr, m_verify_checksums);
 }
 
 void BitseryDeserializer::read(std::shared_ptr<SGObject> _this)
 {
-	InputStreamAdapter adapter { stream() };
+	SG_TRACE_SCOPE("BitseryDeserializer::read");
+	read_stream(stream(), _this, m_verify_checksums);
+}
+
+void BitseryDeserializer::set_verify_checksums(bool verify)
+{
+	m_verify_checksums = verify;
+}
+
+std::shared_ptr<SGObject> BitseryDeserializer::read_mapped(
+	const std::string& path, bool verify_checksums)
+{
+	SG_TRACE_SCOPE("BitseryDeserializer::read_mapped");
+#ifndef _MSC_VER
+	auto file = make_shared<MappedFile>(path);
+	return read_memory(
+		file->data(), file->size(), file, nullptr, verify_checksums);
+#else
+	std::error_condition ec;
+	std::unique_ptr<io::RandomAccessFile> raf;
+	if ((ec = env()->new_random_access_file(path, &raf)))
+		throw to_system_error(ec);
+
+	return read_stream(make_shared<io::FileInputStream>(raf.get()), nullptr,
+		verify_checksums);
+#endif
+}
+
+std::shared_ptr<SGObject> BitseryDeserializer::read_memory(const char* data,
+	uint64_t size, std::shared_ptr<const void> owner,
+	std::shared_ptr<SGObject> _this, bool verify)
+{
+	uint64_t magic = 0;
+	if (size >= sizeof(magic))
+		sg_memcpy(&magic, data, sizeof(magic));
+	if (magic != detail::kSectionedMagic)
+		return read_stream(make_shared<ByteArrayInputStream>(data, size),
+			_this, verify);
+
+	// ByteArrayInputStream copies its buffer, so only hand it the header
+	uint64_t header_bytes = 4 * sizeof(uint64_t);
+	require(size >= header_bytes, "Stream of {} bytes is truncated", size);
+	{
+		InputStreamAdapter adapter { make_shared<ByteArrayInputStream>(data, header_bytes) };
+		BitseryDeser deser {std::move(adapter)};
+		uint64_t flags, num_sections;
+		deser.value8b(magic);
+		deser.value8b(flags);
+		deser.value8b(num_sections);
+		require(num_sections <= (size - header_bytes) / (3 * sizeof(uint64_t)),
+			"Stream of {} bytes is truncated", size);
+		header_bytes += 3 * sizeof(uint64_t) * num_sections;
+	}
+
+	InputStreamAdapter adapter { make_shared<ByteArrayInputStream>(data, header_bytes) };
 	BitseryDeser deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
-	object_reader(deser, addressof(reader_visitor), _this);
+	deser.value8b(magic);
+	auto layout = read_layout(deser);
+	require(layout.graph_bytes <= size - header_bytes,
+		"Stream of {} bytes is truncated", size);
+
+	vector<Section> sections;
+	for (const auto& entry : layout.table)
+	{
+		require(entry[0] <= size && entry[1] <= size - entry[0],
+			"Section at {} of {} bytes exceeds the stream of {} bytes",
+			entry[0], entry[1], size);
+		sections.push_back({const_cast<char*>(data) + entry[0], entry[1], owner});
+	}
+	if (verify)
+		verify_checksums(layout, sections);
+
+	return read_graph(data + layout.header_bytes(), layout.graph_bytes,
+		sections, _this);
 }
@@ -19,10 +19,56 @@ namespace shogun
 			std::shared_ptr<SGObject> read_object() override;
 			void read(std::shared_ptr<SGObject> _this) override;
 
+			/** read an object from a file, using the sections written by
+			 * BitserySerializer::set_section_threshold() in place.
+			 *
+			 * The file is mapped privately, so the large vectors and
+			 * matrices of the object are neither read nor copied until they
+			 * are accessed, and writing to them does not change the file.
+			 * The mapping lives as long as any of them. Files without
+			 * sections are read as by read_object().
+			 *
+			 * Verifying the checksums of the sections reads every page of
+			 * the file up front, which defeats the lazy loading, so it is
+			 * off by default here and independent of
+			 * set_verify_checksums().
+			 *
+			 * @param path local file
+			 * @param verify_checksums whether to verify the checksums of
+			 * the sections
+			 * @return the object
+			 */
+			std::shared_ptr<SGObject> read_mapped(
+				const std::string& path, bool verify_checksums = false);
+
+			/** whether read_object() and read() verify the checksums of
+			 * sections, true by default
+			 *
+			 * @param verify whether to verify checksums
+			 */
+			void set_verify_checksums(bool verify);
+
 			const char* get_name() const override
 			{
 				return "BitseryDeserializer";
 			}
+
+		private:
+			/** read an object from a memory region
+			 *
+			 * @param data memory
+			 * @param size bytes of memory
+			 * @param owner object keeping the memory alive, or nullptr if
+			 * the object must not reference the memory
+			 * @param _this object to read into, or nullptr
+			 * @param verify whether to verify the checksums of sections
+			 */
+			std::shared_ptr<SGObject> read_memory(const char* data,
+				uint64_t size, std::shared_ptr<const void> owner,
+				std::shared_ptr<SGObject> _this, bool verify);
+
+			/** whether to verify the checksums of sections */
+			bool m_verify_checksums;
 		};
 	}
 }
@@ -6,6 +6,8 @@
 #include <shogun/io/serialization/BitserySerializer.h>
 #include <shogun/io/serialization/BitseryVisitor.h>
 #include <shogun/io/ShogunErrc.h>
+#include <shogun/io/stream/ByteArrayOutputStream.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/util/converters.h>
 #include <shogun/util/system.h>
 
@@ -21,8 +23,29 @@ template<class Writer>
 class BitseryWriterVisitor : public detail::BitseryVisitor<Writer, BitseryWriterVisitor<Writer>>
 {
 public:
-	BitseryWriterVisitor(Writer& w):
-		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w) {}
+	BitseryWriterVisitor(Writer& w,
+		vector<pair<const void*, uint64_t>>* sections = nullptr,
+		size_t threshold = 0):
+		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w),
+		m_writer(w), m_sections(sections), m_threshold(threshold) {}
+
+	bool on_contiguous(ContiguousArray* array) override
+	{
+		// the plain format has no marker, elements are always inline
+		if (!m_sections)
+			return false;
+
+		uint64_t bytes = array->size() * array->element_size();
+		uint8_t out_of_line = bytes > 0 && bytes >= m_threshold;
+		m_writer.value1b(out_of_line);
+		if (!out_of_line)
+			return false;
+
+		SG_DEBUG("writing {} bytes to section {}", bytes, m_sections->size());
+		m_writer.value8b(static_cast<uint64_t>(m_sections->size()));
+		m_sections->emplace_back(array->data(), bytes);
+		return true;
+	}
 
 	void on_complex(Writer& writer, complex128_t* v)
 	{
@@ -68,6 +91,13 @@ public:
 			writer.value8b(detail::kNullObjectMagic);
 		}
 	}
+
+private:
+	Writer& m_writer;
+	/** elements written out-of-line, nullptr for the plain format */
+	vector<pair<const void*, uint64_t>>* m_sections;
+	/** minimal size of out-of-line elements */
+	size_t m_threshold;
 };
 
 struct OutputStreamAdapter
@@ -125,7 +155,8 @@ void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, const s
 using OutputAdapter = AdapterWriter<OutputStreamAdapter, bitsery::DefaultConfig>;
 using BitserySer = BasicSerializer<OutputAdapter>;
 
-BitserySerializer::BitserySerializer() : Serializer()
+BitserySerializer::BitserySerializer() : Serializer(),
+	m_section_threshold(0), m_section_checksums(true)
 {
 }
 
@@ -133,10 +164,86 @@ BitserySerializer::~BitserySerializer()
 {
 }
 
+void BitserySerializer::set_section_threshold(size_t bytes)
+{
+	m_section_threshold = bytes;
+}
+
+void BitserySerializer::set_section_checksums(bool checksums)
+{
+	m_section_checksums = checksums;
+}
+
 void BitserySerializer::write(const shared_ptr<SGObject>& object) noexcept(false)
 {
-	OutputStreamAdapter adapter { stream() };
- 	BitserySer serializer {std::move(adapter)};
- 	BitseryWriterVisitor<BitserySer> writer_visitor(serializer);
- 	write_object(serializer, addressof(writer_visitor), object);
+	SG_TRACE_SCOPE("BitserySerializer::write");
+	if (!m_section_threshold)
+	{
+		OutputStreamAdapter adapter { stream() };
+		BitserySer serializer {std::move(adapter)};
+		BitseryWriterVisitor<BitserySer> writer_visitor(serializer);
+		write_object(serializer, addressof(writer_visitor), object);
+		return;
+	}
+
+	// the graph is written first, as the layout of the sections depends on
+	// its size
+	vector<pair<const void*, uint64_t>> sections;
+	auto graph_stream = make_shared<ByteArrayOutputStream>();
+	{
+		OutputStreamAdapter adapter { graph_stream };
+		BitserySer serializer {std::move(adapter)};
+		BitseryWriterVisitor<BitserySer> writer_visitor(
+			serializer, addressof(sections), m_section_threshold);
+		write_object(serializer, addressof(writer_visitor), object);
+	}
+	auto graph = graph_stream->content();
+
+	vector<uint64_t> checksums(sections.size(), 0);
+	uint64_t flags = utils::is_big_endian() ? detail::kSectionBigEndian : 0;
+	if (m_section_checksums)
+	{
+		checksums = detail::section_checksums(sections);
+		flags |= detail::kSectionChecksums;
+	}
+
+	// header, section table, graph and the aligned sections
+	auto header_stream = make_shared<ByteArrayOutputStream>();
+	{
+		OutputStreamAdapter adapter { header_stream };
+		BitserySer serializer {std::move(adapter)};
+		serializer.value8b(detail::kSectionedMagic);
+		serializer.value8b(flags);
+		serializer.value8b(static_cast<uint64_t>(sections.size()));
+		serializer.value8b(static_cast<uint64_t>(graph.size()));
+
+		uint64_t offset = detail::align_section(
+			4 * sizeof(uint64_t) + 3 * sizeof(uint64_t) * sections.size() +
+			graph.size());
+		for (size_t i = 0; i < sections.size(); ++i)
+		{
+			serializer.value8b(offset);
+			serializer.value8b(sections[i].second);
+			serializer.value8b(checksums[i]);
+			offset = detail::align_section(offset + sections[i].second);
+		}
+	}
+	auto header = header_stream->content();
+
+	auto write_bytes = [this](const void* data, uint64_t bytes) {
+		if (auto ec = stream()->write(data, bytes))
+			throw io::to_system_error(ec);
+	};
+	const char padding[detail::kSectionAlignment] = {};
+	uint64_t written = header.size() + graph.size();
+	write_bytes(header.data(), header.size());
+	write_bytes(graph.data(), graph.size());
+	for (const auto& section : sections)
+	{
+		write_bytes(padding, detail::align_section(written) - written);
+		written = detail::align_section(written);
+		write_bytes(section.first, section.second);
+		written += section.second;
+	}
+	SG_DEBUG("wrote {} sections, {} bytes", sections.size(), written);
 }
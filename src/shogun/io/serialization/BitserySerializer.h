@@ -18,10 +18,34 @@ namespace shogun
 			~BitserySerializer() override;
 			virtual void write(const std::shared_ptr<SGObject>& object) noexcept(false);
 
+			/** write the elements of vectors and matrices of at least the
+			 * given size into sections behind the object graph, aligned
+			 * such that BitseryDeserializer can use them in place, e.g. in
+			 * a memory mapped file. 0 writes the plain format, which is the
+			 * default.
+			 *
+			 * @param bytes minimal size of out-of-line elements
+			 */
+			void set_section_threshold(size_t bytes);
+
+			/** whether to store checksums of the sections, which are
+			 * computed in parallel, true by default
+			 *
+			 * @param checksums whether to compute checksums
+			 */
+			void set_section_checksums(bool checksums);
+
 			virtual const char* get_name() const
 			{
 				return "BitserySerializer";
 			}
+
+		private:
+			/** minimal size of out-of-line elements, 0 for none */
+			size_t m_section_threshold;
+
+			/** whether to store checksums of the sections */
+			bool m_section_checksums;
 		};
 	}
 }
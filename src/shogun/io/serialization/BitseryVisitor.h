@@ -6,8 +6,12 @@
 #define __BITSERY_VISITOR__
 
 #include <shogun/lib/any.h>
+#include <shogun/lib/Hash.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace shogun
 {
 	namespace io
@@ -16,6 +20,71 @@ namespace shogun
 		{
 			static const size_t kNullObjectMagic = std::numeric_limits<size_t>::max();
 
+			/** first word of streams with out-of-line sections ("SGSECT01"),
+			 * plain streams start with the size of a pointer or
+			 * kNullObjectMagic
+			 */
+			static const uint64_t kSectionedMagic = 0x3130544345534753;
+			/** alignment of out-of-line sections within the stream */
+			static const uint64_t kSectionAlignment = 64;
+			/** header flag: sections have checksums */
+			static const uint64_t kSectionChecksums = 1;
+			/** header flag: sections are stored big endian */
+			static const uint64_t kSectionBigEndian = 2;
+			/** bytes per block of which checksums are computed in parallel */
+			static const uint64_t kChecksumBlockSize = 1 << 20;
+
+			/** @return offset rounded up to the section alignment */
+			inline uint64_t align_section(uint64_t offset)
+			{
+				return (offset + kSectionAlignment - 1) / kSectionAlignment *
+				       kSectionAlignment;
+			}
+
+			/** compute checksums of sections, with all blocks of all
+			 * sections hashed in parallel
+			 *
+			 * @param sections memory and bytes of each section
+			 * @return checksum of each section
+			 */
+			inline std::vector<uint64_t> section_checksums(
+			    const std::vector<std::pair<const void*, uint64_t>>& sections)
+			{
+				std::vector<std::pair<size_t, uint64_t>> blocks;
+				std::vector<size_t> first_block;
+				for (size_t i = 0; i < sections.size(); ++i)
+				{
+					first_block.push_back(blocks.size());
+					for (uint64_t offset = 0; offset < sections[i].second;
+					     offset += kChecksumBlockSize)
+						blocks.emplace_back(i, offset);
+				}
+				first_block.push_back(blocks.size());
+
+				std::vector<uint32_t> hashes(blocks.size());
+#pragma omp parallel for schedule(dynamic)
+				for (int64_t i = 0; i < (int64_t)blocks.size(); ++i)
+				{
+					const auto& section = sections[blocks[i].first];
+					auto offset = blocks[i].second;
+					hashes[i] = Hash::MurmurHash3(
+					    (uint8_t*)section.first + offset,
+					    std::min(kChecksumBlockSize, section.second - offset),
+					    0);
+				}
+
+				std::vector<uint64_t> checksums;
+				for (size_t i = 0; i < sections.size(); ++i)
+				{
+					auto num_blocks = first_block[i + 1] - first_block[i];
+					uint64_t hash = Hash::MurmurHash3(
+					    (uint8_t*)(hashes.data() + first_block[i]),
+					    num_blocks * sizeof(uint32_t), num_blocks);
+					checksums.push_back((sections[i].second << 32) ^ hash);
+				}
+				return checksums;
+			}
+
 			template <class S, class T>
 			class BitseryVisitor : public AnyVisitor
 			{
@@ -0,0 +1,308 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __STREAMING_HDF5FILE_H__
+#define __STREAMING_HDF5FILE_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_HDF5
+#include <shogun/io/streaming/StreamingFile.h>
+#include <shogun/io/HDF5File.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+
+#include <algorithm>
+#include <string>
+
+namespace shogun
+{
+/** @brief Class StreamingHDF5File is a derived class of StreamingFile which
+ * creates an input source for the online framework from a HDF5 dataset
+ * written by HDF5File::write_vectors() or HDF5File::write_sparse_vectors().
+ *
+ * Vectors are read in blocks, so only the chunks of the current block are
+ * held in memory and decompressed. Labels can be read from a second,
+ * 1-dimensional dataset of the same file.
+ *
+ * This kind of input is seekable, and hence can be used for
+ * making multiple passes over data.
+ */
+template<class T> class StreamingHDF5File : public StreamingFile
+{
+public:
+	/**
+	 * Default constructor
+	 */
+	StreamingHDF5File();
+
+	/**
+	 * Constructor
+	 *
+	 * @param fname filename to open
+	 * @param name name of the dense dataset or sparse group of vectors
+	 * @param labels_name name of the dataset of labels, optional
+	 * @param block_size number of vectors read at once
+	 */
+	StreamingHDF5File(const char* fname, const char* name,
+			const char* labels_name=NULL, int32_t block_size=1024);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~StreamingHDF5File();
+
+	/**
+	 * Read the next vector of a dense dataset
+	 *
+	 * @param vector vector, reallocated if shorter than the vector read
+	 * @param len length of vector, -1 at the end of the dataset
+	 */
+	virtual void get_vector(T*& vector, int32_t& len);
+
+	/**
+	 * Read the next vector of a dense dataset and its label
+	 *
+	 * @param vector vector, reallocated if shorter than the vector read
+	 * @param len length of vector, -1 at the end of the dataset
+	 * @param label label
+	 */
+	virtual void get_vector_and_label(T*& vector, int32_t& len, float64_t& label);
+
+	/**
+	 * Read the next vector of a sparse group
+	 *
+	 * @param vector entries, reallocated if fewer than the entries read
+	 * @param len number of entries, -1 at the end of the dataset
+	 */
+	virtual void get_sparse_vector(SGSparseVectorEntry<T>*& vector, int32_t& len);
+
+	/**
+	 * Read the next vector of a sparse group and its label
+	 *
+	 * @param vector entries, reallocated if fewer than the entries read
+	 * @param len number of entries, -1 at the end of the dataset
+	 * @param label label
+	 */
+	virtual void get_sparse_vector_and_label(SGSparseVectorEntry<T>*& vector,
+			int32_t& len, float64_t& label);
+
+	/** @return true, the dataset can be read again */
+	virtual bool is_seekable()
+	{
+		return true;
+	}
+
+	/**
+	 * Reset the stream so the next vector returned is the first vector of
+	 * the dataset.
+	 */
+	virtual void reset_stream()
+	{
+		vector_num=0;
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "StreamingHDF5File";
+	}
+
+private:
+	/**
+	 * Initialize members to defaults
+	 */
+	void init();
+
+	/**
+	 * Make the block containing vector_num the current block
+	 *
+	 * @return false at the end of the dataset
+	 */
+	bool load_block();
+
+protected:
+	/// file to read from
+	std::shared_ptr<HDF5File> file;
+
+	/// name of the vectors
+	std::string features_name;
+
+	/// name of the labels, empty if there are none
+	std::string labels_name;
+
+	/// whether the vectors are a sparse group
+	bool sparse;
+
+	/// number of vectors in the file
+	index_t num_vectors;
+
+	/// number of vectors read at once
+	index_t block_size;
+
+	/// index of vector to be returned next
+	index_t vector_num;
+
+	/// index of the first vector of the current block
+	index_t block_begin;
+
+	/// one past the last vector of the current block
+	index_t block_end;
+
+	/// vectors of the current block, if dense
+	SGMatrix<T> block;
+
+	/// vectors of the current block, if sparse
+	SGSparseMatrix<T> sparse_block;
+
+	/// labels of the current block
+	SGVector<float64_t> block_labels;
+};
+
+template<class T>
+StreamingHDF5File<T>::StreamingHDF5File() : StreamingFile()
+{
+	init();
+}
+
+template<class T>
+StreamingHDF5File<T>::StreamingHDF5File(const char* fname, const char* name,
+		const char* labels_name, int32_t block_size) : StreamingHDF5File()
+{
+	require(block_size>0, "{}: block size must be positive, got {}",
+			get_name(), block_size);
+
+	file=std::make_shared<HDF5File>(const_cast<char*>(fname), 'r', name);
+	features_name=name;
+	if (labels_name)
+		this->labels_name=labels_name;
+	this->block_size=block_size;
+
+	sparse=file->is_sparse();
+	num_vectors=file->get_num_vectors();
+	if (labels_name)
+	{
+		file->set_variable_name(labels_name);
+		require(file->get_num_vectors()==num_vectors,
+				"{}: {} labels for {} vectors", get_name(),
+				file->get_num_vectors(), num_vectors);
+	}
+}
+
+template<class T>
+StreamingHDF5File<T>::~StreamingHDF5File()
+{
+}
+
+template<class T>
+void StreamingHDF5File<T>::init()
+{
+	file=NULL;
+	sparse=false;
+	num_vectors=0;
+	block_size=1024;
+	vector_num=0;
+	block_begin=0;
+	block_end=0;
+
+	set_generic<T>();
+}
+
+template<class T>
+bool StreamingHDF5File<T>::load_block()
+{
+	if (vector_num>=num_vectors)
+		return false;
+	if (vector_num>=block_begin && vector_num<block_end)
+		return true;
+
+	block_begin=vector_num;
+	block_end=std::min(vector_num+block_size, num_vectors);
+
+	file->set_variable_name(features_name.c_str());
+	if (sparse)
+		sparse_block=file->read_sparse_vectors<T>(block_begin, block_end);
+	else
+		block=file->read_vectors<T>(block_begin, block_end);
+
+	if (!labels_name.empty())
+	{
+		file->set_variable_name(labels_name.c_str());
+		block_labels=SGVector<float64_t>(
+			file->read_vectors<float64_t>(block_begin, block_end));
+	}
+	return true;
+}
+
+template<class T>
+void StreamingHDF5File<T>::get_vector(T*& vector, int32_t& num_feat)
+{
+	require(!sparse, "{}: '{}' holds sparse vectors", get_name(),
+			features_name);
+
+	if (!load_block())
+	{
+		vector=NULL;
+		num_feat=-1;
+		return;
+	}
+
+	int32_t old_len=num_feat;
+	num_feat=block.num_rows;
+	if (old_len<num_feat)
+		vector=SG_REALLOC(T, vector, old_len, num_feat);
+	sg_memcpy(vector, block.get_column_vector(vector_num-block_begin),
+			num_feat*sizeof(T));
+	vector_num++;
+}
+
+template<class T>
+void StreamingHDF5File<T>::get_vector_and_label(T*& vector,
+		int32_t& num_feat, float64_t& label)
+{
+	require(!labels_name.empty(), "{}: no labels given", get_name());
+
+	if (load_block())
+		label=block_labels[vector_num-block_begin];
+	get_vector(vector, num_feat);
+}
+
+template<class T>
+void StreamingHDF5File<T>::get_sparse_vector(SGSparseVectorEntry<T>*& vector,
+		int32_t& len)
+{
+	require(sparse, "{}: '{}' holds dense vectors", get_name(),
+			features_name);
+
+	if (!load_block())
+	{
+		vector=NULL;
+		len=-1;
+		return;
+	}
+
+	const auto& sparse_vector=sparse_block[vector_num-block_begin];
+	int32_t old_len=len;
+	len=sparse_vector.num_feat_entries;
+	if (old_len<len)
+		vector=SG_REALLOC(SGSparseVectorEntry<T>, vector, old_len, len);
+	sg_memcpy(vector, sparse_vector.features,
+			len*sizeof(SGSparseVectorEntry<T>));
+	vector_num++;
+}
+
+template<class T>
+void StreamingHDF5File<T>::get_sparse_vector_and_label(
+		SGSparseVectorEntry<T>*& vector, int32_t& len, float64_t& label)
+{
+	require(!labels_name.empty(), "{}: no labels given", get_name());
+
+	if (load_block())
+		label=block_labels[vector_num-block_begin];
+	get_sparse_vector(vector, len);
+}
+}
+#endif // HAVE_HDF5
+#endif //__STREAMING_HDF5FILE_H__
@@ -8,11 +8,13 @@
  *          Soumyajitde De, Evangelos Anagnostopoulos
  */
 
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/base/progress.h>
 #include <shogun/io/File.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
 
@@ -285,6 +287,7 @@ void Kernel::get_kernel_row(
 // Fills cache for the row m
 void Kernel::cache_kernel_row(int32_t m)
 {
+	SG_TRACE_SCOPE("Kernel::cache_kernel_row");
 	int32_t j,k,l;
 	KERNELCACHE_ELEM *cache;
 
@@ -359,6 +362,8 @@ void* Kernel::cache_multiple_kernel_row_helper(void* p)
 // Fills cache for the rows in key
 void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 {
+	SG_TRACE_NAMED_SCOPE(trace, "Kernel::cache_multiple_kernel_rows");
+	trace.set_counter(num_rows);
 	int32_t nthreads=env()->get_num_threads();
 
 	if (nthreads<2)
@@ -1004,22 +1009,22 @@ float64_t Kernel::sum_symmetric_block(index_t block_begin, index_t block_size,
 			"Please use smaller blocks!", block_size, block_begin, block_begin);
 	require(block_size>=1, "Invalid block size ({})!", block_size);
 
-	float64_t sum=0.0;
+	auto scheduler=env()->scheduler();
+	auto plus=[](float64_t a, float64_t b) { return a+b; };
 
 	// since the block is symmetric with main diagonal inside, we can save half
 	// the computation with using only the upper triangular part.
 	// this can be done in parallel
-	#pragma omp parallel for reduction(+:sum)
-	for (index_t i=0; i<block_size; ++i)
-	{
-		// compute the kernel values on the upper triangular part of the kernel
-		// matrix and compute sum on the fly
-		for (index_t j=i+1; j<block_size; ++j)
+	float64_t sum=scheduler->parallel_reduce(0, block_size, 0.0,
+		[&](index_t i)
 		{
-			float64_t k=kernel(i+block_begin, j+block_begin);
-			sum+=k;
-		}
-	}
+			// compute the kernel values on the upper triangular part of the
+			// kernel matrix and compute sum on the fly
+			float64_t row_sum=0.0;
+			for (index_t j=i+1; j<block_size; ++j)
+				row_sum+=kernel(i+block_begin, j+block_begin);
+			return row_sum;
+		}, plus);
 
 	// the actual sum would be twice of what we computed
 	sum*=2;
@@ -1028,12 +1033,9 @@ float64_t Kernel::sum_symmetric_block(index_t block_begin, index_t block_size,
 	// outside of the loop to save cycles
 	if (!no_diag)
 	{
-		#pragma omp parallel for reduction(+:sum)
-		for (index_t i=0; i<block_size; ++i)
-		{
-			float64_t diag=kernel(i+block_begin, i+block_begin);
-			sum+=diag;
-		}
+		sum+=scheduler->parallel_reduce(0, block_size, 0.0,
+			[&](index_t i) { return kernel(i+block_begin, i+block_begin); },
+			plus);
 	}
 
 	SG_TRACE("Leaving");
@@ -1066,20 +1068,20 @@ float64_t Kernel::sum_block(index_t block_begin_row, index_t block_begin_col,
 		no_diag=false;
 	}
 
-	float64_t sum=0.0;
-
 	// this can be done in parallel for the rows/cols
-	#pragma omp parallel for reduction(+:sum)
-	for (index_t i=0; i<block_size_row; ++i)
-	{
-		// compute the kernel values and compute sum on the fly
-		for (index_t j=0; j<block_size_col; ++j)
+	float64_t sum=env()->scheduler()->parallel_reduce(0, block_size_row, 0.0,
+		[&](index_t i)
 		{
-			float64_t k=no_diag && i==j ? 0 :
-				kernel(i+block_begin_row, j+block_begin_col);
-			sum+=k;
-		}
-	}
+			// compute the kernel values and compute sum on the fly
+			float64_t row_sum=0.0;
+			for (index_t j=0; j<block_size_col; ++j)
+			{
+				float64_t k=no_diag && i==j ? 0 :
+					kernel(i+block_begin_row, j+block_begin_col);
+				row_sum+=k;
+			}
+			return row_sum;
+		}, [](float64_t a, float64_t b) { return a+b; });
 
 	SG_TRACE("Leaving");
 
@@ -1306,6 +1308,7 @@ template <class T> void* Kernel::get_kernel_matrix_helper(void* p)
 template <class T>
 SGMatrix<T> Kernel::get_kernel_matrix()
 {
+	SG_TRACE_SCOPE("Kernel::get_kernel_matrix");
 	T* result = NULL;
 
 	require(has_features(), "no features assigned to kernel");
@@ -1322,41 +1325,23 @@ SGMatrix<T> Kernel::get_kernel_matrix()
 
 	result=SG_MALLOC(T, total_num);
 
-	int32_t num_threads=env()->get_num_threads();
-	K_THREAD_PARAM<T> params;
-	int64_t step = total_num/num_threads;
-	index_t t = 0;
 	auto pb = SG_PROGRESS(range(total_num));
-#pragma omp parallel for lastprivate(t) private(params)
-	for (t = 0; t < num_threads; ++t)
+	// one task per row balances the triangular work of symmetric matrices
+	env()->scheduler()->parallel_for(0, m, [&](index_t i)
 	{
+		K_THREAD_PARAM<T> params;
 		params.kernel = this;
 		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = compute_row_start((t+1)*step, n, symmetric);
-		params.total_start=t*step;
+		params.start = i;
+		params.end = i + 1;
+		params.total_start = 0;
 		params.n=n;
 		params.m=m;
 		params.symmetric=symmetric;
 		params.verbose=false;
 		params.pb = &pb;
 		Kernel::get_kernel_matrix_helper<T>((void*)&params);
-	}
-
-	if (total_num % num_threads != 0)
-	{
-		params.kernel = this;
-		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = m;
-		params.total_start=t*step;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=false;
-		params.pb = &pb;
-		Kernel::get_kernel_matrix_helper<T>((void*)&params);
-	}
+	}, 1);
 
 	pb.complete();
 
@@ -0,0 +1,289 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/Allocator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace shogun;
+
+namespace
+{
+/** innermost scope of the current thread */
+thread_local ScopedAllocator* innermost_scope = nullptr;
+
+/** @return ptr rounded up to a multiple of the alignment */
+char* align_up(char* ptr, size_t alignment)
+{
+	auto address = reinterpret_cast<uintptr_t>(ptr);
+	return ptr + ((alignment - address % alignment) % alignment);
+}
+
+/** @return size stored in front of an arena block */
+size_t& block_header(const void* ptr)
+{
+	return *reinterpret_cast<size_t*>(
+	    const_cast<char*>(static_cast<const char*>(ptr)) - sizeof(size_t));
+}
+}
+
+ScopedAllocator::ScopedAllocator(MemoryAllocator& allocator)
+    : m_allocator(&allocator), m_previous(innermost_scope)
+{
+	innermost_scope = this;
+}
+
+ScopedAllocator::ScopedAllocator(MemoryAllocator* allocator)
+    : m_allocator(allocator), m_previous(innermost_scope)
+{
+	innermost_scope = this;
+}
+
+ScopedAllocator::~ScopedAllocator()
+{
+	innermost_scope = m_previous;
+}
+
+MemoryAllocator* ScopedAllocator::current()
+{
+	return innermost_scope ? innermost_scope->m_allocator : nullptr;
+}
+
+MemoryAllocator* ScopedAllocator::owner(const void* ptr)
+{
+	for (auto scope = innermost_scope; scope; scope = scope->m_previous)
+	{
+		if (scope->m_allocator && scope->m_allocator->owns(ptr))
+			return scope->m_allocator;
+	}
+	return nullptr;
+}
+
+MemoryArena::MemoryArena(size_t chunk_size, size_t alignment)
+    : m_chunk_size(chunk_size),
+      m_alignment(std::max<size_t>(alignment, alignof(std::max_align_t))),
+      m_current(0), m_top(nullptr), m_last(nullptr), m_bytes_used(0)
+{
+}
+
+MemoryArena::~MemoryArena()
+{
+	for (auto& chunk : m_chunks)
+		std::free(chunk.begin);
+}
+
+void* MemoryArena::bump(size_t size, size_t alignment)
+{
+	for (; m_current < m_chunks.size(); m_current++)
+	{
+		if (!m_top)
+			m_top = m_chunks[m_current].begin;
+
+		char* block = align_up(m_top + sizeof(size_t), alignment);
+		if (block + size <= m_chunks[m_current].end)
+		{
+			block_header(block) = size;
+			m_top = block + size;
+			m_last = block;
+			m_bytes_used += size;
+			return block;
+		}
+		m_top = nullptr;
+	}
+	return nullptr;
+}
+
+void* MemoryArena::allocate(size_t size, size_t alignment)
+{
+	alignment = std::max(alignment, m_alignment);
+	if (auto block = bump(size, alignment))
+		return block;
+
+	// none of the chunks has space left, blocks larger than a chunk get a
+	// chunk of their own
+	auto chunk_size =
+	    std::max(m_chunk_size, size + sizeof(size_t) + alignment);
+	auto memory = static_cast<char*>(std::malloc(chunk_size));
+	if (!memory)
+		return nullptr;
+
+	m_chunks.push_back({memory, memory + chunk_size});
+	m_current = m_chunks.size() - 1;
+	m_top = nullptr;
+	return bump(size, alignment);
+}
+
+void MemoryArena::deallocate(void* ptr)
+{
+	// only the most recent block can be given back
+	if (ptr != m_last)
+		return;
+
+	m_bytes_used -= block_header(ptr);
+	m_top = m_last - sizeof(size_t);
+	m_last = nullptr;
+}
+
+void* MemoryArena::reallocate(void* ptr, size_t size)
+{
+	auto old_size = block_header(ptr);
+	if (ptr == m_last && m_last + size <= m_chunks[m_current].end)
+	{
+		block_header(ptr) = size;
+		m_top = m_last + size;
+		m_bytes_used += size;
+		m_bytes_used -= old_size;
+		return ptr;
+	}
+	if (size <= old_size)
+	{
+		block_header(ptr) = size;
+		return ptr;
+	}
+
+	auto block = allocate(size, m_alignment);
+	if (block)
+		sg_memcpy(block, ptr, old_size);
+	return block;
+}
+
+bool MemoryArena::owns(const void* ptr) const
+{
+	auto address = static_cast<const char*>(ptr);
+	return std::any_of(m_chunks.begin(), m_chunks.end(), [&](const Chunk& c) {
+		return address >= c.begin && address < c.end;
+	});
+}
+
+size_t MemoryArena::get_size(const void* ptr) const
+{
+	return block_header(ptr);
+}
+
+void MemoryArena::reset()
+{
+	m_current = 0;
+	m_top = nullptr;
+	m_last = nullptr;
+	m_bytes_used = 0;
+}
+
+size_t MemoryArena::get_bytes_reserved() const
+{
+	size_t bytes = 0;
+	for (const auto& chunk : m_chunks)
+		bytes += chunk.end - chunk.begin;
+	return bytes;
+}
+
+size_t MemoryArena::get_bytes_used() const
+{
+	return m_bytes_used;
+}
+
+PoolAllocator::PoolAllocator(size_t alignment)
+    : m_alignment(std::max<size_t>(alignment, alignof(std::max_align_t))),
+      m_num_reused(0), m_num_fresh(0)
+{
+	m_free_lists.fill(nullptr);
+	m_bump_top.fill(nullptr);
+	m_bump_end.fill(nullptr);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	for (auto memory : m_memory)
+		std::free(memory);
+}
+
+void* PoolAllocator::allocate(size_t size, size_t alignment)
+{
+	// blocks are aligned to their size, as chunks are aligned to the largest
+	// block size
+	size = std::max({size, alignment, m_alignment});
+	if (size > block_size(num_size_classes - 1))
+		return nullptr;
+
+	int32_t size_class = 0;
+	while (block_size(size_class) < size)
+		size_class++;
+
+	if (auto block = m_free_lists[size_class])
+	{
+		m_free_lists[size_class] = *static_cast<void**>(block);
+		m_num_reused++;
+		return block;
+	}
+
+	if (m_bump_top[size_class] == m_bump_end[size_class])
+	{
+		const size_t largest_block = block_size(num_size_classes - 1);
+		auto memory =
+		    static_cast<char*>(std::malloc(chunk_size + largest_block));
+		if (!memory)
+			return nullptr;
+		m_memory.push_back(memory);
+
+		char* begin = align_up(memory, largest_block);
+		m_chunks[begin] = std::make_pair(begin + chunk_size, size_class);
+		m_bump_top[size_class] = begin;
+		m_bump_end[size_class] = begin + chunk_size;
+	}
+
+	auto block = m_bump_top[size_class];
+	m_bump_top[size_class] += block_size(size_class);
+	m_num_fresh++;
+	return block;
+}
+
+void PoolAllocator::deallocate(void* ptr)
+{
+	auto size_class = size_class_of(ptr);
+	*static_cast<void**>(ptr) = m_free_lists[size_class];
+	m_free_lists[size_class] = ptr;
+}
+
+void* PoolAllocator::reallocate(void* ptr, size_t size)
+{
+	auto old_size = block_size(size_class_of(ptr));
+	if (size <= old_size)
+		return ptr;
+
+	auto block = allocate(size, m_alignment);
+	if (block)
+	{
+		sg_memcpy(block, ptr, old_size);
+		deallocate(ptr);
+	}
+	return block;
+}
+
+bool PoolAllocator::owns(const void* ptr) const
+{
+	return size_class_of(ptr) >= 0;
+}
+
+size_t PoolAllocator::get_size(const void* ptr) const
+{
+	return block_size(size_class_of(ptr));
+}
+
+int32_t PoolAllocator::size_class_of(const void* ptr) const
+{
+	auto address = static_cast<const char*>(ptr);
+	auto it = m_chunks.upper_bound(address);
+	if (it == m_chunks.begin())
+		return -1;
+
+	--it;
+	return address < it->second.first ? it->second.second : -1;
+}
+
+PoolAllocator& PoolAllocator::thread_pool()
+{
+	static thread_local PoolAllocator pool;
+	return pool;
+}
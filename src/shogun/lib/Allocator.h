@@ -0,0 +1,313 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __ALLOCATOR_H__
+#define __ALLOCATOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/memory.h>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Interface of allocators that can serve SG_MALLOC, SG_CALLOC,
+ * SG_REALLOC, SG_ALIGNED_MALLOC and SG_FREE.
+ *
+ * An allocator is used on a thread while a ScopedAllocator is alive.
+ * During that time, all new allocations of that thread go to the allocator,
+ * and SG_FREE and SG_REALLOC check with owns() which memory belongs to it.
+ * Memory from the system allocator is handled as before, so containers that
+ * existed before the scope can still be resized and freed.
+ *
+ * Memory allocated from an allocator must be freed on the same thread while
+ * the allocator is installed, or never. It must not escape the scope, e.g.
+ * into members of objects that outlive it. Allocators are thus meant for
+ * temporaries of hot loops.
+ */
+class MemoryAllocator
+{
+public:
+	virtual ~MemoryAllocator()
+	{
+	}
+
+	/** allocate memory
+	 *
+	 * @param size number of bytes
+	 * @param alignment minimal alignment, a power of two
+	 * @return memory, or nullptr to let the system allocator serve the
+	 * request
+	 */
+	virtual void* allocate(size_t size, size_t alignment) = 0;
+
+	/** free memory of this allocator
+	 *
+	 * @param ptr memory with owns(ptr)
+	 */
+	virtual void deallocate(void* ptr) = 0;
+
+	/** resize memory of this allocator, keeping its content
+	 *
+	 * @param ptr memory with owns(ptr)
+	 * @param size new number of bytes
+	 * @return resized memory, or nullptr if the allocator cannot grow it,
+	 * in which case the caller moves the content to the system allocator and
+	 * deallocates ptr
+	 */
+	virtual void* reallocate(void* ptr, size_t size) = 0;
+
+	/** @return whether the memory was allocated by this allocator */
+	virtual bool owns(const void* ptr) const = 0;
+
+	/** @return usable number of bytes of memory with owns(ptr) */
+	virtual size_t get_size(const void* ptr) const = 0;
+
+	/** @return name of the allocator */
+	virtual const char* get_name() const = 0;
+};
+
+/** @brief Installs an allocator on the current thread for the lifetime of
+ * the object.
+ *
+ * Scopes nest: allocations go to the innermost allocator, while memory of
+ * all installed allocators can be freed.
+ *
+ * \code
+ * MemoryArena arena;
+ * for (auto i : range(n))
+ * {
+ *     arena.reset();
+ *     ScopedAllocator scope(arena);
+ *     SGVector<float64_t> temp(m); // from the arena
+ *     ...
+ * }
+ * \endcode
+ */
+class ScopedAllocator
+{
+public:
+	/** constructor
+	 *
+	 * @param allocator allocator to install, must outlive the scope
+	 */
+	explicit ScopedAllocator(MemoryAllocator& allocator);
+
+	/** constructor
+	 *
+	 * @param allocator allocator to install, must outlive the scope, or
+	 * nullptr to serve new allocations from the system allocator again
+	 * until the scope ends
+	 */
+	explicit ScopedAllocator(MemoryAllocator* allocator);
+
+	/** destructor, restores the previously installed allocator */
+	~ScopedAllocator();
+
+	ScopedAllocator(const ScopedAllocator&) = delete;
+	ScopedAllocator& operator=(const ScopedAllocator&) = delete;
+
+	/** @return innermost allocator installed on this thread, or nullptr */
+	static MemoryAllocator* current();
+
+	/** @return allocator installed on this thread that owns the memory,
+	 * or nullptr if the memory is from the system allocator
+	 */
+	static MemoryAllocator* owner(const void* ptr);
+
+private:
+	/** installed allocator, nullptr for the system allocator */
+	MemoryAllocator* m_allocator;
+
+	/** enclosing scope on this thread */
+	ScopedAllocator* m_previous;
+};
+
+/** @brief Allocator that hands out memory from large chunks by increasing a
+ * pointer.
+ *
+ * Freeing single blocks does nothing (except for the last one), all memory
+ * is recycled at once by reset(). This makes allocation a few instructions
+ * and suits temporaries that are created and dropped in every iteration of
+ * a loop.
+ */
+class MemoryArena : public MemoryAllocator
+{
+public:
+	/** constructor
+	 *
+	 * @param chunk_size bytes per chunk, larger blocks get their own chunk
+	 * @param alignment alignment of all blocks, e.g. 64 for SIMD
+	 */
+	MemoryArena(
+	    size_t chunk_size = 1 << 20,
+	    size_t alignment = alignment::container_alignment);
+
+	/** destructor, releases all chunks */
+	virtual ~MemoryArena();
+
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	virtual void* allocate(size_t size, size_t alignment);
+	virtual void deallocate(void* ptr);
+	virtual void* reallocate(void* ptr, size_t size);
+	virtual bool owns(const void* ptr) const;
+	virtual size_t get_size(const void* ptr) const;
+
+	/** recycle all memory, which invalidates all blocks */
+	void reset();
+
+	/** @return bytes of all chunks */
+	size_t get_bytes_reserved() const;
+
+	/** @return bytes handed out since the last reset */
+	size_t get_bytes_used() const;
+
+	virtual const char* get_name() const
+	{
+		return "MemoryArena";
+	}
+
+private:
+	/** memory chunk */
+	struct Chunk
+	{
+		/** first byte */
+		char* begin;
+
+		/** one past the last byte */
+		char* end;
+	};
+
+	/** @return block of the given size and alignment in the current or a
+	 * following chunk, or nullptr
+	 */
+	void* bump(size_t size, size_t alignment);
+
+private:
+	/** bytes per chunk */
+	size_t m_chunk_size;
+
+	/** alignment of all blocks */
+	size_t m_alignment;
+
+	/** chunks, in order of use */
+	std::vector<Chunk> m_chunks;
+
+	/** index of the chunk blocks are taken from */
+	size_t m_current;
+
+	/** first free byte of the current chunk */
+	char* m_top;
+
+	/** most recent block, which can be freed or grown in place */
+	char* m_last;
+
+	/** bytes handed out since the last reset */
+	size_t m_bytes_used;
+};
+
+/** @brief Allocator with free lists of blocks of power-of-two size classes
+ * (16 bytes to 4 KiB).
+ *
+ * Freed blocks are reused by later allocations of the same class without
+ * going to the system allocator. Larger requests are left to the system
+ * allocator. The pool is not thread-safe; every thread can get its own with
+ * thread_pool().
+ */
+class PoolAllocator : public MemoryAllocator
+{
+public:
+	/** constructor
+	 *
+	 * @param alignment alignment of all blocks, e.g. 64 for SIMD
+	 */
+	PoolAllocator(size_t alignment = alignment::container_alignment);
+
+	/** destructor, releases all chunks */
+	virtual ~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator&) = delete;
+	PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+	virtual void* allocate(size_t size, size_t alignment);
+	virtual void deallocate(void* ptr);
+	virtual void* reallocate(void* ptr, size_t size);
+	virtual bool owns(const void* ptr) const;
+	virtual size_t get_size(const void* ptr) const;
+
+	/** @return number of allocations served by a freed block */
+	int64_t get_num_reused() const
+	{
+		return m_num_reused;
+	}
+
+	/** @return number of allocations served by a never used block */
+	int64_t get_num_fresh() const
+	{
+		return m_num_fresh;
+	}
+
+	/** @return pool of the current thread, released at thread exit */
+	static PoolAllocator& thread_pool();
+
+	virtual const char* get_name() const
+	{
+		return "PoolAllocator";
+	}
+
+	/** number of size classes */
+	static constexpr int32_t num_size_classes = 9;
+
+	/** smallest block size */
+	static constexpr size_t min_block_size = 16;
+
+	/** bytes per chunk that is split into blocks */
+	static constexpr size_t chunk_size = 64 * 1024;
+
+private:
+	/** @return size class of the memory, or -1 if not owned */
+	int32_t size_class_of(const void* ptr) const;
+
+	/** @return block size of a size class */
+	static size_t block_size(int32_t size_class)
+	{
+		return min_block_size << size_class;
+	}
+
+private:
+	/** alignment of all blocks */
+	size_t m_alignment;
+
+	/** first free block of every size class, linked through the blocks */
+	std::array<void*, num_size_classes> m_free_lists;
+
+	/** first never used block in the latest chunk of every size class */
+	std::array<char*, num_size_classes> m_bump_top;
+
+	/** end of the latest chunk of every size class */
+	std::array<char*, num_size_classes> m_bump_end;
+
+	/** chunks by their first byte, with their end and size class */
+	std::map<const char*, std::pair<const char*, int32_t>> m_chunks;
+
+	/** memory of the chunks, to release it */
+	std::vector<void*> m_memory;
+
+	/** number of allocations served by a freed block */
+	int64_t m_num_reused;
+
+	/** number of allocations served by a never used block */
+	int64_t m_num_fresh;
+};
+}
+
+#endif // __ALLOCATOR_H__
@@ -0,0 +1,158 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __BOUNDED_QUEUE_H__
+#define __BOUNDED_QUEUE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/macros.h>
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace shogun
+{
+
+/** @brief Lock-free queue of fixed capacity for several producers and
+ * consumers.
+ *
+ * try_push() and try_pop() never block: they fail when the queue is full or
+ * empty. Each slot carries a sequence number that tells producers and
+ * consumers whether it is free or filled for their turn (D. Vyukov's
+ * bounded MPMC queue).
+ */
+template <class T>
+class BoundedQueue
+{
+public:
+	/** constructor
+	 *
+	 * @param capacity minimal number of elements, rounded up to a power
+	 * of two
+	 */
+	explicit BoundedQueue(size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity)
+			size *= 2;
+
+		m_mask = size - 1;
+		m_cells.reset(new Cell[size]);
+		for (size_t i = 0; i < size; ++i)
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		m_tail.store(0, std::memory_order_relaxed);
+		m_head.store(0, std::memory_order_relaxed);
+	}
+
+	/** add an element unless the queue is full
+	 *
+	 * @param value element, moved from on success only
+	 * @return whether the element was added
+	 */
+	bool try_push(T&& value)
+	{
+		Cell* cell;
+		auto pos = m_tail.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &m_cells[pos & m_mask];
+			auto seq = cell->sequence.load(std::memory_order_acquire);
+			auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (m_tail.compare_exchange_weak(
+				        pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = m_tail.load(std::memory_order_relaxed);
+		}
+
+		cell->value = std::move(value);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** add a copy of an element unless the queue is full */
+	bool try_push(const T& value)
+	{
+		T copy(value);
+		return try_push(std::move(copy));
+	}
+
+	/** remove the oldest element unless the queue is empty
+	 *
+	 * @param value element removed
+	 * @return whether an element was removed
+	 */
+	bool try_pop(T& value)
+	{
+		Cell* cell;
+		auto pos = m_head.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &m_cells[pos & m_mask];
+			auto seq = cell->sequence.load(std::memory_order_acquire);
+			auto diff =
+			    static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+			if (diff == 0)
+			{
+				if (m_head.compare_exchange_weak(
+				        pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+				return false;
+			else
+				pos = m_head.load(std::memory_order_relaxed);
+		}
+
+		value = std::move(cell->value);
+		// release what the element holds now rather than on reuse of the slot
+		cell->value = T();
+		cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** @return number of elements the queue holds at most */
+	size_t capacity() const
+	{
+		return m_mask + 1;
+	}
+
+	/** @return approximate number of elements, exact if no thread is
+	 * pushing or popping
+	 */
+	size_t size() const
+	{
+		auto tail = m_tail.load(std::memory_order_acquire);
+		auto head = m_head.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	size_t m_mask;
+	/** next position to push, on a cache line of its own */
+	alignas(64) std::atomic<size_t> m_tail;
+	/** next position to pop, on a cache line of its own */
+	alignas(64) std::atomic<size_t> m_head;
+
+	SG_DELETE_COPY_AND_ASSIGN(BoundedQueue);
+};
+}
+
+#endif // __BOUNDED_QUEUE_H__
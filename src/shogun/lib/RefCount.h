@@ -4,11 +4,15 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/common.h>
 #include <atomic>
+#include <memory>
 
 namespace shogun
 {
 /** brief This class implements a thread-safe counter used for
  * reference counting.
+ *
+ * Within a SingleThreadedRefCountScope, the counter is updated with plain
+ * loads and stores instead of atomic read-modify-write operations.
  */
 class RefCount
 {
@@ -16,8 +20,20 @@ public:
 	/** Constructor
 	 *
 	 * @param ref_start starting value for counter
+	 * @param embedded whether the counter lives in the memory block of the
+	 * counted data, and is thus released with it
 	 */
-	RefCount(int32_t ref_start=0) : rc(ref_start) {};
+	RefCount(int32_t ref_start=0, bool embedded=false)
+		: rc(ref_start), m_embedded(embedded) {};
+
+	/** Constructor for counting references to memory of another object,
+	 * e.g. a memory mapped file
+	 *
+	 * @param owner object that keeps the counted data alive, released
+	 * along with the counter
+	 */
+	RefCount(std::shared_ptr<const void> owner)
+		: rc(0), m_embedded(false), m_owner(std::move(owner)) {};
 
 	/** Increase ref count
 	 *
@@ -25,6 +41,12 @@ public:
 	 */
 	SG_FORCED_INLINE int32_t ref()
 	{
+		if (single_threaded_scopes)
+		{
+			int32_t c = rc.load(std::memory_order_relaxed)+1;
+			rc.store(c, std::memory_order_relaxed);
+			return c;
+		}
 		return rc.fetch_add(1, std::memory_order_relaxed)+1;
 	}
 
@@ -34,6 +56,12 @@ public:
 	 */
 	SG_FORCED_INLINE int32_t unref()
 	{
+		if (single_threaded_scopes)
+		{
+			int32_t c = rc.load(std::memory_order_relaxed)-1;
+			rc.store(c, std::memory_order_relaxed);
+			return c;
+		}
 		return rc.fetch_sub(1, std::memory_order_acquire)-1;
 	}
 
@@ -46,9 +74,58 @@ public:
 		return rc.load(std::memory_order_acquire);
 	}
 
+	/** @return whether the counter is released with the counted data */
+	SG_FORCED_INLINE bool is_embedded() const
+	{
+		return m_embedded;
+	}
+
+	/** @return whether the counted data is owned by another object */
+	SG_FORCED_INLINE bool has_owner() const
+	{
+		return m_owner != nullptr;
+	}
+
 private:
+	friend class SingleThreadedRefCountScope;
+
 	/** reference count */
     std::atomic<int32_t> rc;
+
+	/** whether the counter is released with the counted data */
+	bool m_embedded;
+
+	/** object owning the counted data, if it is not allocated by shogun */
+	std::shared_ptr<const void> m_owner;
+
+	/** number of single threaded scopes alive on this thread */
+	static inline thread_local int32_t single_threaded_scopes = 0;
+};
+
+/** @brief Makes reference counting on the current thread non-atomic for the
+ * lifetime of the object.
+ *
+ * Copying SGVector and SGMatrix then costs no atomic operation. This is
+ * only correct if no other thread copies or destroys containers that share
+ * data with the ones used in the scope while it is alive, e.g. in an OpenMP
+ * region started within it. Scopes nest.
+ */
+class SingleThreadedRefCountScope
+{
+public:
+	SingleThreadedRefCountScope()
+	{
+		RefCount::single_threaded_scopes++;
+	}
+
+	~SingleThreadedRefCountScope()
+	{
+		RefCount::single_threaded_scopes--;
+	}
+
+	SingleThreadedRefCountScope(const SingleThreadedRefCountScope&) = delete;
+	SingleThreadedRefCountScope&
+	operator=(const SingleThreadedRefCountScope&) = delete;
 };
 }
 
@@ -20,4 +20,14 @@ static void BM_RefCount(benchmark::State& state)
 
 BENCHMARK(BM_RefCount);
 
+static void BM_RefCount_SingleThreaded(benchmark::State& state)
+{
+	RefCount rf;
+	SingleThreadedRefCountScope scope;
+	for (auto _ : state)
+		rf.ref();
+}
+
+BENCHMARK(BM_RefCount_SingleThreaded);
+
 }
@@ -43,6 +43,18 @@ SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols, bool ref_counting)
 #endif
 }
 
+template <class T>
+SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols,
+	std::shared_ptr<const void> owner)
+	: SGReferencedData(false), matrix(m),
+	num_rows(nrows), num_cols(ncols), gpu_ptr(nullptr)
+{
+	set_external_owner(std::move(owner));
+#ifdef HAVE_VIENNACL
+    m_on_gpu.store(false, std::memory_order_release);
+#endif
+}
+
 template <class T>
 SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols, index_t offset)
 	: SGReferencedData(false), matrix(m+offset),
@@ -949,7 +961,8 @@ void SGMatrix<T>::init_data()
 template<class T>
 void SGMatrix<T>::free_data()
 {
-	SG_FREE(matrix);
+	if (!has_external_owner())
+		SG_FREE(matrix);
 	matrix=NULL;
 	num_rows=0;
 	num_cols=0;
@@ -62,6 +62,18 @@ template<class T> class SGMatrix : public SGReferencedData
 		/** Wraps a matrix around an existing memory segment with an offset */
 		SGMatrix(T* m, index_t nrows, index_t ncols, index_t offset);
 
+		/** Wraps a matrix around memory owned by another object, e.g. a
+		 * memory mapped file, which is kept alive as long as the matrix's
+		 * data is referenced
+		 *
+		 * @param m memory of nrows*ncols elements
+		 * @param nrows number of rows
+		 * @param ncols number of columns
+		 * @param owner object owning the memory
+		 */
+		SGMatrix(T* m, index_t nrows, index_t ncols,
+			std::shared_ptr<const void> owner);
+
 		/** Constructor to create new matrix in memory */
 		SGMatrix(index_t nrows, index_t ncols, bool ref_counting=true);
 
@@ -0,0 +1,138 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __SGMATRIXVIEW_H__
+#define __SGMATRIXVIEW_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/memory.h>
+
+namespace shogun
+{
+
+/** @brief Read-only view on a subset of the columns of a SGMatrix.
+ *
+ * The view shares the memory of the matrix (which is kept alive by
+ * reference counting) and maps column indices through an index vector, as
+ * the SubsetStack of features does. Subsets of features therefore do not
+ * have to be copied to be read column by column. Every column of the view
+ * is still contiguous, only the columns themselves are scattered.
+ *
+ * An explicit copy is only made with materialize(), for code that needs the
+ * whole matrix to be contiguous, e.g. a matrix product.
+ *
+ * A SGMatrix converts implicitly to a view on all of its columns.
+ */
+template <class T>
+class SGMatrixView
+{
+public:
+	/** Default constructor, empty view */
+	SGMatrixView() : num_rows(0), num_cols(0), m_has_subset(false)
+	{
+	}
+
+	/** View on all columns of a matrix
+	 *
+	 * @param matrix viewed matrix
+	 */
+	SGMatrixView(const SGMatrix<T>& matrix)
+	    : num_rows(matrix.num_rows), num_cols(matrix.num_cols),
+	      m_matrix(matrix), m_has_subset(false)
+	{
+	}
+
+	/** View on the given columns of a matrix
+	 *
+	 * @param matrix viewed matrix
+	 * @param columns indices of the viewed columns, no column if empty
+	 */
+	SGMatrixView(const SGMatrix<T>& matrix, const SGVector<index_t>& columns)
+	    : num_rows(matrix.num_rows), num_cols(columns.vlen),
+	      m_matrix(matrix), m_columns(columns), m_has_subset(true)
+	{
+	}
+
+	/** @return whether the view covers the whole matrix in order */
+	bool is_contiguous() const
+	{
+		return !m_has_subset;
+	}
+
+	/** @return index of the i-th column of the view in the viewed matrix */
+	index_t column_index(index_t col) const
+	{
+		return m_has_subset ? m_columns.vector[col] : col;
+	}
+
+	/** @return pointer to a column of the view, which is contiguous */
+	T* get_column_vector(index_t col) const
+	{
+		return m_matrix.get_column_vector(column_index(col));
+	}
+
+	/** @return element at the given row and column of the view */
+	const T& operator()(index_t i_row, index_t i_col) const
+	{
+		return get_column_vector(i_col)[i_row];
+	}
+
+	/** @return viewed matrix, with all its columns */
+	SGMatrix<T> get_matrix() const
+	{
+		return m_matrix;
+	}
+
+	/** @return indices of the viewed columns, empty if the view is
+	 * contiguous
+	 */
+	SGVector<index_t> get_column_indices() const
+	{
+		return m_columns;
+	}
+
+	/** Contiguous matrix with the columns of the view. This only copies if
+	 * the view does not cover the whole matrix in order.
+	 *
+	 * @return matrix
+	 */
+	SGMatrix<T> materialize() const
+	{
+		if (is_contiguous())
+			return m_matrix;
+
+		SGMatrix<T> result(num_rows, num_cols);
+		for (index_t i = 0; i < num_cols; i++)
+		{
+			sg_memcpy(
+			    result.get_column_vector(i), get_column_vector(i),
+			    sizeof(T) * num_rows);
+		}
+		return result;
+	}
+
+public:
+	/** number of rows */
+	index_t num_rows;
+
+	/** number of columns of the view */
+	index_t num_cols;
+
+private:
+	/** viewed matrix */
+	SGMatrix<T> m_matrix;
+
+	/** indices of the viewed columns, only used if m_has_subset */
+	SGVector<index_t> m_columns;
+
+	/** whether the columns are mapped through m_columns, which may be
+	 * empty
+	 */
+	bool m_has_subset;
+};
+}
+
+#endif // __SGMATRIXVIEW_H__
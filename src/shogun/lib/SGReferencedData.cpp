@@ -2,6 +2,7 @@
 #include <shogun/lib/RefCount.h>
 #include <shogun/io/SGIO.h>
 
+#include <new>
 #include <utility>
 
 using namespace shogun;
@@ -42,7 +43,8 @@ SGReferencedData& SGReferencedData::operator= (const SGReferencedData &orig)
 
 SGReferencedData::~SGReferencedData()
 {
-	delete m_refcount;
+	if (!has_embedded_refcount())
+		delete m_refcount;
 }
 
 int32_t SGReferencedData::ref_count()
@@ -56,6 +58,30 @@ int32_t SGReferencedData::ref_count()
 	return c;
 }
 
+void SGReferencedData::set_embedded_refcount(void* memory)
+{
+	ASSERT(m_refcount == NULL)
+	m_refcount = new (memory) RefCount(0, true);
+	ref();
+}
+
+bool SGReferencedData::has_embedded_refcount() const
+{
+	return m_refcount && m_refcount->is_embedded();
+}
+
+void SGReferencedData::set_external_owner(std::shared_ptr<const void> owner)
+{
+	ASSERT(m_refcount == NULL)
+	m_refcount = new RefCount(std::move(owner));
+	ref();
+}
+
+bool SGReferencedData::has_external_owner() const
+{
+	return m_refcount && m_refcount->has_owner();
+}
+
 /** copy refcount */
 void SGReferencedData::copy_refcount(const SGReferencedData &orig)
 {
@@ -98,8 +124,11 @@ int32_t SGReferencedData::unref()
 	if (c<=0)
 	{
 		SG_TRACE("unref() refcount {} data {} destroying", c, fmt::ptr(this));
+		/* an embedded counter is released along with the data */
+		bool embedded = m_refcount->is_embedded();
 		free_data();
-		delete m_refcount;
+		if (!embedded)
+			delete m_refcount;
 		m_refcount=NULL;
 		return 0;
 	}
@@ -9,6 +9,8 @@
 
 #include <shogun/lib/config.h>
 
+#include <memory>
+
 #include <shogun/lib/common.h>
 
 namespace shogun
@@ -61,6 +63,27 @@ class SGReferencedData
 		 */
 		int32_t unref();
 
+		/** use a counter placed in the memory block of the data, which is
+		 * released by free_data(). Requires that no counter is set yet.
+		 *
+		 * @param memory memory for a RefCount, inside the data block
+		 */
+		void set_embedded_refcount(void* memory);
+
+		/** @return whether the counter is released with the data */
+		bool has_embedded_refcount() const;
+
+		/** count references to data owned by another object, which is kept
+		 * alive until the last reference is dropped and is not freed by
+		 * free_data(). Requires that no counter is set yet.
+		 *
+		 * @param owner object owning the data
+		 */
+		void set_external_owner(std::shared_ptr<const void> owner);
+
+		/** @return whether the data is owned by another object */
+		bool has_external_owner() const;
+
 		/** needs to be overridden to copy data */
 		virtual void copy_data(const SGReferencedData &orig)=0;
 
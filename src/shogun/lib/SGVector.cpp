@@ -13,6 +13,8 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGReferencedData.h>
+#include <shogun/lib/Allocator.h>
+#include <shogun/lib/RefCount.h>
 #include <shogun/io/File.h>
 
 #include <algorithm>
@@ -79,6 +81,16 @@ SGVector<T>::SGVector(T* v, index_t len, bool ref_counting)
 #endif
 }
 
+template<class T>
+SGVector<T>::SGVector(T* v, index_t len, std::shared_ptr<const void> owner)
+: SGReferencedData(false), vector(v), vlen(len), gpu_ptr(NULL)
+{
+	set_external_owner(std::move(owner));
+#ifdef HAVE_VIENNACL
+	m_on_gpu.store(false, std::memory_order_release);
+#endif
+}
+
 template<class T>
 SGVector<T>::SGVector(T* m, index_t len, index_t offset)
 : SGReferencedData(false), vector(m+offset), vlen(len)
@@ -90,9 +102,12 @@ SGVector<T>::SGVector(T* m, index_t len, index_t offset)
 
 template<class T>
 SGVector<T>::SGVector(index_t len, bool ref_counting)
-: SGReferencedData(ref_counting), vlen(len), gpu_ptr(NULL)
+: SGReferencedData(false), vlen(len), gpu_ptr(NULL)
 {
-	vector=SG_ALIGNED_MALLOC(T, len, alignment::container_alignment);
+	if (ref_counting)
+		allocate_with_refcount(len);
+	else
+		vector=SG_ALIGNED_MALLOC(T, len, alignment::container_alignment);
 	std::fill_n(vector, len, 0);
 #ifdef HAVE_VIENNACL
     m_on_gpu.store(false, std::memory_order_release);
@@ -279,8 +294,10 @@ SGVector<T> SGVector<T>::clone() const
 {
 	if (on_gpu())
 		return SGVector<T>(gpu_ptr->clone_vector(gpu_ptr.get(), vlen), vlen);
-	else
+	else if (!vector || !vlen)
 		return SGVector<T>(clone_vector(vector, vlen), vlen);
+	else
+		return SGVector<T>(vector, vector+vlen);
 }
 
 template<class T>
@@ -322,6 +339,20 @@ template<class T>
 void SGVector<T>::resize_vector(int32_t n)
 {
 	assert_on_cpu();
+	if (has_embedded_refcount() || has_external_owner())
+	{
+		// the counter behind the elements cannot be moved by realloc, and
+		// memory of other owners cannot be reallocated at all, other copies
+		// keep the old elements. Like SG_REALLOC, the new block comes from
+		// the allocator of the old one rather than from the innermost
+		// ScopedAllocator, which the vector may outlive.
+		ScopedAllocator owner_scope(ScopedAllocator::owner(vector));
+		SGVector<T> resized(n);
+		sg_memcpy(resized.vector, vector, sizeof(T)*std::min(vlen, n));
+		*this = resized;
+		return;
+	}
+
 	vector=SG_REALLOC(T, vector, vlen, n);
 
 	if (n > vlen)
@@ -369,6 +400,17 @@ void SGVector<T>::display_size() const
 	io::print("SGVector '{}' of size: {}\n", fmt::ptr(vector), vlen);
 }
 
+template<class T>
+void SGVector<T>::allocate_with_refcount(index_t len)
+{
+	const size_t offset = (sizeof(T)*len + alignof(RefCount) - 1) /
+		alignof(RefCount) * alignof(RefCount);
+	uint8_t* block = SG_ALIGNED_MALLOC(
+		uint8_t, offset + sizeof(RefCount), alignment::container_alignment);
+	vector = (T*) block;
+	set_embedded_refcount(block + offset);
+}
+
 template<class T>
 void SGVector<T>::copy_data(const SGReferencedData &orig)
 {
@@ -395,7 +437,8 @@ void SGVector<T>::init_data()
 template<class T>
 void SGVector<T>::free_data()
 {
-	SG_FREE(vector);
+	if (!has_external_owner())
+		SG_FREE(vector);
 	vector=NULL;
 	vlen=0;
 	gpu_ptr=NULL;
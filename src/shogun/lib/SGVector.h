@@ -65,6 +65,16 @@ template<class T> class SGVector : public SGReferencedData
 		/** Wraps a vector around an existing memory segment with an offset */
 		SGVector(T* m, index_t len, index_t offset);
 
+		/** Wraps a vector around memory owned by another object, e.g. a
+		 * memory mapped file, which is kept alive as long as the vector's
+		 * data is referenced
+		 *
+		 * @param v memory of len elements
+		 * @param len length of the vector
+		 * @param owner object owning the memory
+		 */
+		SGVector(T* v, index_t len, std::shared_ptr<const void> owner);
+
 		/** Constructor to create new vector in memory */
 		SGVector(index_t len, bool ref_counting=true);
 
@@ -109,11 +119,11 @@ template<class T> class SGVector : public SGReferencedData
 		/** Construct SGVector from InputIterator list */
 		template<typename InputIt>
 		SGVector(InputIt beginIt, InputIt endIt):
-			SGReferencedData(true),
+			SGReferencedData(false),
 			vlen(std::distance(beginIt, endIt)),
 			gpu_ptr(nullptr)
 		{
-			vector = SG_ALIGNED_MALLOC(T, vlen, alignment::container_alignment);
+			allocate_with_refcount(vlen);
 			std::copy(beginIt, endIt, vector);
 #ifdef HAVE_VIENNACL
             m_on_gpu.store(false, std::memory_order_release);
@@ -270,7 +280,9 @@ template<class T> class SGVector : public SGReferencedData
 		}
 
 #ifndef SWIG // SWIG should skip this part
-		/** Resize vector, with zero padding
+		/** Resize vector, with zero padding. The elements stay with the
+		 * allocator that owns them, even inside the scope of another
+		 * ScopedAllocator.
 		 *
 		 * @param n new size
 		 */
@@ -581,6 +593,14 @@ template<class T> class SGVector : public SGReferencedData
 		virtual void free_data();
 
 	private:
+		/** Allocates memory for len elements followed by the reference
+		 * counter, so that a new vector costs a single allocation. The
+		 * counter is released with the elements.
+		 *
+		 * @param len number of elements
+		 */
+		void allocate_with_refcount(index_t len);
+
 #ifdef HAVE_VIENNACL
 		/** Atomic variable of vector on_gpu status */
 		std::atomic<bool> m_on_gpu;
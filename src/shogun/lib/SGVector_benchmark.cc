@@ -6,6 +6,7 @@
 
 #include "shogun/mathematics/Math.h"
 #include <benchmark/benchmark.h>
+#include "shogun/lib/RefCount.h"
 #include "shogun/lib/SGVector.h"
 
 
@@ -25,4 +26,55 @@ void BM_SGVector_calculation(benchmark::State& state)
 
 BENCHMARK(BM_SGVector_calculation)->Range(8, 2048);
 
+// elements and reference counter share one allocation
+void BM_SGVector_create(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		SGVector<float64_t> a(state.range(0));
+		benchmark::DoNotOptimize(a.vector);
+	}
+}
+
+BENCHMARK(BM_SGVector_create)->Range(1, 64);
+
+void BM_SGVector_create_external_refcount(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		SGVector<float64_t> a(
+		    SG_ALIGNED_MALLOC(
+		        float64_t, state.range(0), alignment::container_alignment),
+		    state.range(0));
+		benchmark::DoNotOptimize(a.vector);
+	}
+}
+
+BENCHMARK(BM_SGVector_create_external_refcount)->Range(1, 64);
+
+void BM_SGVector_copy(benchmark::State& state)
+{
+	SGVector<float64_t> a(4);
+	for (auto _ : state)
+	{
+		SGVector<float64_t> b(a);
+		benchmark::DoNotOptimize(b.vector);
+	}
+}
+
+BENCHMARK(BM_SGVector_copy);
+
+void BM_SGVector_copy_single_threaded(benchmark::State& state)
+{
+	SGVector<float64_t> a(4);
+	SingleThreadedRefCountScope scope;
+	for (auto _ : state)
+	{
+		SGVector<float64_t> b(a);
+		benchmark::DoNotOptimize(b.vector);
+	}
+}
+
+BENCHMARK(BM_SGVector_copy_single_threaded);
+
 }
@@ -5,6 +5,7 @@
 */
 
 #include <rxcpp/rx-lite.hpp>
+#include <shogun/base/Executor.h>
 #include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/StoppableSGObject.h>
@@ -16,6 +17,8 @@ StoppableSGObject::StoppableSGObject() : SGObject()
 {
 	m_cancel_computation = false;
 	m_pause_computation_flag = false;
+	m_stop_requested = false;
+	m_computing = 0;
 
 	m_callback = nullptr;
 };
@@ -24,6 +27,22 @@ StoppableSGObject::~StoppableSGObject(){};
 
 rxcpp::subscription StoppableSGObject::connect_to_signal_handler()
 {
+	bool stop = false;
+	{
+		std::lock_guard<std::mutex> lck(m_mutex);
+		if (m_computing++ == 0)
+		{
+			// a task cancelled before its computation connected stops it
+			// right away, a stop from before is dropped otherwise
+			auto task = TaskState::current();
+			stop = task && task->is_cancel_requested();
+			m_stop_requested = stop;
+			reset_computation_variables();
+		}
+	}
+	if (stop)
+		on_next();
+
 	// Subscribe this algorithm to the signal handler
 	auto subscriber = rxcpp::make_subscriber<int>(
 	    [this](int i) {
@@ -36,6 +55,32 @@ rxcpp::subscription StoppableSGObject::connect_to_signal_handler()
 	return env()->signal()->get_observable()->subscribe(subscriber);
 }
 
+void StoppableSGObject::disconnect_from_signal_handler(
+    rxcpp::subscription& sub)
+{
+	sub.unsubscribe();
+	// a stop requested after this point must not cancel the next
+	// computation
+	std::lock_guard<std::mutex> lck(m_mutex);
+	if (--m_computing == 0)
+	{
+		m_stop_requested = false;
+		reset_computation_variables();
+	}
+}
+
+void StoppableSGObject::stop_computation()
+{
+	{
+		std::lock_guard<std::mutex> lck(m_mutex);
+		if (m_computing == 0)
+			return;
+		m_stop_requested = true;
+	}
+	// the hooks may call back into the object
+	on_next();
+}
+
 void StoppableSGObject::set_callback(std::function<bool()> callback)
 {
 	m_callback = std::move(callback);
@@ -43,7 +88,8 @@ void StoppableSGObject::set_callback(std::function<bool()> callback)
 
 void StoppableSGObject::reset_computation_variables()
 {
-	m_cancel_computation = false;
+	// a computation that was asked to stop remains stopped
+	m_cancel_computation = m_stop_requested.load();
 	m_pause_computation_flag = false;
 }
 
@@ -71,15 +71,31 @@ namespace shogun
 		 */
 		void set_callback(std::function<bool()> callback);
 
+		/**
+		 * Ask the running computation to stop as on SIGINT, e.g. from
+		 * another thread. Does nothing unless a computation is running;
+		 * the computation stays stopped until it disconnects, even if it
+		 * resets its computation variables.
+		 */
+		void stop_computation();
+
 		virtual const char* get_name() const
 		{
 			return "StoppableSGObject";
 		}
 
 	protected:
-		/** connect the machine instance to the signal handler */
+		/** connect the machine instance to the signal handler, the
+		 * computation can be stopped from now on. Computations nest; the
+		 * outermost one drops earlier stop requests, unless it runs in an
+		 * Executor task that was cancelled, in which case it stops right
+		 * away */
 		rxcpp::subscription connect_to_signal_handler();
 
+		/** disconnect the machine instance from the signal handler and
+		 * reset the computation variables once the computation is done */
+		void disconnect_from_signal_handler(rxcpp::subscription& sub);
+
 		/** reset the computation variables */
 		void reset_computation_variables();
 
@@ -115,6 +131,12 @@ namespace shogun
 		/** Mutex used to pause threads */
 		std::mutex m_mutex;
 
+		/** Whether stop_computation() was called during the computation */
+		std::atomic<bool> m_stop_requested;
+
+		/** Number of nested computations connected to the signal handler */
+		int32_t m_computing;
+
 		std::function<bool(void)> m_callback;
 	};
 }
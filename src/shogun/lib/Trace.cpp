@@ -0,0 +1,301 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/Trace.h>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#ifdef HAVE_TFLOGGER
+#include <shogun/lib/tfhistogram/histogram.h>
+#include <tflogger/event_logger.h>
+
+#include <ctime>
+#endif // HAVE_TFLOGGER
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+using namespace shogun;
+
+std::atomic<bool> Trace::m_enabled(false);
+std::atomic<int64_t> Trace::m_epoch(0);
+
+namespace
+{
+	/** ring buffer of the events of one thread, written only by that thread */
+	struct ThreadBuffer
+	{
+		ThreadBuffer(int32_t _thread, int64_t capacity)
+		    : thread(_thread), events(capacity), head(0)
+		{
+		}
+
+		/** index of the thread */
+		int32_t thread;
+		/** events, the event with number i is at i % events.size() */
+		std::vector<TraceEvent> events;
+		/** number of events recorded so far */
+		std::atomic<int64_t> head;
+	};
+
+	/** buffers of all threads that recorded since the last enable() */
+	struct TraceRegistry
+	{
+		std::mutex mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		int64_t capacity = 1 << 16;
+		/** incremented by enable(), threads with a buffer of an older
+		 * generation register a new one
+		 */
+		std::atomic<int64_t> generation{0};
+	};
+
+	TraceRegistry& registry()
+	{
+		static TraceRegistry instance;
+		return instance;
+	}
+
+	// threads keep their buffer alive, so enable() can drop buffers of
+	// the registry while they record
+	thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+	thread_local int64_t t_generation = -1;
+} // namespace
+
+void Trace::enable(int64_t events_per_thread)
+{
+	require(
+	    events_per_thread > 0, "Capacity of trace buffers ({}) must be positive",
+	    events_per_thread);
+
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	r.buffers.clear();
+	r.capacity = events_per_thread;
+	r.generation.fetch_add(1, std::memory_order_release);
+	m_epoch.store(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+	        std::chrono::steady_clock::now().time_since_epoch())
+	        .count(),
+	    std::memory_order_relaxed);
+	m_enabled.store(true, std::memory_order_release);
+}
+
+void Trace::disable()
+{
+	m_enabled.store(false, std::memory_order_release);
+}
+
+void Trace::record(ETraceEventKind kind, const char* scope, int64_t counter)
+{
+	auto& r = registry();
+	if (SG_UNLIKELY(
+	        t_generation != r.generation.load(std::memory_order_acquire)))
+	{
+		std::lock_guard<std::mutex> lock(r.mutex);
+		t_buffer = std::make_shared<ThreadBuffer>(r.buffers.size(), r.capacity);
+		t_generation = r.generation.load(std::memory_order_relaxed);
+		r.buffers.push_back(t_buffer);
+	}
+
+	auto& buffer = *t_buffer;
+	auto head = buffer.head.load(std::memory_order_relaxed);
+	buffer.events[head % buffer.events.size()] = {now(), scope, counter,
+	                                              buffer.thread, kind};
+	buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<TraceEvent> Trace::collect()
+{
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+	{
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		buffers = r.buffers;
+	}
+
+	std::vector<TraceEvent> result;
+	for (const auto& buffer : buffers)
+	{
+		int64_t capacity = buffer->events.size();
+		auto head = buffer->head.load(std::memory_order_acquire);
+		auto first = std::max<int64_t>(0, head - capacity);
+
+		std::vector<TraceEvent> events;
+		events.reserve(head - first);
+		for (auto i = first; i < head; ++i)
+			events.push_back(buffer->events[i % capacity]);
+
+		// skip events the thread overwrote while they were copied
+		auto overwritten = std::max<int64_t>(
+		    0, buffer->head.load(std::memory_order_acquire) - capacity - first);
+		if (overwritten < (int64_t)events.size())
+			result.insert(
+			    result.end(), events.begin() + overwritten, events.end());
+	}
+	return result;
+}
+
+int64_t Trace::get_num_dropped()
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	int64_t dropped = 0;
+	for (const auto& buffer : r.buffers)
+		dropped += std::max<int64_t>(
+		    0, buffer->head.load(std::memory_order_relaxed) -
+		           (int64_t)buffer->events.size());
+	return dropped;
+}
+
+std::map<std::string, TraceSummary>
+Trace::summary(const std::vector<TraceEvent>& events)
+{
+	std::map<std::string, TraceSummary> result;
+	std::map<int32_t, std::vector<const TraceEvent*>> open_scopes;
+	for (const auto& event : events)
+	{
+		switch (event.kind)
+		{
+		case TRACE_BEGIN:
+			open_scopes[event.thread].push_back(&event);
+			break;
+		case TRACE_END:
+		{
+			// begin events of a full buffer may have been overwritten
+			auto& stack = open_scopes[event.thread];
+			auto begin = std::find_if(
+			    stack.rbegin(), stack.rend(), [&event](const TraceEvent* e) {
+				    return e->scope == event.scope;
+			    });
+			if (begin == stack.rend())
+				break;
+
+			auto duration = event.timestamp - (*begin)->timestamp;
+			auto& entry = result[event.scope];
+			entry.calls++;
+			entry.total_ns += duration;
+			entry.max_ns = std::max(entry.max_ns, duration);
+			entry.counter += event.counter;
+			entry.durations.push_back(duration);
+			stack.erase(std::next(begin).base(), stack.end());
+			break;
+		}
+		case TRACE_COUNTER:
+		{
+			auto& entry = result[event.scope];
+			entry.calls++;
+			entry.counter += event.counter;
+			break;
+		}
+		}
+	}
+	return result;
+}
+
+std::string Trace::to_chrome_json(const std::vector<TraceEvent>& events)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	writer.StartObject();
+	writer.Key("displayTimeUnit");
+	writer.String("ns");
+	writer.Key("traceEvents");
+	writer.StartArray();
+	for (const auto& event : events)
+	{
+		writer.StartObject();
+		writer.Key("name");
+		writer.String(event.scope);
+		writer.Key("ph");
+		switch (event.kind)
+		{
+		case TRACE_BEGIN:
+			writer.String("B");
+			break;
+		case TRACE_END:
+			writer.String("E");
+			break;
+		case TRACE_COUNTER:
+			writer.String("C");
+			break;
+		}
+		writer.Key("ts");
+		writer.Double(event.timestamp * 1e-3);
+		writer.Key("pid");
+		writer.Int(0);
+		writer.Key("tid");
+		writer.Int(event.thread);
+		if (event.kind != TRACE_BEGIN)
+		{
+			writer.Key("args");
+			writer.StartObject();
+			writer.Key(event.kind == TRACE_COUNTER ? "value" : "counter");
+			writer.Int64(event.counter);
+			writer.EndObject();
+		}
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+	return buffer.GetString();
+}
+
+void Trace::write_chrome_trace(const std::string& filename)
+{
+	std::ofstream out(filename);
+	require(out.good(), "Could not open '{}' for writing", filename);
+	out << to_chrome_json(collect());
+	require(out.good(), "Could not write trace to '{}'", filename);
+	SG_DEBUG("wrote trace to {}, {} events dropped", filename, get_num_dropped());
+}
+
+#ifdef HAVE_TFLOGGER
+void Trace::write_tensorboard(const std::string& prefix, int64_t step)
+{
+	tflogger::EventLogger writer(prefix.c_str());
+	writer.init();
+
+	auto new_value = [step](tensorflow::Event& e, const std::string& tag) {
+		e.set_wall_time(std::time(nullptr));
+		e.set_step(step);
+		auto value = e.mutable_summary()->add_value();
+		value->set_tag(tag);
+		value->set_node_name("trace");
+		return value;
+	};
+	auto write_scalar = [&](const std::string& tag, float64_t scalar) {
+		tensorflow::Event e;
+		new_value(e, tag)->set_simple_value(scalar);
+		writer.writeEvent(e);
+	};
+
+	for (const auto& scope : summary(collect()))
+	{
+		const auto& timings = scope.second;
+		write_scalar(scope.first + "/calls", timings.calls);
+		write_scalar(scope.first + "/counter", timings.counter);
+		if (timings.durations.empty())
+			continue;
+
+		write_scalar(scope.first + "/total_ms", timings.total_ns * 1e-6);
+		write_scalar(scope.first + "/max_ms", timings.max_ns * 1e-6);
+
+		tensorflow::histogram::Histogram h;
+		for (auto duration : timings.durations)
+			h.Add(duration * 1e-6);
+		auto hp = new tensorflow::HistogramProto();
+		h.EncodeToProto(hp, true);
+		tensorflow::Event e;
+		new_value(e, scope.first + "/duration_ms")->set_allocated_histo(hp);
+		writer.writeEvent(e);
+	}
+
+	writer.flush();
+	writer.close();
+}
+#endif // HAVE_TFLOGGER
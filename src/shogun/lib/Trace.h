@@ -0,0 +1,253 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/macros.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+
+/** kind of a TraceEvent */
+enum ETraceEventKind : uint8_t
+{
+	/** a scope was entered */
+	TRACE_BEGIN = 0,
+	/** a scope was left */
+	TRACE_END = 1,
+	/** value of a counter */
+	TRACE_COUNTER = 2
+};
+
+/** event recorded by Trace */
+struct TraceEvent
+{
+	/** nanoseconds since Trace::enable() */
+	int64_t timestamp;
+	/** name of the scope or counter, with static storage duration */
+	const char* scope;
+	/** counter value, e.g. the number of iterations of a scope */
+	int64_t counter;
+	/** index of the recording thread */
+	int32_t thread;
+	/** kind of the event */
+	ETraceEventKind kind;
+};
+
+/** timings of one scope, aggregated by Trace::summary() */
+struct TraceSummary
+{
+	/** number of completed calls */
+	int64_t calls = 0;
+	/** total nanoseconds of all calls, nested calls are counted twice */
+	int64_t total_ns = 0;
+	/** nanoseconds of the longest call */
+	int64_t max_ns = 0;
+	/** sum of the counters of all calls */
+	int64_t counter = 0;
+	/** nanoseconds of each call */
+	std::vector<int64_t> durations;
+};
+
+/** @brief Low-overhead tracing of hot paths.
+ *
+ * Scopes are marked with SG_TRACE_SCOPE, which records a begin and an end
+ * event with a timestamp in a ring buffer of the current thread. Recording
+ * takes no locks and allocates nothing but the buffer of a thread on its
+ * first event; when a buffer is full, the oldest events are overwritten.
+ * While tracing is disabled, a scope costs a relaxed atomic load and a
+ * branch on entry, a second, well predicted branch on exit and a 16 byte
+ * TraceScope on the stack. Configuring with -DUSE_TRACING=OFF removes the
+ * scopes altogether.
+ *
+ * Unlike parameter observers, which log values of a model through
+ * SGObject::observe(), traces are meant to find where time goes inside a
+ * call such as Machine::train():
+ *
+ *     Trace::enable();
+ *     svm->train(feats);
+ *     Trace::write_chrome_trace("train.json"); // load in chrome://tracing
+ *     Trace::disable();
+ *
+ * Events are collected from all threads that recorded since the last
+ * enable(), including threads that have exited. They are best collected
+ * while no traced code is running; events overwritten during a concurrent
+ * collection are skipped.
+ */
+class Trace
+{
+public:
+	/** start tracing, clearing the events of a previous trace
+	 *
+	 * @param events_per_thread capacity of the ring buffer of each thread
+	 */
+	static void enable(int64_t events_per_thread = 1 << 16);
+
+	/** stop recording events, recorded events are kept */
+	static void disable();
+
+	/** @return whether events are recorded */
+	static SG_FORCED_INLINE bool is_enabled()
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	/** record an event on the current thread, callers check is_enabled()
+	 *
+	 * @param kind kind of the event
+	 * @param scope name with static storage duration
+	 * @param counter counter value
+	 */
+	static void record(ETraceEventKind kind, const char* scope, int64_t counter = 0);
+
+	/** record the value of a counter if tracing is enabled
+	 *
+	 * @param name name with static storage duration
+	 * @param value value
+	 */
+	static SG_FORCED_INLINE void counter(const char* name, int64_t value)
+	{
+		if (is_enabled())
+			record(TRACE_COUNTER, name, value);
+	}
+
+	/** @return events of all threads, ordered by thread and time */
+	static std::vector<TraceEvent> collect();
+
+	/** @return number of events that were overwritten in full buffers */
+	static int64_t get_num_dropped();
+
+	/** aggregate the timings of each scope of collected events
+	 *
+	 * @param events events as returned by collect()
+	 * @return timings by scope name
+	 */
+	static std::map<std::string, TraceSummary>
+	summary(const std::vector<TraceEvent>& events);
+
+	/** convert events to the Chrome trace event format, which can be
+	 * loaded in chrome://tracing or Perfetto
+	 *
+	 * @param events events as returned by collect()
+	 * @return JSON document
+	 */
+	static std::string to_chrome_json(const std::vector<TraceEvent>& events);
+
+	/** write all events in the Chrome trace event format
+	 *
+	 * @param filename name of the file
+	 */
+	static void write_chrome_trace(const std::string& filename);
+
+#ifdef HAVE_TFLOGGER
+	/** write the summary of all events as TensorBoard events: calls, total
+	 * and maximal milliseconds of each scope as scalars and the durations
+	 * of its calls as histogram
+	 *
+	 * @param prefix prefix of the event file, as for
+	 * ParameterObserverTensorBoard
+	 * @param step step of the events, e.g. an epoch
+	 */
+	static void write_tensorboard(const std::string& prefix, int64_t step = 0);
+#endif // HAVE_TFLOGGER
+
+	/** @return nanoseconds since enable() */
+	static SG_FORCED_INLINE int64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		           .count() -
+		       m_epoch.load(std::memory_order_relaxed);
+	}
+
+private:
+	static std::atomic<bool> m_enabled;
+	static std::atomic<int64_t> m_epoch;
+};
+
+/** @brief Records a begin event on construction and an end event on
+ * destruction if tracing was enabled at construction. The destructor tests
+ * whether a begin event was recorded, so that enabling or disabling
+ * tracing inside a scope never leaves an unmatched event. Use
+ * SG_TRACE_SCOPE rather than this class directly.
+ */
+class TraceScope
+{
+public:
+	/** constructor
+	 *
+	 * @param scope name with static storage duration
+	 */
+	SG_FORCED_INLINE TraceScope(const char* scope) : m_scope(nullptr)
+	{
+		if (SG_UNLIKELY(Trace::is_enabled()))
+		{
+			m_scope = scope;
+			Trace::record(TRACE_BEGIN, scope);
+		}
+	}
+
+	SG_FORCED_INLINE ~TraceScope()
+	{
+		if (SG_UNLIKELY(m_scope != nullptr))
+			Trace::record(TRACE_END, m_scope, m_counter);
+	}
+
+	/** set the counter of the end event, e.g. the number of iterations */
+	SG_FORCED_INLINE void set_counter(int64_t counter)
+	{
+		m_counter = counter;
+	}
+
+private:
+	const char* m_scope;
+	int64_t m_counter = 0;
+
+	SG_DELETE_COPY_AND_ASSIGN(TraceScope);
+};
+
+/** @brief Stands in for a TraceScope when tracing is compiled out */
+class NullTraceScope
+{
+public:
+	/** ignore the counter */
+	SG_FORCED_INLINE void set_counter(int64_t)
+	{
+	}
+};
+
+#define SG_TRACE_CONCAT_(a, b) a##b
+#define SG_TRACE_CONCAT(a, b) SG_TRACE_CONCAT_(a, b)
+
+#ifdef USE_TRACING
+/** trace the enclosing block under a name with static storage duration,
+ * e.g. a string literal or the result of SGObject::get_name()
+ */
+#define SG_TRACE_SCOPE(name)                                                   \
+	shogun::TraceScope SG_TRACE_CONCAT(sg_trace_scope_, __LINE__)(name)
+/** trace the enclosing block as variable var, whose end event carries the
+ * counter set by var.set_counter()
+ */
+#define SG_TRACE_NAMED_SCOPE(var, name) shogun::TraceScope var(name)
+/** record the value of a counter */
+#define SG_TRACE_COUNTER(name, value) shogun::Trace::counter(name, value)
+#else
+#define SG_TRACE_SCOPE(name)
+#define SG_TRACE_NAMED_SCOPE(var, name) shogun::NullTraceScope var
+#define SG_TRACE_COUNTER(name, value)
+#endif // USE_TRACING
+
+}
+#endif // __TRACE_H__
@@ -8,6 +8,7 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/labels/Labels.h>
+#include <shogun/lib/SGMatrixView.h>
 #include <shogun/lib/SGVector.h>
 #include <type_traits>
 
@@ -33,6 +34,19 @@ namespace shogun
 		return result->template as<T>();
 	}
 
+	/** Creates a view of the columns of a matrix whose indices are listed
+	 * in the passed vector, without copying them
+	 *
+	 * @param matrix viewed matrix
+	 * @param subset subset of column indices
+	 * @return view on the columns
+	 */
+	template <class T>
+	SGMatrixView<T> view(const SGMatrix<T>& matrix, const SGVector<index_t>& subset)
+	{
+		return SGMatrixView<T>(matrix, subset);
+	}
+
 } // namespace shogun
 
 #endif
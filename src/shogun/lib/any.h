@@ -13,6 +13,7 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string.h>
 #include <string>
@@ -164,6 +165,130 @@ namespace shogun
 		}
 	};
 
+	/** @brief Elements of a vector or matrix of arithmetic type, which a
+	 * visitor can handle as a whole in AnyVisitor::on_contiguous().
+	 */
+	class ContiguousArray
+	{
+	public:
+		virtual ~ContiguousArray() = default;
+
+		/** @return type of the elements */
+		virtual const std::type_info& element_type() const = 0;
+
+		/** @return bytes per element */
+		virtual size_t element_size() const = 0;
+
+		/** @return number of elements */
+		virtual int64_t size() const = 0;
+
+		/** @return elements, the container is reallocated if its size
+		 * differs from size()
+		 */
+		virtual void* data() = 0;
+
+		/** let the container use memory of size() elements owned by another
+		 * object instead of its own
+		 *
+		 * @param memory elements
+		 * @param owner object that is kept alive while the elements are used
+		 */
+		virtual void bind(void* memory, std::shared_ptr<const void> owner) = 0;
+	};
+
+	namespace any_detail
+	{
+		/** elements of a SGVector, with the size visited by enter_vector() */
+		template <class T>
+		class VectorArray : public ContiguousArray
+		{
+		public:
+			VectorArray(SGVector<T>* v, index_t size) : m_v(v), m_size(size)
+			{
+			}
+
+			const std::type_info& element_type() const override
+			{
+				return typeid(T);
+			}
+
+			size_t element_size() const override
+			{
+				return sizeof(T);
+			}
+
+			int64_t size() const override
+			{
+				return m_size;
+			}
+
+			void* data() override
+			{
+				if (m_size != m_v->vlen)
+					*m_v = SGVector<T>(m_size);
+				return m_v->vector;
+			}
+
+			void bind(void* memory, std::shared_ptr<const void> owner) override
+			{
+				*m_v = SGVector<T>(static_cast<T*>(memory), m_size, std::move(owner));
+			}
+
+		private:
+			SGVector<T>* m_v;
+			index_t m_size;
+		};
+
+		/** elements of a SGMatrix, with the shape visited by enter_matrix() */
+		template <class T>
+		class MatrixArray : public ContiguousArray
+		{
+		public:
+			MatrixArray(SGMatrix<T>* m, index_t rows, index_t cols)
+			    : m_m(m), m_rows(rows), m_cols(cols)
+			{
+			}
+
+			const std::type_info& element_type() const override
+			{
+				return typeid(T);
+			}
+
+			size_t element_size() const override
+			{
+				return sizeof(T);
+			}
+
+			int64_t size() const override
+			{
+				return int64_t(m_rows) * m_cols;
+			}
+
+			void* data() override
+			{
+				if (m_rows != m_m->num_rows || m_cols != m_m->num_cols)
+					*m_m = SGMatrix<T>(m_rows, m_cols);
+				return m_m->matrix;
+			}
+
+			void bind(void* memory, std::shared_ptr<const void> owner) override
+			{
+				*m_m = SGMatrix<T>(
+				    static_cast<T*>(memory), m_rows, m_cols, std::move(owner));
+			}
+
+		private:
+			SGMatrix<T>* m_m;
+			index_t m_rows;
+			index_t m_cols;
+		};
+
+		/** whether vectors and matrices of T are offered as ContiguousArray */
+		template <class T>
+		constexpr bool is_contiguous_element =
+		    std::is_arithmetic_v<T> || std::is_same_v<T, complex128_t>;
+	} // namespace any_detail
+
 	class AnyVisitor
 	{
 	public:
@@ -197,6 +322,18 @@ namespace shogun
 		virtual void exit_std_vector(size_t* size) = 0;
 		virtual void exit_map(size_t* size) = 0;
 
+		/** called for vectors and matrices of arithmetic type after their
+		 * shape was visited by enter_vector() or enter_matrix()
+		 *
+		 * @param array elements of the vector or matrix
+		 * @return whether the visitor handled all elements, otherwise they
+		 * are visited one by one
+		 */
+		virtual bool on_contiguous(ContiguousArray* array)
+		{
+			return false;
+		}
+
 		template <typename T>
 		void on_matrix_row(index_t* rows, index_t* cols, SGMatrix<T>* _v)
 		{
@@ -213,6 +350,15 @@ namespace shogun
 		{
 			auto size = _v->vlen;
 			enter_vector(std::addressof(size));
+			if constexpr (any_detail::is_contiguous_element<T>)
+			{
+				any_detail::VectorArray<T> array(_v, size);
+				if (on_contiguous(std::addressof(array)))
+				{
+					exit_vector(std::addressof(size));
+					return;
+				}
+			}
 			if (size != _v->vlen)
 				_v->resize_vector(size);
 			for (auto&& _value : *_v)
@@ -292,6 +438,15 @@ namespace shogun
 			auto rows = _matrix->num_rows;
 			auto cols = _matrix->num_cols;
 			enter_matrix(std::addressof(rows), std::addressof(cols));
+			if constexpr (any_detail::is_contiguous_element<T>)
+			{
+				any_detail::MatrixArray<T> array(_matrix, rows, cols);
+				if (on_contiguous(std::addressof(array)))
+				{
+					exit_matrix(std::addressof(rows), std::addressof(cols));
+					return;
+				}
+			}
 			if ((rows != _matrix->num_rows) || (cols != _matrix->num_cols))
 				*_matrix = SGMatrix<T>(rows, cols);
 			for (auto index = 0; index < cols; index++)
@@ -41,6 +41,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/external/shogun_libsvm.h>
 #include <shogun/mathematics/Math.h>
@@ -446,6 +447,7 @@ void Solver::Solve(
 	const schar *p_y, float64_t *p_alpha, float64_t p_Cp, float64_t p_Cn,
 	float64_t p_eps, SolutionInfo* p_si, int32_t shrinking, bool use_bias)
 {
+	SG_TRACE_NAMED_SCOPE(trace, "libsvm::Solver::Solve");
 	auto sub = connect_to_signal_handler();
 
 	this->l = p_l;
@@ -544,6 +546,7 @@ void Solver::Solve(
 			gap, -Math::log10(gap), -Math::log10(1), -Math::log10(eps));
 
 		++iter;
+		trace.set_counter(iter);
 
 		// update alpha[i] and alpha[j], handle bounds carefully
 
@@ -5,6 +5,7 @@
  *          Weijie Lin, Bjoern Esser, Sergey Lisitsyn, Thoralf Klein
  */
 
+#include <shogun/lib/Allocator.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
@@ -14,12 +15,16 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 
 #ifdef USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
 #elif USE_TCMALLOC
 #include <gperftools/tcmalloc.h>
+#elif USE_MIMALLOC
+#include <mimalloc.h>
 #endif
 
 using namespace shogun;
@@ -41,6 +46,8 @@ void* operator new(size_t size)
 {
 #if defined(USE_TCMALLOC)
 	void *p=tc_malloc(size);
+#elif defined(USE_MIMALLOC)
+	void *p=mi_malloc(size);
 #else
 	void *p=std::malloc(size);
 #endif
@@ -53,6 +60,8 @@ void operator delete(void *p) noexcept
 {
 #if defined(USE_TCMALLOC)
 	tc_free(p);
+#elif defined(USE_MIMALLOC)
+	mi_free(p);
 #else
 	std::free(p);
 #endif
@@ -77,6 +86,8 @@ void* operator new(size_t size, std::align_val_t al)
 		size += align - rem;
 #if defined(USE_TCMALLOC)
 	void *p = tc_new_aligned_nothrow(size, align);
+#elif defined(USE_MIMALLOC)
+	void *p = mi_malloc_aligned(size, align);
 #elif HAVE_STD_ALIGNED_ALLOC
 	void *p = std::aligned_alloc(size, align);
 #else
@@ -107,14 +118,32 @@ void operator delete[](void *p, std::align_val_t al)
 
 #endif // USE_JEMALLOC
 
-namespace shogun
+namespace
 {
-void* sg_malloc(size_t size)
+/** allocation counters, only updated while enabled */
+std::atomic<bool> statistics_enabled(false);
+std::atomic<int64_t> num_allocations(0);
+std::atomic<int64_t> num_deallocations(0);
+std::atomic<int64_t> num_reallocations(0);
+std::atomic<int64_t> bytes_allocated(0);
+
+SG_FORCED_INLINE void count(std::atomic<int64_t>& counter, size_t size)
+{
+	if (statistics_enabled.load(std::memory_order_relaxed))
+	{
+		counter.fetch_add(1, std::memory_order_relaxed);
+		bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+	}
+}
+
+void* system_malloc(size_t size)
 {
 #if defined(USE_JEMALLOC)
 	void* p=je_malloc(size);
 #elif defined(USE_TCMALLOC)
 	void *p=tc_malloc(size);
+#elif defined(USE_MIMALLOC)
+	void *p=mi_malloc(size);
 #else
 	void* p=std::malloc(size);
 #endif
@@ -124,9 +153,45 @@ void* sg_malloc(size_t size)
 	return p;
 }
 
+void system_free(void* ptr)
+{
+#if defined(USE_JEMALLOC)
+	je_free(ptr);
+#elif defined(USE_TCMALLOC)
+	tc_free(ptr);
+#elif defined(USE_MIMALLOC)
+	mi_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+/** @return memory from the allocator installed on this thread, or nullptr */
+SG_FORCED_INLINE void* scoped_malloc(size_t size, size_t al)
+{
+	auto allocator = ScopedAllocator::current();
+	return allocator ? allocator->allocate(size, al) : nullptr;
+}
+}
+
+namespace shogun
+{
+void* sg_malloc(size_t size)
+{
+	count(num_allocations, size);
+	if (void* p = scoped_malloc(size, alignof(std::max_align_t)))
+		return p;
+
+	return system_malloc(size);
+}
+
 #ifdef HAVE_ALIGNED_MALLOC
 void* sg_aligned_malloc(size_t size, size_t al)
 {
+	count(num_allocations, size);
+	if (void* p = scoped_malloc(size, al))
+		return p;
+
 	/* the value of size shall be an integral multiple of alignment.  */
 	if (std::size_t rem = size & (al - 1))
 		size += al - rem;
@@ -134,6 +199,8 @@ void* sg_aligned_malloc(size_t size, size_t al)
 	void* p = je_aligned_alloc(al, size);
 #elif defined(USE_TCMALLOC)
 	void *p = tc_memalign(al, size);
+#elif defined(USE_MIMALLOC)
+	void *p = mi_malloc_aligned(size, al);
 #else
 
 #ifdef HAVE_STD_ALIGNED_ALLOC
@@ -151,7 +218,7 @@ void* sg_aligned_malloc(size_t size, size_t al)
 	#error "HAVE_ALIGNED_MALLOC but dont have a method for it!"
 #endif
 #endif // HAVE_STD_ALIGNED_ALLOC
-#endif // USE_JEMALLOC || USE_TCMALLOC
+#endif // USE_JEMALLOC || USE_TCMALLOC || USE_MIMALLOC
 	if (!p)
 		allocation_error(p, size, "aligned_malloc");
 
@@ -161,10 +228,16 @@ void* sg_aligned_malloc(size_t size, size_t al)
 
 void* sg_calloc(size_t num, size_t size)
 {
+	count(num_allocations, num*size);
+	if (void* p = scoped_malloc(num*size, alignof(std::max_align_t)))
+		return memset(p, 0, num*size);
+
 #if defined(USE_JEMALLOC)
 	void* p=je_calloc(num, size);
 #elif defined(USE_TCMALLOC)
 	void* p=tc_calloc(num, size);
+#elif defined(USE_MIMALLOC)
+	void* p=mi_calloc(num, size);
 #else
 	void* p=calloc(num, size);
 #endif
@@ -176,30 +249,88 @@ void* sg_calloc(size_t num, size_t size)
 
 void  sg_free(void* ptr)
 {
-#if defined(USE_JEMALLOC)
-	je_free(ptr);
-#elif defined(USE_TCMALLOC)
-	tc_free(ptr);
-#else
-	free(ptr);
-#endif
+	if (!ptr)
+		return;
+
+	if (statistics_enabled.load(std::memory_order_relaxed))
+		num_deallocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (auto allocator = ScopedAllocator::owner(ptr))
+		allocator->deallocate(ptr);
+	else
+		system_free(ptr);
 }
 
 void* sg_realloc(void* ptr, size_t size)
 {
+	if (!ptr)
+		return sg_malloc(size);
+
+	count(num_reallocations, size);
+	if (auto allocator = ScopedAllocator::owner(ptr))
+	{
+		if (!size)
+		{
+			allocator->deallocate(ptr);
+			return nullptr;
+		}
+		if (void* p = allocator->reallocate(ptr, size))
+			return p;
+
+		/* the allocator cannot grow the memory, move it */
+		void* p = system_malloc(size);
+		sg_memcpy(p, ptr, std::min(allocator->get_size(ptr), size));
+		allocator->deallocate(ptr);
+		return p;
+	}
+
 #if defined(USE_JEMALLOC)
 	void* p=je_realloc(ptr, size);
 #elif defined(USE_TCMALLOC)
 	void* p=tc_realloc(ptr, size);
+#elif defined(USE_MIMALLOC)
+	void* p=mi_realloc(ptr, size);
 #else
 	void* p=realloc(ptr, size);
 #endif
 
-	if (!p && (size || !ptr))
+	if (!p && size)
 		allocation_error(p, size, "realloc");
 
 	return p;
 }
+
+void set_allocation_statistics_enabled(bool enabled)
+{
+	statistics_enabled.store(enabled);
+}
+
+AllocationStatistics get_allocation_statistics()
+{
+	return {num_allocations.load(), num_deallocations.load(),
+	        num_reallocations.load(), bytes_allocated.load()};
+}
+
+void reset_allocation_statistics()
+{
+	num_allocations.store(0);
+	num_deallocations.store(0);
+	num_reallocations.store(0);
+	bytes_allocated.store(0);
+}
+
+const char* get_malloc_backend()
+{
+#if defined(USE_JEMALLOC)
+	return "jemalloc";
+#elif defined(USE_TCMALLOC)
+	return "tcmalloc";
+#elif defined(USE_MIMALLOC)
+	return "mimalloc";
+#else
+	return "system";
+#endif
+}
 }
 
 void* shogun::get_copy(void* src, size_t len)
@@ -145,6 +145,30 @@ namespace alignment
 
 void* get_copy(void* src, size_t len);
 char* get_strdup(const char* str);
+
+/** counters of the allocations through SG_MALLOC, SG_CALLOC, SG_REALLOC,
+ * SG_ALIGNED_MALLOC and SG_FREE since the last reset
+ */
+struct AllocationStatistics
+{
+	/** number of allocations */
+	int64_t num_allocations;
+	/** number of frees */
+	int64_t num_deallocations;
+	/** number of reallocations */
+	int64_t num_reallocations;
+	/** bytes requested by allocations and reallocations */
+	int64_t bytes_allocated;
+};
+
+/** enable or disable counting allocations, disabled by default */
+void set_allocation_statistics_enabled(bool enabled);
+/** @return allocations counted since the last reset */
+AllocationStatistics get_allocation_statistics();
+/** reset the allocation counters */
+void reset_allocation_statistics();
+/** @return name of the malloc implementation shogun was built with */
+const char* get_malloc_backend();
 }
 
 #endif // DOXYGEN_SHOULD_SKIP_THIS
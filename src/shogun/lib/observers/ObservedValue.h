@@ -46,6 +46,14 @@ namespace shogun
 
 #endif
 
+		/**
+		 * @return step of the value
+		 */
+		int64_t get_step() const
+		{
+			return m_step;
+		}
+
 		/** @return object name */
 		virtual const char* get_name() const
 		{
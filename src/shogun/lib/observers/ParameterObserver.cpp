@@ -5,21 +5,201 @@
  *
  */
 
+#include <shogun/lib/BoundedQueue.h>
 #include <shogun/lib/RefCount.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/lib/observers/ParameterObserver.h>
 #include <shogun/util/converters.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <thread>
+
 using namespace shogun;
 
+namespace
+{
+	int64_t to_nanos(const time_point& t)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           t.time_since_epoch())
+		    .count();
+	}
+} // namespace
+
+struct ParameterObserver::AsyncChannel
+{
+	AsyncChannel(int32_t capacity)
+	    : queue(capacity), num_pushed(0), num_delivered(0), closed(false)
+	{
+	}
+
+	BoundedQueue<TimedObservedValue> queue;
+	std::atomic<int64_t> num_pushed;
+	std::atomic<int64_t> num_delivered;
+	/** set when the observer turns synchronous, the queue is dropped once
+	 * it is drained */
+	std::atomic<bool> closed;
+
+	/** flush() waits here for num_delivered */
+	std::mutex mutex;
+	std::condition_variable delivered;
+};
+
+/**
+ * A single background thread delivers the values of all asynchronous
+ * observers. It only holds weak references, so observers are destroyed as
+ * usual and never while their on_next_impl() runs.
+ */
+class ParameterObserver::Dispatcher
+{
+public:
+	static Dispatcher& instance()
+	{
+		static Dispatcher dispatcher;
+		return dispatcher;
+	}
+
+	void add(
+	    std::weak_ptr<ParameterObserver> observer,
+	    std::shared_ptr<AsyncChannel> channel)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_channels.emplace_back(std::move(observer), std::move(channel));
+		if (!m_thread.joinable())
+			m_thread = std::thread(&Dispatcher::run, this);
+	}
+
+	/** wake up the thread, without blocking */
+	void notify()
+	{
+		if (!m_pending.exchange(true, std::memory_order_acq_rel))
+			m_wakeup.notify_one();
+	}
+
+	~Dispatcher()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wakeup.notify_one();
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+private:
+	Dispatcher() : m_pending(false), m_stop(false)
+	{
+	}
+
+	void run()
+	{
+		std::vector<Registration> channels;
+		for (;;)
+		{
+			{
+				// producers notify without the lock, a missed wakeup only
+				// delays delivery until the timeout
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wakeup.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+					return m_stop ||
+					       m_pending.load(std::memory_order_acquire);
+				});
+				if (m_stop)
+					return;
+				m_pending.store(false, std::memory_order_release);
+				channels = m_channels;
+			}
+
+			bool expired = false;
+			for (auto& registration : channels)
+				expired |= drain(registration);
+			channels.clear();
+
+			if (expired)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_channels.erase(
+				    std::remove_if(
+				        m_channels.begin(), m_channels.end(),
+				        [](const Registration& r) {
+					        return r.first.expired() ||
+					               (r.second->closed.load() &&
+					                r.second->queue.size() == 0);
+				        }),
+				    m_channels.end());
+			}
+		}
+	}
+
+	typedef std::pair<
+	    std::weak_ptr<ParameterObserver>, std::shared_ptr<AsyncChannel>>
+	    Registration;
+
+	/** @return whether the registration can be removed */
+	bool drain(Registration& registration)
+	{
+		auto observer = registration.first.lock();
+		if (!observer)
+			return true;
+
+		auto& channel = *registration.second;
+		TimedObservedValue value;
+		int64_t num_delivered = 0;
+		while (channel.queue.try_pop(value))
+		{
+			try
+			{
+				observer->deliver(value);
+			}
+			catch (...)
+			{
+				observer->on_error(std::current_exception());
+			}
+			++num_delivered;
+		}
+		value.first.reset();
+
+		if (num_delivered)
+		{
+			{
+				std::lock_guard<std::mutex> lock(channel.mutex);
+				channel.num_delivered.fetch_add(
+				    num_delivered, std::memory_order_release);
+			}
+			channel.delivered.notify_all();
+		}
+		return channel.closed.load() && channel.queue.size() == 0;
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeup;
+	std::atomic<bool> m_pending;
+	bool m_stop;
+	std::vector<Registration> m_channels;
+	std::thread m_thread;
+};
+
 ParameterObserver::ParameterObserver()
-    : m_observed_parameters(), m_subscription_id(-1)
+    : m_observed_parameters(), m_subscription_id(-1), m_step_interval(1),
+      m_time_interval(0), m_last_time(std::numeric_limits<int64_t>::min()),
+      m_num_dropped(0)
 {
 	SG_ADD(
 	    &m_subscription_id, "subscription_id",
 	    "Id of the subscription to an object.");
+	SG_ADD(
+	    &m_step_interval, "step_interval",
+	    "Observe values of every n-th step only.");
+	SG_ADD(
+	    &m_time_interval, "time_interval",
+	    "Minimal milliseconds between two observed values.");
 	this->watch_method(
 	    "num_observations", &ParameterObserver::get_num_observations);
+	this->watch_method("num_dropped", &ParameterObserver::get_num_dropped);
 }
 
 ParameterObserver::ParameterObserver(
@@ -53,6 +233,8 @@ ParameterObserver::ParameterObserver(
 
 ParameterObserver::~ParameterObserver()
 {
+	if (m_channel)
+		m_channel->closed.store(true);
 }
 
 bool ParameterObserver::observes(const std::string& param)
@@ -80,5 +262,104 @@ bool ParameterObserver::observes(const AnyParameterProperties& property)
 
 index_t ParameterObserver::get_num_observations() const
 {
+	std::lock_guard<std::mutex> lock(m_observations_mutex);
 	return utils::safe_convert<index_t>(m_observations.size());
 };
+
+int64_t ParameterObserver::get_num_dropped() const
+{
+	return m_num_dropped.load(std::memory_order_relaxed);
+}
+
+bool ParameterObserver::samples(int64_t step) const
+{
+	if (m_step_interval > 1 && step % m_step_interval != 0)
+		return false;
+	if (m_time_interval <= 0)
+		return true;
+
+	auto now = to_nanos(std::chrono::steady_clock::now());
+	return now - m_last_time.load(std::memory_order_relaxed) >=
+	       m_time_interval * 1000000;
+}
+
+bool ParameterObserver::claim_time(const TimedObservedValue& value)
+{
+	if (m_time_interval <= 0)
+		return true;
+
+	// several threads may emit, only one value per interval is observed
+	auto now = to_nanos(value.second);
+	auto last = m_last_time.load(std::memory_order_relaxed);
+	do
+	{
+		if (now - last < m_time_interval * 1000000)
+			return false;
+	} while (!m_last_time.compare_exchange_weak(
+	    last, now, std::memory_order_relaxed));
+	return true;
+}
+
+void ParameterObserver::on_next(const TimedObservedValue& value)
+{
+	if (!samples(value.first->get_step()) || !claim_time(value))
+		return;
+
+	// set_asynchronous() may replace the channel meanwhile
+	auto channel = std::atomic_load(&m_channel);
+	if (!channel)
+	{
+		deliver(value);
+		return;
+	}
+
+	if (channel->queue.try_push(value))
+	{
+		channel->num_pushed.fetch_add(1, std::memory_order_release);
+		Dispatcher::instance().notify();
+	}
+	else
+		m_num_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ParameterObserver::deliver(const TimedObservedValue& value)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_observations_mutex);
+		m_observations.push_back(value.first);
+	}
+	on_next_impl(value);
+}
+
+void ParameterObserver::set_asynchronous(int32_t capacity)
+{
+	require(capacity >= 0, "Queue capacity ({}) must not be negative", capacity);
+
+	if (auto channel = std::atomic_load(&m_channel))
+	{
+		flush();
+		channel->closed.store(true);
+		std::atomic_store(&m_channel, std::shared_ptr<AsyncChannel>());
+	}
+	if (capacity == 0)
+		return;
+
+	auto self = std::static_pointer_cast<ParameterObserver>(shared_from_this());
+	auto channel = std::make_shared<AsyncChannel>(capacity);
+	Dispatcher::instance().add(self, channel);
+	std::atomic_store(&m_channel, channel);
+}
+
+void ParameterObserver::flush()
+{
+	auto channel = std::atomic_load(&m_channel);
+	if (!channel)
+		return;
+
+	auto target = channel->num_pushed.load(std::memory_order_acquire);
+	Dispatcher::instance().notify();
+	std::unique_lock<std::mutex> lock(channel->mutex);
+	channel->delivered.wait(lock, [&channel, target]() {
+		return channel->num_delivered.load(std::memory_order_acquire) >= target;
+	});
+}
@@ -7,6 +7,9 @@
 #ifndef SHOGUN_PARAMETEROBSERVER_H
 #define SHOGUN_PARAMETEROBSERVER_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -20,6 +23,16 @@ namespace shogun
 
 	/**
 	 * Interface for the parameter observer classes
+	 *
+	 * Observations can be sampled with the parameters "step_interval" (only
+	 * every n-th step) and "time_interval" (at most one value per given
+	 * milliseconds). Values that are not sampled are dropped in the emitting
+	 * thread before they are cloned.
+	 *
+	 * An asynchronous observer, see set_asynchronous(), queues values in a
+	 * bounded queue that a background thread drains, so emitting never
+	 * blocks; values that do not fit in the queue are dropped and counted
+	 * as "num_dropped".
 	 */
 	class ParameterObserver : public SGObject
 	{
@@ -83,11 +96,12 @@ namespace shogun
 		 */
 		ObservedValue* get_observation(index_t i)
 		{
+			std::lock_guard<std::mutex> lock(m_observations_mutex);
 			require(
-			    i >= 0 && i < this->get_num_observations(),
+			    i >= 0 && i < (index_t)m_observations.size(),
 			    "Observation index ({}) is out of bound (total observations "
 			    "{})",
-			    i, this->get_num_observations());
+			    i, m_observations.size());
 			return this->m_observations[i].get();
 		};
 
@@ -96,19 +110,49 @@ namespace shogun
 		 */
 		virtual void clear()
 		{
+			std::lock_guard<std::mutex> lock(m_observations_mutex);
 			m_observations.clear();
 		};
 
 		/**
 		 * Method which will be called when the parameter observable emits a
-		 * value.
+		 * value. The value is delivered to on_next_impl() right away, or on
+		 * the background thread if the observer is asynchronous.
 		 * @param value the value emitted by the parameter observable
 		 */
-		void on_next(const TimedObservedValue& value)
+		void on_next(const TimedObservedValue& value);
+
+		/**
+		 * Whether a value of the given step passes the sampling policies.
+		 * This is cheap, so emitters check it before creating a value.
+		 * @param step step of the value
+		 * @return true if a value of this step would be observed now
+		 */
+		bool samples(int64_t step) const;
+
+		/**
+		 * Deliver values on a background thread through a bounded queue.
+		 * The observer must be owned by a shared_ptr. Values still queued
+		 * when it is destroyed are lost, so call flush() before.
+		 * @param capacity number of values the queue holds, 0 to deliver
+		 * values synchronously again
+		 */
+		void set_asynchronous(int32_t capacity = 1024);
+
+		/**
+		 * @return whether values are delivered on a background thread
+		 */
+		bool is_asynchronous() const
 		{
-			m_observations.push_back(value.first);
-			on_next_impl(value);
-		};
+			return std::atomic_load(&m_channel) != nullptr;
+		}
+
+		/**
+		 * Wait until all values queued so far have been delivered.
+		 * Does nothing for synchronous observers. Must not be called from
+		 * on_next_impl().
+		 */
+		void flush();
 
 		/**
 		 * Method which will be called on errors
@@ -135,6 +179,12 @@ namespace shogun
 		 */
 		index_t get_num_observations() const;
 
+		/**
+		 * Get the number of values dropped because the queue was full.
+		 * @return number of values dropped
+		 */
+		int64_t get_num_dropped() const;
+
 		/**
 		 * Implementation of the on_next method which will be needed
 		 * in order to process the observed value
@@ -158,6 +208,47 @@ namespace shogun
 		 * Subscription id set when I subscribe to a machine
 		 */
 		int64_t m_subscription_id;
+
+		/**
+		 * Observe values of every n-th step only
+		 */
+		int64_t m_step_interval;
+
+		/**
+		 * Minimal milliseconds between two observed values
+		 */
+		int64_t m_time_interval;
+
+	private:
+		/**
+		 * Store a value and pass it to on_next_impl()
+		 * @param value the observed value
+		 */
+		void deliver(const TimedObservedValue& value);
+
+		/**
+		 * Check the time interval and claim it for a value
+		 * @param value the observed value
+		 * @return true if the value is observed
+		 */
+		bool claim_time(const TimedObservedValue& value);
+
+		/** Queue and counters of an asynchronous observer */
+		struct AsyncChannel;
+		/** Background thread that drains the queues */
+		class Dispatcher;
+
+		/** Guards m_observations, which the background thread appends to */
+		mutable std::mutex m_observations_mutex;
+
+		/** Queue of an asynchronous observer, nullptr if synchronous */
+		std::shared_ptr<AsyncChannel> m_channel;
+
+		/** Steady clock nanoseconds of the last value observed */
+		std::atomic<int64_t> m_last_time;
+
+		/** Values dropped because the queue was full */
+		std::atomic<int64_t> m_num_dropped;
 	};
 }
 
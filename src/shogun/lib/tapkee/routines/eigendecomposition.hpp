@@ -82,13 +82,21 @@ EigendecompositionResult eigendecomposition_impl_dense(const MatrixType& wm, Ind
 	return EigendecompositionResult();
 }
 
-//! Randomized redsvd-like implementation of eigendecomposition-based embedding
+//! Randomized implementation of eigendecomposition-based embedding
+//! (range finder with power iterations, Halko, Martinsson and Tropp 2011).
+//! Only products with matrices of target_dimension+skip+oversampling
+//! columns are computed.
 template <class MatrixType, class MatrixOperationType>
 EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm, IndexType target_dimension, unsigned int skip)
 {
 	timed_context context("Randomized eigendecomposition");
 
-	DenseMatrix O(wm.rows(), target_dimension+skip);
+	const IndexType oversampling = 10;
+	const IndexType n_power_iterations = 2;
+	const IndexType n_samples = std::min(static_cast<IndexType>(wm.rows()),
+	                                     target_dimension+skip+oversampling);
+
+	DenseMatrix O(wm.rows(), n_samples);
 	for (IndexType i=0; i<O.rows(); ++i)
 	{
 		for (IndexType j=0; j<O.cols(); j++)
@@ -98,25 +106,16 @@ EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm
 	}
 	MatrixOperationType operation(wm);
 
-	DenseMatrix Y = operation(O);
-	for (IndexType i=0; i<Y.cols(); i++)
-	{
-		for (IndexType j=0; j<i; j++)
-		{
-			ScalarType r = Y.col(i).dot(Y.col(j));
-			Y.col(i) -= r*Y.col(j);
-		}
-		ScalarType norm = Y.col(i).norm();
-		if (norm < 1e-4)
-		{
-			for (int k = i; k<Y.cols(); k++)
-				Y.col(k).setZero();
-		}
-		Y.col(i) *= (1.f / norm);
-	}
+	// orthonormalize after every product so that the directions of
+	// smaller eigenvalues are not lost to rounding
+	DenseMatrix identity = DenseMatrix::Identity(wm.rows(), n_samples);
+	DenseMatrix Y = operation(O).householderQr().householderQ() * identity;
+	for (IndexType i=0; i<n_power_iterations; i++)
+		Y = operation(Y).householderQr().householderQ() * identity;
 
-	DenseMatrix B1 = operation(Y);
-	DenseMatrix B = Y.householderQr().solve(B1);
+	// Rayleigh-Ritz projection of the (symmetric) operator
+	DenseMatrix B = Y.transpose() * operation(Y);
+	B = (B + B.transpose().eval()) / 2.0;
 	DenseSelfAdjointEigenSolver eigenOfB(B);
 
 	if (eigenOfB.info() == Eigen::Success)
@@ -125,12 +124,17 @@ EigendecompositionResult eigendecomposition_impl_randomized(const MatrixType& wm
 		{
 			assert(skip==0);
 			DenseMatrix selected_eigenvectors = (Y*eigenOfB.eigenvectors()).rightCols(target_dimension);
-			return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues());
+			return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues().tail(target_dimension));
 		}
 		else
 		{
-			DenseMatrix selected_eigenvectors = (Y*eigenOfB.eigenvectors()).leftCols(target_dimension+skip).rightCols(target_dimension);
-			return EigendecompositionResult(selected_eigenvectors,eigenOfB.eigenvalues());
+			// the operator is the inverse, so the smallest eigenvalues of
+			// the matrix are the inverses of the largest ones of B
+			DenseMatrix selected_eigenvectors = (Y*eigenOfB.eigenvectors()).
+				rightCols(target_dimension+skip).leftCols(target_dimension).rowwise().reverse();
+			DenseVector selected_eigenvalues = eigenOfB.eigenvalues().
+				segment(n_samples-skip-target_dimension,target_dimension).reverse().cwiseInverse();
+			return EigendecompositionResult(selected_eigenvectors,selected_eigenvalues);
 		}
 	}
 	else
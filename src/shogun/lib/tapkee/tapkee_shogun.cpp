@@ -82,6 +82,8 @@ std::shared_ptr<DenseFeatures<float64_t>> shogun::tapkee_embed(const shogun::TAP
 #else
 	tapkee::EigenMethod eigen_method = tapkee::Dense;
 #endif
+	if (parameters.randomized_eigendecomposition)
+		eigen_method = tapkee::Randomized;
 #ifdef TAPKEE_USE_LGPL_COVERTREE
 	tapkee::NeighborsMethod neighbors_method = tapkee::CoverTree;
 #else
@@ -51,6 +51,7 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
 		sne_perplexity(30.0), squishing_rate(0.99),
+		randomized_eigendecomposition(false),
 		kernel(NULL), distance(NULL), features(NULL)
 	{
 	}
@@ -69,6 +70,7 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t sne_theta;
 	float64_t sne_perplexity;
 	float64_t squishing_rate;
+	bool randomized_eigendecomposition;
 	Kernel* kernel;
 	Distance* distance;
 	DotFeatures* features;
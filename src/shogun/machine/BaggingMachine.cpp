@@ -6,6 +6,7 @@
  */
 
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
 #include <shogun/base/progress.h>
 #include <shogun/ensemble/CombinationRule.h>
 #include <shogun/ensemble/MeanRule.h>
@@ -14,6 +15,7 @@
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/evaluation/Evaluation.h>
 
+#include <mutex>
 #include <utility>
 
 using namespace shogun;
@@ -107,8 +109,7 @@ BaggingMachine::apply_outputs_without_combination(std::shared_ptr<Features> data
 	SGMatrix<float64_t> output(data->get_num_vectors(), m_num_bags);
 	output.zero();
 
-#pragma omp parallel for
-	for (int32_t i = 0; i < m_num_bags; ++i)
+	env()->scheduler()->parallel_for(0, m_num_bags, [&](index_t i)
 	{
 		auto m = m_bags.at(i);
 		auto l = m->apply(data);
@@ -120,7 +121,7 @@ BaggingMachine::apply_outputs_without_combination(std::shared_ptr<Features> data
 
 		float64_t* bag_results = output.get_column_vector(i);
 		sg_memcpy(bag_results, lv.vector, lv.vlen * sizeof(float64_t));
-	}
+	}, 1);
 
 	return output;
 }
@@ -151,12 +152,18 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 
 	m_oob_indices.clear();
 
+	// bags are stored by index, so that their order does not depend on
+	// the threads
+	m_bags.resize(m_num_bags);
+	m_oob_indices.resize(m_num_bags);
+
 	SGMatrix<index_t> rnd_indicies(m_bag_size, m_num_bags);
 	random::fill_array(rnd_indicies, 0, m_bag_size - 1, m_prng);
 
+	// guards m_all_oob_idx
+	std::mutex oob_mutex;
 	auto pb = SG_PROGRESS(range(m_num_bags));
-#pragma omp parallel for
-	for (int32_t i = 0; i < m_num_bags; ++i)
+	env()->scheduler()->parallel_for(0, m_num_bags, [&](index_t i)
 	{
 		auto c=std::dynamic_pointer_cast<Machine>(m_machine->clone());
 		ASSERT(c != NULL);
@@ -201,18 +208,17 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 		features->remove_subset();
 		labels->remove_subset();
 
-#pragma omp critical
-		{
 		// get out of bag indexes
-		auto oob = get_oob_indices(idx);
-		m_oob_indices.push_back(oob);
+		{
+			std::lock_guard<std::mutex> lock(oob_mutex);
+			m_oob_indices[i] = get_oob_indices(idx);
+		}
 
 		// add trained machine to bag array
-		m_bags.push_back(c);
-		}
+		m_bags[i] = c;
 
 		pb.print_progress();
-	}
+	}, 1);
 	pb.complete();
 
 	return true;
@@ -8,6 +8,7 @@
 #include <shogun/machine/KernelMulticlassMachine.h>
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/labels/BinaryLabels.h>
 #include <shogun/machine/KernelMachine.h>
 
 #include <unordered_set>
@@ -73,6 +74,95 @@ void KernelMulticlassMachine::store_model_features()
 	}
 }
 
+std::vector<std::shared_ptr<BinaryLabels>> KernelMulticlassMachine::get_submachines_outputs()
+{
+	if (!m_kernel || m_machines.empty())
+		return MulticlassMachine::get_submachines_outputs();
+
+	bool fall_back=m_kernel->has_property(KP_LINADD) &&
+		m_kernel->get_is_initialized();
+	for (auto m: m_machines)
+	{
+		auto machine=std::dynamic_pointer_cast<KernelMachine>(m);
+		if (!machine || machine->get_kernel()!=m_kernel ||
+			(m_kernel->has_property(KP_BATCHEVALUATION) &&
+			 machine->get_batch_computation_enabled()))
+			fall_back=true;
+	}
+	/* submachines evaluate the kernel their own way */
+	if (fall_back)
+		return MulticlassMachine::get_submachines_outputs();
+
+	int32_t num_machines=m_machines.size();
+
+	/* position of every support vector in the union of all of them */
+	std::vector<index_t> sv_position(m_kernel->get_num_vec_lhs(), -1);
+	std::vector<index_t> all_sv;
+	std::vector<SGVector<index_t>> machine_sv(num_machines);
+	std::vector<SGVector<float64_t>> machine_alphas(num_machines);
+	SGVector<float64_t> biases(num_machines);
+	for (int32_t i=0; i<num_machines; ++i)
+	{
+		auto machine=m_machines[i]->as<KernelMachine>();
+		int32_t num_sv=machine->get_num_support_vectors();
+		machine_sv[i]=SGVector<index_t>(num_sv);
+		machine_alphas[i]=SGVector<float64_t>(num_sv);
+		for (int32_t j=0; j<num_sv; ++j)
+		{
+			index_t sv=machine->get_support_vector(j);
+			if (sv_position[sv]<0)
+			{
+				sv_position[sv]=all_sv.size();
+				all_sv.push_back(sv);
+			}
+			machine_sv[i][j]=sv_position[sv];
+			machine_alphas[i][j]=machine->get_alpha(j);
+		}
+		biases[i]=machine->get_bias();
+	}
+
+	auto rhs=m_kernel->get_rhs();
+	int32_t num_vectors=rhs ? rhs->get_num_vectors() : m_kernel->get_num_vec_rhs();
+	int32_t num_all_sv=all_sv.size();
+
+	SG_DEBUG("{}: evaluating kernel between {} test vectors and {} support "
+			"vectors of {} submachines", get_name(), num_vectors, num_all_sv,
+			num_machines);
+
+	/* one vector per row, one submachine per column */
+	SGMatrix<float64_t> scores(num_vectors, num_machines);
+#pragma omp parallel
+	{
+		SGVector<float64_t> kernel_values(num_all_sv);
+
+#pragma omp for
+		for (int32_t vec=0; vec<num_vectors; ++vec)
+		{
+			for (int32_t k=0; k<num_all_sv; ++k)
+				kernel_values[k]=m_kernel->kernel(all_sv[k], vec);
+
+			for (int32_t i=0; i<num_machines; ++i)
+			{
+				float64_t score=biases[i];
+				for (int32_t j=0; j<machine_sv[i].vlen; ++j)
+					score+=machine_alphas[i][j]*kernel_values[machine_sv[i][j]];
+				scores(vec, i)=score;
+			}
+		}
+	}
+
+	std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
+	for (int32_t i=0; i<num_machines; ++i)
+	{
+		SGVector<float64_t> output(num_vectors);
+		sg_memcpy(output.vector, scores.get_column_vector(i),
+				sizeof(float64_t)*num_vectors);
+		outputs[i]=std::make_shared<BinaryLabels>(output);
+	}
+
+	return outputs;
+}
+
 KernelMulticlassMachine::KernelMulticlassMachine() : MulticlassMachine(), m_kernel(NULL)
 {
 	SG_ADD(&m_kernel,"kernel", "The kernel to be used", ParameterProperties::HYPER);
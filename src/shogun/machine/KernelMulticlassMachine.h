@@ -63,6 +63,15 @@ class KernelMulticlassMachine : public MulticlassMachine
 		 */
 		virtual void store_model_features();
 
+		/** get outputs of all submachines. Unless the kernel uses linadd
+		 * or batch evaluation, the kernel is evaluated only once between
+		 * every test vector and the union of the support vectors of all
+		 * submachines.
+		 *
+		 * @return outputs, one per submachine
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>> get_submachines_outputs();
+
 	protected:
 
 		/** init machine for training with kernel init */
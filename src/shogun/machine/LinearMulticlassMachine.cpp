@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+using namespace shogun;
+
+std::vector<std::shared_ptr<BinaryLabels>> LinearMulticlassMachine::get_submachines_outputs()
+{
+	if (!m_features || m_machines.empty() ||
+	    m_features->get_feature_class() != C_DENSE ||
+	    m_features->get_feature_type() != F_DREAL)
+		return MulticlassMachine::get_submachines_outputs();
+
+	int32_t num_machines=m_machines.size();
+	int32_t dim=m_features->get_dim_feature_space();
+
+	SGMatrix<float64_t> weights(dim, num_machines);
+	SGVector<float64_t> biases(num_machines);
+	for (int32_t i=0; i<num_machines; ++i)
+	{
+		auto machine=m_machines[i]->as<LinearMachine>();
+		auto w=machine->get_w();
+		require(w.vlen==dim, "Dimension of weight vector {} ({}) does not "
+				"match dimension of features ({})", i, w.vlen, dim);
+
+		sg_memcpy(weights.get_column_vector(i), w.vector, sizeof(float64_t)*dim);
+		biases[i]=machine->get_bias();
+	}
+
+	/* one vector per row, one submachine per column */
+	auto feature_matrix=
+		m_features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	auto scores=linalg::matrix_prod(feature_matrix, weights, true, false);
+
+	int32_t num_vectors=scores.num_rows;
+	std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
+	for (int32_t i=0; i<num_machines; ++i)
+	{
+		SGVector<float64_t> output(num_vectors);
+		float64_t* column=scores.get_column_vector(i);
+		for (int32_t j=0; j<num_vectors; ++j)
+			output[j]=column[j]+biases[i];
+
+		outputs[i]=std::make_shared<BinaryLabels>(output);
+	}
+
+	return outputs;
+}
+
+std::shared_ptr<Features> LinearMulticlassMachine::get_submachine_train_features(
+		const SGVector<index_t>& subset) const
+{
+	if (subset.vlen)
+		return view(m_features, subset);
+
+	return m_features->duplicate();
+}
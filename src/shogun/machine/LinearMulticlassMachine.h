@@ -81,6 +81,14 @@ class LinearMulticlassMachine : public MulticlassMachine
 			return m_features;
 		}
 
+		/** get outputs of all submachines. For dense features, the weight
+		 * vectors are stacked into one matrix and all submachines are
+		 * scored with a single matrix product.
+		 *
+		 * @return outputs, one per submachine
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>> get_submachines_outputs();
+
 	protected:
 
 		/** init machine for train with setting features */
@@ -114,6 +122,22 @@ class LinearMulticlassMachine : public MulticlassMachine
 			return true;
 		}
 
+		/** linear submachines can be trained concurrently on shallow
+		 * copies of the features
+		 */
+		virtual bool supports_parallel_training() const
+		{
+			return true;
+		}
+
+		/** training features of one submachine
+		 *
+		 * @param subset subset indices, all vectors if empty
+		 * @return shallow copy of the features with the subset
+		 */
+		virtual std::shared_ptr<Features>
+		get_submachine_train_features(const SGVector<index_t>& subset) const;
+
 		/** check features availability */
 		virtual bool is_ready()
 		{
@@ -8,7 +8,9 @@
 #include <shogun/machine/LinearStructuredOutputMachine.h>
 #include <shogun/features/Features.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -40,6 +42,13 @@ SGVector< float64_t > LinearStructuredOutputMachine::get_w() const
 	return m_w;
 }
 
+SGVector<float64_t> LinearStructuredOutputMachine::get_oracle_times() const
+{
+	SGVector<float64_t> times(m_oracle_times.size());
+	std::copy(m_oracle_times.begin(), m_oracle_times.end(), times.vector);
+	return times;
+}
+
 std::shared_ptr<StructuredLabels> LinearStructuredOutputMachine::apply_structured(std::shared_ptr<Features> data)
 {
 	if (data)
@@ -58,11 +67,9 @@ std::shared_ptr<StructuredLabels> LinearStructuredOutputMachine::apply_structure
 	std::shared_ptr<StructuredLabels> out;
 	out = m_model->structured_labels_factory(num_input_vectors);
 
+	auto predictions = m_model->predict_batch(m_w, num_input_vectors);
 	for ( int32_t i = 0 ; i < num_input_vectors ; ++i )
-	{
-		auto result = m_model->argmax(m_w, i, false);
-		out->add_label(result->argmax);
-	}
+		out->add_label(predictions[i]);
 
 	io::info("{}", out->to_string());
 
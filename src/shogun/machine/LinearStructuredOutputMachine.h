@@ -13,6 +13,8 @@
 #include <shogun/machine/StructuredOutputMachine.h>
 #include <shogun/lib/SGVector.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -57,6 +59,13 @@ class LinearStructuredOutputMachine : public StructuredOutputMachine
 		 */
 		virtual std::shared_ptr<StructuredLabels> apply_structured(std::shared_ptr<Features> data = NULL);
 
+		/** get the wall-clock time spent in the loss-augmented inference
+		 * (argmax oracle) in each iteration of the last training run
+		 *
+		 * @return oracle time per iteration in seconds
+		 */
+		SGVector<float64_t> get_oracle_times() const;
+
 		/** @return object name */
 		virtual const char* get_name() const
 		{
@@ -71,6 +80,9 @@ class LinearStructuredOutputMachine : public StructuredOutputMachine
 		/** weight vector */
 		SGVector< float64_t > m_w;
 
+		/** oracle time per iteration of the last training run */
+		std::vector<float64_t> m_oracle_times;
+
 }; /* class LinearStructuredOutputMachine */
 
 } /* namespace shogun */
@@ -8,6 +8,7 @@
 
 #include <rxcpp/rx-lite.hpp>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/machine/Machine.h>
 
 using namespace shogun;
@@ -33,6 +34,7 @@ Machine::~Machine()
 
 bool Machine::train(std::shared_ptr<Features> data)
 {
+	SG_TRACE_SCOPE("Machine::train");
 	if (train_require_labels())
 	{
 		if (m_labels == NULL)
@@ -44,33 +46,60 @@ bool Machine::train(std::shared_ptr<Features> data)
 	auto sub = connect_to_signal_handler();
 	bool result = false;
 
-	if (support_feature_dispatching())
+	try
 	{
-		require(data != NULL, "Features not provided!");
-		require(
-		    data->get_num_vectors() == m_labels->get_num_labels(),
-		    "Number of training vectors ({}) does not match number of "
-		    "labels ({})",
-		    data->get_num_vectors(), m_labels->get_num_labels());
-
-		if (support_dense_dispatching() && data->get_feature_class() == C_DENSE)
-			result = train_dense(data);
-		else if (
-		    support_string_dispatching() &&
-		    data->get_feature_class() == C_STRING)
-			result = train_string(data);
+		if (support_feature_dispatching())
+		{
+			require(data != NULL, "Features not provided!");
+			require(
+			    data->get_num_vectors() == m_labels->get_num_labels(),
+			    "Number of training vectors ({}) does not match number of "
+			    "labels ({})",
+			    data->get_num_vectors(), m_labels->get_num_labels());
+
+			if (support_dense_dispatching() &&
+			    data->get_feature_class() == C_DENSE)
+				result = train_dense(data);
+			else if (
+			    support_string_dispatching() &&
+			    data->get_feature_class() == C_STRING)
+				result = train_string(data);
+			else
+				error(
+				    "Training with {} is not implemented!", data->get_name());
+		}
 		else
-			error("Training with {} is not implemented!", data->get_name());
+			result = train_machine(data);
+	}
+	catch (...)
+	{
+		disconnect_from_signal_handler(sub);
+		throw;
 	}
-	else
-		result = train_machine(data);
 
-	sub.unsubscribe();
-	reset_computation_variables();
+	disconnect_from_signal_handler(sub);
 
 	return result;
 }
 
+TaskFuture<bool> Machine::train_async(
+    std::shared_ptr<Features> data, std::chrono::milliseconds timeout)
+{
+	auto machine = as<Machine>();
+	return env()->executor()->submit<bool>(
+	    [machine, data]() { return machine->train(data); },
+	    [machine]() { machine->stop_computation(); }, timeout);
+}
+
+TaskFuture<std::shared_ptr<Labels>> Machine::apply_async(
+    std::shared_ptr<Features> data, std::chrono::milliseconds timeout)
+{
+	auto machine = as<Machine>();
+	return env()->executor()->submit<std::shared_ptr<Labels>>(
+	    [machine, data]() { return machine->apply(data); },
+	    [machine]() { machine->stop_computation(); }, timeout);
+}
+
 void Machine::set_labels(std::shared_ptr<Labels> lab)
 {
     if (lab != NULL)
@@ -119,27 +148,38 @@ std::shared_ptr<Labels> Machine::apply(std::shared_ptr<Features> data)
 
 	std::shared_ptr<Labels> result=NULL;
 
-	switch (get_machine_problem_type())
+	// like training, applying can be stopped, e.g. by apply_async()
+	auto sub = connect_to_signal_handler();
+	try
+	{
+		switch (get_machine_problem_type())
+		{
+			case PT_BINARY:
+				result=apply_binary(data);
+				break;
+			case PT_REGRESSION:
+				result=apply_regression(data);
+				break;
+			case PT_MULTICLASS:
+				result=apply_multiclass(data);
+				break;
+			case PT_STRUCTURED:
+				result=apply_structured(data);
+				break;
+			case PT_LATENT:
+				result=apply_latent(data);
+				break;
+			default:
+				error("Unknown problem type");
+				break;
+		}
+	}
+	catch (...)
 	{
-		case PT_BINARY:
-			result=apply_binary(data);
-			break;
-		case PT_REGRESSION:
-			result=apply_regression(data);
-			break;
-		case PT_MULTICLASS:
-			result=apply_multiclass(data);
-			break;
-		case PT_STRUCTURED:
-			result=apply_structured(data);
-			break;
-		case PT_LATENT:
-			result=apply_latent(data);
-			break;
-		default:
-			error("Unknown problem type");
-			break;
+		disconnect_from_signal_handler(sub);
+		throw;
 	}
+	disconnect_from_signal_handler(sub);
 
 	SG_TRACE("leaving {}::apply({} at {})",
 			get_name(), data ? data->get_name() : "NULL", fmt::ptr(data.get()));
@@ -11,6 +11,7 @@
 #ifndef _MACHINE_H__
 #define _MACHINE_H__
 
+#include <shogun/base/Executor.h>
 #include <shogun/base/class_list.h>
 #include <shogun/features/Features.h>
 #include <shogun/labels/BinaryLabels.h>
@@ -162,6 +163,40 @@ class Machine : public StoppableSGObject
 		 */
 		virtual std::shared_ptr<Labels> apply(std::shared_ptr<Features> data=NULL);
 
+#ifndef SWIG
+		/** train machine on the global executor, see train()
+		 *
+		 * Cancelling the returned task stops training as SIGINT does.
+		 * The machine must be owned by a std::shared_ptr and must not be
+		 * changed until the task is done.
+		 *
+		 * @param data training data
+		 * @param timeout cancel training if it is not done after this
+		 * long, zero for no timeout
+		 * @return handle of the result of train()
+		 */
+		TaskFuture<bool> train_async(
+		    std::shared_ptr<Features> data = NULL,
+		    std::chrono::milliseconds timeout =
+		        std::chrono::milliseconds::zero());
+
+		/** apply machine on the global executor, see apply()
+		 *
+		 * Cancelling the returned task stops applying as SIGINT does:
+		 * machines that check for it, e.g. KernelMachine and KNN, return
+		 * the labels computed so far, others finish.
+		 *
+		 * @param data (test)data to be classified
+		 * @param timeout cancel the task if it is not done after this
+		 * long, zero for no timeout
+		 * @return handle of the result of apply()
+		 */
+		TaskFuture<std::shared_ptr<Labels>> apply_async(
+		    std::shared_ptr<Features> data = NULL,
+		    std::chrono::milliseconds timeout =
+		        std::chrono::milliseconds::zero());
+#endif
+
 		/** apply machine to data in means of binary classification problem */
 		virtual std::shared_ptr<BinaryLabels> apply_binary(std::shared_ptr<Features> data=NULL);
 		/** apply machine to data in means of regression problem */
@@ -6,6 +6,8 @@
  *          Evan Shelhamer, Shell Hu, Thoralf Klein, Viktor Gal
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/progress.h>
 #include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/KernelMachine.h>
@@ -14,6 +16,8 @@
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/labels/MultilabelLabels.h>
 
+#include <atomic>
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -69,6 +73,15 @@ std::shared_ptr<BinaryLabels> MulticlassMachine::get_submachine_outputs(int32_t
 	return machine->apply_binary();
 }
 
+std::vector<std::shared_ptr<BinaryLabels>> MulticlassMachine::get_submachines_outputs()
+{
+	std::vector<std::shared_ptr<BinaryLabels>> outputs(m_machines.size());
+	for (int32_t i=0; i<utils::safe_convert<int32_t>(m_machines.size()); ++i)
+		outputs[i] = get_submachine_outputs(i);
+
+	return outputs;
+}
+
 float64_t MulticlassMachine::get_submachine_output(int32_t i, int32_t num)
 {
 	auto machine = get_machine(i);
@@ -109,14 +122,12 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 		else
 			result->allocate_confidences_for(num_machines);
 
-		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
+		auto outputs = get_submachines_outputs();
 		SGVector<float64_t> As(num_machines);
 		SGVector<float64_t> Bs(num_machines);
 
 		for (int32_t i=0; i<num_machines; ++i)
 		{
-			outputs[i] = get_submachine_outputs(i);
-
 			if (heuris==OVA_SOFTMAX)
 			{
 				Statistics::SigmoidParamters params = Statistics::fit_sigmoid(outputs[i]->get_values());
@@ -195,10 +206,7 @@ std::shared_ptr<MultilabelLabels> MulticlassMachine::apply_multilabel_output(std
 		require(n_outputs<=num_machines,"You request more outputs than machines available");
 
 		auto result=std::make_shared<MultilabelLabels>(num_vectors, n_outputs);
-		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
-
-		for (int32_t i=0; i < num_machines; ++i)
-			outputs[i] = get_submachine_outputs(i);
+		auto outputs = get_submachines_outputs();
 
 		SGVector<float64_t> output_for_i(num_machines);
 		for (int32_t i=0; i<num_vectors; i++)
@@ -236,6 +244,21 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 
 	m_multiclass_strategy->train_start(
 	    multiclass_labels(m_labels), train_labels);
+	if (supports_parallel_training() && env()->get_num_threads() > 1)
+	{
+		try
+		{
+			train_submachines_parallel(train_labels);
+		}
+		catch (...)
+		{
+			m_multiclass_strategy->train_stop();
+			throw;
+		}
+		m_multiclass_strategy->train_stop();
+		return true;
+	}
+
 	while (m_multiclass_strategy->train_has_more())
 	{
 		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
@@ -261,6 +284,75 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void MulticlassMachine::train_submachines_parallel(std::shared_ptr<BinaryLabels> train_labels)
+{
+	/* the strategy prepares one binary problem after the other, so collect
+	 * them all before training */
+	std::vector<SGVector<index_t>> subsets;
+	std::vector<SGVector<float64_t>> problem_labels;
+	while (m_multiclass_strategy->train_has_more())
+	{
+		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+		if (subset.vlen)
+			train_labels->add_subset(subset);
+
+		problem_labels.push_back(train_labels->get_labels_copy());
+
+		if (subset.vlen)
+			train_labels->remove_subset();
+
+		subsets.push_back(subset);
+	}
+
+	int32_t num_machines=subsets.size();
+	m_machines.resize(num_machines);
+
+	SG_DEBUG("training {} submachines of {} on {} threads", num_machines,
+			m_machine->get_name(), env()->get_num_threads());
+
+	auto pb = SG_PROGRESS(range(num_machines));
+	// an exception escaping the parallel region terminates the program, so
+	// the first one is kept and rethrown after the region, and the
+	// submachines not started yet are skipped
+	std::exception_ptr exception;
+	std::atomic<bool> failed(false);
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_machines; ++i)
+	{
+		if (failed.load(std::memory_order_relaxed))
+			continue;
+
+		try
+		{
+			// only need to clone hyperparameters and settings of machine
+			// model parameters are inferred/learned during training
+			auto machine = make_clone(m_machine,
+					ParameterProperties::HYPER | ParameterProperties::SETTING);
+
+			machine->set_labels(std::make_shared<BinaryLabels>(problem_labels[i]));
+			machine->train(get_submachine_train_features(subsets[i]));
+			m_machines[i] = get_machine_from_trained(machine);
+		}
+		catch (...)
+		{
+#pragma omp critical
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+			failed.store(true, std::memory_order_relaxed);
+		}
+		pb.print_progress();
+	}
+
+	if (exception)
+	{
+		m_machines.clear();
+		std::rethrow_exception(exception);
+	}
+	pb.complete();
+}
+
 float64_t MulticlassMachine::apply_one(int32_t vec_idx)
 {
 	init_machines_for_apply(NULL);
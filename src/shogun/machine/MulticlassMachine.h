@@ -16,6 +16,8 @@
 
 #include <shogun/util/converters.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -79,6 +81,12 @@ class MulticlassMachine : public BaseMulticlassMachine
 		 */
 		virtual std::shared_ptr<BinaryLabels> get_submachine_outputs(int32_t i);
 
+		/** get outputs of all submachines at once, which allows subclasses
+		 * to share work between the submachines
+		 * @return outputs, one per submachine
+		 */
+		virtual std::vector<std::shared_ptr<BinaryLabels>> get_submachines_outputs();
+
 		/** get output of i-th submachine for num-th vector
 		 * @param i number of submachine
 		 * @param num number of feature vector
@@ -186,6 +194,27 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset() = 0;
 
+		/** whether the submachines may be trained concurrently, each as a
+		 * clone of the base machine on its own view of the training data
+		 */
+		virtual bool supports_parallel_training() const
+		{
+			return false;
+		}
+
+		/** training features of one submachine, not shared with the other
+		 * submachines. Only called if supports_parallel_training().
+		 *
+		 * @param subset subset indices, all vectors if empty
+		 * @return features
+		 */
+		virtual std::shared_ptr<Features>
+		get_submachine_train_features(const SGVector<index_t>& subset) const
+		{
+			not_implemented(SOURCE_LOCATION);
+			return nullptr;
+		}
+
 		/** whether the machine is acceptable in set_machine */
 		virtual bool is_acceptable_machine(std::shared_ptr<Machine >machine)
 		{
@@ -197,6 +226,14 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** register parameters */
 		void register_parameters();
 
+		/** prepares all binary problems of the strategy and trains the
+		 * submachines concurrently. The first exception thrown by a
+		 * submachine is rethrown once all threads are done.
+		 *
+		 * @param train_labels binary labels the strategy writes to
+		 */
+		void train_submachines_parallel(std::shared_ptr<BinaryLabels> train_labels);
+
 	protected:
 		/** type of multiclass strategy */
 		std::shared_ptr<MulticlassStrategy >m_multiclass_strategy;
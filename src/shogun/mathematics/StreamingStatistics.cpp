@@ -0,0 +1,304 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StreamingStatistics.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+
+/** moments of a set of vectors */
+struct Moments
+{
+	int64_t num_examples;
+	VectorXd mean;
+	VectorXd m2;
+	VectorXd min;
+	VectorXd max;
+};
+
+/** @return moments of the columns [begin, end) of data */
+Moments column_moments(const Map<MatrixXd>& data, index_t begin, index_t end)
+{
+	auto block = data.middleCols(begin, end - begin);
+	Moments moments;
+	moments.num_examples = end - begin;
+	moments.mean = block.rowwise().mean();
+	moments.m2 = (block.colwise() - moments.mean).rowwise().squaredNorm();
+	moments.min = block.rowwise().minCoeff();
+	moments.max = block.rowwise().maxCoeff();
+	return moments;
+}
+
+/** adds the moments b to a, pairwise update of Chan et al. */
+void combine(Moments& a, const Moments& b)
+{
+	if (b.num_examples == 0)
+		return;
+	if (a.num_examples == 0)
+	{
+		a = b;
+		return;
+	}
+
+	const int64_t num_examples = a.num_examples + b.num_examples;
+	VectorXd delta = b.mean - a.mean;
+	a.mean += delta * (float64_t(b.num_examples) / num_examples);
+	a.m2 += b.m2 + delta.cwiseAbs2() * (float64_t(a.num_examples) *
+	                                    b.num_examples / num_examples);
+	a.min = a.min.cwiseMin(b.min);
+	a.max = a.max.cwiseMax(b.max);
+	a.num_examples = num_examples;
+}
+
+}
+
+StreamingStatistics::StreamingStatistics() : SGObject()
+{
+	init();
+}
+
+StreamingStatistics::StreamingStatistics(bool compute_cov) : SGObject()
+{
+	init();
+	m_compute_cov = compute_cov;
+}
+
+StreamingStatistics::~StreamingStatistics()
+{
+}
+
+void StreamingStatistics::init()
+{
+	m_compute_cov = false;
+	m_num_examples = 0;
+
+	SG_ADD(&m_compute_cov, "compute_cov",
+		"Whether to accumulate the covariance matrix", ParameterProperties::SETTING);
+	SG_ADD(&m_num_examples, "num_examples", "Number of vectors");
+	SG_ADD(&m_mean, "mean", "Mean");
+	SG_ADD(&m_m2, "m2", "Sum of squared deviations from the mean");
+	SG_ADD(&m_min, "min", "Minimum");
+	SG_ADD(&m_max, "max", "Maximum");
+	SG_ADD(&m_comoment, "comoment",
+		"Sum of outer products of deviations from the mean");
+}
+
+void StreamingStatistics::update(const SGMatrix<float64_t>& batch)
+{
+	if (batch.num_cols == 0)
+		return;
+
+	Map<MatrixXd> data(batch.matrix, batch.num_rows, batch.num_cols);
+
+	// moments of chunks in parallel, combined in a fixed order so that
+	// results do not depend on the scheduling
+	const int32_t num_chunks = Math::max(
+		Math::min(env()->get_num_threads(), batch.num_cols / 256), 1);
+	std::vector<Moments> chunk_moments(num_chunks);
+
+	#pragma omp parallel for schedule(static, 1)
+	for (int32_t c = 0; c < num_chunks; c++)
+	{
+		const index_t begin = int64_t(batch.num_cols) * c / num_chunks;
+		const index_t end = int64_t(batch.num_cols) * (c + 1) / num_chunks;
+		chunk_moments[c] = column_moments(data, begin, end);
+	}
+
+	Moments moments = chunk_moments[0];
+	for (int32_t c = 1; c < num_chunks; c++)
+		combine(moments, chunk_moments[c]);
+
+	SGVector<float64_t> mean(moments.mean.data(), batch.num_rows, false);
+	SGVector<float64_t> m2(moments.m2.data(), batch.num_rows, false);
+	SGVector<float64_t> min(moments.min.data(), batch.num_rows, false);
+	SGVector<float64_t> max(moments.max.data(), batch.num_rows, false);
+
+	// the comoment of the whole batch is a single (parallel) product
+	SGMatrix<float64_t> comoment;
+	if (m_compute_cov)
+	{
+		comoment = SGMatrix<float64_t>(batch.num_rows, batch.num_rows);
+		Map<MatrixXd> comoment_eig(comoment.matrix, batch.num_rows, batch.num_rows);
+		MatrixXd centered = data.colwise() - moments.mean;
+		comoment_eig.noalias() = centered * centered.transpose();
+	}
+
+	add_moments(moments.num_examples, mean, m2, min, max, comoment);
+}
+
+void StreamingStatistics::update(std::shared_ptr<Features> features, int32_t batch_size)
+{
+	require(features, "No features provided.");
+
+	if (features->get_feature_class() == C_DENSE)
+	{
+		update(features->as<DenseFeatures<float64_t>>()->get_feature_matrix());
+		return;
+	}
+
+	require(
+	    features->get_feature_class() == C_STREAMING_DENSE &&
+	        features->get_feature_type() == F_DREAL,
+	    "Features ({}) must be dense or streaming dense features of 64bit "
+	    "floats.",
+	    features->get_name());
+	require(batch_size > 0, "Batch size ({}) must be positive.", batch_size);
+
+	auto stream = features->as<StreamingDenseFeatures<float64_t>>();
+	stream->start_parser();
+	while (true)
+	{
+		SGMatrix<float64_t> batch = stream->get_streamed_features(batch_size)
+			->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+		update(batch);
+
+		/* stream is exhausted */
+		if (batch.num_cols < batch_size)
+			break;
+	}
+	stream->end_parser();
+}
+
+void StreamingStatistics::merge(const std::shared_ptr<StreamingStatistics>& other)
+{
+	require(other, "No statistics to merge provided.");
+	require(
+	    other->m_compute_cov == m_compute_cov,
+	    "Statistics to merge must both accumulate the covariance or not.");
+
+	add_moments(
+	    other->m_num_examples, other->m_mean, other->m_m2, other->m_min,
+	    other->m_max, other->m_comoment);
+}
+
+void StreamingStatistics::add_moments(
+    int64_t num_examples, const SGVector<float64_t>& mean,
+    const SGVector<float64_t>& m2, const SGVector<float64_t>& min,
+    const SGVector<float64_t>& max, const SGMatrix<float64_t>& comoment)
+{
+	if (num_examples == 0)
+		return;
+
+	const index_t num_features = mean.vlen;
+	if (m_num_examples == 0)
+	{
+		m_num_examples = num_examples;
+		m_mean = mean.clone();
+		m_m2 = m2.clone();
+		m_min = min.clone();
+		m_max = max.clone();
+		if (m_compute_cov)
+			m_comoment = comoment.clone();
+		return;
+	}
+
+	require(
+	    num_features == m_mean.vlen,
+	    "Dimension of the vectors ({}) must match the previous ones ({}).",
+	    num_features, m_mean.vlen);
+
+	Map<VectorXd> mean_a(m_mean.vector, num_features);
+	Map<VectorXd> mean_b(mean.vector, num_features);
+	VectorXd delta = mean_b - mean_a;
+	const float64_t weight =
+		float64_t(m_num_examples) * num_examples / (m_num_examples + num_examples);
+
+	if (m_compute_cov)
+	{
+		Map<MatrixXd> comoment_a(m_comoment.matrix, num_features, num_features);
+		Map<MatrixXd> comoment_b(comoment.matrix, num_features, num_features);
+		comoment_a += comoment_b;
+		comoment_a.noalias() += weight * delta * delta.transpose();
+	}
+
+	Moments a{m_num_examples, mean_a, Map<VectorXd>(m_m2.vector, num_features),
+		Map<VectorXd>(m_min.vector, num_features),
+		Map<VectorXd>(m_max.vector, num_features)};
+	Moments b{num_examples, mean_b, Map<VectorXd>(m2.vector, num_features),
+		Map<VectorXd>(min.vector, num_features),
+		Map<VectorXd>(max.vector, num_features)};
+	combine(a, b);
+
+	m_num_examples = a.num_examples;
+	mean_a = a.mean;
+	Map<VectorXd>(m_m2.vector, num_features) = a.m2;
+	Map<VectorXd>(m_min.vector, num_features) = a.min;
+	Map<VectorXd>(m_max.vector, num_features) = a.max;
+}
+
+void StreamingStatistics::reset()
+{
+	m_num_examples = 0;
+	m_mean = SGVector<float64_t>();
+	m_m2 = SGVector<float64_t>();
+	m_min = SGVector<float64_t>();
+	m_max = SGVector<float64_t>();
+	m_comoment = SGMatrix<float64_t>();
+}
+
+float64_t StreamingStatistics::normalizer(bool unbiased) const
+{
+	require(
+	    m_num_examples > (unbiased ? 1 : 0),
+	    "At least {} vectors are needed, {} were added.", unbiased ? 2 : 1,
+	    m_num_examples);
+	return unbiased ? m_num_examples - 1 : m_num_examples;
+}
+
+SGVector<float64_t> StreamingStatistics::get_mean() const
+{
+	require(m_num_examples > 0, "No vectors were added.");
+	return m_mean.clone();
+}
+
+SGVector<float64_t> StreamingStatistics::get_variance(bool unbiased) const
+{
+	const float64_t n = normalizer(unbiased);
+	SGVector<float64_t> variance(m_m2.vlen);
+	for (index_t i = 0; i < m_m2.vlen; i++)
+		variance[i] = m_m2[i] / n;
+	return variance;
+}
+
+SGVector<float64_t> StreamingStatistics::get_std(bool unbiased) const
+{
+	SGVector<float64_t> std = get_variance(unbiased);
+	for (index_t i = 0; i < std.vlen; i++)
+		std[i] = std::sqrt(std[i]);
+	return std;
+}
+
+SGMatrix<float64_t> StreamingStatistics::get_cov(bool unbiased) const
+{
+	require(
+	    m_compute_cov,
+	    "The covariance matrix is only accumulated with compute_cov set.");
+	const float64_t n = normalizer(unbiased);
+	SGMatrix<float64_t> cov(m_comoment.num_rows, m_comoment.num_cols);
+	for (int64_t i = 0; i < int64_t(cov.num_rows) * cov.num_cols; i++)
+		cov.matrix[i] = m_comoment.matrix[i] / n;
+	return cov;
+}
+
+SGVector<float64_t> StreamingStatistics::get_min() const
+{
+	require(m_num_examples > 0, "No vectors were added.");
+	return m_min.clone();
+}
+
+SGVector<float64_t> StreamingStatistics::get_max() const
+{
+	require(m_num_examples > 0, "No vectors were added.");
+	return m_max.clone();
+}
@@ -0,0 +1,162 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef STREAMING_STATISTICS_H_
+#define STREAMING_STATISTICS_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+class Features;
+template <class T> class StreamingDenseFeatures;
+
+/** @brief Class StreamingStatistics accumulates per-feature count, mean,
+ * variance, minimum, maximum and optionally the covariance matrix of dense
+ * feature vectors in a single pass.
+ *
+ * Batches are split into chunks whose moments are computed in parallel
+ * and combined with the pairwise update of Chan, Golub and LeVeque (1979),
+ * which is also used to merge accumulators of different threads or shards.
+ * Memory does not depend on the number of vectors, so data can be streamed
+ * from StreamingDenseFeatures in mini-batches.
+ *
+ * Preprocessors like RescaleFeatures, PruneVarSubMean and PCA can be fitted
+ * from the accumulated statistics.
+ */
+class StreamingStatistics : public SGObject
+{
+public:
+	/** default constructor */
+	StreamingStatistics();
+
+	/** constructor
+	 * @param compute_cov whether to accumulate the covariance matrix too,
+	 * which needs memory quadratic in the number of features
+	 */
+	StreamingStatistics(bool compute_cov);
+
+	/** destructor */
+	virtual ~StreamingStatistics();
+
+	/** add a batch of vectors
+	 * @param batch matrix with one vector per column
+	 */
+	void update(const SGMatrix<float64_t>& batch);
+
+	/** add all vectors of dense features, or everything that is left in
+	 * a stream of StreamingDenseFeatures
+	 * @param features dense or streaming dense features
+	 * @param batch_size number of vectors read from a stream at once
+	 */
+	void update(std::shared_ptr<Features> features, int32_t batch_size = 1024);
+
+	/** add everything accumulated by another accumulator
+	 * @param other accumulator of vectors of the same dimension
+	 */
+	void merge(const std::shared_ptr<StreamingStatistics>& other);
+
+	/** remove everything added so far */
+	void reset();
+
+	/** @return number of vectors added so far */
+	int64_t get_num_examples() const
+	{
+		return m_num_examples;
+	}
+
+	/** @return dimension of the vectors, 0 before the first update */
+	int32_t get_num_features() const
+	{
+		return m_mean.vlen;
+	}
+
+	/** @return whether the covariance matrix is accumulated */
+	bool get_compute_cov() const
+	{
+		return m_compute_cov;
+	}
+
+	/** @return per-feature mean */
+	SGVector<float64_t> get_mean() const;
+
+	/** @param unbiased whether to divide by n-1 instead of n
+	 * @return per-feature variance
+	 */
+	SGVector<float64_t> get_variance(bool unbiased = false) const;
+
+	/** @param unbiased whether to divide by n-1 instead of n
+	 * @return per-feature standard deviation
+	 */
+	SGVector<float64_t> get_std(bool unbiased = false) const;
+
+	/** @param unbiased whether to divide by n-1 instead of n
+	 * @return covariance matrix, only if compute_cov was set
+	 */
+	SGMatrix<float64_t> get_cov(bool unbiased = false) const;
+
+	/** @return per-feature minimum */
+	SGVector<float64_t> get_min() const;
+
+	/** @return per-feature maximum */
+	SGVector<float64_t> get_max() const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "StreamingStatistics";
+	}
+
+private:
+	/** init */
+	void init();
+
+	/** combines the accumulated moments with the moments of other vectors
+	 * @param num_examples number of other vectors
+	 * @param mean mean of other vectors
+	 * @param m2 sum of squared deviations from their mean
+	 * @param min minimum of other vectors
+	 * @param max maximum of other vectors
+	 * @param comoment sum of outer products of deviations from their mean,
+	 * only used if compute_cov is set
+	 */
+	void add_moments(
+	    int64_t num_examples, const SGVector<float64_t>& mean,
+	    const SGVector<float64_t>& m2, const SGVector<float64_t>& min,
+	    const SGVector<float64_t>& max, const SGMatrix<float64_t>& comoment);
+
+	/** divisor of the second moments
+	 * @param unbiased whether to divide by n-1 instead of n
+	 */
+	float64_t normalizer(bool unbiased) const;
+
+private:
+	/** whether to accumulate the covariance matrix */
+	bool m_compute_cov;
+
+	/** number of vectors */
+	int64_t m_num_examples;
+
+	/** mean */
+	SGVector<float64_t> m_mean;
+
+	/** sum of squared deviations from the mean */
+	SGVector<float64_t> m_m2;
+
+	/** minimum */
+	SGVector<float64_t> m_min;
+
+	/** maximum */
+	SGVector<float64_t> m_max;
+
+	/** sum of outer products of deviations from the mean */
+	SGMatrix<float64_t> m_comoment;
+};
+}
+
+#endif /* STREAMING_STATISTICS_H_ */
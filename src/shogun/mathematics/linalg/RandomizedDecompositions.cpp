@@ -0,0 +1,136 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/RandomizedDecompositions.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+
+/** @return orthonormal basis of the columns of Y (thin Q factor) */
+MatrixXd orthonormalize(const MatrixXd& Y)
+{
+	HouseholderQR<MatrixXd> qr(Y);
+	return qr.householderQ() * MatrixXd::Identity(Y.rows(), Y.cols());
+}
+
+/** @return orthonormal basis approximating the range of A */
+MatrixXd range_finder(
+    const Map<MatrixXd>& A, const Map<MatrixXd>& omega,
+    int32_t num_power_iterations)
+{
+	MatrixXd Q = orthonormalize(A * omega);
+	for (int32_t i = 0; i < num_power_iterations; i++)
+	{
+		// orthonormalize after every product, otherwise the directions of
+		// the smaller singular values are lost to rounding
+		Q = orthonormalize(A.transpose() * Q);
+		Q = orthonormalize(A * Q);
+	}
+	return Q;
+}
+
+} // namespace
+
+void linalg::randomized_svd(
+    const SGMatrix<float64_t>& A, const SGMatrix<float64_t>& omega,
+    SGVector<float64_t>& s, SGMatrix<float64_t>& U, SGMatrix<float64_t>& V,
+    int32_t num_power_iterations)
+{
+	const index_t k = s.vlen;
+	require(
+	    omega.num_rows == A.num_cols,
+	    "Number of rows of the test matrix ({}) doesn't match the number "
+	    "of columns of A ({}).",
+	    omega.num_rows, A.num_cols);
+	require(
+	    k > 0 && k <= omega.num_cols &&
+	        omega.num_cols <= std::min(A.num_rows, A.num_cols),
+	    "Invalid number of singular values ({}) or columns of the test "
+	    "matrix ({}) for a {} x {} matrix.",
+	    k, omega.num_cols, A.num_rows, A.num_cols);
+	require(
+	    U.num_rows == A.num_rows && U.num_cols == k,
+	    "Left singular vectors' matrix ({} x {}) must be {} x {}.",
+	    U.num_rows, U.num_cols, A.num_rows, k);
+	require(
+	    V.num_rows * V.num_cols == 0 ||
+	        (V.num_rows == A.num_cols && V.num_cols == k),
+	    "Right singular vectors' matrix ({} x {}) must be empty or {} x {}.",
+	    V.num_rows, V.num_cols, A.num_cols, k);
+
+	Map<MatrixXd> A_eig(A.matrix, A.num_rows, A.num_cols);
+	Map<MatrixXd> omega_eig(omega.matrix, omega.num_rows, omega.num_cols);
+	const index_t l = omega.num_cols;
+
+	// A ~ QB with B = Q^T A, and B^T = Q2 R, so that the SVD of the small
+	// matrix R^T = W S Z^T gives A ~ (QW) S (Q2 Z)^T
+	MatrixXd Q = range_finder(A_eig, omega_eig, num_power_iterations);
+	MatrixXd Bt = A_eig.transpose() * Q;
+	HouseholderQR<MatrixXd> qr(Bt);
+	MatrixXd Rt = qr.matrixQR()
+	                  .topRows(l)
+	                  .triangularView<Upper>()
+	                  .toDenseMatrix()
+	                  .transpose();
+
+	const bool compute_V = V.num_rows * V.num_cols > 0;
+	JacobiSVD<MatrixXd> svd(
+	    Rt, compute_V ? ComputeThinU | ComputeThinV : ComputeThinU);
+
+	Map<VectorXd> s_eig(s.vector, k);
+	Map<MatrixXd> U_eig(U.matrix, U.num_rows, k);
+	s_eig = svd.singularValues().head(k);
+	U_eig.noalias() = Q * svd.matrixU().leftCols(k);
+
+	if (compute_V)
+	{
+		Map<MatrixXd> V_eig(V.matrix, V.num_rows, k);
+		V_eig.noalias() = (qr.householderQ() * MatrixXd::Identity(Bt.rows(), l)) *
+		                  svd.matrixV().leftCols(k);
+	}
+}
+
+void linalg::randomized_eigen_solver_symmetric(
+    const SGMatrix<float64_t>& A, const SGMatrix<float64_t>& omega,
+    SGVector<float64_t>& eigenvalues, SGMatrix<float64_t>& eigenvectors,
+    int32_t num_power_iterations)
+{
+	const index_t k = eigenvalues.vlen;
+	require(
+	    A.num_rows == A.num_cols, "Matrix A ({} x {}) is not square!",
+	    A.num_rows, A.num_cols);
+	require(
+	    omega.num_rows == A.num_rows,
+	    "Number of rows of the test matrix ({}) doesn't match A ({}).",
+	    omega.num_rows, A.num_rows);
+	require(
+	    k > 0 && k <= omega.num_cols && omega.num_cols <= A.num_rows,
+	    "Invalid number of eigenvalues ({}) or columns of the test matrix "
+	    "({}) for a {} x {} matrix.",
+	    k, omega.num_cols, A.num_rows, A.num_cols);
+	require(
+	    eigenvectors.num_rows == A.num_rows && eigenvectors.num_cols == k,
+	    "Eigenvectors' matrix ({} x {}) must be {} x {}.",
+	    eigenvectors.num_rows, eigenvectors.num_cols, A.num_rows, k);
+
+	Map<MatrixXd> A_eig(A.matrix, A.num_rows, A.num_cols);
+	Map<MatrixXd> omega_eig(omega.matrix, omega.num_rows, omega.num_cols);
+
+	// Rayleigh-Ritz: eigenvectors of Q^T A Q lifted back by Q
+	MatrixXd Q = range_finder(A_eig, omega_eig, num_power_iterations);
+	MatrixXd T = Q.transpose() * (A_eig * Q);
+	SelfAdjointEigenSolver<MatrixXd> solver(T);
+	require(
+	    solver.info() == Eigen::Success,
+	    "Eigendecomposition of the projected matrix failed.");
+
+	Map<VectorXd> eigenvalues_eig(eigenvalues.vector, k);
+	Map<MatrixXd> eigenvectors_eig(eigenvectors.matrix, A.num_rows, k);
+	eigenvalues_eig = solver.eigenvalues().tail(k);
+	eigenvectors_eig.noalias() = Q * solver.eigenvectors().rightCols(k);
+}
@@ -0,0 +1,139 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef RANDOMIZED_DECOMPOSITIONS_H_
+#define RANDOMIZED_DECOMPOSITIONS_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+namespace shogun
+{
+
+	namespace linalg
+	{
+
+		/** Computes the truncated SVD \f$A \approx U S V^T\f$ of the k
+		 * largest singular values using the randomized range finder of
+		 * Halko, Martinsson and Tropp (2011): the range of \f$A\Omega\f$ is
+		 * refined by power iterations and A is decomposed in the resulting
+		 * orthonormal basis. All work besides products with A is on
+		 * matrices with k+oversampling columns, so the cost is
+		 * \f$O(mn(k+p))\f$ per iteration and \f$O((m+n)(k+p)^2)\f$ for the
+		 * decompositions. Products are parallelized by Eigen.
+		 *
+		 * This operation works with CPU backends only.
+		 *
+		 * @param A The matrix (m x n) to decompose
+		 * @param omega Test matrix (n x l), k <= l <= min(m, n), usually
+		 * gaussian
+		 * @param s Pre-allocated vector of length k for the singular
+		 * values, in descending order
+		 * @param U Pre-allocated matrix (m x k) for the left singular vectors
+		 * @param V Pre-allocated matrix (n x k) for the right singular
+		 * vectors, they are not computed if V is empty
+		 * @param num_power_iterations Number of power iterations
+		 */
+		void randomized_svd(
+		    const SGMatrix<float64_t>& A, const SGMatrix<float64_t>& omega,
+		    SGVector<float64_t>& s, SGMatrix<float64_t>& U,
+		    SGMatrix<float64_t>& V, int32_t num_power_iterations);
+
+		/** Computes the eigenvalues and eigenvectors of the k largest
+		 * eigenvalues of a symmetric matrix with the randomized range finder
+		 * (@see randomized_svd) followed by a Rayleigh-Ritz projection.
+		 * The largest eigenvalues have to be the ones of largest magnitude,
+		 * which is the case for positive semi-definite matrices.
+		 *
+		 * This operation works with CPU backends only.
+		 *
+		 * @param A The symmetric matrix (n x n)
+		 * @param omega Test matrix (n x l), k <= l <= n, usually gaussian
+		 * @param eigenvalues Pre-allocated vector of length k for the
+		 * eigenvalues, in ascending order as for eigen_solver_symmetric
+		 * @param eigenvectors Pre-allocated matrix (n x k)
+		 * @param num_power_iterations Number of power iterations
+		 */
+		void randomized_eigen_solver_symmetric(
+		    const SGMatrix<float64_t>& A, const SGMatrix<float64_t>& omega,
+		    SGVector<float64_t>& eigenvalues, SGMatrix<float64_t>& eigenvectors,
+		    int32_t num_power_iterations);
+
+		/** Draws a gaussian test matrix for the randomized decompositions
+		 *
+		 * @param num_rows Number of rows
+		 * @param num_cols Number of columns
+		 * @param prng Random number generator
+		 * @return The test matrix
+		 */
+		template <typename PRNG>
+		SGMatrix<float64_t>
+		gaussian_test_matrix(index_t num_rows, index_t num_cols, PRNG& prng)
+		{
+			NormalDistribution<float64_t> normal_dist;
+			SGMatrix<float64_t> omega(num_rows, num_cols);
+			for (int64_t i = 0; i < int64_t(num_rows) * num_cols; i++)
+				omega.matrix[i] = normal_dist(prng);
+			return omega;
+		}
+
+		/** Computes the truncated SVD of the k largest singular values
+		 * (@see randomized_svd) with a gaussian test matrix.
+		 *
+		 * @param A The matrix (m x n) to decompose
+		 * @param s Pre-allocated vector of length k for the singular
+		 * values, in descending order
+		 * @param U Pre-allocated matrix (m x k) for the left singular vectors
+		 * @param V Pre-allocated matrix (n x k) for the right singular
+		 * vectors, they are not computed if V is empty
+		 * @param prng Random number generator
+		 * @param oversampling Number of additional columns of the test
+		 * matrix, which improve the accuracy of the k-th singular value
+		 * @param num_power_iterations Number of power iterations, which
+		 * improve the accuracy when the spectrum decays slowly
+		 */
+		template <typename PRNG>
+		void randomized_svd(
+		    const SGMatrix<float64_t>& A, SGVector<float64_t>& s,
+		    SGMatrix<float64_t>& U, SGMatrix<float64_t>& V, PRNG& prng,
+		    index_t oversampling = 10, int32_t num_power_iterations = 2)
+		{
+			auto l = std::min(
+			    s.vlen + oversampling, std::min(A.num_rows, A.num_cols));
+			randomized_svd(
+			    A, gaussian_test_matrix(A.num_cols, l, prng), s, U, V,
+			    num_power_iterations);
+		}
+
+		/** Computes the k largest eigenvalues and their eigenvectors of a
+		 * symmetric matrix (@see randomized_eigen_solver_symmetric) with a
+		 * gaussian test matrix.
+		 *
+		 * @param A The symmetric matrix (n x n)
+		 * @param eigenvalues Pre-allocated vector of length k for the
+		 * eigenvalues, in ascending order
+		 * @param eigenvectors Pre-allocated matrix (n x k)
+		 * @param prng Random number generator
+		 * @param oversampling Number of additional columns of the test
+		 * matrix
+		 * @param num_power_iterations Number of power iterations
+		 */
+		template <typename PRNG>
+		void randomized_eigen_solver_symmetric(
+		    const SGMatrix<float64_t>& A, SGVector<float64_t>& eigenvalues,
+		    SGMatrix<float64_t>& eigenvectors, PRNG& prng,
+		    index_t oversampling = 10, int32_t num_power_iterations = 2)
+		{
+			auto l = std::min(eigenvalues.vlen + oversampling, A.num_rows);
+			randomized_eigen_solver_symmetric(
+			    A, gaussian_test_matrix(A.num_cols, l, prng), eigenvalues,
+			    eigenvectors, num_power_iterations);
+		}
+	} // namespace linalg
+} // namespace shogun
+
+#endif // RANDOMIZED_DECOMPOSITIONS_H_
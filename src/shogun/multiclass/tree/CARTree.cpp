@@ -30,6 +30,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <shogun/lib/Allocator.h>
+#include <shogun/lib/Trace.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -349,7 +351,8 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 
 	auto node=std::make_shared<bnode_t>();
 	auto labels_vec = labels->get_labels();
-	auto mat = data->get_feature_matrix();
+	// the subset of the node is read through a view, not copied
+	auto mat = data->get_feature_matrix_view();
 	auto num_feats=mat.num_rows;
 	auto num_vecs=mat.num_cols;
 
@@ -557,13 +560,14 @@ SGVector<float64_t> CARTree::get_unique_labels(const SGVector<float64_t>& labels
 }
 
 index_t CARTree::compute_best_attribute(
-    const SGMatrix<float64_t>& mat, const SGVector<float64_t>& weights,
+    const SGMatrixView<float64_t>& mat, const SGVector<float64_t>& weights,
     std::shared_ptr<DenseLabels> labels, SGVector<float64_t>& left,
     SGVector<float64_t>& right, SGVector<bool>& is_left_final,
     index_t& num_missing_final, index_t& count_left, index_t& count_right,
     float64_t& impurity, index_t subset_size,
     const SGVector<index_t>& active_indices)
 {
+	SG_TRACE_SCOPE("CARTree::compute_best_attribute");
 	auto labels_vec=labels->get_labels();
 	auto num_vecs=labels->get_num_labels();
 	auto num_feats = (m_pre_sort) ? mat.num_cols : mat.num_rows;
@@ -628,8 +632,25 @@ index_t CARTree::compute_best_attribute(
 		}
 	}
 
+	// the categories of the best nominal split are written to left and
+	// right, which outlive the arena below, so they are sized up front
+	if (std::any_of(m_nominal.begin(), m_nominal.end(), [](bool b) { return b; }))
+	{
+		if (left.vlen < num_vecs)
+			left.resize_vector(num_vecs);
+		if (right.vlen < num_vecs)
+			right.resize_vector(num_vecs);
+	}
+
+	// the temporaries of an attribute are dropped at the end of its
+	// iteration, so they are served from an arena that is recycled for the
+	// next attribute rather than from malloc
+	MemoryArena arena;
 	for (index_t i=0;i<num_feats;++i)
 	{
+		arena.reset();
+		ScopedAllocator arena_scope(arena);
+
 		SGVector<float64_t> feats(num_vecs);
 		SGVector<index_t> sorted_args(num_vecs);
 		SGVector<index_t> temp_count_indices(count_indices.size());
@@ -770,8 +791,6 @@ index_t CARTree::compute_best_attribute(
 
 					index_t l=0;
 					index_t r=0;
-					if (right.vlen < count_right)
-						right.resize_vector(count_right);
 					for (index_t w = 0; w < feats_left.vlen; ++w)
 					{
 						if (feats_left[w])
@@ -886,7 +905,7 @@ index_t CARTree::compute_best_attribute(
 	return best_attribute;
 }
 
-SGVector<bool> CARTree::surrogate_split(SGMatrix<float64_t> m,SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr) const
+SGVector<bool> CARTree::surrogate_split(const SGMatrixView<float64_t>& m,SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr) const
 {
 	// return vector - left/right belongingness
 	SGVector<bool> ret(m.num_cols);
@@ -957,7 +976,7 @@ SGVector<bool> CARTree::surrogate_split(SGMatrix<float64_t> m,SGVector<float64_t
 	return ret;
 }
 
-void CARTree::handle_missing_vecs_for_continuous_surrogate(SGMatrix<float64_t> m, const std::vector<index_t>& missing_vecs,
+void CARTree::handle_missing_vecs_for_continuous_surrogate(const SGMatrixView<float64_t>& m, const std::vector<index_t>& missing_vecs,
 		std::vector<float64_t>& association_index, std::vector<index_t>& intersect_vecs,
 		SGVector<bool> is_left, SGVector<float64_t> weights, float64_t p, index_t attr) const
 {
@@ -1011,7 +1030,7 @@ void CARTree::handle_missing_vecs_for_continuous_surrogate(SGMatrix<float64_t> m
 	}
 }
 
-void CARTree::handle_missing_vecs_for_nominal_surrogate(SGMatrix<float64_t> m, const std::vector<index_t>& missing_vecs,
+void CARTree::handle_missing_vecs_for_nominal_surrogate(const SGMatrixView<float64_t>& m, const std::vector<index_t>& missing_vecs,
 		std::vector<float64_t>& association_index, const std::vector<index_t>& intersect_vecs,
 		SGVector<bool> is_left, SGVector<float64_t> weights, float64_t p, index_t attr) const
 {
@@ -283,7 +283,7 @@ protected:
 	 * @return index to the best attribute
 	 */
 	virtual index_t compute_best_attribute(
-		const SGMatrix<float64_t>& mat, const SGVector<float64_t>& weights,
+		const SGMatrixView<float64_t>& mat, const SGVector<float64_t>& weights,
 		std::shared_ptr<DenseLabels> labels, SGVector<float64_t>& left,
 		SGVector<float64_t>& right, SGVector<bool>& is_left_final,
 		index_t& num_missing, index_t& count_left, index_t& count_right,
@@ -298,7 +298,7 @@ protected:
 	 * @param attr best attribute chosen for split
 	 * @return vector denoting whether a data point goes to left child for all data points including ones with missing attributes
 	 */
-	SGVector<bool> surrogate_split(SGMatrix<float64_t> data, SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr) const;
+	SGVector<bool> surrogate_split(const SGMatrixView<float64_t>& data, SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr) const;
 
 
 	/** handles missing values for a chosen continuous surrogate attribute
@@ -313,7 +313,7 @@ protected:
 	 * @param attr surrogate attribute chosen for split
 	 * @return vector denoting whether a data point goes to left child for all data points including ones with missing attributes
 	 */
-	void handle_missing_vecs_for_continuous_surrogate(SGMatrix<float64_t> m, const std::vector<index_t>& missing_vecs,
+	void handle_missing_vecs_for_continuous_surrogate(const SGMatrixView<float64_t>& m, const std::vector<index_t>& missing_vecs,
 		std::vector<float64_t>& association_index, std::vector<index_t>& intersect_vecs,
 		SGVector<bool> is_left, SGVector<float64_t> weights, float64_t p, index_t attr) const;
 
@@ -329,7 +329,7 @@ protected:
 	 * @param attr surrogate attribute chosen for split
 	 * @return vector denoting whether a data point goes to left child for all data points including ones with missing attributes
 	 */
-	void handle_missing_vecs_for_nominal_surrogate(SGMatrix<float64_t> m, const std::vector<index_t>& missing_vecs,
+	void handle_missing_vecs_for_nominal_surrogate(const SGMatrixView<float64_t>& m, const std::vector<index_t>& missing_vecs,
 		std::vector<float64_t>& association_index, const std::vector<index_t>& intersect_vecs,
 		SGVector<bool> is_left, SGVector<float64_t> weights, float64_t p, index_t attr) const;
 
@@ -50,7 +50,7 @@ void RandomCARTree::set_feature_subset_size(index_t size)
 }
 
 index_t RandomCARTree::compute_best_attribute(
-    const SGMatrix<float64_t>& mat, const SGVector<float64_t>& weights,
+    const SGMatrixView<float64_t>& mat, const SGVector<float64_t>& weights,
     std::shared_ptr<DenseLabels> labels, SGVector<float64_t>& left,
     SGVector<float64_t>& right, SGVector<bool>& is_left_final,
     index_t& num_missing_final, index_t& count_left, index_t& count_right,
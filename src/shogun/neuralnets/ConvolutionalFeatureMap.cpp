@@ -82,12 +82,12 @@ void CConvolutionalFeatureMap::compute_activations(
 	int32_t batch_size = activations.num_cols;
 
 	float64_t bias = parameters[0];
-	for (int32_t i=0; i<m_output_num_neurons; i++)
+	#pragma omp parallel for
+	for (int32_t j=0; j<batch_size; j++)
 	{
-		for (int32_t j=0; j<batch_size; j++)
-		{
-			activations(i+m_row_offset,j) = bias;
-		}
+		float64_t* column = activations.get_column_vector(j) + m_row_offset;
+		for (int32_t i=0; i<m_output_num_neurons; i++)
+			column[i] = bias;
 	}
 
 	int32_t weights_index_offset = 1;
@@ -112,18 +112,23 @@ void CConvolutionalFeatureMap::compute_activations(
 
 	if (m_activation_function==CMAF_LOGISTIC)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				activations(i + m_row_offset, j) =
-				    1.0 /
-				    (1.0 + std::exp(-1.0 * activations(i + m_row_offset, j)));
+		#pragma omp parallel for
+		for (int32_t j=0; j<batch_size; j++)
+		{
+			float64_t* column = activations.get_column_vector(j) + m_row_offset;
+			for (int32_t i=0; i<m_output_num_neurons; i++)
+				column[i] = 1.0 / (1.0 + std::exp(-1.0 * column[i]));
+		}
 	}
 	else if (m_activation_function==CMAF_RECTIFIED_LINEAR)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				activations(i+m_row_offset,j) =
-					Math::max<float64_t>(0, activations(i+m_row_offset,j));
+		#pragma omp parallel for
+		for (int32_t j=0; j<batch_size; j++)
+		{
+			float64_t* column = activations.get_column_vector(j) + m_row_offset;
+			for (int32_t i=0; i<m_output_num_neurons; i++)
+				column[i] = Math::max<float64_t>(0, column[i]);
+		}
 	}
 }
 
@@ -138,31 +143,31 @@ void CConvolutionalFeatureMap::compute_gradients(
 {
 	int32_t batch_size = activation_gradients.num_cols;
 
-	if (m_activation_function==CMAF_LOGISTIC)
+	float64_t bias_gradient = 0;
+	#pragma omp parallel for reduction(+:bias_gradient)
+	for (int32_t j=0; j<batch_size; j++)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
+		float64_t* gradients =
+			activation_gradients.get_column_vector(j) + m_row_offset;
+		const float64_t* outputs =
+			activations.get_column_vector(j) + m_row_offset;
+
+		if (m_activation_function==CMAF_LOGISTIC)
 		{
-			for (int32_t j=0; j<batch_size; j++)
-			{
-				activation_gradients(i+m_row_offset,j) *=
-					activation_gradients(i+m_row_offset,j) *
-					(1.0-activation_gradients(i+m_row_offset,j));
-			}
+			for (int32_t i=0; i<m_output_num_neurons; i++)
+				gradients[i] *= gradients[i] * (1.0-gradients[i]);
 		}
-	}
-	else if (m_activation_function==CMAF_RECTIFIED_LINEAR)
-	{
+		else if (m_activation_function==CMAF_RECTIFIED_LINEAR)
+		{
+			for (int32_t i=0; i<m_output_num_neurons; i++)
+				if (outputs[i]==0)
+					gradients[i] = 0;
+		}
+
 		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				if (activations(i+m_row_offset,j)==0)
-					activation_gradients(i+m_row_offset,j) = 0;
+			bias_gradient += gradients[i];
 	}
 
-	float64_t bias_gradient = 0;
-	for (int32_t i=0; i<m_output_num_neurons; i++)
-		for (int32_t j=0; j<batch_size; j++)
-			bias_gradient += activation_gradients(i+m_row_offset,j);
-
 	parameter_gradients[0] = bias_gradient;
 
 	int32_t weights_index_offset = 1;
@@ -210,6 +215,7 @@ void CConvolutionalFeatureMap::pool_activations(
 		result_height /= pooling_height;
 	}
 
+	#pragma omp parallel for
 	for (int32_t i=0; i<pooled_activations.num_cols; i++)
 	{
 		SGMatrix<float64_t> image(
@@ -272,40 +278,52 @@ void CConvolutionalFeatureMap::convolve(
 	int32_t inputs_row_offset,
  	int32_t outputs_row_offset)
 {
+	// every column of the batch is an independent image, so the batch is
+	// split across threads. The filter window is clipped against the image
+	// borders once per output pixel so that the inner loops run branch free
+	// over contiguous rows of the column major image.
+	#pragma omp parallel for
 	for (int32_t i=0; i<outputs.num_cols; i++)
 	{
-		SGMatrix<float64_t> image(
-			inputs.matrix+i*inputs.num_rows + inputs_row_offset,
-			m_input_height, m_input_width, false);
-
-		SGMatrix<float64_t> result(
-			outputs.matrix+i*outputs.num_rows + outputs_row_offset,
-			m_output_height, m_output_width, false);
+		const float64_t* image =
+			inputs.matrix + i*inputs.num_rows + inputs_row_offset;
+		float64_t* result =
+			outputs.matrix + i*outputs.num_rows + outputs_row_offset;
 
 		for (int32_t x=0; x<m_input_width; x+=m_stride_x)
 		{
+			int32_t x_begin = Math::max(x-m_radius_x, 0);
+			int32_t x_end = Math::min(x+m_radius_x, m_input_width-1);
+
 			for (int32_t y=0; y<m_input_height; y+=m_stride_y)
 			{
+				int32_t y_begin = Math::max(y-m_radius_y, 0);
+				int32_t y_end = Math::min(y+m_radius_y, m_input_height-1);
+
 				int32_t res_x = m_autoencoder_position == NLAP_NONE ? x/m_stride_x : x;
 				int32_t res_y = m_autoencoder_position == NLAP_NONE ? y/m_stride_y : y;
+				int32_t res_index = res_y + res_x*m_output_height;
 
-				float64_t sum = reset_output ? 0 : result(res_y,res_x);
-				for (int32_t x1=x-m_radius_x; x1<=x+m_radius_x; x1++)
+				float64_t sum = reset_output ? 0 : result[res_index];
+				for (int32_t x1=x_begin; x1<=x_end; x1++)
 				{
-					for (int32_t y1=y-m_radius_y; y1<=y+m_radius_y; y1++)
+					const float64_t* image_column = image + x1*m_input_height;
+					if (flip)
 					{
-						if (x1>=0 && y1>=0 && x1<image.num_cols && y1<image.num_rows)
-						{
-							if (flip)
-								sum +=
-									weights(y1-y+m_radius_y,x1-x+m_radius_x)*image(y1,x1);
-							else
-								sum +=
-									weights(m_radius_y-y1+y,m_radius_x-x1+x)*image(y1,x1);
-						}
+						const float64_t* w =
+							weights.get_column_vector(x1-x+m_radius_x);
+						for (int32_t y1=y_begin; y1<=y_end; y1++)
+							sum += w[y1-y+m_radius_y]*image_column[y1];
+					}
+					else
+					{
+						const float64_t* w =
+							weights.get_column_vector(m_radius_x-x1+x);
+						for (int32_t y1=y_begin; y1<=y_end; y1++)
+							sum += w[m_radius_y-y1+y]*image_column[y1];
 					}
 				}
-				result(res_y,res_x) = sum;
+				result[res_index] = sum;
 			}
 		}
 	}
@@ -319,36 +337,55 @@ void CConvolutionalFeatureMap::compute_weight_gradients(
  	int32_t local_gradients_row_offset)
 {
 	weight_gradients.zero();
-	for (int32_t i=0; i<local_gradients.num_cols; i++)
-	{
-		SGMatrix<float64_t> image(
-			inputs.matrix+i*inputs.num_rows + inputs_row_offset,
-			m_input_height, m_input_width, false);
 
-		SGMatrix<float64_t> LG_image(
-			local_gradients.matrix+i*local_gradients.num_rows
-			+ local_gradients_row_offset, m_output_height, m_output_width, false);
+	// each thread accumulates the contributions of its share of the batch
+	// into a private filter sized buffer, the buffers are summed up at the end
+	#pragma omp parallel
+	{
+		SGMatrix<float64_t> local_weight_gradients(
+			weight_gradients.num_rows, weight_gradients.num_cols);
+		local_weight_gradients.zero();
 
-		for (int32_t x=0; x<m_input_width; x+=m_stride_x)
+		#pragma omp for
+		for (int32_t i=0; i<local_gradients.num_cols; i++)
 		{
-			for (int32_t y=0; y<m_input_height; y+=m_stride_y)
+			const float64_t* image =
+				inputs.matrix + i*inputs.num_rows + inputs_row_offset;
+			const float64_t* LG_image = local_gradients.matrix +
+				i*local_gradients.num_rows + local_gradients_row_offset;
+
+			for (int32_t x=0; x<m_input_width; x+=m_stride_x)
 			{
-				for (int32_t x1=x-m_radius_x; x1<=x+m_radius_x; x1++)
+				int32_t x_begin = Math::max(x-m_radius_x, 0);
+				int32_t x_end = Math::min(x+m_radius_x, m_input_width-1);
+
+				for (int32_t y=0; y<m_input_height; y+=m_stride_y)
 				{
-					for (int32_t y1=y-m_radius_y; y1<=y+m_radius_y; y1++)
+					int32_t y_begin = Math::max(y-m_radius_y, 0);
+					int32_t y_end = Math::min(y+m_radius_y, m_input_height-1);
+
+					float64_t lg;
+					if (m_autoencoder_position == NLAP_NONE)
+						lg = LG_image[y/m_stride_y + (x/m_stride_x)*m_output_height];
+					else
+						lg = LG_image[y + x*m_output_height];
+
+					for (int32_t x1=x_begin; x1<=x_end; x1++)
 					{
-						if (x1>=0 && y1>=0 && x1<image.num_cols && y1<image.num_rows)
-						{
-							if (m_autoencoder_position == NLAP_NONE)
-								weight_gradients(m_radius_y-y1+y,m_radius_x-x1+x) +=
-									LG_image(y/m_stride_y,x/m_stride_x)*image(y1,x1);
-							else
-								weight_gradients(m_radius_y-y1+y,m_radius_x-x1+x) +=
-									LG_image(y,x)*image(y1,x1);
-						}
+						const float64_t* image_column = image + x1*m_input_height;
+						float64_t* wg = local_weight_gradients.get_column_vector(
+							m_radius_x-x1+x);
+						for (int32_t y1=y_begin; y1<=y_end; y1++)
+							wg[m_radius_y-y1+y] += lg*image_column[y1];
 					}
 				}
 			}
 		}
+
+		#pragma omp critical
+		{
+			for (int64_t k=0; k<weight_gradients.num_rows*weight_gradients.num_cols; k++)
+				weight_gradients.matrix[k] += local_weight_gradients.matrix[k];
+		}
 	}
 }
@@ -149,6 +149,7 @@ void DeepAutoencoder::pre_train(std::shared_ptr<Features> data)
 		ae->set_gd_momentum(pt_gd_momentum[i-1]);
 		ae->set_gd_mini_batch_size(pt_gd_mini_batch_size[i-1]);
 		ae->set_gd_error_damping_coeff(pt_gd_error_damping_coeff[i-1]);
+		ae->set_single_precision(m_single_precision);
 
 		// forward propagate the data to obtain the training data for the
 		// current autoencoder
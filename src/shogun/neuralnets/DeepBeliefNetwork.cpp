@@ -42,6 +42,7 @@
 #include <shogun/neuralnets/NeuralInputLayer.h>
 #include <shogun/neuralnets/NeuralLogisticLayer.h>
 #include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/Helpers.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
 
@@ -181,6 +182,7 @@ void DeepBeliefNetwork::pre_train(int32_t index,
 	rbm->gd_learning_rate = pt_gd_learning_rate[index];
 	rbm->gd_learning_rate_decay = pt_gd_learning_rate_decay[index];
 	rbm->gd_momentum = pt_gd_momentum[index];
+	rbm->single_precision = single_precision;
 
 	if (index > 0)
 	{
@@ -266,6 +268,7 @@ void DeepBeliefNetwork::train(std::shared_ptr<Features> features)
 
 	top_rbm->cd_num_steps = cd_num_steps;
 	top_rbm->cd_persistent = false;
+	top_rbm->single_precision = single_precision;
 	top_rbm->set_batch_size(gd_mini_batch_size);
 
 	float64_t alpha = gd_learning_rate;
@@ -403,9 +406,11 @@ std::shared_ptr<NeuralNetwork> DeepBeliefNetwork::convert_to_neural_network(
 }
 
 void DeepBeliefNetwork::down_step(int32_t index, SGVector< float64_t > params,
-	SGMatrix< float64_t > input, SGMatrix< float64_t > result, bool sample_states)
+	SGMatrix< float64_t > input, SGMatrix< float64_t > result, bool sample_states,
+	SGVector<float32_t> params_single)
 {
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
 	EMatrix In(input.matrix, input.num_rows, input.num_cols);
@@ -418,7 +423,28 @@ void DeepBeliefNetwork::down_step(int32_t index, SGVector< float64_t > params,
 	{
 		EMatrix W(get_weights(index,params).matrix,
 			m_layer_sizes[index + 1], m_layer_sizes[index]);
-		Out += W.transpose()*In;
+		if (single_precision)
+		{
+			float32_t* buffer = single_precision_buffer(
+				W.size()+In.size()+Out.size(), m_buffer_single);
+
+			// the weights are converted here unless wake_sleep() did
+			float32_t* weights = buffer;
+			if (params_single.vlen>0)
+				weights = params_single.vector+m_weights_index_offsets[index];
+			else
+				std::copy(W.data(), W.data()+W.size(), weights);
+
+			EMatrixF W32(weights, W.rows(), W.cols());
+			EMatrixF In32(buffer+W.size(), input.num_rows, input.num_cols);
+			EMatrixF P(buffer+W.size()+In.size(),
+				result.num_rows, result.num_cols);
+			In32 = In.cast<float32_t>();
+			P.noalias() = W32.transpose()*In32;
+			Out += P.cast<float64_t>();
+		}
+		else
+			Out += W.transpose()*In;
 	}
 
 	if (index > 0 || (index==0 && m_visible_units_type==RBMVUT_BINARY))
@@ -454,9 +480,11 @@ void DeepBeliefNetwork::down_step(int32_t index, SGVector< float64_t > params,
 }
 
 void DeepBeliefNetwork::up_step(int32_t index, SGVector< float64_t > params,
-	SGMatrix< float64_t > input, SGMatrix< float64_t > result, bool sample_states)
+	SGMatrix< float64_t > input, SGMatrix< float64_t > result, bool sample_states,
+	SGVector<float32_t> params_single)
 {
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
 	EMatrix In(input.matrix, input.num_rows, input.num_cols);
@@ -469,7 +497,28 @@ void DeepBeliefNetwork::up_step(int32_t index, SGVector< float64_t > params,
 	{
 		EMatrix W(get_weights(index-1, params).matrix,
 			m_layer_sizes[index], m_layer_sizes[index - 1]);
-		Out += W*In;
+		if (single_precision)
+		{
+			float32_t* buffer = single_precision_buffer(
+				W.size()+In.size()+Out.size(), m_buffer_single);
+
+			// the weights are converted here unless wake_sleep() did
+			float32_t* weights = buffer;
+			if (params_single.vlen>0)
+				weights = params_single.vector+m_weights_index_offsets[index-1];
+			else
+				std::copy(W.data(), W.data()+W.size(), weights);
+
+			EMatrixF W32(weights, W.rows(), W.cols());
+			EMatrixF In32(buffer+W.size(), input.num_rows, input.num_cols);
+			EMatrixF P(buffer+W.size()+In.size(),
+				result.num_rows, result.num_cols);
+			In32 = In.cast<float32_t>();
+			P.noalias() = W32*In32;
+			Out += P.cast<float64_t>();
+		}
+		else
+			Out += W*In;
 	}
 
 	int32_t len = result.num_rows*result.num_cols;
@@ -495,12 +544,27 @@ void DeepBeliefNetwork::wake_sleep(SGMatrix< float64_t > data, std::shared_ptr<R
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
+	// the parameters do not change during the step, so the up and down
+	// passes read one float32 copy of them
+	SGVector<float32_t> gen_params_single;
+	SGVector<float32_t> rec_params_single;
+	if (single_precision)
+	{
+		gen_params_single = SGVector<float32_t>(to_single_precision(
+			gen_params.vector, gen_params.vlen, m_gen_params_single),
+			gen_params.vlen, false);
+		rec_params_single = SGVector<float32_t>(to_single_precision(
+			rec_params.vector, rec_params.vlen, m_rec_params_single),
+			rec_params.vlen, false);
+	}
+
 	// Wake phase
 	for (int32_t i=0; i<data.num_rows*data.num_cols; i++)
 		wake_states[0][i] = data[i];
 
 	for (int32_t i=1; i<m_num_layers-1; i++)
-		up_step(i, rec_params, wake_states[i-1], wake_states[i]);
+		up_step(i, rec_params, wake_states[i-1], wake_states[i], true,
+			rec_params_single);
 
 	// Contrastive divergence in the top RBM
 	SGVector<float64_t> top_rbm_gradients(
@@ -511,13 +575,16 @@ void DeepBeliefNetwork::wake_sleep(SGMatrix< float64_t > data, std::shared_ptr<R
 	// Sleep phase
 	sleep_states.set_matrix(m_num_layers-2, top_rbm->visible_state);
 	for (int32_t i=m_num_layers-3; i>=0; i--)
-		down_step(i, gen_params, sleep_states[i+1], sleep_states[i]);
+		down_step(i, gen_params, sleep_states[i+1], sleep_states[i], true,
+			gen_params_single);
 
 	// Predictions
 	for (int32_t i=1; i<m_num_layers-1; i++)
-		up_step(i, rec_params, sleep_states[i-1], psleep_states[i]);
+		up_step(i, rec_params, sleep_states[i-1], psleep_states[i], true,
+			rec_params_single);
 	for (int32_t i=0; i<m_num_layers-2; i++)
-		down_step(i, gen_params, wake_states[i+1], pwake_states[i]);
+		down_step(i, gen_params, wake_states[i+1], pwake_states[i], true,
+			gen_params_single);
 
 	// Gradients for generative parameters
 	for (int32_t i=0; i<m_num_layers-2; i++)
@@ -591,6 +658,7 @@ void DeepBeliefNetwork::init()
 	gd_learning_rate = 0.1;
 	gd_learning_rate_decay = 1.0;
 	gd_momentum = 0.9;
+	single_precision = false;
 
 	m_visible_units_type = RBMVUT_BINARY;
 	m_num_layers = 0;
@@ -660,6 +728,9 @@ void DeepBeliefNetwork::init()
 	    &gd_learning_rate_decay, "gd_learning_rate_decay",
 	    "Gradient descent learning rate decay");
 	SG_ADD(&gd_momentum, "gd_momentum", "Gradient Descent Momentum");
+	SG_ADD(
+	    &single_precision, "single_precision",
+	    "Whether to compute the products in single precision");
 
 	SG_ADD(&m_sigma, "m_sigma", "Initialization Sigma");
 
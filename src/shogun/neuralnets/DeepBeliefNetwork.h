@@ -212,15 +212,22 @@ public:
 	virtual const char* get_name() const { return "DeepBeliefNetwork"; }
 
 protected:
-	/** Computes the states of some layer using the states of the layer above it */
+	/** Computes the states of some layer using the states of the layer above
+	 * it. If single_precision is true, the product reads params_single, or a
+	 * float32 copy of the weights made by the call if it is empty.
+	 */
 	virtual void down_step(int32_t index, SGVector<float64_t> params,
 		SGMatrix<float64_t> input, SGMatrix<float64_t> result,
-		bool sample_states = true);
+		bool sample_states = true,
+		SGVector<float32_t> params_single = SGVector<float32_t>());
 
-	/** Computes the states of some layer using the states of the layer below it */
+	/** Computes the states of some layer using the states of the layer below
+	 * it, see down_step() for params_single
+	 */
 	virtual void up_step(int32_t index, SGVector<float64_t> params,
 		SGMatrix<float64_t> input, SGMatrix<float64_t> result,
-		bool sample_states = true);
+		bool sample_states = true,
+		SGVector<float32_t> params_single = SGVector<float32_t>());
 
 	/** Computes the gradients using the wake-sleep algorithm */
 	virtual void wake_sleep(SGMatrix<float64_t> data,
@@ -339,6 +346,13 @@ public:
 	 */
 	float64_t gd_momentum;
 
+	/** If true, the matrix products of pre-training, of the up/down passes
+	 * and of wake-sleep training are computed in single precision, see
+	 * RBM::single_precision. Each wake-sleep step converts the generative
+	 * and recognition parameters to float32 once. Default value is false
+	 */
+	bool single_precision;
+
 protected:
 	/** Type of the visible units */
 	ERBMVisibleUnitType m_visible_units_type;
@@ -372,6 +386,16 @@ protected:
 	/** Standard deviation of the gaussian used to initialize the
 	 * parameters */
 	float64_t m_sigma;
+
+private:
+	/** float32 copies of the generative and recognition parameters, made
+	 * once per wake-sleep step
+	 */
+	SGVector<float32_t> m_gen_params_single;
+	SGVector<float32_t> m_rec_params_single;
+
+	/** buffer of the single precision products */
+	SGVector<float32_t> m_buffer_single;
 };
 
 }
@@ -8,6 +8,8 @@
 #include <shogun/neuralnets/DeepAutoencoder.h>
 #include <shogun/neuralnets/Helpers.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 std::shared_ptr<DenseFeatures<float64_t>> shogun::reconstruct(const std::shared_ptr<Machine>& net, 
@@ -29,4 +31,18 @@ std::shared_ptr<Machine> shogun::convert_to_neural_network(const std::shared_ptr
 	if (auto ae = net->as<DeepAutoencoder>())
 		return ae->convert_to_neural_network(output_layer, sigma);
 	error("Expected net to be a DeepAutoencoder.");
-}
\ No newline at end of file
+}
+float32_t* shogun::single_precision_buffer(index_t len, SGVector<float32_t>& buffer)
+{
+	if (buffer.vlen < len)
+		buffer = SGVector<float32_t>(len);
+	return buffer.vector;
+}
+
+float32_t* shogun::to_single_precision(
+	const float64_t* values, index_t len, SGVector<float32_t>& buffer)
+{
+	float32_t* result = single_precision_buffer(len, buffer);
+	std::copy(values, values+len, result);
+	return result;
+}
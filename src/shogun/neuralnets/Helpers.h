@@ -15,6 +15,26 @@ namespace shogun {
 
 	std::shared_ptr<Machine> convert_to_neural_network(const std::shared_ptr<Machine>& net, 
 		std::shared_ptr<NeuralLayer> output_layer, float64_t sigma);
+
+	/** Returns a buffer of at least len values, reallocating it only if it
+	 * is too small, so that the single precision products of the networks
+	 * reuse their memory across calls.
+	 *
+	 * @param len number of values
+	 * @param buffer buffer to reuse
+	 * @return values of the buffer
+	 */
+	float32_t* single_precision_buffer(index_t len, SGVector<float32_t>& buffer);
+
+	/** Converts values to single precision into a reused buffer
+	 *
+	 * @param values values to convert
+	 * @param len number of values
+	 * @param buffer buffer to reuse, see single_precision_buffer()
+	 * @return converted values
+	 */
+	float32_t* to_single_precision(
+		const float64_t* values, index_t len, SGVector<float32_t>& buffer);
 }
 
 #endif
\ No newline at end of file
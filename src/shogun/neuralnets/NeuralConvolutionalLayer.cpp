@@ -206,8 +206,9 @@ void NeuralConvolutionalLayer::compute_gradients(
 
 	// compute the pre-pooling activation gradients
 	m_convolution_output_gradients.zero();
-	for (int32_t i=0; i<m_num_neurons; i++)
-		for (int32_t j=0; j<m_batch_size; j++)
+	#pragma omp parallel for
+	for (int32_t j=0; j<m_batch_size; j++)
+		for (int32_t i=0; i<m_num_neurons; i++)
 			if (m_max_indices(i,j)!=-1.0)
 				m_convolution_output_gradients(m_max_indices(i,j),j) =
 					m_activation_gradients(i,j);
@@ -32,6 +32,7 @@
  */
 
 #include <shogun/neuralnets/NeuralLayer.h>
+#include <shogun/neuralnets/Helpers.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
@@ -110,6 +111,12 @@ void NeuralLayer::dropout_activations()
 	}
 }
 
+void NeuralLayer::update_single_precision_activations()
+{
+	to_single_precision(m_activations.matrix, m_num_neurons*m_batch_size,
+		m_activations_single);
+}
+
 void NeuralLayer::init()
 {
 	m_num_neurons = 0;
@@ -119,6 +126,7 @@ void NeuralLayer::init()
 	m_batch_size = 0;
 	dropout_prop = 0.0;
 	contraction_coefficient = 0.0;
+	single_precision = false;
 	is_training = false;
 	autoencoder_position = NLAP_NONE;
 
@@ -131,6 +139,9 @@ void NeuralLayer::init()
 	SG_ADD(
 	    &contraction_coefficient, "contraction_coefficient",
 	    "Contraction Coefficient");
+	SG_ADD(
+	    &single_precision, "single_precision",
+	    "Whether to compute the products in single precision");
 	SG_ADD(&is_training, "is_training", "is_training");
 	SG_ADD(&m_batch_size, "batch_size", "Batch Size");
 	SG_ADD(&m_activations, "activations", "Activations");
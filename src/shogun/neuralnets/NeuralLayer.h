@@ -228,6 +228,33 @@ public:
 	 */
 	virtual void dropout_activations();
 
+	/** Sets the single precision copy of the layer's parameters that the
+	 * products read when single_precision is true. Set by the network that
+	 * owns the layer whenever its parameters change.
+	 *
+	 * @param parameters float32 copy of the layer's parameters
+	 */
+	void set_single_precision_parameters(SGVector<float32_t> parameters)
+	{
+		m_parameters_single = parameters;
+	}
+
+	/** Copies the final activations to the single precision buffer that the
+	 * layers connected to this layer read when single_precision is true
+	 */
+	virtual void update_single_precision_activations();
+
+	/** Gets the single precision copy of the layer's activations, see
+	 * update_single_precision_activations()
+	 *
+	 * @return float32 activations, of size num_neurons * batch_size
+	 */
+	virtual SGMatrix<float32_t> get_single_precision_activations()
+	{
+		return SGMatrix<float32_t>(
+			m_activations_single.vector, m_num_neurons, m_batch_size, false);
+	}
+
 	/** Computes
 	 * \f[ \frac{\lambda}{N} \sum_{k=0}^{N-1} \left \| J(x_k) \right \|^2_F \f]
 	 * where \f$ \left \| J(x_k)) \right \|^2_F \f$ is the Frobenius norm of
@@ -339,6 +366,14 @@ public:
 	 */
 	float64_t contraction_coefficient;
 
+	/** If true, the matrix products of the layer are computed in single
+	 * precision, reading float32 copies of the parameters and of the input
+	 * activations that are made once per forward pass. The activations,
+	 * gradients and parameter updates are still float64_t. Set by the
+	 * network that owns the layer. Default value is false.
+	 */
+	bool single_precision;
+
 	/** For autoencoders, specifies the position of the layer in the autoencoder,
 	 * i.e an encoding layer or a decoding layer. Default value is NLAP_NONE
 	 */
@@ -393,6 +428,17 @@ protected:
 	 * size num_neurons * batch_size
 	 */
 	SGMatrix<bool> m_dropout_mask;
+
+	/** float32 copy of the layer's parameters, set by the network */
+	SGVector<float32_t> m_parameters_single;
+
+	/** float32 copy of the activations, see
+	 * update_single_precision_activations()
+	 */
+	SGVector<float32_t> m_activations_single;
+
+	/** buffer of the single precision products and gradients */
+	SGVector<float32_t> m_buffer_single;
 };
 
 }
@@ -37,6 +37,7 @@
 
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/neuralnets/Helpers.h>
 
 using namespace shogun;
 
@@ -82,6 +83,7 @@ void NeuralLinearLayer::compute_activations(
 	float64_t* biases = parameters.vector;
 
 	typedef Eigen::Map<Eigen::MatrixXd> EMappedMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMappedMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EMappedVector;
 
 	EMappedMatrix  A(m_activations.matrix, m_num_neurons, m_batch_size);
@@ -95,14 +97,30 @@ void NeuralLinearLayer::compute_activations(
 		auto& layer = layers[m_input_indices[l]];
 
 		float64_t* weights = parameters.vector + weights_index_offset;
-		weights_index_offset += m_num_neurons*layer->get_num_neurons();
 
-		EMappedMatrix W(weights, m_num_neurons, layer->get_num_neurons());
-		EMappedMatrix X(layer->get_activations().matrix,
-				layer->get_num_neurons(), m_batch_size);
+		if (single_precision)
+		{
+			EMappedMatrixF W(m_parameters_single.vector + weights_index_offset,
+					m_num_neurons, layer->get_num_neurons());
+			EMappedMatrixF X(layer->get_single_precision_activations().matrix,
+					layer->get_num_neurons(), m_batch_size);
+			EMappedMatrixF P(single_precision_buffer(
+					m_num_neurons*m_batch_size, m_buffer_single),
+					m_num_neurons, m_batch_size);
+
+			P.noalias() = W*X;
+			A += P.cast<float64_t>();
+		}
+		else
+		{
+			EMappedMatrix W(weights, m_num_neurons, layer->get_num_neurons());
+			EMappedMatrix X(layer->get_activations().matrix,
+					layer->get_num_neurons(), m_batch_size);
 
-		A += W*X;
+			A += W*X;
+		}
 
+		weights_index_offset += m_num_neurons*layer->get_num_neurons();
 	}
 }
 
@@ -117,6 +135,7 @@ void NeuralLinearLayer::compute_gradients(
 	// compute bias gradients
 	float64_t* bias_gradients = parameter_gradients.vector;
 	typedef Eigen::Map<Eigen::MatrixXd> EMappedMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMappedMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EMappedVector;
 
 	EMappedVector BG(bias_gradients, m_num_neurons);
@@ -151,12 +170,41 @@ void NeuralLinearLayer::compute_gradients(
 		EMappedMatrix  IG(layer->get_activation_gradients().matrix,
 				layer->get_num_neurons(), m_batch_size);
 
-		// compute weight gradients
-		WG = LG*X.transpose();
+		if (single_precision)
+		{
+			int32_t num_inputs = layer->get_num_neurons();
+			int32_t len = m_num_neurons*m_batch_size;
+			float32_t* buffer = single_precision_buffer(
+				len + num_inputs*Math::max(m_num_neurons, m_batch_size),
+				m_buffer_single);
+
+			EMappedMatrixF LG32(buffer, m_num_neurons, m_batch_size);
+			EMappedMatrixF W32(m_parameters_single.vector +
+					(weights - parameters.vector), m_num_neurons, num_inputs);
+			EMappedMatrixF X32(layer->get_single_precision_activations().matrix,
+					num_inputs, m_batch_size);
+			LG32 = LG.cast<float32_t>();
+
+			EMappedMatrixF WG32(buffer+len, m_num_neurons, num_inputs);
+			WG32.noalias() = LG32*X32.transpose();
+			WG = WG32.cast<float64_t>();
+
+			if (!layer->is_input())
+			{
+				EMappedMatrixF IG32(buffer+len, num_inputs, m_batch_size);
+				IG32.noalias() = W32.transpose()*LG32;
+				IG += IG32.cast<float64_t>();
+			}
+		}
+		else
+		{
+			// compute weight gradients
+			WG = LG*X.transpose();
 
-		// compute input gradients
-		if (!layer->is_input())
-			IG += W.transpose()*LG;
+			// compute input gradients
+			if (!layer->is_input())
+				IG += W.transpose()*LG;
+		}
 
 	}
 
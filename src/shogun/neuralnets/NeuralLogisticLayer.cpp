@@ -54,6 +54,7 @@ void NeuralLogisticLayer::compute_activations(
 
 	// apply logistic activation function
 	int32_t length = m_num_neurons*m_batch_size;
+	#pragma omp parallel for
 	for (int32_t i=0; i<length; i++)
 		m_activations[i] = 1.0 / (1.0 + std::exp(-1.0 * m_activations[i]));
 }
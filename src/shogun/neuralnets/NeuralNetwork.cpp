@@ -38,6 +38,7 @@
 #include <shogun/mathematics/UniformRealDistribution.h>
 #include <shogun/neuralnets/NeuralLayer.h>
 #include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/Helpers.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 
 using namespace shogun;
@@ -458,9 +459,21 @@ SGMatrix<float64_t> NeuralNetwork::forward_propagate(
 	if (j==-1)
 		j = m_num_layers-1;
 
+	// the parameters only change between passes, so the layers read one
+	// float32 copy of them in the forward and the backward pass
+	if (m_single_precision)
+	{
+		to_single_precision(m_params.vector, m_total_num_parameters,
+			m_params_single);
+	}
+
 	for (int32_t i=0; i<=j; i++)
 	{
 		auto layer = get_layer(i);
+		layer->single_precision = m_single_precision;
+		if (m_single_precision)
+			layer->set_single_precision_parameters(
+				get_section(m_params_single, i));
 
 		if (layer->is_input())
 			layer->compute_activations(inputs);
@@ -468,6 +481,10 @@ SGMatrix<float64_t> NeuralNetwork::forward_propagate(
 			layer->compute_activations(get_section(m_params, i), m_layers);
 
 		layer->dropout_activations();
+
+		// the activations of the last layer are not read by any product
+		if (m_single_precision && i<j)
+			layer->update_single_precision_activations();
 	}
 
 	return get_layer(j)->get_activations();
@@ -766,6 +783,7 @@ void NeuralNetwork::init()
 	m_optimization_method = NNOM_LBFGS;
 	m_dropout_hidden = 0.0;
 	m_dropout_input = 0.0;
+	m_single_precision = false;
 	m_max_norm = -1.0;
 	m_l2_coefficient = 0.0;
 	m_l1_coefficient = 0.0;
@@ -817,6 +835,9 @@ void NeuralNetwork::init()
 	    "Hidden neuron dropout probability");
 	SG_ADD(
 	    &m_dropout_input, "dropout_input", "Input neuron dropout probability");
+	SG_ADD(
+	    &m_single_precision, "single_precision",
+	    "Whether to compute the layer products in single precision");
 	SG_ADD(&m_max_norm, "max_norm", "Max Norm");
 	SG_ADD(
 	    &m_total_num_parameters, "total_num_parameters",
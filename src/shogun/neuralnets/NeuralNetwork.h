@@ -325,6 +325,27 @@ public:
 		return m_dropout_input;
 	}
 
+	/** Sets whether the matrix products of the layers are computed in single
+	 * precision. The products read float32 copies of the parameters and of
+	 * the activations of the input layers, which are made once per forward
+	 * pass and shared with the backward pass. The activations, gradients and
+	 * parameter updates are kept in double precision, so the copies add one
+	 * conversion pass over each of them, see NeuralNetwork_benchmark.
+	 * default value false
+	 *
+	 * @param single_precision whether to use single precision products
+	 */
+	void set_single_precision(bool single_precision)
+	{
+		m_single_precision = single_precision;
+	}
+
+	/** Returns whether the products are computed in single precision */
+	bool get_single_precision() const
+	{
+		return m_single_precision;
+	}
+
 	/** Sets maximum allowable L2 norm for a neurons weights
 	 * When using this, a good value might be 15
 	 * default value -1 (max-norm regularization disabled)
@@ -672,6 +693,14 @@ protected:
 	 */
 	float64_t m_dropout_input;
 
+	/** If true, the matrix products of the layers are computed in single
+	 * precision. Default value false
+	 */
+	bool m_single_precision;
+
+	/** float32 copy of m_params read by the single precision products */
+	SGVector<float32_t> m_params_single;
+
 	/** Maximum allowable L2 norm for a neurons weights
 	 *When using this, a good value might be 15
 	 *
@@ -0,0 +1,97 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/labels/RegressionLabels.h"
+#include "shogun/mathematics/NormalDistribution.h"
+#include "shogun/neuralnets/NeuralInputLayer.h"
+#include "shogun/neuralnets/NeuralLinearLayer.h"
+#include "shogun/neuralnets/NeuralLogisticLayer.h"
+#include "shogun/neuralnets/NeuralNetwork.h"
+#include <random>
+
+namespace shogun
+{
+
+/* One epoch of mini-batch gradient descent of an autoencoder shaped network,
+ * whose cost is dominated by the products of the two layers.
+ */
+class NeuralNetworkFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal_dist;
+
+		index_t num_inputs = st.range(0);
+		SGMatrix<float64_t> mat(num_inputs, num_vecs);
+		for (index_t i = 0; i < num_inputs * num_vecs; i++)
+			mat.matrix[i] = normal_dist(prng);
+		features = std::make_shared<DenseFeatures<float64_t>>(mat);
+
+		SGMatrix<float64_t> targets(1, num_vecs);
+		for (index_t i = 0; i < num_vecs; i++)
+			targets[i] = normal_dist(prng);
+		labels = std::make_shared<RegressionLabels>(targets.get_row_vector(0));
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		features.reset();
+		labels.reset();
+	}
+
+	void train(bool single_precision, const ::benchmark::State& st)
+	{
+		index_t num_inputs = st.range(0);
+		std::vector<std::shared_ptr<NeuralLayer>> layers;
+		layers.push_back(std::make_shared<NeuralInputLayer>(num_inputs));
+		layers.push_back(
+		    std::make_shared<NeuralLogisticLayer>(num_inputs / 4));
+		layers.push_back(std::make_shared<NeuralLinearLayer>(1));
+
+		auto network = std::make_shared<NeuralNetwork>(layers);
+		network->put("seed", 17);
+		network->quick_connect();
+		network->initialize_neural_network();
+		network->set_optimization_method(NNOM_GRADIENT_DESCENT);
+		network->set_gd_mini_batch_size(batch_size);
+		network->set_max_num_epochs(1);
+		network->set_single_precision(single_precision);
+		network->set_labels(labels);
+		network->train(features);
+	}
+
+	static constexpr index_t num_vecs = 2048;
+	static constexpr index_t batch_size = 256;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+};
+
+BENCHMARK_DEFINE_F(NeuralNetworkFixture, DoublePrecision)
+(benchmark::State& st)
+{
+	for (auto _ : st)
+		train(false, st);
+}
+
+BENCHMARK_DEFINE_F(NeuralNetworkFixture, SinglePrecision)
+(benchmark::State& st)
+{
+	for (auto _ : st)
+		train(true, st);
+}
+
+BENCHMARK_REGISTER_F(NeuralNetworkFixture, DoublePrecision)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(NeuralNetworkFixture, SinglePrecision)
+    ->RangeMultiplier(4)
+    ->Range(64, 1024)
+    ->Unit(benchmark::kMillisecond);
+}
@@ -52,6 +52,7 @@ void NeuralRectifiedLinearLayer::compute_activations(SGVector<float64_t> paramet
 	NeuralLinearLayer::compute_activations(parameters, layers);
 
 	int32_t len = m_num_neurons*m_batch_size;
+	#pragma omp parallel for
 	for (int32_t i=0; i<len; i++)
 	{
 		m_activations[i] = Math::max<float64_t>(0, m_activations[i]);
@@ -58,6 +58,7 @@ void NeuralSoftmaxLayer::compute_activations(
 
 	float64_t max = m_activations.max_single();
 
+	#pragma omp parallel for
 	for (int32_t j=0; j<m_batch_size; j++)
 	{
 		float64_t sum = 0;
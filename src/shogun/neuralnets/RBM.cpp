@@ -38,6 +38,7 @@
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/neuralnets/Helpers.h>
 
 #include <utility>
 
@@ -332,6 +333,7 @@ void RBM::free_energy_gradients(SGMatrix< float64_t > visible,
 	}
 
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
 	EMatrix V(visible.matrix, visible.num_rows, visible.num_cols);
@@ -341,15 +343,40 @@ void RBM::free_energy_gradients(SGMatrix< float64_t > visible,
 	EVector BG(get_visible_bias(gradients).vector, m_num_visible);
 	EVector CG(get_hidden_bias(gradients).vector, m_num_hidden);
 
+	if (single_precision)
+	{
+		int32_t len_hidden = m_num_hidden*m_batch_size;
+		int32_t len_visible = m_num_visible*m_batch_size;
+		float32_t* buffer = single_precision_buffer(
+			len_hidden+len_visible+m_num_hidden*m_num_visible, m_buffer_single);
+
+		EMatrixF PH32(buffer, m_num_hidden, m_batch_size);
+		EMatrixF V32(buffer+len_hidden, m_num_visible, m_batch_size);
+		EMatrixF PHV(buffer+len_hidden+len_visible, m_num_hidden, m_num_visible);
+		PH32 = PH.cast<float32_t>();
+		V32 = V.cast<float32_t>();
+		PHV.noalias() = PH32*V32.transpose();
+
+		if (positive_phase)
+			WG = -1*PHV.cast<float64_t>()/m_batch_size;
+		else
+			WG += PHV.cast<float64_t>()/m_batch_size;
+	}
+	else
+	{
+		if (positive_phase)
+			WG = -1*PH*V.transpose()/m_batch_size;
+		else
+			WG += PH*V.transpose()/m_batch_size;
+	}
+
 	if (positive_phase)
 	{
-		WG = -1*PH*V.transpose()/m_batch_size;
 		BG = -1*V.rowwise().sum()/m_batch_size;
 		CG = -1*PH.rowwise().sum()/m_batch_size;
 	}
 	else
 	{
-		WG += PH*V.transpose()/m_batch_size;
 		BG += V.rowwise().sum()/m_batch_size;
 		CG += PH.rowwise().sum()/m_batch_size;
 	}
@@ -360,6 +387,15 @@ void RBM::contrastive_divergence(SGMatrix< float64_t > visible_batch,
 {
 	set_batch_size(visible_batch.num_cols);
 
+	// the weights do not change until the update, so the products of the
+	// chain read one float32 copy of them
+	if (single_precision)
+	{
+		to_single_precision(get_weights().matrix, m_num_hidden*m_num_visible,
+			m_weights_single);
+		m_weights_single_current = true;
+	}
+
 	// positive phase
 	mean_hidden(visible_batch, hidden_state);
 	free_energy_gradients(visible_batch, gradients, true, hidden_state);
@@ -396,6 +432,17 @@ void RBM::contrastive_divergence(SGMatrix< float64_t > visible_batch,
 				l1_coefficient * m_params[i+m_num_visible+m_num_hidden];
 	}
 
+	m_weights_single_current = false;
+}
+
+float32_t* RBM::get_single_precision_weights()
+{
+	if (!m_weights_single_current)
+	{
+		to_single_precision(get_weights().matrix, m_num_hidden*m_num_visible,
+			m_weights_single);
+	}
+	return m_weights_single.vector;
 }
 
 float64_t RBM::reconstruction_error(SGMatrix< float64_t > visible,
@@ -451,6 +498,7 @@ float64_t RBM::pseudo_likelihood(SGMatrix< float64_t > visible,
 void RBM::mean_hidden(SGMatrix< float64_t > visible, SGMatrix< float64_t > result)
 {
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
 	EMatrix V(visible.matrix, visible.num_rows, visible.num_cols);
@@ -459,7 +507,21 @@ void RBM::mean_hidden(SGMatrix< float64_t > visible, SGMatrix< float64_t > resul
 	EVector C(get_hidden_bias().vector, m_num_hidden);
 
 	H.colwise() = C;
-	H += W*V;
+	if (single_precision)
+	{
+		int32_t len_visible = visible.num_rows*visible.num_cols;
+		float32_t* buffer = single_precision_buffer(
+			len_visible+result.num_rows*result.num_cols, m_buffer_single);
+
+		EMatrixF W32(get_single_precision_weights(), m_num_hidden, m_num_visible);
+		EMatrixF V32(buffer, visible.num_rows, visible.num_cols);
+		EMatrixF P(buffer+len_visible, result.num_rows, result.num_cols);
+		V32 = V.cast<float32_t>();
+		P.noalias() = W32*V32;
+		H += P.cast<float64_t>();
+	}
+	else
+		H += W*V;
 
 	int32_t len = result.num_rows*result.num_cols;
 	for (int32_t i=0; i<len; i++)
@@ -469,6 +531,7 @@ void RBM::mean_hidden(SGMatrix< float64_t > visible, SGMatrix< float64_t > resul
 void RBM::mean_visible(SGMatrix< float64_t > hidden, SGMatrix< float64_t > result)
 {
 	typedef Eigen::Map<Eigen::MatrixXd> EMatrix;
+	typedef Eigen::Map<Eigen::MatrixXf> EMatrixF;
 	typedef Eigen::Map<Eigen::VectorXd> EVector;
 
 	EMatrix H(hidden.matrix, hidden.num_rows, hidden.num_cols);
@@ -477,7 +540,21 @@ void RBM::mean_visible(SGMatrix< float64_t > hidden, SGMatrix< float64_t > resul
 	EVector B(get_visible_bias().vector, m_num_visible);
 
 	V.colwise() = B;
-	V += W.transpose()*H;
+	if (single_precision)
+	{
+		int32_t len_hidden = hidden.num_rows*hidden.num_cols;
+		float32_t* buffer = single_precision_buffer(
+			len_hidden+result.num_rows*result.num_cols, m_buffer_single);
+
+		EMatrixF W32(get_single_precision_weights(), m_num_hidden, m_num_visible);
+		EMatrixF H32(buffer, hidden.num_rows, hidden.num_cols);
+		EMatrixF P(buffer+len_hidden, result.num_rows, result.num_cols);
+		H32 = H.cast<float32_t>();
+		P.noalias() = W32.transpose()*H32;
+		V += P.cast<float64_t>();
+	}
+	else
+		V += W.transpose()*H;
 
 	for (int32_t k=0; k<m_num_visible_groups; k++)
 	{
@@ -603,6 +680,8 @@ void RBM::init()
 	cd_num_steps = 1;
 	cd_persistent = true;
 	cd_sample_visible = false;
+	single_precision = false;
+	m_weights_single_current = false;
 	l2_coefficient = 0.0;
 	l1_coefficient = 0.0;
 	monitoring_method = RBMMM_RECONSTRUCTION_ERROR;
@@ -633,6 +712,9 @@ void RBM::init()
 	SG_ADD(
 	    &cd_sample_visible, "sample_visible",
 	    "Whether to sample the visible units during (P)CD");
+	SG_ADD(
+	    &single_precision, "single_precision",
+	    "Whether to compute the products in single precision");
 	SG_ADD(&l2_coefficient, "l2_coefficient", "L2 regularization coeff");
 	SG_ADD(&l1_coefficient, "l1_coefficient", "L1 regularization coeff");
 	SG_ADD(&monitoring_interval, "monitoring_interval", "Monitoring Interval");
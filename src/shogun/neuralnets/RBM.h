@@ -382,6 +382,14 @@ public:
 	 */
 	bool cd_sample_visible;
 
+	/** If true, the matrix products of the Gibbs chain and of the free energy
+	 * gradients are computed in single precision. During contrastive
+	 * divergence they read one float32 copy of the weights, made when it
+	 * starts. The states, parameters and updates are kept in double
+	 * precision. Default value is false
+	 */
+	bool single_precision;
+
 	/** L2 Regularization coeff, default value is 0.0*/
 	float64_t l2_coefficient;
 
@@ -462,7 +470,21 @@ protected:
 	SGVector<float64_t> m_params;
 
 private:
+	/** @return float32 copy of the weights for the single precision
+	 * products, converted unless contrastive divergence made it already
+	 */
+	float32_t* get_single_precision_weights();
+
 	UniformRealDistribution<float64_t> m_uniform_prob;
+
+	/** float32 copy of the weights, see get_single_precision_weights() */
+	SGVector<float32_t> m_weights_single;
+
+	/** whether m_weights_single matches the current weights */
+	bool m_weights_single_current;
+
+	/** buffer of the single precision products */
+	SGVector<float32_t> m_buffer_single;
 };
 
 }
@@ -102,6 +102,20 @@ public:
 		SGVector<float64_t> raw_negative_descend_direction,
 		float64_t learning_rate);
 
+	/** Update the target variable based on the non-zero entries of a sparse
+	 * negative descend direction. A zero gradient leaves the accumulated
+	 * squared gradient of a variable unchanged, so only the variables of the
+	 * non-zero entries are touched.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction non-zero entries of the negative
+	 * descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate);
+
 protected:
 	/** Get the negative descend direction given current variable  and gradient 
 	 *
@@ -32,6 +32,7 @@
 #ifndef DESCENDUPDATER_H
 #define DESCENDUPDATER_H
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/base/SGObject.h>
 namespace shogun
 {
@@ -62,6 +63,32 @@ public:
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> negative_descend_direction, float64_t learning_rate)=0;
 
+	/** Update the target variable based on the non-zero entries of a sparse
+	 * negative descend direction
+	 *
+	 * Updaters whose update with a zero direction leaves a variable and its
+	 * state unchanged (eg, GradientDescendUpdater, AdaGradUpdater) only
+	 * touch the variables of the non-zero entries. The default
+	 * implementation densifies the direction and calls update_variable().
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param negative_descend_direction non-zero entries of the negative
+	 * descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> negative_descend_direction, float64_t learning_rate)
+	{
+		SGVector<float64_t> direction(variable_reference.vlen);
+		direction.zero();
+		for(index_t k=0; k<negative_descend_direction.num_feat_entries; k++)
+		{
+			const auto& entry=negative_descend_direction.features[k];
+			direction[entry.feat_index]+=entry.entry;
+		}
+		update_variable(variable_reference, direction, learning_rate);
+	}
+
 };
 
 }
@@ -66,6 +66,8 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 		}
 	}
 
+	// coordinates that do not move are not written, so that lock free
+	// (Hogwild) updates with sparse gradients do not overwrite each other
 	for(index_t idx=0; idx<variable_reference.vlen; idx++)
 	{
 		float64_t negative_descend_direction=get_negative_descend_direction(
@@ -74,15 +76,38 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 		{
 			DescendPair pair=m_correction->get_corrected_descend_direction(
 				negative_descend_direction, idx);
-			variable_reference[idx]+=pair.descend_direction;
+			if(pair.descend_direction!=0.0)
+				variable_reference[idx]+=pair.descend_direction;
 		}
-		else
+		else if(negative_descend_direction!=0.0)
 		{
 			variable_reference[idx]-=negative_descend_direction;
 		}
 	}
 }
 
+void DescendUpdaterWithCorrection::update_variable_entries(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	if(m_correction)
+	{
+		DescendUpdater::update_variable_sparse(variable_reference,
+			raw_negative_descend_direction, learning_rate);
+		return;
+	}
+
+	for(index_t k=0; k<raw_negative_descend_direction.num_feat_entries; k++)
+	{
+		const auto& entry=raw_negative_descend_direction.features[k];
+		require(entry.feat_index>=0 && entry.feat_index<variable_reference.vlen,
+			"The index ({}) of the negative descend direction is invalid", entry.feat_index);
+		float64_t negative_descend_direction=get_negative_descend_direction(
+			variable_reference[entry.feat_index], entry.entry, entry.feat_index, learning_rate);
+		if(negative_descend_direction!=0.0)
+			variable_reference[entry.feat_index]-=negative_descend_direction;
+	}
+}
+
 void DescendUpdaterWithCorrection::init()
 {
 	m_correction=NULL;
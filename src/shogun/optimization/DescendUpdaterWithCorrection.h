@@ -95,6 +95,19 @@ protected:
 	virtual float64_t get_negative_descend_direction(float64_t variable,
 		float64_t raw_negative_descend_direction, index_t idx, float64_t learning_rate)=0;
 
+	/** Update only the variables of the non-zero entries of a sparse negative
+	 * descend direction, for updaters whose update with a zero direction is a
+	 * no-op. With a descend correction every variable keeps moving, so the
+	 * direction is densified instead.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction non-zero entries of the negative
+	 * descend direction, with distinct indices
+	 * @param learning_rate learning rate
+	 */
+	void update_variable_entries(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
 	/** descend correction object */
 	std::shared_ptr<DescendCorrection> m_correction;
 
@@ -33,6 +33,7 @@
 #define FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #include <shogun/lib/config.h>
 #include <shogun/optimization/FirstOrderCostFunction.h>
+#include <shogun/lib/SGSparseVector.h>
 namespace shogun
 {
 /** @brief The first order stochastic cost function base class.
@@ -86,6 +87,66 @@ public:
 	 * @return cost
 	 */
 	virtual float64_t get_cost()=0;
+
+	/** Does the cost function support indexed sample gradients
+	 * (see get_sample_gradient())?
+	 *
+	 * The parallel modes of FirstOrderStochasticMinimizer require it.
+	 *
+	 * @return whether indexed sample gradients are supported
+	 */
+	virtual bool supports_sample_gradient() const { return false; }
+
+	/** Get the sample size, ie the number of indices accepted by
+	 * get_sample_gradient()
+	 *
+	 * @return the sample size
+	 */
+	virtual int32_t get_sample_size()
+	{
+		not_implemented(SOURCE_LOCATION);
+		return 0;
+	}
+
+	/** Get the SAMPLE gradient of the idx-th sample wrt target variables
+	 *
+	 * Unlike get_gradient(), the sample is given explicitly and the sample
+	 * sequence of begin_sample()/next_sample() is not touched. Implementations
+	 * must only read the target variables, so that several threads can call
+	 * this method at the same time.
+	 *
+	 * @param idx index of the sample
+	 * @return sample gradient of variables
+	 */
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx)
+	{
+		not_implemented(SOURCE_LOCATION);
+		return SGVector<float64_t>();
+	}
+
+	/** Does the cost function support sparse sample gradients
+	 * (see get_sparse_sample_gradient())?
+	 *
+	 * @return whether sparse sample gradients are supported
+	 */
+	virtual bool supports_sparse_sample_gradient() const { return false; }
+
+	/** Get the non-zero entries of the SAMPLE gradient of the idx-th sample
+	 * wrt target variables
+	 *
+	 * Sample gradients of linear models over sparse features only touch the
+	 * variables of the non-zero features. SPM_HOGWILD then updates only
+	 * these variables instead of all of them. Same thread safety as
+	 * get_sample_gradient().
+	 *
+	 * @param idx index of the sample
+	 * @return non-zero entries of the sample gradient of variables
+	 */
+	virtual SGSparseVector<float64_t> get_sparse_sample_gradient(index_t idx)
+	{
+		not_implemented(SOURCE_LOCATION);
+		return SGSparseVector<float64_t>();
+	}
 };
 
 }
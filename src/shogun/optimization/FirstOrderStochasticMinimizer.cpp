@@ -68,6 +68,17 @@ void FirstOrderStochasticMinimizer::set_learning_rate(std::shared_ptr<LearningRa
 	}
 }
 
+void FirstOrderStochasticMinimizer::set_parallel_mode(EStochasticParallelMode mode)
+{
+	m_parallel_mode=mode;
+}
+
+void FirstOrderStochasticMinimizer::set_mini_batch_size(int32_t mini_batch_size)
+{
+	require(mini_batch_size>0, "The mini-batch size ({}) must be positive", mini_batch_size);
+	m_mini_batch_size=mini_batch_size;
+}
+
 void FirstOrderStochasticMinimizer::do_proximal_operation(SGVector<float64_t>variable_reference)
 {
 	auto proximal_penalty=std::dynamic_pointer_cast<ProximalPenalty>(m_penalty_type);
@@ -89,6 +100,12 @@ void FirstOrderStochasticMinimizer::init_minimization()
 	require(m_fun,"Cost function must set");
 	require(m_gradient_updater,"Descend updater must set");
 	require(m_num_passes>0, "The number to go through data must set");
+	if(m_parallel_mode!=SPM_SEQUENTIAL)
+	{
+		auto fun=m_fun->as<FirstOrderStochasticCostFunction>();
+		require(fun->supports_sample_gradient(),
+			"The cost function must support indexed sample gradients in parallel mode");
+	}
 	m_cur_passes=0;
 }
 
@@ -99,6 +116,8 @@ void FirstOrderStochasticMinimizer::init()
 	m_num_passes=0;
 	m_cur_passes=0;
 	m_iter_counter=0;
+	m_parallel_mode=SPM_SEQUENTIAL;
+	m_mini_batch_size=1;
 
 	SG_ADD((std::shared_ptr<SGObject>*)&m_learning_rate, "FirstOrderMinimizer__m_learning_rate",
 		"learning_rate in FirstOrderStochasticMinimizer");
@@ -110,4 +129,11 @@ void FirstOrderStochasticMinimizer::init()
 		"cur_passes in FirstOrderStochasticMinimizer");
 	SG_ADD(&m_iter_counter, "FirstOrderMinimizer__m_iter_counter",
 		"m_iter_counter in FirstOrderStochasticMinimizer");
+	SG_ADD_OPTIONS((machine_int_t*)&m_parallel_mode,
+		"FirstOrderMinimizer__m_parallel_mode",
+		"parallel_mode in FirstOrderStochasticMinimizer",
+		ParameterProperties::NONE,
+		SG_OPTIONS(SPM_SEQUENTIAL, SPM_HOGWILD, SPM_MINI_BATCH));
+	SG_ADD(&m_mini_batch_size, "FirstOrderMinimizer__m_mini_batch_size",
+		"mini_batch_size in FirstOrderStochasticMinimizer");
 }
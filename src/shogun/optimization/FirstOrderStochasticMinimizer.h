@@ -37,6 +37,21 @@
 namespace shogun
 {
 
+/** @brief Execution modes of stochastic minimizers over several threads */
+enum EStochasticParallelMode
+{
+	/** samples are visited one at a time by the calling thread */
+	SPM_SEQUENTIAL = 0,
+	/** each thread visits its share of the samples and updates the shared
+	 * target variables without locking [Recht et al, 2011] (Hogwild!)
+	 */
+	SPM_HOGWILD = 1,
+	/** the sample gradients of each mini-batch are computed by all threads,
+	 * averaged and applied in one synchronous update
+	 */
+	SPM_MINI_BATCH = 2
+};
+
 /** @brief The base class for stochastic first-order gradient-based minimizers.
  *
  * This class gives the interface of these stochastic minimizers.
@@ -135,6 +150,42 @@ public:
 	 */
 	virtual int32_t get_iteration_counter() {return m_iter_counter;}
 
+	/** Set how the samples are distributed over the threads of
+	 * env()->get_num_threads(). Default is SPM_SEQUENTIAL.
+	 *
+	 * The parallel modes require a cost function that supports
+	 * FirstOrderStochasticCostFunction::get_sample_gradient().
+	 *
+	 * In SPM_HOGWILD mode every thread updates the target variables with its
+	 * own copy of the gradient updater, so adaptive updaters (eg, AdaGrad,
+	 * Adam) keep per thread statistics. Coordinates whose update is zero are
+	 * not written, which makes the lock free updates safe for sparse
+	 * gradients. Proximal operations are done once per pass.
+	 *
+	 * In SPM_MINI_BATCH mode each update uses the average gradient of
+	 * set_mini_batch_size() samples, so the iteration counter counts
+	 * mini-batches.
+	 *
+	 * @param mode parallel mode
+	 */
+	virtual void set_parallel_mode(EStochasticParallelMode mode);
+
+	/** Get the parallel mode
+	 *
+	 * @return parallel mode
+	 */
+	virtual EStochasticParallelMode get_parallel_mode() const
+	{
+		return m_parallel_mode;
+	}
+
+	/** Set the number of samples averaged in each update in
+	 * SPM_MINI_BATCH mode
+	 *
+	 * @param mini_batch_size the mini-batch size
+	 */
+	virtual void set_mini_batch_size(int32_t mini_batch_size);
+
 protected:
 	/** Do proximal update in place 
 	 *
@@ -160,6 +211,12 @@ protected:
 
 	/** learning_rate object */
 	std::shared_ptr<LearningRate> m_learning_rate;
+
+	/** how the samples are distributed over threads */
+	EStochasticParallelMode m_parallel_mode;
+
+	/** number of samples per update in SPM_MINI_BATCH mode */
+	int32_t m_mini_batch_size;
 	
 private:
 	/** Init */
@@ -52,3 +52,9 @@ float64_t GradientDescendUpdater::get_negative_descend_direction(float64_t varia
 {
 	return learning_rate*gradient;
 }
+
+void GradientDescendUpdater::update_variable_sparse(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> negative_descend_direction, float64_t learning_rate)
+{
+	update_variable_entries(variable_reference, negative_descend_direction, learning_rate);
+}
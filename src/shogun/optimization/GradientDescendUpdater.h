@@ -59,6 +59,17 @@ public:
 	 */
 	virtual const char* get_name() const { return "GradientDescendUpdater"; }
 
+	/** Update the target variable based on the non-zero entries of a sparse
+	 * negative descend direction, touching only their variables
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param negative_descend_direction non-zero entries of the negative
+	 * descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_sparse(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> negative_descend_direction, float64_t learning_rate);
+
 protected:
 	/** Get the negative descend direction given current variable and gradient
 	 *
@@ -0,0 +1,141 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/optimization/MarginLossCostFunction.h>
+
+using namespace shogun;
+
+MarginLossCostFunction::MarginLossCostFunction()
+	: FirstOrderSAGCostFunction()
+{
+	init();
+}
+
+MarginLossCostFunction::MarginLossCostFunction(
+	std::shared_ptr<DotFeatures> features, std::shared_ptr<BinaryLabels> labels,
+	std::shared_ptr<LossFunction> loss)
+	: FirstOrderSAGCostFunction()
+{
+	init();
+	require(features, "Features must be set");
+	require(labels, "Labels must be set");
+	require(loss, "Loss must be set");
+	require(features->get_num_vectors()==labels->get_num_labels(),
+		"Number of features ({}) and labels ({}) do not match",
+		features->get_num_vectors(), labels->get_num_labels());
+
+	m_features=features;
+	m_labels=labels->get_labels();
+	m_loss=loss;
+	m_weights=SGVector<float64_t>(features->get_dim_feature_space());
+	m_weights.zero();
+}
+
+MarginLossCostFunction::~MarginLossCostFunction()
+{
+}
+
+SGVector<float64_t> MarginLossCostFunction::obtain_variable_reference()
+{
+	return m_weights;
+}
+
+float64_t MarginLossCostFunction::get_cost()
+{
+	float64_t cost=0.0;
+	for(index_t idx=0; idx<m_labels.vlen; idx++)
+	{
+		float64_t prediction=m_features->dot(idx, m_weights);
+		cost+=m_loss->loss(prediction*m_labels[idx]);
+	}
+	return cost;
+}
+
+void MarginLossCostFunction::begin_sample()
+{
+	m_idx=-1;
+}
+
+bool MarginLossCostFunction::next_sample()
+{
+	m_idx++;
+	return m_idx<m_labels.vlen;
+}
+
+SGVector<float64_t> MarginLossCostFunction::get_gradient()
+{
+	require(m_idx>=0 && m_idx<m_labels.vlen, "begin_sample() and next_sample() must be called first");
+	return get_sample_gradient(m_idx);
+}
+
+SGVector<float64_t> MarginLossCostFunction::get_average_gradient()
+{
+	SGVector<float64_t> gradient(m_weights.vlen);
+	gradient.zero();
+	for(index_t idx=0; idx<m_labels.vlen; idx++)
+	{
+		m_features->add_to_dense_vec(get_prediction_gradient(idx), idx,
+			gradient.vector, gradient.vlen);
+	}
+	gradient.scale(1.0/m_labels.vlen);
+	return gradient;
+}
+
+int32_t MarginLossCostFunction::get_sample_size()
+{
+	return m_labels.vlen;
+}
+
+SGVector<float64_t> MarginLossCostFunction::get_sample_gradient(index_t idx)
+{
+	SGVector<float64_t> gradient(m_weights.vlen);
+	gradient.zero();
+	m_features->add_to_dense_vec(get_prediction_gradient(idx), idx,
+		gradient.vector, gradient.vlen);
+	return gradient;
+}
+
+SGSparseVector<float64_t> MarginLossCostFunction::get_sparse_sample_gradient(index_t idx)
+{
+	float64_t coefficient=get_prediction_gradient(idx);
+	SGSparseVector<float64_t> gradient(m_features->get_nnz_features_for_vector(idx));
+
+	index_t num_entries=0;
+	int32_t index;
+	float64_t value;
+	void* iterator=m_features->get_feature_iterator(idx);
+	while(m_features->get_next_feature(index, value, iterator))
+	{
+		require(num_entries<gradient.num_feat_entries,
+			"Features of vector {} exceed their number of non-zero features", idx);
+		gradient.features[num_entries].feat_index=index;
+		gradient.features[num_entries].entry=coefficient*value;
+		num_entries++;
+	}
+	m_features->free_feature_iterator(iterator);
+
+	gradient.num_feat_entries=num_entries;
+	return gradient;
+}
+
+float64_t MarginLossCostFunction::get_prediction_gradient(index_t idx) const
+{
+	require(idx>=0 && idx<m_labels.vlen, "The index ({}) is invalid", idx);
+	float64_t label=m_labels[idx];
+	float64_t prediction=m_features->dot(idx, m_weights);
+	return m_loss->first_derivative(prediction*label)*label;
+}
+
+void MarginLossCostFunction::init()
+{
+	m_features=NULL;
+	m_loss=NULL;
+	m_idx=-1;
+
+	SG_ADD((std::shared_ptr<SGObject>*)&m_features, "features",
+		"features of the samples");
+	SG_ADD(&m_labels, "labels", "labels of the samples");
+	SG_ADD((std::shared_ptr<SGObject>*)&m_loss, "loss", "margin loss");
+	SG_ADD(&m_weights, "weights", "weights of the linear classifier");
+}
@@ -0,0 +1,101 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef MARGINLOSSCOSTFUNCTION_H
+#define MARGINLOSSCOSTFUNCTION_H
+#include <shogun/lib/config.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/loss/LossFunction.h>
+#include <shogun/optimization/FirstOrderSAGCostFunction.h>
+namespace shogun
+{
+/** @brief Stochastic cost function of a linear classifier under a margin
+ * loss.
+ *
+ * \f[
+ * f(w)=\sum_i{ \ell(y_i w^T x_i) }
+ * \f]
+ * where \f$(y_i,x_i)\f$ is the i-th sample with \f$y_i \in \{-1,+1\}\f$ and
+ * \f$\ell\f$ is a LossFunction (eg, LogLoss for logistic regression,
+ * SmoothHingeLoss).
+ *
+ * The sample gradient \f$\ell'(y_i w^T x_i) y_i x_i\f$ has the non-zero
+ * features of \f$x_i\f$ only, so get_sparse_sample_gradient() costs the
+ * number of non-zero features of a sample and SPM_HOGWILD minimizers only
+ * write the variables of these features.
+ */
+class MarginLossCostFunction: public FirstOrderSAGCostFunction
+{
+public:
+	/** default constructor */
+	MarginLossCostFunction();
+
+	/** constructor
+	 *
+	 * @param features features of the samples
+	 * @param labels binary labels of the samples
+	 * @param loss margin loss
+	 */
+	MarginLossCostFunction(std::shared_ptr<DotFeatures> features,
+		std::shared_ptr<BinaryLabels> labels, std::shared_ptr<LossFunction> loss);
+
+	virtual ~MarginLossCostFunction();
+
+	/** Get the weights of the linear classifier, which are the target
+	 * variables. They start at zero.
+	 *
+	 * @return reference of the weights
+	 */
+	virtual SGVector<float64_t> obtain_variable_reference();
+
+	virtual float64_t get_cost();
+
+	virtual void begin_sample();
+
+	virtual bool next_sample();
+
+	virtual SGVector<float64_t> get_gradient();
+
+	virtual SGVector<float64_t> get_average_gradient();
+
+	virtual int32_t get_sample_size();
+
+	virtual bool supports_sample_gradient() const { return true; }
+
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx);
+
+	virtual bool supports_sparse_sample_gradient() const { return true; }
+
+	virtual SGSparseVector<float64_t> get_sparse_sample_gradient(index_t idx);
+
+	/** @return name of the class */
+	virtual const char* get_name() const { return "MarginLossCostFunction"; }
+
+private:
+	/** @return derivative of the sample cost wrt the prediction of the
+	 * idx-th sample
+	 */
+	float64_t get_prediction_gradient(index_t idx) const;
+
+	void init();
+
+	/** features of the samples */
+	std::shared_ptr<DotFeatures> m_features;
+
+	/** labels of the samples */
+	SGVector<float64_t> m_labels;
+
+	/** margin loss */
+	std::shared_ptr<LossFunction> m_loss;
+
+	/** weights of the linear classifier */
+	SGVector<float64_t> m_weights;
+
+	/** current sample of the sample sequence */
+	index_t m_idx;
+};
+
+}
+#endif
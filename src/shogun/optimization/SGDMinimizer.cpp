@@ -30,9 +30,13 @@
  */
 #include <shogun/optimization/SGDMinimizer.h>
 #include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/L1Penalty.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/lib/config.h>
 
 #include <utility>
+#include <vector>
 using namespace shogun;
 
 SGDMinimizer::SGDMinimizer()
@@ -60,6 +64,17 @@ float64_t SGDMinimizer::minimize()
 	require(fun,"the cost function must be a stochastic cost function");
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
+		if(m_parallel_mode==SPM_HOGWILD)
+		{
+			do_hogwild_pass(fun,variable_reference);
+			continue;
+		}
+		if(m_parallel_mode==SPM_MINI_BATCH)
+		{
+			do_mini_batch_pass(fun,variable_reference);
+			continue;
+		}
+
 		fun->begin_sample();
 		while(fun->next_sample())
 		{
@@ -78,6 +93,95 @@ float64_t SGDMinimizer::minimize()
 	return cost+get_penalty(variable_reference);
 }
 
+void SGDMinimizer::do_hogwild_pass(
+	std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+	SGVector<float64_t> variable_reference)
+{
+	int32_t num_samples=fun->get_sample_size();
+	int32_t num_threads=Math::max(Math::min(env()->get_num_threads(), num_samples), 1);
+	int32_t iter_offset=m_iter_counter;
+
+	// the updaters keep per-coordinate state (eg, AdaGrad), each thread gets
+	// its own copy so that only the target variables are shared
+	std::vector<std::shared_ptr<DescendUpdater>> updaters(num_threads);
+	for(int32_t t=0; t<num_threads; t++)
+		updaters[t]=m_gradient_updater->clone()->as<DescendUpdater>();
+
+	// a penalty with a gradient (eg, L2) moves every variable, so sparse
+	// gradients only help without one
+	bool sparse=fun->supports_sparse_sample_gradient() &&
+		(!m_penalty_type || std::dynamic_pointer_cast<L1Penalty>(m_penalty_type));
+
+	#pragma omp parallel for num_threads(num_threads)
+	for(int32_t t=0; t<num_threads; t++)
+	{
+		int32_t local_iter=0;
+		for(index_t idx=t; idx<num_samples; idx+=num_threads)
+		{
+			local_iter++;
+			float64_t learning_rate=1.0;
+			if(m_learning_rate)
+				learning_rate=m_learning_rate->get_learning_rate(
+					iter_offset+local_iter*num_threads);
+			if(sparse)
+			{
+				updaters[t]->update_variable_sparse(variable_reference,
+					fun->get_sparse_sample_gradient(idx),learning_rate);
+				continue;
+			}
+			SGVector<float64_t> grad=fun->get_sample_gradient(idx);
+			update_gradient(grad,variable_reference);
+			updaters[t]->update_variable(variable_reference,grad,learning_rate);
+		}
+	}
+
+	m_iter_counter+=num_samples;
+	do_proximal_operation(variable_reference);
+}
+
+void SGDMinimizer::do_mini_batch_pass(
+	std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+	SGVector<float64_t> variable_reference)
+{
+	int32_t num_samples=fun->get_sample_size();
+	int32_t num_threads=env()->get_num_threads();
+	SGVector<float64_t> grad(variable_reference.vlen);
+
+	for(index_t begin=0; begin<num_samples; begin+=m_mini_batch_size)
+	{
+		index_t end=Math::min(begin+m_mini_batch_size, num_samples);
+		grad.zero();
+
+		#pragma omp parallel num_threads(num_threads)
+		{
+			SGVector<float64_t> local_grad(variable_reference.vlen);
+			local_grad.zero();
+
+			#pragma omp for
+			for(index_t idx=begin; idx<end; idx++)
+			{
+				SGVector<float64_t> sample_grad=fun->get_sample_gradient(idx);
+				SGVector<float64_t>::vec1_plus_scalar_times_vec2(local_grad.vector,
+					1.0, sample_grad.vector, local_grad.vlen);
+			}
+
+			#pragma omp critical
+			SGVector<float64_t>::vec1_plus_scalar_times_vec2(grad.vector,
+				1.0, local_grad.vector, grad.vlen);
+		}
+		grad.scale(1.0/(end-begin));
+
+		m_iter_counter++;
+		float64_t learning_rate=1.0;
+		if(m_learning_rate)
+			learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+		update_gradient(grad,variable_reference);
+		m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
+
+		do_proximal_operation(variable_reference);
+	}
+}
+
 void SGDMinimizer::init()
 {
 }
@@ -69,10 +69,37 @@ public:
 	 */
 	virtual float64_t minimize();
 
+	/** Does minimizer support batch update
+	 *
+	 * @return whether minimizer supports batch update
+	 */
+	virtual bool supports_batch_update() const
+	{
+		return m_parallel_mode==SPM_MINI_BATCH;
+	}
+
 protected:
 	/*  init the minimization process */
 	virtual void init_minimization();
 
+	/** Goes once through all samples, see SPM_HOGWILD
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable_reference the target variables
+	 */
+	virtual void do_hogwild_pass(
+		std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+		SGVector<float64_t> variable_reference);
+
+	/** Goes once through all samples, see SPM_MINI_BATCH
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable_reference the target variables
+	 */
+	virtual void do_mini_batch_pass(
+		std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+		SGVector<float64_t> variable_reference);
+
 private:
 	  /* Init */
 	void init();
@@ -81,6 +81,8 @@ void SVRGMinimizer::init_minimization()
 		sgd.set_penalty_weight(m_penalty_weight);
 		sgd.set_penalty_type(m_penalty_type);
 		sgd.set_learning_rate(m_learning_rate);
+		sgd.set_parallel_mode(m_parallel_mode);
+		sgd.set_mini_batch_size(m_mini_batch_size);
 		sgd.minimize();
 		m_iter_counter+=sgd.get_iteration_counter();
 	}
@@ -109,8 +109,7 @@ void HomogeneousKernelMap::init()
 	size_t numElements = (tableHeight * tableWidth + 2*(1+m_order));
 	if (unsigned(m_table.vlen) != numElements) {
 		SG_DEBUG ("reallocating... {} -> {}", m_table.vlen, numElements)
-		m_table.vector = SG_REALLOC (float64_t, m_table.vector, m_table.vlen, numElements);
-		m_table.vlen = numElements;
+		m_table.resize_vector(numElements);
 	}
 
 	int exponent;
@@ -0,0 +1,291 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/preprocessor/IncrementalPCA.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+IncrementalPCA::IncrementalPCA(int32_t target_dim, int32_t batch_size)
+    : DensePreprocessor<float64_t>()
+{
+	init();
+	require(
+	    batch_size > 0, "Batch size ({}) must be positive.", batch_size);
+	set_target_dim(target_dim);
+	m_batch_size = batch_size;
+}
+
+IncrementalPCA::~IncrementalPCA()
+{
+}
+
+void IncrementalPCA::init()
+{
+	m_target_dim = 1;
+	m_batch_size = 1024;
+	m_num_examples = 0;
+
+	SG_ADD(
+	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_batch_size, "batch_size", "Number of vectors per update",
+	    ParameterProperties::SETTING);
+	SG_ADD(&m_num_examples, "num_examples", "Number of vectors seen so far");
+	SG_ADD(&m_mean_vector, "mean_vector", "Mean Vector.");
+	SG_ADD(
+	    &m_transformation_matrix, "transformation_matrix",
+	    "Transformation matrix (principal directions).");
+	SG_ADD(
+	    &m_singular_values, "singular_values",
+	    "Singular values of the centered data.");
+}
+
+void IncrementalPCA::cleanup()
+{
+	m_num_examples = 0;
+	m_mean_vector = SGVector<float64_t>();
+	m_transformation_matrix = SGMatrix<float64_t>();
+	m_singular_values = SGVector<float64_t>();
+	m_fitted = false;
+}
+
+void IncrementalPCA::fit(std::shared_ptr<Features> features)
+{
+	cleanup();
+	partial_fit(std::move(features));
+}
+
+void IncrementalPCA::partial_fit(std::shared_ptr<Features> features)
+{
+	require(features, "No features provided.");
+
+	if (features->get_feature_class() == C_DENSE)
+	{
+		auto feature_matrix =
+		    features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+		for (index_t begin = 0; begin < feature_matrix.num_cols;
+		     begin += m_batch_size)
+		{
+			auto num_vectors =
+			    std::min(m_batch_size, feature_matrix.num_cols - begin);
+			partial_fit(
+			    SGMatrix<float64_t>(
+			        feature_matrix.get_column_vector(begin),
+			        feature_matrix.num_rows, num_vectors, false));
+		}
+		return;
+	}
+
+	require(
+	    features->get_feature_class() == C_STREAMING_DENSE &&
+	        features->get_feature_type() == F_DREAL,
+	    "Features ({}) must be dense or streaming dense features of 64bit "
+	    "floats.",
+	    features->get_name());
+
+	auto stream = features->as<StreamingDenseFeatures<float64_t>>();
+	stream->start_parser();
+	while (true)
+	{
+		SGMatrix<float64_t> batch =
+		    stream->get_streamed_features(m_batch_size)
+		        ->as<DenseFeatures<float64_t>>()
+		        ->get_feature_matrix();
+		if (batch.num_cols > 0)
+			partial_fit(batch);
+
+		/* stream is exhausted */
+		if (batch.num_cols < m_batch_size)
+			break;
+	}
+	stream->end_parser();
+}
+
+void IncrementalPCA::partial_fit(const SGMatrix<float64_t>& batch)
+{
+	if (batch.num_cols == 0)
+		return;
+
+	Map<MatrixXd> data(batch.matrix, batch.num_rows, batch.num_cols);
+	SGVector<float64_t> mean(batch.num_rows);
+	Map<VectorXd> mean_eig(mean.vector, mean.vlen);
+	mean_eig = data.rowwise().mean();
+
+	SGMatrix<float64_t> centered(batch.num_rows, batch.num_cols);
+	Map<MatrixXd> centered_eig(centered.matrix, batch.num_rows, batch.num_cols);
+	centered_eig = data.colwise() - mean_eig;
+
+	update(batch.num_cols, mean, centered);
+}
+
+void IncrementalPCA::merge(const std::shared_ptr<IncrementalPCA>& other)
+{
+	require(other, "No model to merge provided.");
+	if (other->m_num_examples == 0)
+		return;
+
+	auto num_features = other->m_transformation_matrix.num_rows;
+	auto num_dim = other->m_transformation_matrix.num_cols;
+	SGMatrix<float64_t> scatter(num_features, num_dim);
+	Map<MatrixXd> scatter_eig(scatter.matrix, num_features, num_dim);
+	scatter_eig =
+	    Map<MatrixXd>(
+	        other->m_transformation_matrix.matrix, num_features, num_dim) *
+	    Map<VectorXd>(other->m_singular_values.vector, num_dim).asDiagonal();
+
+	update(other->m_num_examples, other->m_mean_vector, scatter);
+}
+
+void IncrementalPCA::update(
+    int64_t num_examples, const SGVector<float64_t>& mean,
+    const SGMatrix<float64_t>& scatter)
+{
+	const index_t num_features = mean.vlen;
+	Map<VectorXd> mean_b(mean.vector, num_features);
+	Map<MatrixXd> scatter_b(scatter.matrix, num_features, scatter.num_cols);
+
+	// the scatter of the union is the one of
+	// [U S, scatter_b, sqrt(n_a n_b / n) (mean_b - mean_a)]
+	MatrixXd stacked;
+	if (m_num_examples == 0)
+	{
+		stacked = scatter_b;
+		m_mean_vector = mean.clone();
+	}
+	else
+	{
+		require(
+		    num_features == m_mean_vector.vlen,
+		    "Dimension of the vectors ({}) must match the previous ones ({}).",
+		    num_features, m_mean_vector.vlen);
+
+		const index_t num_dim = m_singular_values.vlen;
+		Map<VectorXd> mean_a(m_mean_vector.vector, num_features);
+		const float64_t num_total = m_num_examples + num_examples;
+
+		stacked = MatrixXd(num_features, num_dim + scatter_b.cols() + 1);
+		stacked.leftCols(num_dim) =
+		    Map<MatrixXd>(m_transformation_matrix.matrix, num_features, num_dim) *
+		    Map<VectorXd>(m_singular_values.vector, num_dim).asDiagonal();
+		stacked.middleCols(num_dim, scatter_b.cols()) = scatter_b;
+		stacked.rightCols(1) =
+		    std::sqrt(m_num_examples * (num_examples / num_total)) *
+		    (mean_b - mean_a);
+
+		mean_a += (mean_b - mean_a) * (num_examples / num_total);
+	}
+	m_num_examples += num_examples;
+
+	// thin SVD through QR, so that only the small triangular factor is
+	// decomposed: stacked = Q R = (Q W) S Z^T
+	const index_t rank = std::min<index_t>(num_features, stacked.cols());
+	HouseholderQR<MatrixXd> qr(stacked);
+	MatrixXd R = qr.matrixQR()
+	                 .topRows(rank)
+	                 .triangularView<Upper>()
+	                 .toDenseMatrix();
+	JacobiSVD<MatrixXd> svd(R, ComputeThinU);
+
+	const index_t num_dim = std::min<index_t>(m_target_dim, rank);
+	m_singular_values = SGVector<float64_t>(num_dim);
+	Map<VectorXd>(m_singular_values.vector, num_dim) =
+	    svd.singularValues().head(num_dim);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd>(m_transformation_matrix.matrix, num_features, num_dim)
+	    .noalias() = (qr.householderQ() * MatrixXd::Identity(num_features, rank)) *
+	                 svd.matrixU().leftCols(num_dim);
+
+	m_fitted = true;
+}
+
+SGMatrix<float64_t> IncrementalPCA::apply_to_matrix(SGMatrix<float64_t> matrix)
+{
+	assert_fitted();
+	require(
+	    matrix.num_rows == m_mean_vector.vlen,
+	    "Dimension of the vectors ({}) must match the fitted ones ({}).",
+	    matrix.num_rows, m_mean_vector.vlen);
+
+	auto num_dim = m_transformation_matrix.num_cols;
+	Map<MatrixXd> transform_matrix(
+	    m_transformation_matrix.matrix, matrix.num_rows, num_dim);
+	Map<VectorXd> mean(m_mean_vector.vector, m_mean_vector.vlen);
+	Map<MatrixXd> feature_matrix(matrix.matrix, matrix.num_rows, matrix.num_cols);
+
+	SGMatrix<float64_t> ret(num_dim, matrix.num_cols);
+	Map<MatrixXd> ret_matrix(ret.matrix, num_dim, matrix.num_cols);
+	ret_matrix.noalias() =
+	    transform_matrix.transpose() * (feature_matrix.colwise() - mean);
+
+	return ret;
+}
+
+SGVector<float64_t> IncrementalPCA::apply_to_feature_vector(SGVector<float64_t> vector)
+{
+	assert_fitted();
+	require(
+	    vector.vlen == m_mean_vector.vlen,
+	    "Dimension of the vector ({}) must match the fitted ones ({}).",
+	    vector.vlen, m_mean_vector.vlen);
+
+	auto num_dim = m_transformation_matrix.num_cols;
+	SGVector<float64_t> result(num_dim);
+	Map<VectorXd> result_vec(result.vector, num_dim);
+	Map<VectorXd> input_vec(vector.vector, vector.vlen);
+	Map<VectorXd> mean(m_mean_vector.vector, m_mean_vector.vlen);
+	Map<MatrixXd> transform_matrix(
+	    m_transformation_matrix.matrix, vector.vlen, num_dim);
+
+	result_vec.noalias() = transform_matrix.transpose() * (input_vec - mean);
+
+	return result;
+}
+
+SGMatrix<float64_t> IncrementalPCA::get_transformation_matrix() const
+{
+	return m_transformation_matrix;
+}
+
+SGVector<float64_t> IncrementalPCA::get_eigenvalues() const
+{
+	require(
+	    m_num_examples > 1, "At least 2 vectors are needed, {} were seen.",
+	    m_num_examples);
+
+	SGVector<float64_t> eigenvalues(m_singular_values.vlen);
+	for (index_t i = 0; i < eigenvalues.vlen; i++)
+	{
+		eigenvalues[i] = m_singular_values[i] * m_singular_values[i] /
+		                 (m_num_examples - 1);
+	}
+	return eigenvalues;
+}
+
+SGVector<float64_t> IncrementalPCA::get_mean() const
+{
+	return m_mean_vector;
+}
+
+int64_t IncrementalPCA::get_num_examples() const
+{
+	return m_num_examples;
+}
+
+void IncrementalPCA::set_target_dim(int32_t dim)
+{
+	require(dim > 0, "Target dimension ({}) must be positive.", dim);
+	m_target_dim = dim;
+}
+
+int32_t IncrementalPCA::get_target_dim() const
+{
+	return m_target_dim;
+}
@@ -0,0 +1,147 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef INCREMENTAL_PCA_H_
+#define INCREMENTAL_PCA_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/Features.h>
+#include <shogun/lib/common.h>
+#include <shogun/preprocessor/DensePreprocessor.h>
+
+namespace shogun
+{
+/** @brief Preprocessor IncrementalPCA performs principal component analysis
+ * on data that is seen in mini-batches, e.g. read from
+ * StreamingDenseFeatures, keeping only the mean and the T leading principal
+ * directions scaled by their singular values.
+ *
+ * Every batch X (with its own mean m_B subtracted) updates the model with
+ * the thin SVD of
+ * \f[
+ * [U S, X - m_B, \sqrt{\frac{n n_B}{n + n_B}} (m_B - m)]
+ * \f]
+ * of which again the T leading singular vectors are kept (Ross et al.,
+ * Incremental Learning for Robust Visual Tracking, 2008). The cost per batch
+ * is \f$O(D(T+N_B)^2)\f$ and memory is \f$O(D(T+N_B))\f$, independent of the
+ * total number of vectors. The SVD is computed from a QR decomposition of
+ * this matrix, which Eigen parallelizes. Models fitted on different shards
+ * can be merged with the same update.
+ *
+ * Vectors are centered with the fitted mean before they are projected on
+ * the principal directions.
+ */
+class IncrementalPCA : public DensePreprocessor<float64_t>
+{
+public:
+	/** constructor
+	 *
+	 * @param target_dim number of principal directions to keep
+	 * @param batch_size number of vectors per update
+	 */
+	IncrementalPCA(int32_t target_dim = 1, int32_t batch_size = 1024);
+
+	/** destructor */
+	virtual ~IncrementalPCA();
+
+	/** fit from scratch on (streaming) dense features
+	 *
+	 * @param features dense or streaming dense features
+	 */
+	virtual void fit(std::shared_ptr<Features> features);
+
+	/** update the fitted model with more (streaming) dense features
+	 *
+	 * @param features dense or streaming dense features
+	 */
+	void partial_fit(std::shared_ptr<Features> features);
+
+	/** update the fitted model with a batch of vectors
+	 *
+	 * @param batch matrix with one vector per column
+	 */
+	void partial_fit(const SGMatrix<float64_t>& batch);
+
+	/** update the fitted model with the model fitted on other data
+	 *
+	 * @param other model fitted on vectors of the same dimension
+	 */
+	void merge(const std::shared_ptr<IncrementalPCA>& other);
+
+	/** cleanup */
+	virtual void cleanup();
+
+	/** apply preprocessor to feature vector
+	 * @param vector feature vector
+	 * @return processed feature vector
+	 */
+	virtual SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector);
+
+	/** @return transformation matrix, i.e. the principal directions */
+	SGMatrix<float64_t> get_transformation_matrix() const;
+
+	/** @return variance along the principal directions, descending */
+	SGVector<float64_t> get_eigenvalues() const;
+
+	/** @return mean of the vectors seen so far */
+	SGVector<float64_t> get_mean() const;
+
+	/** @return number of vectors seen so far */
+	int64_t get_num_examples() const;
+
+	/** setter for target dimension
+	 * @param dim target dimension
+	 */
+	void set_target_dim(int32_t dim);
+
+	/** getter for target dimension
+	 * @return target dimension
+	 */
+	int32_t get_target_dim() const;
+
+	/** @return object name */
+	virtual const char* get_name() const { return "IncrementalPCA"; }
+
+	/** @return a type of preprocessor */
+	virtual EPreprocessorType get_type() const { return P_INCREMENTALPCA; }
+
+protected:
+	virtual SGMatrix<float64_t> apply_to_matrix(SGMatrix<float64_t> matrix);
+
+private:
+	void init();
+
+	/** adds vectors with the given number, mean and scatter to the model
+	 *
+	 * @param num_examples number of vectors
+	 * @param mean mean of the vectors
+	 * @param scatter matrix Y with \f$YY^T\f$ the scatter matrix of the
+	 * vectors around their mean
+	 */
+	void update(
+	    int64_t num_examples, const SGVector<float64_t>& mean,
+	    const SGMatrix<float64_t>& scatter);
+
+protected:
+	/** number of principal directions to keep */
+	int32_t m_target_dim;
+
+	/** number of vectors per update */
+	int32_t m_batch_size;
+
+	/** number of vectors seen so far */
+	int64_t m_num_examples;
+
+	/** mean vector */
+	SGVector<float64_t> m_mean_vector;
+
+	/** principal directions */
+	SGMatrix<float64_t> m_transformation_matrix;
+
+	/** singular values of the centered data */
+	SGVector<float64_t> m_singular_values;
+};
+}
+#endif // INCREMENTAL_PCA_H_
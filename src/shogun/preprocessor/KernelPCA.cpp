@@ -19,15 +19,16 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/RandomizedDecompositions.h>
 
 using namespace shogun;
 
-KernelPCA::KernelPCA() : Preprocessor()
+KernelPCA::KernelPCA() : RandomMixin<Preprocessor>()
 {
 	init();
 }
 
-KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : Preprocessor()
+KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : RandomMixin<Preprocessor>()
 {
 	init();
 	set_kernel(std::move(k));
@@ -40,6 +41,8 @@ void KernelPCA::init()
 	m_transformation_matrix = SGMatrix<float64_t>();
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
+	m_randomized = false;
+	m_num_power_iterations = 2;
 	m_kernel = NULL;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
@@ -49,6 +52,11 @@ void KernelPCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(&m_randomized, "randomized",
+		"whether to use the randomized eigensolver", ParameterProperties::SETTING);
+	SG_ADD(&m_num_power_iterations, "num_power_iterations",
+		"number of power iterations of the randomized eigensolver",
+		ParameterProperties::SETTING);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
 }
 
@@ -100,8 +108,17 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 
 	SGVector<float64_t> eigenvalues(m_target_dim);
 	SGMatrix<float64_t> eigenvectors(kernel_matrix.num_rows, m_target_dim);
-	linalg::eigen_solver_symmetric(
-	    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
+	if (m_randomized)
+	{
+		linalg::randomized_eigen_solver_symmetric(
+		    kernel_matrix, eigenvalues, eigenvectors, m_prng, 10,
+		    m_num_power_iterations);
+	}
+	else
+	{
+		linalg::eigen_solver_symmetric(
+		    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
+	}
 
 	m_transformation_matrix =
 	    SGMatrix<float64_t>(kernel_matrix.num_rows, m_target_dim);
@@ -228,6 +245,16 @@ int32_t KernelPCA::get_target_dim() const
 	return m_target_dim;
 }
 
+void KernelPCA::set_randomized(bool randomized)
+{
+	m_randomized = randomized;
+}
+
+bool KernelPCA::get_randomized() const
+{
+	return m_randomized;
+}
+
 void KernelPCA::set_kernel(std::shared_ptr<Kernel> kernel)
 {
 
@@ -12,6 +12,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -27,8 +28,12 @@ class Kernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * With set_randomized(true), the leading eigenvectors of the centered kernel
+ * matrix are approximated by a randomized range finder with power iterations
+ * (see linalg::randomized_eigen_solver_symmetric), which costs O(n^2 k) instead
+ * of O(n^3) for n vectors and k target dimensions.
  */
-class KernelPCA : public Preprocessor
+class KernelPCA : public RandomMixin<Preprocessor>
 {
 public:
 		/** default constructor
@@ -101,6 +106,16 @@ public:
 		 */
 		int32_t get_target_dim() const;
 
+		/** setter for randomized eigendecomposition
+		 * @param randomized whether to use the randomized eigensolver
+		 */
+		void set_randomized(bool randomized);
+
+		/** getter for randomized eigendecomposition
+		 * @return whether the randomized eigensolver is used
+		 */
+		bool get_randomized() const;
+
 		/** setter for kernel
 		 * @param kernel kernel to set
 		 */
@@ -130,6 +145,12 @@ public:
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** whether to use the randomized eigensolver */
+		bool m_randomized;
+
+		/** number of power iterations of the randomized eigensolver */
+		int32_t m_num_power_iterations;
+
 		/** kernel to be used */
 		std::shared_ptr<Kernel> m_kernel;
 };
@@ -9,7 +9,9 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StreamingStatistics.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/RandomizedDecompositions.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PCA.h>
 
@@ -19,7 +21,7 @@ using namespace Eigen;
 PCA::PCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -30,7 +32,7 @@ PCA::PCA(
 }
 
 PCA::PCA(EPCAMethod method, bool do_whitening, EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -51,6 +53,8 @@ void PCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_num_power_iterations = 2;
+	m_oversampling = 10;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -72,6 +76,14 @@ void PCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_power_iterations, "num_power_iterations",
+	    "Number of power iterations of the randomized method",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "Number of additional samples of the randomized method",
+	    ParameterProperties::SETTING);
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_mode, "mode", "PCA Mode.",
 	    ParameterProperties::HYPER,
@@ -83,7 +95,7 @@ void PCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED));
 }
 
 PCA::~PCA()
@@ -92,6 +104,15 @@ PCA::~PCA()
 
 void PCA::fit(std::shared_ptr<Features> features)
 {
+	// data streamed in mini-batches is fitted from its covariance matrix
+	if (features->get_feature_class() == C_STREAMING_DENSE)
+	{
+		auto statistics = std::make_shared<StreamingStatistics>(true);
+		statistics->update(features);
+		fit_from_statistics(statistics);
+		return;
+	}
+
 	if (m_fitted)
 		cleanup();
 
@@ -117,34 +138,84 @@ void PCA::fit(std::shared_ptr<Features> features)
 	data_mean = fmatrix.rowwise().sum() / (float64_t)num_vectors;
 	fmatrix = fmatrix.colwise() - data_mean;
 
-	m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
-
 	if (m_method == AUTO)
 		m_method = (num_vectors > num_features) ? EVD : SVD;
 
-	if (m_method == EVD)
-		init_with_evd(feature_matrix, max_dim_allowed);
+	if (m_method == RANDOMIZED)
+	{
+		init_with_randomized_svd(feature_matrix);
+	}
 	else
-		init_with_svd(feature_matrix, max_dim_allowed);
+	{
+		m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
+		if (m_method == EVD)
+			init_with_evd(feature_matrix, max_dim_allowed);
+		else
+			init_with_svd(feature_matrix, max_dim_allowed);
+	}
 
 	// restore feature matrix
 	fmatrix = fmatrix.colwise() + data_mean;
 	m_fitted = true;
 }
 
+void PCA::fit_from_statistics(
+    const std::shared_ptr<StreamingStatistics>& statistics)
+{
+	if (m_fitted)
+		cleanup();
+
+	require(
+	    statistics->get_compute_cov(),
+	    "PCA needs statistics that accumulate the covariance matrix.");
+	auto num_vectors = statistics->get_num_examples();
+	auto num_features = statistics->get_num_features();
+	io::info("num_examples: {} num_features: {}", num_vectors, num_features);
+
+	auto max_dim_allowed =
+	    (int32_t)std::min<int64_t>(num_vectors, num_features);
+	num_dim = 0;
+
+	require(
+	    m_target_dim <= max_dim_allowed,
+	    "target dimension should be less or equal to than minimum of N and D");
+	require(
+	    m_method == AUTO || m_method == EVD,
+	    "PCA from statistics can only use the EVD method.");
+
+	m_mean_vector = statistics->get_mean();
+	m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
+	init_with_covariance(
+	    statistics->get_cov(true), num_vectors, max_dim_allowed);
+
+	m_fitted = true;
+}
+
 void PCA::init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed)
 {
 	int32_t num_vectors = feature_matrix.num_cols;
 	int32_t num_features = feature_matrix.num_rows;
 
 	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
-	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, max_dim_allowed);
 
 	// covariance matrix
-	MatrixXd cov_mat(num_features, num_features);
+	SGMatrix<float64_t> cov(num_features, num_features);
+	Map<MatrixXd> cov_mat(cov.matrix, num_features, num_features);
 	cov_mat = fmatrix*fmatrix.transpose();
 	cov_mat /= (num_vectors-1);
 
+	init_with_covariance(cov, num_vectors, max_dim_allowed);
+}
+
+void PCA::init_with_covariance(
+    const SGMatrix<float64_t>& cov, int64_t num_vectors,
+    int32_t max_dim_allowed)
+{
+	int32_t num_features = cov.num_rows;
+
+	Map<MatrixXd> cov_mat(cov.matrix, num_features, num_features);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, max_dim_allowed);
+
 	io::info("Computing Eigenvalues");
 	// eigen value computed
 	SelfAdjointEigenSolver<MatrixXd> eigenSolve =
@@ -289,6 +360,56 @@ void PCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_d
 	}
 }
 
+void PCA::init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix)
+{
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+
+	require(
+	    m_mode == FIXED_NUMBER,
+	    "Randomized PCA only supports FIXED_NUMBER mode as it computes the "
+	    "leading {} eigenvalues only.",
+	    m_target_dim);
+
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	io::info("Reducing from {} to {} features...", num_features, num_dim);
+
+	// left singular vectors of the centered data form eigenvectors
+	SGVector<float64_t> singular_values(num_dim);
+	SGMatrix<float64_t> right_vectors;
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	linalg::randomized_svd(
+	    feature_matrix, singular_values, m_transformation_matrix,
+	    right_vectors, m_prng, m_oversampling, m_num_power_iterations);
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	Map<VectorXd> singularValues(singular_values.vector, num_dim);
+	eigenValues = singularValues.cwiseProduct(singularValues) / (num_vectors - 1);
+
+	if (m_whitening)
+	{
+		Map<MatrixXd> transformMatrix(
+		    m_transformation_matrix.matrix, num_features, num_dim);
+		for (int32_t i = 0; i < num_dim; i++)
+		{
+			if (Math::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				io::warn("Covariance matrix has almost zero Eigenvalue (ie "
+					"Eigenvalue within a tolerance of {:E} around 0) at "
+					"dimension {}. Consider reducing its dimension.",
+					m_eigenvalue_zero_tolerance, i + 1);
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /= singularValues[i];
+		}
+	}
+}
+
 void PCA::cleanup()
 {
 	m_transformation_matrix=SGMatrix<float64_t>();
@@ -409,3 +530,20 @@ int32_t PCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void PCA::set_num_power_iterations(int32_t num_power_iterations)
+{
+	require(
+	    num_power_iterations >= 0,
+	    "Number of power iterations ({}) must be non-negative.",
+	    num_power_iterations);
+	m_num_power_iterations = num_power_iterations;
+}
+
+void PCA::set_oversampling(int32_t oversampling)
+{
+	require(
+	    oversampling >= 0, "Oversampling ({}) must be non-negative.",
+	    oversampling);
+	m_oversampling = oversampling;
+}
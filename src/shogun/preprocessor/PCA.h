@@ -13,10 +13,13 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
 {
+class StreamingStatistics;
+
 /** Matrix decomposition method for PCA */
 enum EPCAMethod
 {
@@ -29,7 +32,11 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized truncated SVD of the data matrix, FIXED_NUMBER mode only.
+	 * Time complexity ~dnk (k-target dimensions)
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -83,6 +90,14 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
+ * <em>RANDOMIZED</em> : Randomized truncated SVD of the feature matrix X
+ * (Halko, Martinsson and Tropp, 2011). Only the T leading singular vectors are
+ * approximated from the range of \f$X\Omega\f$ for a gaussian test matrix
+ * \f$\Omega\f$, refined by a few power iterations. Only the T leading
+ * eigenvalues are computed. The time complexity of this method is
+ * \f$~DNT\f$ per power iteration and it can only be used in FIXED_NUMBER
+ * mode.
+ *
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
@@ -104,7 +119,7 @@ enum EPCAMemoryMode
  *
  * Note that vectors/matrices don't have to have zero mean as it is substracted within the class.
  */
-class PCA : public DensePreprocessor<float64_t>
+class PCA : public RandomMixin<DensePreprocessor<float64_t>>
 {
 	public:
 
@@ -113,7 +128,7 @@ class PCA : public DensePreprocessor<float64_t>
 		 * @param do_whitening normalize columns(eigenvectors) in transformation matrix
 		 * @param mode mode of pca : FIXED_NUMBER/VARIANCE_EXPLAINED/THRESHOLD
 		 * @param thresh threshold value for VARIANCE_EXPLAINED or THRESHOLD mode
-		 * @param method Matrix decomposition method used : SVD/EVD/AUTO[default]
+		 * @param method Matrix decomposition method used : SVD/EVD/RANDOMIZED/AUTO[default]
 		 * @param mem_mode memory usage mode of PCA : MEM_REALLOCATE/MEM_IN_PLACE
 		 */
 		PCA(bool do_whitening=false, EPCAMode mode=FIXED_NUMBER, float64_t thresh=1e-6,
@@ -132,6 +147,14 @@ class PCA : public DensePreprocessor<float64_t>
 
 		virtual void fit(std::shared_ptr<Features> features);
 
+		/** fit from accumulated statistics with the EVD method, e.g. of
+		 * data streamed in mini-batches or merged from several shards
+		 *
+		 * @param statistics statistics accumulating the covariance matrix
+		 */
+		void fit_from_statistics(
+		    const std::shared_ptr<StreamingStatistics>& statistics);
+
 		/** cleanup */
 		virtual void cleanup();
 
@@ -188,6 +211,16 @@ class PCA : public DensePreprocessor<float64_t>
 		 */
 		int32_t get_target_dim() const;
 
+		/** set number of power iterations of the RANDOMIZED method
+		 * @param num_power_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_power_iterations);
+
+		/** set number of additional samples of the RANDOMIZED method
+		 * @param oversampling number of additional columns of the test matrix
+		 */
+		void set_oversampling(int32_t oversampling);
+
 	protected:
 
 		void init();
@@ -225,11 +258,24 @@ class PCA : public DensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** number of power iterations of the RANDOMIZED method */
+		int32_t m_num_power_iterations;
+
+		/** number of additional samples of the RANDOMIZED method */
+		int32_t m_oversampling;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix from the eigenvalue
+		 * decomposition of the covariance matrix */
+		void init_with_covariance(
+		    const SGMatrix<float64_t>& cov, int64_t num_vectors,
+		    int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized truncated svd */
+		void init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix);
 };
 }
 #endif // PCA_H_
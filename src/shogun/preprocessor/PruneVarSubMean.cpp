@@ -8,6 +8,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/StreamingStatistics.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
@@ -28,43 +29,27 @@ PruneVarSubMean::~PruneVarSubMean()
 }
 
 void PruneVarSubMean::fit(std::shared_ptr<Features> features)
+{
+	auto statistics = std::make_shared<StreamingStatistics>();
+	statistics->update(features);
+	fit_from_statistics(statistics);
+}
+
+void PruneVarSubMean::fit_from_statistics(
+    const std::shared_ptr<StreamingStatistics>& statistics)
 {
 	if (m_fitted)
 		cleanup();
 
-	auto simple_features = features->as<DenseFeatures<float64_t>>();
-	auto num_examples = simple_features->get_num_vectors();
-	auto num_features = simple_features->get_num_features();
-
-	m_idx = SGVector<int32_t>();
-	m_std = SGVector<float64_t>();
-
-	SGVector<float64_t> var(num_features);
-
-	auto feature_matrix = simple_features->get_feature_matrix();
-
-	// compute mean
-	m_mean = linalg::rowwise_sum(feature_matrix);
-	linalg::scale(m_mean, m_mean, 1.0 / num_examples);
-
-	// compute var
-	for (auto i : range(num_examples))
-	{
-		for (auto j : range(num_features))
-		{
-			auto diff =
-			    linalg::add(m_mean, feature_matrix.get_column(i), 1.0, -1.0);
-			var[j] += linalg::dot(diff, diff);
-		}
-	}
+	auto num_features = statistics->get_num_features();
+	auto mean = statistics->get_mean();
+	auto var = statistics->get_variance();
 
 	int32_t num_ok = 0;
 	auto idx_ok = SGVector<int32_t>(num_features);
 
 	for (auto j : range(num_features))
 	{
-		var[j] /= num_examples;
-
 		if (var[j] >= 1e-14)
 		{
 			idx_ok[num_ok] = j;
@@ -74,18 +59,17 @@ void PruneVarSubMean::fit(std::shared_ptr<Features> features)
 
 	io::info("Reducing number of features from {} to {}", num_features, num_ok);
 
-	m_idx.resize_vector(num_ok);
-	SGVector<float64_t> new_mean(num_ok);
-	m_std.resize_vector(num_ok);
+	m_idx = SGVector<int32_t>(num_ok);
+	m_mean = SGVector<float64_t>(num_ok);
+	m_std = SGVector<float64_t>(num_ok);
 
 	for (auto j : range(num_ok))
 	{
 		m_idx[j] = idx_ok[j];
-		new_mean[j] = m_mean[idx_ok[j]];
+		m_mean[j] = mean[idx_ok[j]];
 		m_std[j] = std::sqrt(var[idx_ok[j]]);
 	}
 	m_num_idx = num_ok;
-	m_mean = new_mean;
 
 	m_fitted = true;
 }
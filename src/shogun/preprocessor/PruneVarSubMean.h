@@ -17,6 +17,8 @@
 
 namespace shogun
 {
+class StreamingStatistics;
+
 /** @brief Preprocessor PruneVarSubMean will substract the mean and remove
  * features that have zero variance.
  *
@@ -35,9 +37,17 @@ class PruneVarSubMean : public DensePreprocessor<float64_t>
 		/** destructor */
 		virtual ~PruneVarSubMean();
 
-		/// Fit preprocessor into features
+		/// Fit preprocessor into (streaming) dense features
 		virtual void fit(std::shared_ptr<Features> features);
 
+		/** Fit preprocessor from accumulated statistics, e.g. of data
+		 * streamed in mini-batches or merged from several shards
+		 *
+		 * @param statistics the statistics to take mean and variance from
+		 */
+		void fit_from_statistics(
+		    const std::shared_ptr<StreamingStatistics>& statistics);
+
 		/// cleanup
 		virtual void cleanup();
 
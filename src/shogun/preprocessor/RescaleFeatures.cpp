@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <shogun/base/range.h>
+#include <shogun/mathematics/StreamingStatistics.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/RescaleFeatures.h>
 
@@ -22,39 +23,36 @@ RescaleFeatures::~RescaleFeatures()
 }
 
 void RescaleFeatures::fit(std::shared_ptr<Features> features)
+{
+	auto statistics = std::make_shared<StreamingStatistics>();
+	statistics->update(features);
+	fit_from_statistics(statistics);
+}
+
+void RescaleFeatures::fit_from_statistics(
+    const std::shared_ptr<StreamingStatistics>& statistics)
 {
 	if (m_fitted)
 		cleanup();
 
-	auto simple_features = features->as<DenseFeatures<float64_t>>();
-	int32_t num_examples = simple_features->get_num_vectors();
-	int32_t num_features = simple_features->get_num_features();
 	require(
-	    num_examples > 1, "number of feature vectors should be at least 2!");
+	    statistics->get_num_examples() > 1,
+	    "number of feature vectors should be at least 2!");
 
 	io::info("Extracting min and range values for each feature");
 
+	int32_t num_features = statistics->get_num_features();
+	auto min = statistics->get_min();
+	auto max = statistics->get_max();
 	m_min = SGVector<float64_t>(num_features);
 	m_range = SGVector<float64_t>(num_features);
-	auto feature_matrix = simple_features->get_feature_matrix();
 	for (index_t i = 0; i < num_features; i++)
 	{
-		SGVector<float64_t> vec = feature_matrix.get_row_vector(i);
-		float64_t cur_min = vec[0];
-		float64_t cur_max = vec[0];
-
-		/* find the max and min values in one loop */
-		for (index_t j = 1; j < vec.vlen; j++)
-		{
-			cur_min = std::min(vec[j], cur_min);
-			cur_max = std::max(vec[j], cur_max);
-		}
-
 		/* only rescale if range > 0 */
-		if ((cur_max - cur_min) > 0)
+		if ((max[i] - min[i]) > 0)
 		{
-			m_min[i] = cur_min;
-			m_range[i] = 1.0 / (cur_max - cur_min);
+			m_min[i] = min[i];
+			m_range[i] = 1.0 / (max[i] - min[i]);
 		}
 		else
 		{
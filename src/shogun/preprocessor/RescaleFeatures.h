@@ -13,6 +13,8 @@
 
 namespace shogun
 {
+	class StreamingStatistics;
+
 	/**@brief Preprocessor RescaleFeautres is rescaling the range of features to
 	 * make the features independent of each other and aims to scale the range
 	 * in [0, 1] or [-1, 1].
@@ -35,11 +37,21 @@ namespace shogun
 		/**
 		 * Fit preprocessor into features
 		 *
-		 * @param features the features to derive the min and max values
-		 * from.
+		 * @param features the (streaming) dense features to derive the min
+		 * and max values from.
 		 */
 		virtual void fit(std::shared_ptr<Features> features);
 
+		/**
+		 * Fit preprocessor from accumulated statistics, e.g. of data
+		 * streamed in mini-batches or merged from several shards
+		 *
+		 * @param statistics the statistics to take the min and max values
+		 * from.
+		 */
+		void fit_from_statistics(
+		    const std::shared_ptr<StreamingStatistics>& statistics);
+
 		/**
 		 * Cleanup
 		 */
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <shogun/io/SGIO.h>
 #include <shogun/structure/BeliefPropagation.h>
@@ -61,6 +62,16 @@ TreeMaxProduct::TreeMaxProduct(std::shared_ptr<FactorGraph> fg)
 
 	get_message_order(m_msg_order, m_is_root);
 
+	auto facs = m_fg->get_factors();
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+
+	m_msg_map_var.assign(cards.size(), -1);
+	m_msg_map_fac.assign(facs.size(), -1);
+	m_msgset_map_var.assign(cards.size(), std::vector<int32_t>());
+	m_msg_offsets.resize(m_msg_order.size() + 1);
+	m_msg_var_index.resize(m_msg_order.size());
+	m_msg_offsets[0] = 0;
+
 	// calculate lookup tables for forward messages
 	// a key is unique because a tree has only one root
 	// a var or a factor has only one edge towards root
@@ -76,8 +87,18 @@ TreeMaxProduct::TreeMaxProduct(std::shared_ptr<FactorGraph> fg)
 			// <fac_id, msg_id>
 			m_msg_map_fac[m_msg_order[mi]->child] = mi;
 			// collect incoming msgs for each var_id
-			m_msgset_map_var[m_msg_order[mi]->parent].insert(mi);
+			m_msgset_map_var[m_msg_order[mi]->parent].push_back(mi);
 		}
+
+		// msg size is determined by var node of msg edge
+		int32_t var_id = m_msg_order[mi]->get_var_node();
+		m_msg_offsets[mi+1] = m_msg_offsets[mi] + cards[var_id];
+
+		// find index of var_id in the factor
+		SGVector<int32_t> fvars = facs[m_msg_order[mi]->get_factor_node()]->get_variables();
+		SGVector<int32_t> fvar_set = fvars.find(var_id);
+		ASSERT(fvar_set.vlen == 1);
+		m_msg_var_index[mi] = fvar_set[0];
 	}
 
 }
@@ -95,15 +116,15 @@ void TreeMaxProduct::init()
 {
 	m_msg_order = std::vector<MessageEdge*>(m_fg->get_num_edges(), (MessageEdge*) NULL);
 	m_is_root = std::vector<bool>(m_fg->get_cardinalities().size(), false);
-	m_fw_msgs = std::vector< std::vector<float64_t> >(m_msg_order.size(),
-			std::vector<float64_t>());
-	m_bw_msgs = std::vector< std::vector<float64_t> >(m_msg_order.size(),
-			std::vector<float64_t>());
+	m_msg_offsets = std::vector<int32_t>();
+	m_msg_var_index = std::vector<int32_t>();
+	m_fw_msgs = std::vector<float64_t>();
+	m_bw_msgs = std::vector<float64_t>();
 	m_states = std::vector<int32_t>(m_fg->get_cardinalities().size(), 0);
 
-	m_msg_map_var = msg_map_type();
-	m_msg_map_fac = msg_map_type();
-	m_msgset_map_var = msgset_map_type();
+	m_msg_map_var = std::vector<int32_t>();
+	m_msg_map_fac = std::vector<int32_t>();
+	m_msgset_map_var = std::vector< std::vector<int32_t> >();
 }
 
 void TreeMaxProduct::get_message_order(std::vector<MessageEdge*>& order,
@@ -210,6 +231,8 @@ float64_t TreeMaxProduct::inference(SGVector<int32_t> assignment)
 		"{}::inference(): the output assignment should be prepared as"
 		"the same size as variables!", get_name());
 
+	m_fg->build_factor_table(m_table);
+
 	bottom_up_pass();
 	top_down_pass();
 
@@ -225,17 +248,10 @@ float64_t TreeMaxProduct::inference(SGVector<int32_t> assignment)
 void TreeMaxProduct::bottom_up_pass()
 {
 	SG_DEBUG("\n***enter bottom_up_pass().");
-	auto facs = m_fg->get_factors();
 	SGVector<int32_t> cards = m_fg->get_cardinalities();
 
 	// init forward msgs to 0
-	m_fw_msgs.resize(m_msg_order.size());
-	for (uint32_t mi = 0; mi < m_msg_order.size(); ++mi)
-	{
-		// msg size is determined by var node of msg edge
-		m_fw_msgs[mi].resize(cards[m_msg_order[mi]->get_var_node()]);
-		std::fill(m_fw_msgs[mi].begin(), m_fw_msgs[mi].end(), 0);
-	}
+	m_fw_msgs.assign(m_msg_offsets.back(), 0);
 
 	// pass msgs along the order up to root
 	// if var -> factor
@@ -250,69 +266,55 @@ void TreeMaxProduct::bottom_up_pass()
 		SG_DEBUG("mi = {}, mtype: {} {} -> {}", mi,
 			m_msg_order[mi]->mtype, m_msg_order[mi]->child, m_msg_order[mi]->parent);
 
+		float64_t* msg = m_fw_msgs.data() + m_msg_offsets[mi];
+
 		if (m_msg_order[mi]->mtype == VAR_TO_FAC) // var -> factor
 		{
-			uint32_t var_id = m_msg_order[mi]->child;
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
+			int32_t var_id = m_msg_order[mi]->child;
 
 			// q_v2f = sum(r_f2v), i.e. sum all incoming f2v msgs
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin(); cit != msgset_var.end(); cit++)
+			for (int32_t in_msg : m_msgset_map_var[var_id])
 			{
-				std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-					m_fw_msgs[mi].begin(),
-					m_fw_msgs[mi].begin(),
-					std::plus<float64_t>());
+				const float64_t* r_f2v = m_fw_msgs.data() + m_msg_offsets[in_msg];
+				for (int32_t si = 0; si < cards[var_id]; si++)
+					msg[si] += r_f2v[si];
 			}
 		}
 		else // factor -> var
 		{
 			int32_t fac_id = m_msg_order[mi]->child;
 			int32_t var_id = m_msg_order[mi]->parent;
+			int32_t var_id_index = m_msg_var_index[mi];
 
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
-
-
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
+			const float64_t* fenrgs = m_table.energies.data() + m_table.energy_offsets[fac_id];
+			int32_t num_enrgs = m_table.energy_offsets[fac_id+1] - m_table.energy_offsets[fac_id];
+			const int32_t* fvars = m_table.variables.data() + m_table.variable_offsets[fac_id];
+			int32_t num_fvars = m_table.variable_offsets[fac_id+1] - m_table.variable_offsets[fac_id];
 
-			std::vector<float64_t> r_f2v(fenrgs.size(), 0);
-			std::vector<float64_t> r_f2v_max(cards[var_id],
-				-std::numeric_limits<float64_t>::infinity());
+			std::fill(msg, msg + cards[var_id], -std::numeric_limits<float64_t>::infinity());
 
-			// TODO: optimize with index_from_new_state()
 			// marginalization
 			// r_f2v = max(-fenrg + sum_{j!=var_id} q_v2f[adj_var_state])
-			for (int32_t ei = 0; ei < fenrgs.size(); ei++)
+			for (int32_t ei = 0; ei < num_enrgs; ei++)
 			{
-				r_f2v[ei] = -fenrgs[ei];
+				float64_t r_f2v = -fenrgs[ei];
 
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
+				for (int32_t vi = 0; vi < num_fvars; vi++)
 				{
 					if (vi == var_id_index)
 						continue;
 
-					uint32_t adj_msg = m_msg_map_var[fvars[vi]];
-					int32_t adj_var_state = ftype->state_from_index(ei, vi);
+					int32_t adj_msg = m_msg_map_var[fvars[vi]];
+					int32_t adj_var_state = m_table.state_from_index(fac_id, ei, vi);
 
-					r_f2v[ei] += m_fw_msgs[adj_msg][adj_var_state];
+					r_f2v += m_fw_msgs[m_msg_offsets[adj_msg] + adj_var_state];
 				}
 
-				// find max value for each state of var_id
-				int32_t var_state = ftype->state_from_index(ei, var_id_index);
-				if (r_f2v[ei] > r_f2v_max[var_state])
-					r_f2v_max[var_state] = r_f2v[ei];
+				// in max-product, final r_f2v is the max value for each state of var_id
+				int32_t var_state = m_table.state_from_index(fac_id, ei, var_id_index);
+				if (r_f2v > msg[var_state])
+					msg[var_state] = r_f2v;
 			}
-
-			// in max-product, final r_f2v = r_f2v_max
-			for (int32_t si = 0; si < cards[var_id]; si++)
-				m_fw_msgs[mi][si] = r_f2v_max[si];
-
-
 		}
 	}
 
@@ -324,14 +326,12 @@ void TreeMaxProduct::bottom_up_pass()
 		if (!m_is_root[ri])
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
 		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
+		for (int32_t in_msg : m_msgset_map_var[ri])
 		{
-			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-				rmarg.begin(),
-				rmarg.begin(),
-				std::plus<float64_t>());
+			const float64_t* r_f2v = m_fw_msgs.data() + m_msg_offsets[in_msg];
+			for (int32_t si = 0; si < cards[ri]; si++)
+				rmarg[si] += r_f2v[si];
 		}
 
 		m_map_energy += *std::max_element(rmarg.begin(), rmarg.end());
@@ -343,17 +343,10 @@ void TreeMaxProduct::top_down_pass()
 {
 	SG_DEBUG("\n***enter top_down_pass().");
 	int32_t minf = std::numeric_limits<int32_t>::max();
-	auto facs = m_fg->get_factors();
 	SGVector<int32_t> cards = m_fg->get_cardinalities();
 
 	// init backward msgs to 0
-	m_bw_msgs.resize(m_msg_order.size());
-	for (uint32_t mi = 0; mi < m_msg_order.size(); ++mi)
-	{
-		// msg size is determined by var node of msg edge
-		m_bw_msgs[mi].resize(cards[m_msg_order[mi]->get_var_node()]);
-		std::fill(m_bw_msgs[mi].begin(), m_bw_msgs[mi].end(), 0);
-	}
+	m_bw_msgs.assign(m_msg_offsets.back(), 0);
 
 	// init states to max infinity
 	m_states.resize(cards.size());
@@ -366,15 +359,13 @@ void TreeMaxProduct::top_down_pass()
 		if (!m_is_root[ri])
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
 		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
+		for (int32_t in_msg : m_msgset_map_var[ri])
 		{
-			// rmarg += m_fw_msgs[*cit]
-			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-				rmarg.begin(),
-				rmarg.begin(),
-				std::plus<float64_t>());
+			// rmarg += m_fw_msgs[in_msg]
+			const float64_t* r_f2v = m_fw_msgs.data() + m_msg_offsets[in_msg];
+			for (int32_t si = 0; si < cards[ri]; si++)
+				rmarg[si] += r_f2v[si];
 		}
 
 		// argmax
@@ -394,21 +385,20 @@ void TreeMaxProduct::top_down_pass()
 		SG_DEBUG("mi = {}, mtype: {} {} <- {}", mi,
 			m_msg_order[mi]->mtype, m_msg_order[mi]->child, m_msg_order[mi]->parent);
 
+		float64_t* msg = m_bw_msgs.data() + m_msg_offsets[mi];
+		int32_t msg_size = m_msg_offsets[mi+1] - m_msg_offsets[mi];
+
 		if (m_msg_order[mi]->mtype == FAC_TO_VAR) // factor <- var
 		{
 			int32_t fac_id = m_msg_order[mi]->child;
 			int32_t var_id = m_msg_order[mi]->parent;
+			int32_t var_id_index = m_msg_var_index[mi];
 
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
-
-
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
+			const float64_t* fenrgs = m_table.energies.data() + m_table.energy_offsets[fac_id];
+			int32_t num_enrgs = m_table.energy_offsets[fac_id+1] - m_table.energy_offsets[fac_id];
+			const int32_t* fvars = m_table.variables.data() + m_table.variable_offsets[fac_id];
+			int32_t num_fvars = m_table.variable_offsets[fac_id+1] - m_table.variable_offsets[fac_id];
+			int32_t var_id_stride = m_table.strides[m_table.variable_offsets[fac_id] + var_id_index];
 
 			// q_v2f = r_bw_parent2v + sum_{child!=f} r_fw_child2v
 			// make sure the state of var_id has been inferred (factor marginalization)
@@ -418,100 +408,87 @@ void TreeMaxProduct::top_down_pass()
 			// parent msg: r_bw_parent2v
 			if (m_is_root[var_id] == 0)
 			{
-				uint32_t parent_msg = m_msg_map_var[var_id];
-				std::fill(m_bw_msgs[mi].begin(), m_bw_msgs[mi].end(),
-					m_bw_msgs[parent_msg][m_states[var_id]]);
+				int32_t parent_msg = m_msg_map_var[var_id];
+				std::fill(msg, msg + msg_size,
+					m_bw_msgs[m_msg_offsets[parent_msg] + m_states[var_id]]);
 			}
 
 			// siblings: sum_{child!=f} r_fw_child2v
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin();
-				cit != msgset_var.end(); cit++)
+			for (int32_t in_msg : m_msgset_map_var[var_id])
 			{
-				if (m_msg_order[*cit]->child == fac_id)
+				if (m_msg_order[in_msg]->child == fac_id)
 					continue;
 
-				for (uint32_t xi = 0; xi < m_bw_msgs[mi].size(); xi++)
-					m_bw_msgs[mi][xi] += m_fw_msgs[*cit][m_states[var_id]];
+				for (int32_t xi = 0; xi < msg_size; xi++)
+					msg[xi] += m_fw_msgs[m_msg_offsets[in_msg] + m_states[var_id]];
 			}
 
 			// m_states from maximizing marginal distributions of fac_id
 			// mu(f) = -E(v_state) + sum_v q_v2f
-			std::vector<float64_t> marg(fenrgs.size(), 0);
-			for (uint32_t ei = 0; ei < marg.size(); ei++)
+			int32_t ei_max = 0;
+			float64_t marg_max = -std::numeric_limits<float64_t>::infinity();
+			for (int32_t ei = 0; ei < num_enrgs; ei++)
 			{
-				int32_t nei = ftype->index_from_new_state(ei, var_id_index, m_states[var_id]);
-				marg[ei] = -fenrgs[nei];
+				// index of ei with the state of var_id replaced by the inferred one
+				int32_t nei = ei + var_id_stride *
+					(m_states[var_id] - m_table.state_from_index(fac_id, ei, var_id_index));
+				float64_t marg = -fenrgs[nei];
 
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
+				for (int32_t vi = 0; vi < num_fvars; vi++)
 				{
 					if (vi == var_id_index)
 					{
-						int32_t var_id_state = ftype->state_from_index(ei, var_id_index);
-						if (m_states[var_id] != minf)
-							var_id_state = m_states[var_id];
-
-						marg[ei] += m_bw_msgs[mi][var_id_state];
+						marg += msg[m_states[var_id]];
 					}
 					else
 					{
-						uint32_t adj_id = fvars[vi];
-						uint32_t adj_msg = m_msg_map_var[adj_id];
-						int32_t adj_id_state = ftype->state_from_index(ei, vi);
+						int32_t adj_msg = m_msg_map_var[fvars[vi]];
+						int32_t adj_id_state = m_table.state_from_index(fac_id, ei, vi);
 
-						marg[ei] += m_fw_msgs[adj_msg][adj_id_state];
+						marg += m_fw_msgs[m_msg_offsets[adj_msg] + adj_id_state];
 					}
 				}
-			}
 
-			int32_t ei_max = static_cast<int32_t>(
-				std::max_element(marg.begin(), marg.end())
-				- marg.begin());
+				if (marg > marg_max || ei == 0)
+				{
+					marg_max = marg;
+					ei_max = ei;
+				}
+			}
 
 			// infer states of neiboring vars of f
-			for (int32_t vi = 0; vi < fvars.size(); vi++)
+			for (int32_t vi = 0; vi < num_fvars; vi++)
 			{
 				int32_t nvar_id = fvars[vi];
 				// usually parent node has been inferred
 				if (m_states[nvar_id] != minf)
 					continue;
 
-				int32_t nvar_id_state = ftype->state_from_index(ei_max, vi);
-				m_states[nvar_id] = nvar_id_state;
+				m_states[nvar_id] = m_table.state_from_index(fac_id, ei_max, vi);
 			}
-
-
 		}
 		else // var <- factor
 		{
 			int32_t var_id = m_msg_order[mi]->child;
 			int32_t fac_id = m_msg_order[mi]->parent;
+			int32_t var_id_index = m_msg_var_index[mi];
 
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
-
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
-
+			const float64_t* fenrgs = m_table.energies.data() + m_table.energy_offsets[fac_id];
+			int32_t num_enrgs = m_table.energy_offsets[fac_id+1] - m_table.energy_offsets[fac_id];
+			const int32_t* fvars = m_table.variables.data() + m_table.variable_offsets[fac_id];
+			int32_t num_fvars = m_table.variable_offsets[fac_id+1] - m_table.variable_offsets[fac_id];
 
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
-
-			uint32_t msg_parent = m_msg_map_fac[fac_id];
+			int32_t msg_parent = m_msg_map_fac[fac_id];
 			int32_t var_parent = m_msg_order[msg_parent]->parent;
 
-			std::vector<float64_t> r_f2v(fenrgs.size());
-			std::vector<float64_t> r_f2v_max(cards[var_id],
-				-std::numeric_limits<float64_t>::infinity());
+			std::fill(msg, msg + cards[var_id], -std::numeric_limits<float64_t>::infinity());
 
 			// r_f2v = max(-fenrg + sum_{j!=var_id} q_v2f[adj_var_state])
-			for (int32_t ei = 0; ei < fenrgs.size(); ei++)
+			for (int32_t ei = 0; ei < num_enrgs; ei++)
 			{
-				r_f2v[ei] = -fenrgs[ei];
+				float64_t r_f2v = -fenrgs[ei];
 
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
+				for (int32_t vi = 0; vi < num_fvars; vi++)
 				{
 					if (vi == var_id_index)
 						continue;
@@ -519,34 +496,28 @@ void TreeMaxProduct::top_down_pass()
 					if (fvars[vi] == var_parent)
 					{
 						ASSERT(m_states[var_parent] != minf);
-						r_f2v[ei] += m_bw_msgs[msg_parent][m_states[var_parent]];
+						r_f2v += m_bw_msgs[m_msg_offsets[msg_parent] + m_states[var_parent]];
 					}
 					else
 					{
 						int32_t adj_id = fvars[vi];
-						uint32_t adj_msg = m_msg_map_var[adj_id];
-						int32_t adj_var_state = ftype->state_from_index(ei, vi);
+						int32_t adj_msg = m_msg_map_var[adj_id];
+						int32_t adj_var_state = m_table.state_from_index(fac_id, ei, vi);
 
 						if (m_states[adj_id] != minf)
 							adj_var_state = m_states[adj_id];
 
-						r_f2v[ei] += m_fw_msgs[adj_msg][adj_var_state];
+						r_f2v += m_fw_msgs[m_msg_offsets[adj_msg] + adj_var_state];
 					}
 				}
 
 				// max marginalization
-				int32_t var_id_state = ftype->state_from_index(ei, var_id_index);
-				if (r_f2v[ei] > r_f2v_max[var_id_state])
-					r_f2v_max[var_id_state] = r_f2v[ei];
+				int32_t var_id_state = m_table.state_from_index(fac_id, ei, var_id_index);
+				if (r_f2v > msg[var_id_state])
+					msg[var_id_state] = r_f2v;
 			}
-
-			for (int32_t si = 0; si < cards[var_id]; si++)
-				m_bw_msgs[mi][si] = r_f2v_max[si];
-
-
 		}
 	} // end for msg edge
 
 	SG_DEBUG("***leave top_down_pass().");
 }
-
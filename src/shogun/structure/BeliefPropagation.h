@@ -14,7 +14,6 @@
 #include <shogun/structure/MAPInference.h>
 
 #include <vector>
-#include <set>
 
 #include <unordered_map>
 
@@ -97,8 +96,6 @@ protected:
  */
 IGNORE_IN_CLASSLIST class TreeMaxProduct : public BeliefPropagation
 {
-	typedef std::unordered_map<uint32_t, uint32_t> msg_map_type;
-	typedef std::unordered_map<uint32_t, std::set<uint32_t> > msgset_map_type;
 	typedef std::unordered_multimap<int32_t, int32_t> var_factor_map_type;
 
 public:
@@ -123,13 +120,22 @@ private:
 private:
 	std::vector<MessageEdge*> m_msg_order;
 	std::vector<bool> m_is_root;
-	std::vector< std::vector<float64_t> > m_fw_msgs;
-	std::vector< std::vector<float64_t> > m_bw_msgs;
+	// all msgs are stored back to back, msg mi starts at m_msg_offsets[mi]
+	std::vector<int32_t> m_msg_offsets;
+	// index of the var node of each msg edge in its factor
+	std::vector<int32_t> m_msg_var_index;
+	std::vector<float64_t> m_fw_msgs;
+	std::vector<float64_t> m_bw_msgs;
 	std::vector<int32_t> m_states;
-
-	msg_map_type m_msg_map_var;
-	msg_map_type m_msg_map_fac;
-	msgset_map_type m_msgset_map_var;
+	// flat energy tables, rebuilt at each inference
+	FactorTable m_table;
+
+	// var_id -> var_to_factor msg towards root
+	std::vector<int32_t> m_msg_map_var;
+	// fac_id -> factor_to_var msg towards root
+	std::vector<int32_t> m_msg_map_fac;
+	// var_id -> incoming factor_to_var msgs, in msg order
+	std::vector< std::vector<int32_t> > m_msgset_map_var;
 };
 
 }
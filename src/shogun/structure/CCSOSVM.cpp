@@ -10,6 +10,7 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/lib/Time.h>
 
 using namespace shogun;
 
@@ -192,6 +193,8 @@ bool CCSOSVM::train_machine(std::shared_ptr<Features> data)
 	if (data)
 		set_features(data);
 
+	m_oracle_times.clear();
+
 	SGVector<float64_t> alpha;
 	float64_t** G; /* Gram matrix */
 	std::vector<SGSparseVector<float64_t> > dXc; /* constraint matrix */
@@ -528,37 +531,14 @@ SGSparseVector<float64_t> CCSOSVM::find_cutting_plane(float64_t* margin)
 
 	index_t num_samples = m_model->get_features()->get_num_vectors();
 	/* find cutting plane */
-	*margin = 0;
 	new_constraint.zero();
-	for (index_t i = 0; i < num_samples; i++)
-	{
-		auto result = m_model->argmax(m_w, i);
-		if (result->psi_computed)
-		{
-			linalg::add(new_constraint, result->psi_truth, new_constraint);
-			result->psi_pred.scale(-1.0);
-			linalg::add(new_constraint, result->psi_pred, new_constraint);
-		}
-		else if(result->psi_computed_sparse)
-		{
-			result->psi_truth_sparse.add_to_dense(1.0, new_constraint.vector,
-					new_constraint.vlen);
-			result->psi_pred_sparse.add_to_dense(-1.0, new_constraint.vector,
-					new_constraint.vlen);
-		}
-		else
-		{
-			error("model({}) should have either of psi_computed or psi_computed_sparse"
-					"to be set true", m_model->get_name());
-		}
-		/*
-		printf("%.16lf %.16lf\n",
-				Math::dot(result->psi_truth.vector, result->psi_truth.vector, result->psi_truth.vlen),
-				Math::dot(result->psi_pred.vector, result->psi_pred.vector, result->psi_pred.vlen));
-		*/
-		*margin += result->delta;
+	SGVector<index_t> samples(num_samples);
+	samples.range_fill();
+	Time oracle_timer;
+	*margin = m_model->argmax_batch(m_w, samples, new_constraint);
+	m_oracle_times.push_back(oracle_timer.cur_time_diff());
+	SG_DEBUG("oracle time: {}s", m_oracle_times.back());
 
-	}
 	/* scaling */
 	float64_t scale = 1/(float64_t)num_samples;
 	new_constraint.scale(scale);
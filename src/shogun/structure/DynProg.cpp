@@ -1018,6 +1018,10 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 				for (int32_t j=0; j<m_seq_len; j++)
 					seq.element(i,j) = 0 ;
 
+			// the entries are independent, plif lookups only read the plifs
+			// and svm_value; the sparse features are not safe to query
+			// concurrently though
+			#pragma omp parallel for collapse(2) schedule(static) if (seq_input!=NULL)
 			for (int32_t i=0; i<m_N; i++)
 				for (int32_t j=0; j<m_seq_len; j++)
 					for (int32_t k=0; k<max_num_signals; k++)
@@ -256,6 +256,15 @@ public:
 
 
 	/** run the viterbi algorithm to compute the n best viterbi paths
+	 *
+	 * The score and traceback tables are kept for every position, so the
+	 * memory grows as O(num positions * num states * nbest). The traceback
+	 * is not checkpointed and there is no parallel driver for several
+	 * contigs, so sequences that are too long have to be split into
+	 * contigs by the caller.
+	 * Distinct DynProg objects can process independent contigs
+	 * concurrently, as long as they do not share the PlifMatrix that
+	 * precompute_tiling_plifs() writes to.
 	 *
 	 * @param max_num_signals maximal number of signals for a single state
 	 * @param use_orf whether orf shall be used
@@ -8,6 +8,7 @@
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/structure/FWSOSVM.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/Time.h>
 
 using namespace shogun;
 
@@ -93,54 +94,27 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 		m_helper = std::make_shared<SOSVMHelper>();
 	}
 
+	SGVector<index_t> all_idx(N);
+	all_idx.range_fill();
+	m_oracle_times.clear();
+
 	// Main loop
 	int32_t k = 0;
 	SGVector<float64_t> w_s(M);
 	float64_t ell_s = 0;
 	for (int32_t pi = 0; pi < m_num_iter; ++pi)
 	{
-		// init w_s and ell_s
+		// init w_s
 		k = pi;
 		w_s.zero();
-		ell_s = 0;
 
-		for (int32_t si = 0; si < N; ++si)
-		{
-			// 1) solve the loss-augmented inference for point si
-			auto result = m_model->argmax(m_w, si);
-
-			// 2) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
-			SGVector<float64_t> psi_i(M);
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				error("model({}) should have either of psi_computed or psi_computed_sparse"
-						"to be set true", m_model->get_name());
-			}
-
-			// 3) loss_i = L(y_i, y_pred)
-			float64_t loss_i = result->delta;
-			ASSERT(loss_i - linalg::dot(m_w, psi_i) >= -1e-12);
-
-			// 4) update w_s and ell_s
-			linalg::add(w_s, psi_i, w_s);
-			ell_s += loss_i;
-
-
-
-		} // end si
+		// 1-4) solve the loss-augmented inference for all points and
+		// accumulate the subgradients psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
+		// and losses L(y_i, y_pred) into w_s and ell_s
+		Time oracle_timer;
+		ell_s = m_model->argmax_batch(m_w, all_idx, w_s);
+		m_oracle_times.push_back(oracle_timer.cur_time_diff());
+		SG_DEBUG("oracle time: {}s", m_oracle_times.back());
 
 		w_s.scale(1.0 / (N*m_lambda));
 		ell_s /= N;
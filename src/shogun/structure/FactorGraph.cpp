@@ -8,6 +8,8 @@
 #include <shogun/structure/FactorGraph.h>
 #include <shogun/labels/FactorGraphLabels.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 FactorGraph::FactorGraph()
@@ -177,6 +179,47 @@ SGVector<float64_t> FactorGraph::evaluate_energies() const
 	return etable;
 }
 
+void FactorGraph::build_factor_table(FactorTable& table) const
+{
+	int32_t num_factors = m_factors.size();
+	table.energy_offsets.resize(num_factors + 1);
+	table.variable_offsets.resize(num_factors + 1);
+	table.energy_offsets[0] = 0;
+	table.variable_offsets[0] = 0;
+
+	for (int32_t fi = 0; fi < num_factors; ++fi)
+	{
+		table.energy_offsets[fi+1] = table.energy_offsets[fi] +
+			m_factors[fi]->get_energies().size();
+		table.variable_offsets[fi+1] = table.variable_offsets[fi] +
+			m_factors[fi]->get_num_vars();
+	}
+
+	table.energies.resize(table.energy_offsets[num_factors]);
+	table.variables.resize(table.variable_offsets[num_factors]);
+	table.cardinalities.resize(table.variable_offsets[num_factors]);
+	table.strides.resize(table.variable_offsets[num_factors]);
+
+	for (int32_t fi = 0; fi < num_factors; ++fi)
+	{
+		SGVector<float64_t> fenrgs = m_factors[fi]->get_energies();
+		SGVector<int32_t> fvars = m_factors[fi]->get_variables();
+		SGVector<int32_t> fcards = m_factors[fi]->get_cardinalities();
+		std::copy(fenrgs.begin(), fenrgs.end(),
+			table.energies.begin() + table.energy_offsets[fi]);
+
+		int32_t stride = 1;
+		for (int32_t vi = 0; vi < fvars.size(); ++vi)
+		{
+			int32_t k = table.variable_offsets[fi] + vi;
+			table.variables[k] = fvars[vi];
+			table.cardinalities[k] = fcards[vi];
+			table.strides[k] = stride;
+			stride *= table.cardinalities[k];
+		}
+	}
+}
+
 void FactorGraph::connect_components()
 {
 	if (m_dset->get_connected())
@@ -14,9 +14,75 @@
 #include <shogun/labels/FactorGraphLabels.h>
 #include <shogun/structure/DisjointSet.h>
 
+#include <vector>
+
 namespace shogun
 {
 
+/** @brief Flat, contiguous layout of the factors of a FactorGraph.
+ * The energy tables and variable indices of all factors are stored
+ * back to back, so that inference algorithms can stream through them
+ * without touching the individual Factor objects.
+ */
+struct FactorTable
+{
+	/** energy tables of all factors, concatenated */
+	std::vector<float64_t> energies;
+
+	/** offsets of the energy tables in energies (num_factors+1 entries) */
+	std::vector<int32_t> energy_offsets;
+
+	/** variables of all factors, concatenated */
+	std::vector<int32_t> variables;
+
+	/** cardinality of each entry of variables */
+	std::vector<int32_t> cardinalities;
+
+	/** cumulative product of the cardinalities within each factor,
+	 * i.e. the stride of each entry of variables in the energy table
+	 */
+	std::vector<int32_t> strides;
+
+	/** offsets of the variables in variables (num_factors+1 entries) */
+	std::vector<int32_t> variable_offsets;
+
+	/** @return number of factors */
+	int32_t get_num_factors() const
+	{
+		return energy_offsets.empty() ? 0 : energy_offsets.size() - 1;
+	}
+
+	/** state of the vi-th variable of a factor in energy table entry ei
+	 *
+	 * @param fi factor index
+	 * @param ei index in the energy table of the factor
+	 * @param vi index of the variable in the factor
+	 */
+	int32_t state_from_index(int32_t fi, int32_t ei, int32_t vi) const
+	{
+		int32_t k = variable_offsets[fi] + vi;
+		return (ei / strides[k]) % cardinalities[k];
+	}
+
+	/** evaluate energy given full assignment
+	 *
+	 * @param state an assignment
+	 */
+	float64_t evaluate_energy(const SGVector<int32_t> state) const
+	{
+		float64_t energy = 0.0;
+		for (int32_t fi = 0; fi < get_num_factors(); ++fi)
+		{
+			int32_t ei = 0;
+			for (int32_t k = variable_offsets[fi]; k < variable_offsets[fi+1]; ++k)
+				ei += state[variables[k]] * strides[k];
+
+			energy += energies[energy_offsets[fi] + ei];
+		}
+		return energy;
+	}
+};
+
 /** @brief Class FactorGraph a factor graph is a structured input in general
  */
 class FactorGraph : public SGObject
@@ -92,6 +158,15 @@ public:
 	/** @return energy table for the graph */
 	SGVector<float64_t> evaluate_energies() const;
 
+	/** fill a flat, contiguous copy of the current factor energies and
+	 * variables. The storage of table is reused if it is large enough,
+	 * so it can be kept as a workspace across several calls.
+	 * NOTE call this after compute_energies() and loss_augmentation()
+	 *
+	 * @param table output table
+	 */
+	void build_factor_table(FactorTable& table) const;
+
 	/** @return disjoint set */
 	std::shared_ptr<DisjointSet> get_disjoint_set() const;
 
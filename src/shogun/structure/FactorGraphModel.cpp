@@ -289,7 +289,9 @@ std::shared_ptr<ResultSet> FactorGraphModel::argmax(SGVector<float64_t> w, int32
 	if (m_verbose)
 		io::print("\n------ example {}\n", feat_idx);
 
-	// update factor parameters
+	// update factor parameters, concurrent calls share the same w so
+	// only the first one writes them
+	#pragma omp critical (FactorGraphModel_w_to_fparams)
 	w_to_fparams(w);
 	fg->compute_energies();
 
@@ -116,6 +116,14 @@ public:
 	 */
 	virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true);
 
+	/** argmax may be called concurrently for distinct examples with the
+	 * same w: the factor parameters are only updated (under a lock) when
+	 * w changes, and every example has its own factor graph.
+	 *
+	 * @return true
+	 */
+	virtual bool is_argmax_thread_safe() const { return true; }
+
 	/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 	 *
 	 * @param y1 an instance of structured data
@@ -68,7 +68,7 @@ void GraphCut::init()
 	if (m_fg == NULL)
 		return;
 
-	auto facs = m_fg->get_factors();
+	m_fg->build_factor_table(m_table);
 
 	SGVector<int32_t> cards = m_fg->get_cardinalities();
 
@@ -83,11 +83,9 @@ void GraphCut::init()
 	m_num_factors_at_order = SGVector<int32_t> (4);
 	m_num_factors_at_order.zero();
 
-	for (auto& fac : facs)
+	for (int32_t j = 0; j < m_table.get_num_factors(); j++)
 	{
-		int32_t num_vars = fac->get_num_vars();
-
-
+		int32_t num_vars = m_table.variable_offsets[j+1] - m_table.variable_offsets[j];
 
 		if (num_vars > 3)
 		{
@@ -105,13 +103,8 @@ void GraphCut::init()
 	// build s-t graph
 	build_st_graph(m_num_nodes, max_num_edges);
 
-	for (int32_t j = 0; j < m_fg->get_num_factors(); j++)
-	{
-		auto fac = facs[j];
-		add_factor(fac);
-
-	}
-
+	for (int32_t j = 0; j < m_table.get_num_factors(); j++)
+		add_factor(m_table, j);
 
 }
 
@@ -201,33 +194,31 @@ float64_t GraphCut::inference(SGVector<int32_t> assignment)
 		assignment[vi] = get_assignment(vi) == SOURCE ? 0 : 1;
 	}
 
-	m_map_energy = m_fg->evaluate_energy(assignment);
+	m_map_energy = m_table.evaluate_energy(assignment);
 	SG_DEBUG("fg.evaluate_energy(assignment) = {}", m_fg->evaluate_energy(assignment));
 	SG_DEBUG("minimized energy = {}", m_map_energy);
 
 	return m_map_energy;
 }
 
-void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
+void GraphCut::add_factor(const FactorTable& table, int32_t fi)
 {
-	SGVector<int32_t> fcards = factor->get_cardinalities();
+	const int32_t* fvars = table.variables.data() + table.variable_offsets[fi];
+	const float64_t* fenrgs = table.energies.data() + table.energy_offsets[fi];
+	int32_t f_order = table.variable_offsets[fi+1] - table.variable_offsets[fi];
 
-	for (int32_t i = 0; i < fcards.size(); i++)
+	for (int32_t i = 0; i < f_order; i++)
 	{
-		ASSERT(fcards[i] == 2);
+		ASSERT(table.cardinalities[table.variable_offsets[fi] + i] == 2);
 	}
 
-	int32_t f_order = factor->get_num_vars();
-
 	switch (f_order)
 	{
 	case 0:
 		break;
 	case 1:
 	{
-		SGVector<int32_t> fvars = factor->get_variables();
-		SGVector<float64_t> fenrgs = factor->get_energies();
-		ASSERT(fenrgs.size() == 2);
+		ASSERT(table.energy_offsets[fi+1] - table.energy_offsets[fi] == 2);
 		int32_t var = fvars[0];
 		float64_t v0 = fenrgs[0];
 		float64_t v1 = fenrgs[1];
@@ -244,8 +235,6 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 	break;
 	case 2:
 	{
-		SGVector<int32_t> fvars = factor->get_variables();
-		SGVector<float64_t> fenrgs = factor->get_energies();
 		int32_t var0 = fvars[0];
 		int32_t var1 = fvars[1];
 		float64_t A = fenrgs[0]; //E{0,0} = {y_var0, y_var1}
@@ -299,8 +288,6 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 	break;
 	case 3:
 	{
-		SGVector<int32_t> fvars = factor->get_variables();
-		SGVector<float64_t> fenrgs = factor->get_energies();
 		int32_t var0 = fvars[0];
 		int32_t var1 = fvars[1];
 		int32_t var2 = fvars[2];
@@ -313,7 +300,11 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 		float64_t D = fenrgs[6]; //{0,1,1}
 		float64_t H = fenrgs[7]; //{1,1,1}
 
-		int32_t id = get_tripleId(fvars);
+		SGVector<int32_t> triple(3);
+		triple[0] = var0;
+		triple[1] = var1;
+		triple[2] = var2;
+		int32_t id = get_tripleId(triple);
 		float64_t P = (A + D + F + G) - (B + C + E + H);
 
 		if (P >= 0.0)
@@ -228,9 +228,10 @@ private:
 	 * V. Kolmogorov, and R. Zabin. "What energy functions can be minimized via graph cuts?."
 	 * T-PAMI. 2004.
 	 *
-	 * @param factor the factor to add
+	 * @param table flat factor table of the factor graph
+	 * @param fi index of the factor to add
 	 */
-	void add_factor(const std::shared_ptr<Factor>& factor);
+	void add_factor(const FactorTable& table, int32_t fi);
 
 	/** Get the triple node id in s-t graph (for factor order = 3)
 	 *
@@ -307,6 +308,8 @@ private:
 	SGVector<int32_t> m_num_factors_at_order;
 	/** list of triple nodes, for order-3 factors */
 	std::vector< SGVector<int32_t> > m_triple_list;
+	/** flat energy tables of the factor graph */
+	FactorTable m_table;
 
 	/** nodes in the st graph */
 	GCNode*		m_nodes;
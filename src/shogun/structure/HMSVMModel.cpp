@@ -77,16 +77,20 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 
 	// Translate from labels sequence to state sequence
 	SGVector< int32_t > state_seq = m_state_model->labels_to_states(label_seq);
-	m_transmission_weights.zero();
+	// local buffers keep this method free of writes to the model
+	SGMatrix< float64_t > transmission_weights(
+			m_transmission_weights.num_rows, m_transmission_weights.num_cols);
+	transmission_weights.zero();
 
 	for ( int32_t i = 0 ; i < state_seq.vlen-1 ; ++i )
-		m_transmission_weights(state_seq[i],state_seq[i+1]) += 1;
+		transmission_weights(state_seq[i],state_seq[i+1]) += 1;
 
 	SGMatrix< float64_t > obs = mf->get_feature_vector(feat_idx);
 	require(obs.num_rows == D && obs.num_cols == state_seq.vlen,
 		"obs.num_rows ({}) != D ({}) OR obs.num_cols ({}) != state_seq.vlen ({})",
 		obs.num_rows, D, obs.num_cols, state_seq.vlen);
-	m_emission_weights.zero();
+	SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+	emission_weights.zero();
 	index_t aux_idx, weight_idx;
 
 	if ( !m_use_plifs )	// Do not use PLiFs
@@ -98,11 +102,11 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			for ( int32_t j = 0 ; j < state_seq.vlen ; ++j )
 			{
 				weight_idx = aux_idx + state_seq[j]*D*m_num_obs + obs(f,j);
-				m_emission_weights[weight_idx] += 1;
+				emission_weights[weight_idx] += 1;
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_obs);
 	}
 	else	// Use PLiFs
@@ -133,15 +137,15 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 				weight_idx = aux_idx + state_seq[j]*D*m_num_plif_nodes;
 
 				if ( count == 0 )
-					m_emission_weights[weight_idx] += 1;
+					emission_weights[weight_idx] += 1;
 				else if ( count == m_num_plif_nodes )
-					m_emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
+					emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
 				else
 				{
-					m_emission_weights[weight_idx + count] +=
+					emission_weights[weight_idx + count] +=
 						(value-limits[count-1]) / (limits[count]-limits[count-1]);
 
-					m_emission_weights[weight_idx + count-1] +=
+					emission_weights[weight_idx + count-1] +=
 						(limits[count]-value) / (limits[count]-limits[count-1]);
 				}
 
@@ -149,17 +153,18 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_plif_nodes);
 	}
 
 	return psi;
 }
 
-std::shared_ptr<ResultSet> HMSVMModel::argmax(
+SGVector< int32_t > HMSVMModel::viterbi(
 		SGVector< float64_t > w,
 		int32_t feat_idx,
-		bool const training)
+		bool const training,
+		float64_t& score)
 {
 	ASSERT(w.vlen == get_dim())
 
@@ -192,7 +197,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	if ( !m_use_plifs )	// Do not use PLiFs
 	{
 		index_t em_idx;
-		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+		SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+		m_state_model->reshape_emission_params(emission_weights, w, D, m_num_obs);
 
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
@@ -202,7 +208,7 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 				em_idx = j*m_num_obs + (index_t)Math::round(x(j,i));
 
 				for ( int32_t s = 0 ; s < S ; ++s )
-					E(s,i) += m_emission_weights[s*D*m_num_obs + em_idx];
+					E(s,i) += emission_weights[s*D*m_num_obs + em_idx];
 			}
 		}
 	}
@@ -248,7 +254,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	// Initialize the dynamic programming table and the traceback matrix
 	SGMatrix< float64_t >  dp(T, S);
 	SGMatrix< float64_t > trb(T, S);
-	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+	SGMatrix< float64_t > transmission_weights(S, S);
+	m_state_model->reshape_transmission_params(transmission_weights, w);
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
@@ -281,8 +288,8 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 
 			for ( int32_t prev = 0 ; prev < S ; ++prev )
 			{
-				// aij = m_transmission_weights(prev, cur)
-				a = m_transmission_weights[cur*S + prev];
+				// aij = transmission_weights(prev, cur)
+				a = transmission_weights[cur*S + prev];
 
 				if ( a > -Math::INFTY )
 				{
@@ -301,19 +308,16 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 
 	// Trace back the most likely sequence of states
 	SGVector< int32_t > opt_path(T);
-	auto ret = std::make_shared<ResultSet>();
-
-	ret->psi_computed = true;
-	ret->score = -Math::INFTY;
+	score = -Math::INFTY;
 	opt_path[T-1] = -1;
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
 		idx = s*T + T-1;
 
-		if ( q[s] > -Math::INFTY && dp[idx] > ret->score )
+		if ( q[s] > -Math::INFTY && dp[idx] > score )
 		{
-			ret->score = dp[idx];
+			score = dp[idx];
 			opt_path[T-1] = s;
 		}
 	}
@@ -325,6 +329,19 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	for ( int32_t i = T-1 ; i > 0 ; --i )
 		opt_path[i-1] = trb[opt_path[i]*T + i];
 
+	return opt_path;
+}
+
+std::shared_ptr<ResultSet> HMSVMModel::argmax(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	auto ret = std::make_shared<ResultSet>();
+	ret->psi_computed = true;
+
+	SGVector< int32_t > opt_path = viterbi(w, feat_idx, training, ret->score);
+
 	// Populate the ResultSet object to return
 	auto ypred = m_state_model->states_to_labels(opt_path);
 
@@ -340,6 +357,21 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	return ret;
 }
 
+float64_t HMSVMModel::add_argmax_subgradient(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		SGVector< float64_t > subgrad)
+{
+	float64_t score;
+	SGVector< int32_t > opt_path = viterbi(w, feat_idx, true, score);
+	auto ypred = m_state_model->states_to_labels(opt_path);
+
+	add_truth_joint_feature_vector(feat_idx, 1.0, subgrad);
+	add_joint_feature_vector(feat_idx, ypred, -1.0, subgrad);
+
+	return StructuredModel::delta_loss(feat_idx, ypred);
+}
+
 float64_t HMSVMModel::delta_loss(std::shared_ptr<StructuredData> y1, std::shared_ptr<StructuredData> y2)
 {
 	auto seq1 = y1->as<Sequence>();
@@ -604,6 +636,10 @@ void HMSVMModel::init_training()
 			}
 		}
 	}
+
+	// The joint feature vectors of the true sequences do not change
+	// during training
+	init_truth_cache();
 }
 
 SGMatrix< float64_t > HMSVMModel::get_transmission_weights() const
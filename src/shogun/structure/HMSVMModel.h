@@ -78,6 +78,26 @@ class HMSVMModel : public StructuredModel
 		 */
 		virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true);
 
+		/** argmax does not modify the model unless PLiFs are used, whose
+		 * penalties are updated from w on every call
+		 *
+		 * @return whether PLiFs are not used
+		 */
+		virtual bool is_argmax_thread_safe() const { return !m_use_plifs; }
+
+		/** solves the loss-augmented inference for one example and adds
+		 * its subgradient to subgrad, using the cached joint feature
+		 * vector of the true sequence
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the example
+		 * @param subgrad dense vector of size get_dim()
+		 *
+		 * @return loss of the predicted sequence
+		 */
+		virtual float64_t add_argmax_subgradient(SGVector< float64_t > w,
+				int32_t feat_idx, SGVector< float64_t > subgrad);
+
 		/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 		 *
 		 * @param y1 an instance of structured data
@@ -172,6 +192,17 @@ class HMSVMModel : public StructuredModel
 		/* internal initialization */
 		void init();
 
+		/** loss-augmented (if training) Viterbi decoding
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the sequence to decode
+		 * @param training whether to add the loss to the emission scores
+		 * @param score the score of the best path is returned here
+		 * @return the most likely sequence of states
+		 */
+		SGVector< int32_t > viterbi(SGVector< float64_t > w, int32_t feat_idx,
+				bool const training, float64_t& score);
+
 	private:
 		/** in case of discrete observations, the cardinality of the space of observations */
 		int32_t m_num_obs;
@@ -92,6 +92,21 @@ SGVector<float64_t> HashedMultilabelModel::get_joint_feature_vector(
 	return SGVector<float64_t>();
 }
 
+void HashedMultilabelModel::add_joint_feature_vector(int32_t feat_idx,
+                std::shared_ptr<StructuredData > y, float64_t alpha,
+                SGVector<float64_t> psi)
+{
+	get_sparse_joint_feature_vector(feat_idx, y).add_to_dense(alpha,
+	                psi.vector, psi.vlen);
+}
+
+float64_t HashedMultilabelModel::dot_joint_feature_vector(
+                SGVector<float64_t> w, int32_t feat_idx,
+                std::shared_ptr<StructuredData > y)
+{
+	return get_sparse_joint_feature_vector(feat_idx, y).dense_dot(w);
+}
+
 SGSparseVector<float64_t> HashedMultilabelModel::get_sparse_joint_feature_vector(
         int32_t feat_idx, std::shared_ptr<StructuredData > y)
 {
@@ -79,6 +79,30 @@ public:
 	virtual SGSparseVector<float64_t> get_sparse_joint_feature_vector(int32_t feat_idx,
 	                std::shared_ptr<StructuredData > y);
 
+	/** adds \f$ \alpha \Psi(x, y) \f$ to psi using the sparse joint
+	 * feature vector
+	 *
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured label to use
+	 * @param alpha scalar the joint feature vector is multiplied with
+	 * @param psi dense vector of size get_dim()
+	 */
+	virtual void add_joint_feature_vector(int32_t feat_idx,
+	                std::shared_ptr<StructuredData > y, float64_t alpha,
+	                SGVector<float64_t> psi);
+
+	/** computes \f$ \langle w, \Psi(x, y) \rangle \f$ using the sparse
+	 * joint feature vector
+	 *
+	 * @param w weight vector
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured label to use
+	 *
+	 * @return the dot product
+	 */
+	virtual float64_t dot_joint_feature_vector(SGVector<float64_t> w,
+	                int32_t feat_idx, std::shared_ptr<StructuredData > y);
+
 	/** obtain the argmax of
 	 *
 	 * \f[
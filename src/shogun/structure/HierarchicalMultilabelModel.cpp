@@ -163,6 +163,49 @@ SGVector<float64_t> HierarchicalMultilabelModel::get_joint_feature_vector(
 	return psi;
 }
 
+void HierarchicalMultilabelModel::add_joint_feature_vector(int32_t feat_idx,
+                std::shared_ptr<StructuredData > y, float64_t alpha,
+                SGVector<float64_t> psi)
+{
+	auto slabel = y->as<SparseMultilabel>();
+	SGVector<int32_t> label_vector = get_label_vector(slabel->get_data());
+
+	auto dot_feats = m_features->as<DotFeatures>();
+	int32_t feats_dim = dot_feats->get_dim_feature_space();
+
+	for (index_t i = 0; i < label_vector.vlen; i++)
+	{
+		if (label_vector[i])
+		{
+			dot_feats->add_to_dense_vec(alpha, feat_idx,
+			                psi.vector + i * feats_dim, feats_dim);
+		}
+	}
+}
+
+float64_t HierarchicalMultilabelModel::dot_joint_feature_vector(
+                SGVector<float64_t> w, int32_t feat_idx,
+                std::shared_ptr<StructuredData > y)
+{
+	auto slabel = y->as<SparseMultilabel>();
+	SGVector<int32_t> label_vector = get_label_vector(slabel->get_data());
+
+	auto dot_feats = m_features->as<DotFeatures>();
+	int32_t feats_dim = dot_feats->get_dim_feature_space();
+
+	float64_t result = 0;
+	for (index_t i = 0; i < label_vector.vlen; i++)
+	{
+		if (label_vector[i])
+		{
+			result += dot_feats->dot(feat_idx,
+			                w.slice(i * feats_dim, i * feats_dim + feats_dim));
+		}
+	}
+
+	return result;
+}
+
 float64_t HierarchicalMultilabelModel::delta_loss(std::shared_ptr<StructuredData > y1,
                 std::shared_ptr<StructuredData > y2)
 {
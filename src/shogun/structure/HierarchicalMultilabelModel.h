@@ -72,6 +72,30 @@ public:
 	virtual SGVector<float64_t> get_joint_feature_vector(int32_t feat_idx,
 	                std::shared_ptr<StructuredData > y);
 
+	/** adds \f$ \alpha \Psi(x, y) \f$ to psi, i.e. alpha times the
+	 * feature vector to the block of each node in y and of its ancestors
+	 *
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured labels to use
+	 * @param alpha scalar the joint feature vector is multiplied with
+	 * @param psi dense vector of size get_dim()
+	 */
+	virtual void add_joint_feature_vector(int32_t feat_idx,
+	                std::shared_ptr<StructuredData > y, float64_t alpha,
+	                SGVector<float64_t> psi);
+
+	/** computes \f$ \langle w, \Psi(x, y) \rangle \f$ from the blocks
+	 * of the nodes in y and of their ancestors
+	 *
+	 * @param w weight vector
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured labels to use
+	 *
+	 * @return the dot product
+	 */
+	virtual float64_t dot_joint_feature_vector(SGVector<float64_t> w,
+	                int32_t feat_idx, std::shared_ptr<StructuredData > y);
+
 	/** obtain the argmax of
 	 *
 	 * \f[
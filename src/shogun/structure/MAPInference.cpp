@@ -104,6 +104,35 @@ float64_t MAPInference::get_energy() const
 	return m_energy;
 }
 
+std::shared_ptr<FactorGraphLabels> MAPInference::batch_inference(
+	const std::vector<std::shared_ptr<FactorGraph>>& fgs,
+	EMAPInferType inference_method, SGVector<float64_t> energies)
+{
+	int32_t num_fgs = fgs.size();
+	require(energies.vlen == 0 || energies.vlen == num_fgs,
+		"MAPInference::batch_inference(): energies ({}) should be empty "
+		"or of the same size as the batch ({})!", energies.vlen, num_fgs);
+
+	std::vector<std::shared_ptr<FactorGraphObservation>> outputs(num_fgs);
+
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t i = 0; i < num_fgs; ++i)
+	{
+		MAPInference infer_met(fgs[i], inference_method);
+		infer_met.inference();
+
+		outputs[i] = infer_met.get_structured_outputs();
+		if (energies.vlen > 0)
+			energies[i] = infer_met.get_energy();
+	}
+
+	auto labels = std::make_shared<FactorGraphLabels>(num_fgs);
+	for (auto& output : outputs)
+		labels->add_label(output);
+
+	return labels;
+}
+
 //-----------------------------------------------------------------
 
 MAPInferImpl::MAPInferImpl() : SGObject()
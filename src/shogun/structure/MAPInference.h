@@ -14,6 +14,8 @@
 #include <shogun/structure/FactorGraph.h>
 #include <shogun/labels/FactorGraphLabels.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -70,6 +72,23 @@ public:
 	/** @return minimized energy */
 	float64_t get_energy() const;
 
+	/** perform inference on a batch of factor graphs in parallel.
+	 * Every graph gets its own inference implementation, so message
+	 * buffers and energy tables are never shared between threads.
+	 * NOTE the graphs must be distinct objects, since inference may
+	 * modify their internal state (e.g. connect_components())
+	 *
+	 * @param fgs factor graphs
+	 * @param inference_method name of MAP inference method
+	 * @param energies if of size fgs.size(), filled with the minimized
+	 * energy of each graph
+	 * @return structured outputs, in the order of fgs
+	 */
+	static std::shared_ptr<FactorGraphLabels> batch_inference(
+		const std::vector<std::shared_ptr<FactorGraph>>& fgs,
+		EMAPInferType inference_method,
+		SGVector<float64_t> energies = SGVector<float64_t>());
+
 private:
 	/** register parameters and initialize members */
 	void init();
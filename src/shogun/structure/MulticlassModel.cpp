@@ -62,18 +62,36 @@ SGVector< float64_t > MulticlassModel::get_joint_feature_vector(int32_t feat_idx
 	return psi;
 }
 
-std::shared_ptr<ResultSet> MulticlassModel::argmax(
+void MulticlassModel::init_training()
+{
+	m_num_classes = m_labels->as<MulticlassSOLabels>()->get_num_classes();
+	init_truth_cache();
+}
+
+void MulticlassModel::prepare_argmax_batch(bool training)
+{
+	// prediction uses the number of classes of the trained model
+	if (training)
+		m_num_classes = m_labels->as<MulticlassSOLabels>()->get_num_classes();
+}
+
+int32_t MulticlassModel::predict_class(
 		SGVector< float64_t > w,
 		int32_t feat_idx,
-		bool const training)
+		bool const training,
+		float64_t& max_score)
 {
 	auto df = m_features->as<DotFeatures>();
 	int32_t feats_dim   = df->get_dim_feature_space();
 
 	if ( training )
 	{
+		// only written if neither init_training nor prepare_argmax_batch
+		// was called, so that concurrent calls during training do not
+		// modify the model
 		auto ml = m_labels->as<MulticlassSOLabels>();
-		m_num_classes = ml->get_num_classes();
+		if ( m_num_classes != ml->get_num_classes() )
+			m_num_classes = ml->get_num_classes();
 	}
 	else
 	{
@@ -86,8 +104,9 @@ std::shared_ptr<ResultSet> MulticlassModel::argmax(
 
 	// Find the class that gives the maximum score
 
-	float64_t score = 0, ypred = 0;
-	float64_t max_score = -Math::INFTY;
+	float64_t score = 0;
+	int32_t ypred = 0;
+	max_score = -Math::INFTY;
 
 	for ( int32_t c = 0 ; c < m_num_classes ; ++c )
 	{
@@ -102,6 +121,17 @@ std::shared_ptr<ResultSet> MulticlassModel::argmax(
 		}
 	}
 
+	return ypred;
+}
+
+std::shared_ptr<ResultSet> MulticlassModel::argmax(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	float64_t max_score;
+	int32_t ypred = predict_class(w, feat_idx, training, max_score);
+
 	// Build the ResultSet object to return
 	auto ret = std::make_shared<ResultSet>();
 
@@ -123,6 +153,56 @@ std::shared_ptr<ResultSet> MulticlassModel::argmax(
 	return ret;
 }
 
+float64_t MulticlassModel::add_argmax_subgradient(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		SGVector< float64_t > subgrad)
+{
+	float64_t max_score;
+	int32_t ypred = predict_class(w, feat_idx, true, max_score);
+
+	add_truth_joint_feature_vector(feat_idx, 1.0, subgrad);
+	add_class_feature_vector(feat_idx, ypred, -1.0, subgrad);
+
+	return delta_loss(feat_idx, float64_t(ypred));
+}
+
+void MulticlassModel::add_joint_feature_vector(
+		int32_t feat_idx,
+		std::shared_ptr<StructuredData> y,
+		float64_t alpha,
+		SGVector< float64_t > psi)
+{
+	auto r = y->as<RealNumber>();
+	ASSERT(r != NULL)
+	add_class_feature_vector(feat_idx, r->value, alpha, psi);
+}
+
+float64_t MulticlassModel::dot_joint_feature_vector(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		std::shared_ptr<StructuredData> y)
+{
+	auto df = m_features->as<DotFeatures>();
+	int32_t feats_dim = df->get_dim_feature_space();
+	int32_t c = y->as<RealNumber>()->value;
+
+	return df->dot(feat_idx, w.slice(c*feats_dim, c*feats_dim + feats_dim));
+}
+
+void MulticlassModel::add_class_feature_vector(
+		int32_t feat_idx,
+		int32_t c,
+		float64_t alpha,
+		SGVector< float64_t > psi)
+{
+	auto df = m_features->as<DotFeatures>();
+	int32_t feats_dim = df->get_dim_feature_space();
+	ASSERT(psi.vlen >= (c+1)*feats_dim)
+
+	df->add_to_dense_vec(alpha, feat_idx, psi.vector + c*feats_dim, feats_dim);
+}
+
 float64_t MulticlassModel::delta_loss(std::shared_ptr<StructuredData> y1, std::shared_ptr<StructuredData> y2)
 {
 	auto rn1 = y1->as<RealNumber>();
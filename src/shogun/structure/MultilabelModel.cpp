@@ -150,17 +150,19 @@ SGVector<int32_t> MultilabelModel::to_sparse(SGVector<float64_t> dense_vec,
 	return sparse_vec;
 }
 
-std::shared_ptr<ResultSet > MultilabelModel::argmax(SGVector<float64_t> w, int32_t feat_idx,
-                                      bool const training)
+SGVector<float64_t> MultilabelModel::predict_labels(SGVector<float64_t> w,
+                int32_t feat_idx, bool const training, float64_t& total_score)
 {
 	auto dot_feats = m_features->as<DotFeatures>();
 	int32_t feats_dim = dot_feats->get_dim_feature_space();
 
-	auto multi_labs = m_labels->as<MultilabelSOLabels>();
-
 	if (training)
 	{
-		m_num_classes = multi_labs->get_num_classes();
+		// only written if init_training was not called, so that concurrent
+		// calls during training do not modify the model
+		auto multi_labs = m_labels->as<MultilabelSOLabels>();
+		if (m_num_classes != multi_labs->get_num_classes())
+			m_num_classes = multi_labs->get_num_classes();
 	}
 	else
 	{
@@ -171,7 +173,8 @@ std::shared_ptr<ResultSet > MultilabelModel::argmax(SGVector<float64_t> w, int32
 	int32_t dim = get_dim();
 	ASSERT(dim == w.vlen);
 
-	float64_t score = 0, total_score = 0;
+	float64_t score = 0;
+	total_score = 0;
 	SGVector<float64_t> y_pred_dense(m_num_classes);
 	y_pred_dense.zero();
 
@@ -187,6 +190,16 @@ std::shared_ptr<ResultSet > MultilabelModel::argmax(SGVector<float64_t> w, int32
 
 	}
 
+	return y_pred_dense;
+}
+
+std::shared_ptr<ResultSet > MultilabelModel::argmax(SGVector<float64_t> w, int32_t feat_idx,
+                                      bool const training)
+{
+	float64_t total_score;
+	SGVector<float64_t> y_pred_dense =
+	        predict_labels(w, feat_idx, training, total_score);
+
 	SGVector<int32_t> y_pred_sparse = to_sparse(y_pred_dense, 1, 0);
 
 	auto ret = std::make_shared<ResultSet>();
@@ -211,6 +224,71 @@ std::shared_ptr<ResultSet > MultilabelModel::argmax(SGVector<float64_t> w, int32
 	return ret;
 }
 
+float64_t MultilabelModel::add_argmax_subgradient(SGVector<float64_t> w,
+                int32_t feat_idx, SGVector<float64_t> subgrad)
+{
+	float64_t total_score;
+	SGVector<float64_t> y_pred_dense =
+	        predict_labels(w, feat_idx, true, total_score);
+
+	auto dot_feats = m_features->as<DotFeatures>();
+	int32_t feats_dim = dot_feats->get_dim_feature_space();
+
+	add_truth_joint_feature_vector(feat_idx, 1.0, subgrad);
+	for (int32_t c = 0; c < m_num_classes; c++)
+	{
+		if (y_pred_dense[c] == 1)
+			dot_feats->add_to_dense_vec(-1.0, feat_idx,
+			                subgrad.vector + c * feats_dim, feats_dim);
+	}
+
+	auto y_true = m_labels->get_label(feat_idx)->as<SparseMultilabel>();
+	return delta_loss(
+	               MultilabelSOLabels::to_dense(y_true, m_num_classes, 1, 0),
+	               y_pred_dense);
+}
+
+void MultilabelModel::add_joint_feature_vector(int32_t feat_idx,
+                std::shared_ptr<StructuredData > y, float64_t alpha,
+                SGVector<float64_t> psi)
+{
+	auto dot_feats = m_features->as<DotFeatures>();
+	int32_t feats_dim = dot_feats->get_dim_feature_space();
+	auto slabel = y->as<SparseMultilabel>();
+	ASSERT(slabel != NULL);
+	SGVector<int32_t> slabel_data = slabel->get_data();
+
+	for (index_t i = 0; i < slabel_data.vlen; i++)
+	{
+		dot_feats->add_to_dense_vec(alpha, feat_idx,
+		                psi.vector + slabel_data[i] * feats_dim, feats_dim);
+	}
+}
+
+float64_t MultilabelModel::dot_joint_feature_vector(SGVector<float64_t> w,
+                int32_t feat_idx, std::shared_ptr<StructuredData > y)
+{
+	auto dot_feats = m_features->as<DotFeatures>();
+	int32_t feats_dim = dot_feats->get_dim_feature_space();
+	SGVector<int32_t> slabel_data = y->as<SparseMultilabel>()->get_data();
+
+	float64_t result = 0;
+	for (index_t i = 0; i < slabel_data.vlen; i++)
+	{
+		int32_t c = slabel_data[i];
+		result += dot_feats->dot(feat_idx,
+		                w.slice(c * feats_dim, c * feats_dim + feats_dim));
+	}
+
+	return result;
+}
+
+void MultilabelModel::init_training()
+{
+	m_num_classes = m_labels->as<MultilabelSOLabels>()->get_num_classes();
+	init_truth_cache();
+}
+
 void MultilabelModel::init_primal_opt(
         float64_t regularization,
         SGMatrix<float64_t> &A,
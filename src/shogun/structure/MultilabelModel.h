@@ -72,6 +72,50 @@ public:
 	virtual std::shared_ptr<ResultSet > argmax(SGVector<float64_t> w, int32_t feat_idx,
 	                            bool const training = true);
 
+	/** @return true, argmax only reads the model during training */
+	virtual bool is_argmax_thread_safe() const { return true; }
+
+	/** fetches the number of classes from the labels and caches the joint
+	 * feature vectors of the true labels
+	 */
+	virtual void init_training();
+
+	/** solves the loss-augmented inference for one example and adds its
+	 * subgradient to subgrad without building any joint feature vectors
+	 *
+	 * @param w weight vector
+	 * @param feat_idx index of the example
+	 * @param subgrad dense vector of size get_dim()
+	 *
+	 * @return loss of the prediction
+	 */
+	virtual float64_t add_argmax_subgradient(SGVector<float64_t> w,
+	                int32_t feat_idx, SGVector<float64_t> subgrad);
+
+	/** adds \f$ \alpha \Psi(x, y) \f$ to psi, i.e. alpha times the
+	 * feature vector to the block of each class in y
+	 *
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured label to use
+	 * @param alpha scalar the joint feature vector is multiplied with
+	 * @param psi dense vector of size get_dim()
+	 */
+	virtual void add_joint_feature_vector(int32_t feat_idx,
+	                std::shared_ptr<StructuredData > y, float64_t alpha,
+	                SGVector<float64_t> psi);
+
+	/** computes \f$ \langle w, \Psi(x, y) \rangle \f$ from the blocks
+	 * of the classes in y
+	 *
+	 * @param w weight vector
+	 * @param feat_idx index of the feature vector to use
+	 * @param y structured label to use
+	 *
+	 * @return the dot product
+	 */
+	virtual float64_t dot_joint_feature_vector(SGVector<float64_t> w,
+	                int32_t feat_idx, std::shared_ptr<StructuredData > y);
+
 	/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 	 *
 	 * @param y1 an instance of structured data
@@ -129,6 +173,10 @@ private:
 	float64_t delta_loss(SGVector<float64_t> y1, SGVector<float64_t> y2);
 	float64_t delta_loss(float64_t y1, float64_t y2);
 
+	/** computes the dense {0, 1} indicator of the predicted classes */
+	SGVector<float64_t> predict_labels(SGVector<float64_t> w, int32_t feat_idx,
+	                bool const training, float64_t& total_score);
+
 	/** convert dense vector to sparse
 	 * dense vector would be in the form of {d_true, d_false}^dense_dim
 	 * sparse vector would contain the indices where the value of
@@ -5,6 +5,7 @@
  */
 
 
+#include <algorithm>
 #include <stdio.h>
 
 #include <shogun/lib/config.h>
@@ -147,13 +148,11 @@ float64_t Plif::lookup_penalty_svm(
 		break ;
 	}
 
-	int32_t idx = 0 ;
+	// number of leading limits <= d_value, found by bisection since
+	// limits are monotonically increasing
+	int32_t idx = std::partition_point(limits.vector, limits.vector+len,
+		[d_value](float64_t limit) { return limit<=d_value; }) - limits.vector ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
@@ -243,13 +242,11 @@ float64_t Plif::lookup_penalty(float64_t p_value, float64_t* svm_values) const
 	io::print("  -> value = {:1.4f} ", d_value);
 #endif
 
-	int32_t idx = 0 ;
+	// number of leading limits <= d_value, found by bisection since
+	// limits are monotonically increasing
+	int32_t idx = std::partition_point(limits.vector, limits.vector+len,
+		[d_value](float64_t limit) { return limit<=d_value; }) - limits.vector ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
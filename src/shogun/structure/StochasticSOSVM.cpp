@@ -7,10 +7,13 @@
 
 #include <shogun/base/progress.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/Time.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 StochasticSOSVM::StochasticSOSVM()
@@ -45,11 +48,13 @@ void StochasticSOSVM::init()
 	SG_ADD(&m_num_iter, "num_iter", "Number of iterations");
 	SG_ADD(&m_do_weighted_averaging, "do_weighted_averaging", "Do weighted averaging");
 	SG_ADD(&m_debug_multiplier, "debug_multiplier", "Debug multiplier");
+	SG_ADD(&m_batch_size, "batch_size", "Number of examples per update");
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_weighted_averaging = true;
 	m_debug_multiplier = 0;
+	m_batch_size = 1;
 }
 
 StochasticSOSVM::~StochasticSOSVM()
@@ -102,44 +107,39 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 		m_debug_multiplier = 100;
 	}
 
+	m_oracle_times.clear();
+
 	// Main loop
 	int32_t k = 0;
+	int32_t num_seen = 0;
 	UniformIntDistribution<int32_t> uniform_int_dist;
+	SGVector<float64_t> w_s(M);
 	for (auto pi : SG_PROGRESS(range(m_num_iter)))
 	{
-		for (int32_t si = 0; si < N; ++si)
+		float64_t oracle_time = 0;
+		for (int32_t si = 0; si < N; si += m_batch_size)
 		{
-			// 1) Picking random example
-			int32_t i = uniform_int_dist(m_prng, {0, N-1});
-
-			// 2) solve the loss-augmented inference for point i
-			auto result = m_model->argmax(m_w, i);
-
-			// 3) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
-			SGVector<float64_t> psi_i(M);
-			SGVector<float64_t> w_s(M);
-
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
+			// 1) Picking random examples
+			SGVector<index_t> batch(Math::min(m_batch_size, N - si));
+			// the examples of a batch are distinct, since models may
+			// update per-example state in argmax
+			for (index_t j = 0; j < batch.vlen; ++j)
 			{
-				error("model({}) should have either of psi_computed or psi_computed_sparse"
-						"to be set true", m_model->get_name());
+				do
+					batch[j] = uniform_int_dist(m_prng, {0, N-1});
+				while (std::find(batch.vector, batch.vector + j, batch[j])
+					!= batch.vector + j);
 			}
 
-			w_s = psi_i.clone();
-			w_s.scale(1.0 / (N*m_lambda));
+			// 2-3) solve the loss-augmented inference for the picked
+			// examples and get the averaged subgradient
+			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
+			Time oracle_timer;
+			w_s.zero();
+			m_model->argmax_batch(m_w, batch, w_s);
+			oracle_time += oracle_timer.cur_time_diff();
+
+			w_s.scale(1.0 / (batch.vlen*N*m_lambda));
 
 			// 4) step-size gamma
 			float64_t gamma = 1.0 / (k+1.0);
@@ -157,10 +157,10 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 			}
 
 			k += 1;
-
+			num_seen += batch.vlen;
 
 			// Debug: compute objective and training error
-			if (m_verbose && k == debug_iter)
+			if (m_verbose && num_seen >= debug_iter)
 			{
 				SGVector<float64_t> w_debug;
 				if (m_do_weighted_averaging)
@@ -174,11 +174,14 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 				SG_DEBUG("pass {} (iteration {}), SVM primal = {}, train_error = {} ",
 					pi, k, primal, train_error);
 
-				m_helper->add_debug_info(primal, (1.0*k) / N, train_error);
+				m_helper->add_debug_info(primal, (1.0*num_seen) / N, train_error);
 
 				debug_iter = Math::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
 			}
 		}
+
+		m_oracle_times.push_back(oracle_time);
+		SG_DEBUG("pass {}, oracle time: {}s", pi, oracle_time);
 	}
 
 	if (m_do_weighted_averaging)
@@ -221,3 +224,14 @@ void StochasticSOSVM::set_debug_multiplier(int32_t multiplier)
 	m_debug_multiplier = multiplier;
 }
 
+int32_t StochasticSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void StochasticSOSVM::set_batch_size(int32_t batch_size)
+{
+	require(batch_size > 0, "Batch size ({}) must be positive", batch_size);
+	m_batch_size = batch_size;
+}
+
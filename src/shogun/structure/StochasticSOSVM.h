@@ -82,6 +82,18 @@ public:
 	 */
 	void set_debug_multiplier(int32_t multiplier);
 
+	/** @return number of examples per update */
+	int32_t get_batch_size() const;
+
+	/** set the number of randomly picked examples whose averaged
+	 * subgradient is used in each update. The loss-augmented inference of
+	 * the examples in a batch runs in parallel if the model supports it,
+	 * see StructuredModel::is_argmax_thread_safe.
+	 *
+	 * @param batch_size number of examples per update (default: 1)
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -112,6 +124,9 @@ private:
 	 */
 	int32_t m_debug_multiplier;
 
+	/** Number of examples per update (default: 1) */
+	int32_t m_batch_size;
+
 }; /* CStochasticSOSVM */
 
 } /* namespace shogun */
@@ -6,7 +6,9 @@
  */
 
 #include <shogun/structure/StructuredModel.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -75,6 +77,7 @@ void StructuredModel::init_primal_opt(
 void StructuredModel::set_labels(std::shared_ptr<StructuredLabels> labels)
 {
 	m_labels = std::move(labels);
+	m_truth_psi_cache.clear();
 }
 
 std::shared_ptr<StructuredLabels> StructuredModel::get_labels()
@@ -88,6 +91,7 @@ void StructuredModel::set_features(std::shared_ptr<Features> features)
 
 
 	m_features = std::move(features);
+	m_truth_psi_cache.clear();
 }
 
 std::shared_ptr<Features> StructuredModel::get_features()
@@ -96,6 +100,175 @@ std::shared_ptr<Features> StructuredModel::get_features()
 	return m_features;
 }
 
+float64_t StructuredModel::argmax_batch(SGVector<float64_t> w,
+		SGVector<index_t> feat_idx, SGVector<float64_t> subgrad)
+{
+	require(subgrad.vlen == get_dim(), "Subgradient size ({}) must match "
+		"the dimension of the model ({})", subgrad.vlen, get_dim());
+
+	prepare_argmax_batch(true);
+
+	float64_t loss = 0;
+	// an exception escaping the parallel region terminates the program, so
+	// the first one is kept and rethrown after the region
+	std::exception_ptr exception;
+	#pragma omp parallel if (is_argmax_thread_safe() && feat_idx.vlen > 1)
+	{
+		SGVector<float64_t> local_subgrad(subgrad.vlen);
+		local_subgrad.zero();
+		float64_t local_loss = 0;
+
+		#pragma omp for schedule(dynamic)
+		for (index_t i = 0; i < feat_idx.vlen; ++i)
+		{
+			try
+			{
+				local_loss += add_argmax_subgradient(w, feat_idx[i], local_subgrad);
+			}
+			catch (...)
+			{
+				#pragma omp critical
+				{
+					if (!exception)
+						exception = std::current_exception();
+				}
+			}
+		}
+
+		#pragma omp critical
+		{
+			SGVector<float64_t>::add(subgrad.vector, 1.0, subgrad.vector,
+				1.0, local_subgrad.vector, subgrad.vlen);
+			loss += local_loss;
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+
+	return loss;
+}
+
+std::vector<std::shared_ptr<StructuredData>> StructuredModel::predict_batch(
+		SGVector<float64_t> w, int32_t num_vectors)
+{
+	prepare_argmax_batch(false);
+
+	std::vector<std::shared_ptr<StructuredData>> predictions(num_vectors);
+	std::exception_ptr exception;
+	#pragma omp parallel for schedule(dynamic) if (is_argmax_thread_safe())
+	for (int32_t i = 0; i < num_vectors; ++i)
+	{
+		try
+		{
+			predictions[i] = argmax(w, i, false)->argmax;
+		}
+		catch (...)
+		{
+			#pragma omp critical
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+
+	return predictions;
+}
+
+float64_t StructuredModel::add_argmax_subgradient(SGVector<float64_t> w,
+		int32_t feat_idx, SGVector<float64_t> subgrad)
+{
+	auto result = argmax(w, feat_idx);
+
+	if (result->psi_computed)
+	{
+		SGVector<float64_t>::add(subgrad.vector, 1.0, subgrad.vector,
+			1.0, result->psi_truth.vector, subgrad.vlen);
+		SGVector<float64_t>::add(subgrad.vector, 1.0, subgrad.vector,
+			-1.0, result->psi_pred.vector, subgrad.vlen);
+	}
+	else if (result->psi_computed_sparse)
+	{
+		result->psi_truth_sparse.add_to_dense(1.0,
+			subgrad.vector, subgrad.vlen);
+		result->psi_pred_sparse.add_to_dense(-1.0,
+			subgrad.vector, subgrad.vlen);
+	}
+	else
+	{
+		error("model({}) should have either of psi_computed or "
+			"psi_computed_sparse to be set true", get_name());
+	}
+
+	return result->delta;
+}
+
+void StructuredModel::add_joint_feature_vector(int32_t feat_idx,
+		std::shared_ptr<StructuredData> y, float64_t alpha,
+		SGVector<float64_t> psi)
+{
+	SGVector<float64_t> joint = get_joint_feature_vector(feat_idx, y);
+	SGVector<float64_t>::add(psi.vector, 1.0, psi.vector, alpha,
+		joint.vector, psi.vlen);
+}
+
+float64_t StructuredModel::dot_joint_feature_vector(SGVector<float64_t> w,
+		int32_t feat_idx, std::shared_ptr<StructuredData> y)
+{
+	return linalg::dot(w, get_joint_feature_vector(feat_idx, y));
+}
+
+void StructuredModel::add_truth_joint_feature_vector(int32_t feat_idx,
+		float64_t alpha, SGVector<float64_t> psi)
+{
+	if (feat_idx < (int32_t) m_truth_psi_cache.size())
+		m_truth_psi_cache[feat_idx].add_to_dense(alpha, psi.vector, psi.vlen);
+	else
+		add_joint_feature_vector(feat_idx, m_labels->get_label(feat_idx),
+			alpha, psi);
+}
+
+void StructuredModel::init_truth_cache()
+{
+	int32_t num_labels = m_labels->get_num_labels();
+	int32_t dim = get_dim();
+
+	std::vector<SGSparseVector<float64_t>> cache(num_labels);
+	#pragma omp parallel if (is_argmax_thread_safe())
+	{
+		SGVector<float64_t> psi(dim);
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t i = 0; i < num_labels; ++i)
+		{
+			psi.zero();
+			add_joint_feature_vector(i, m_labels->get_label(i), 1.0, psi);
+
+			int32_t nnz = 0;
+			for (index_t j = 0; j < dim; ++j)
+				nnz += psi[j] != 0;
+
+			SGSparseVector<float64_t> sparse_psi(nnz);
+			for (index_t j = 0, k = 0; j < dim; ++j)
+			{
+				if (psi[j] != 0)
+				{
+					sparse_psi.features[k].feat_index = j;
+					sparse_psi.features[k].entry = psi[j];
+					k++;
+				}
+			}
+			cache[i] = sparse_psi;
+		}
+	}
+
+	m_truth_psi_cache = std::move(cache);
+}
+
 SGVector< float64_t > StructuredModel::get_joint_feature_vector(
 		int32_t feat_idx,
 		int32_t lab_idx)
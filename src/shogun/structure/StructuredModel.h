@@ -21,6 +21,8 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/StructuredData.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -236,6 +238,116 @@ class StructuredModel : public SGObject
 		 */
 		virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/** whether argmax may be called concurrently from several threads,
+		 * with the same w and distinct feat_idx, during training.
+		 * Implementations returning true must not write to any member
+		 * state in argmax and in the joint feature vector computations.
+		 * Solvers only evaluate the loss-augmented inference of several
+		 * examples in parallel when this returns true.
+		 *
+		 * @return false by default
+		 */
+		virtual bool is_argmax_thread_safe() const { return false; }
+
+		/** called by argmax_batch and predict_batch before the inference
+		 * of the batch. Models whose argmax lazily initializes member
+		 * state do it here, so that the threads of the batch only read it.
+		 * Empty by default.
+		 *
+		 * @param training whether the batch is loss-augmented inference
+		 * during training
+		 */
+		virtual void prepare_argmax_batch(bool training) {}
+
+		/** solves the loss-augmented inference for a batch of examples and
+		 * accumulates their subgradients
+		 * \f$ \Psi(x_i,y_i) - \Psi(x_i,y_{pred}) \f$ into subgrad.
+		 * The examples are processed in parallel if
+		 * is_argmax_thread_safe() returns true, after a call to
+		 * prepare_argmax_batch(). Exceptions thrown by argmax are
+		 * rethrown once all threads are done.
+		 *
+		 * @param w weight vector
+		 * @param feat_idx indices of the examples
+		 * @param subgrad dense vector of size get_dim() the summed
+		 * subgradients are added to
+		 *
+		 * @return sum of the losses \f$ \Delta(y_i, y_{pred}) \f$
+		 */
+		float64_t argmax_batch(SGVector<float64_t> w,
+				SGVector<index_t> feat_idx, SGVector<float64_t> subgrad);
+
+		/** predicts the structured outputs of the first num_vectors
+		 * examples, in parallel if is_argmax_thread_safe() returns true,
+		 * after a call to prepare_argmax_batch(). Exceptions thrown by
+		 * argmax are rethrown once all threads are done.
+		 *
+		 * @param w weight vector
+		 * @param num_vectors number of examples
+		 *
+		 * @return predicted output of each example
+		 */
+		std::vector<std::shared_ptr<StructuredData>> predict_batch(
+				SGVector<float64_t> w, int32_t num_vectors);
+
+		/** solves the loss-augmented inference for one example and adds
+		 * its subgradient \f$ \Psi(x_i,y_i) - \Psi(x_i,y_{pred}) \f$ to
+		 * subgrad. The default implementation uses the joint feature
+		 * vectors of argmax; models may override it to skip building them.
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the example
+		 * @param subgrad dense vector of size get_dim()
+		 *
+		 * @return loss \f$ \Delta(y_i, y_{pred}) \f$
+		 */
+		virtual float64_t add_argmax_subgradient(SGVector<float64_t> w,
+				int32_t feat_idx, SGVector<float64_t> subgrad);
+
+		/** adds \f$ \alpha \Psi(x_{feat\_idx}, y) \f$ to a dense vector,
+		 * without allocating the joint feature vector when the model
+		 * overrides it
+		 *
+		 * @param feat_idx index of the feature vector to use
+		 * @param y structured label to use
+		 * @param alpha scalar the joint feature vector is multiplied with
+		 * @param psi dense vector of size get_dim()
+		 */
+		virtual void add_joint_feature_vector(int32_t feat_idx,
+				std::shared_ptr<StructuredData> y, float64_t alpha,
+				SGVector<float64_t> psi);
+
+		/** computes \f$ \langle w, \Psi(x_{feat\_idx}, y) \rangle \f$,
+		 * without allocating the joint feature vector when the model
+		 * overrides it
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the feature vector to use
+		 * @param y structured label to use
+		 *
+		 * @return the dot product
+		 */
+		virtual float64_t dot_joint_feature_vector(SGVector<float64_t> w,
+				int32_t feat_idx, std::shared_ptr<StructuredData> y);
+
+		/** adds \f$ \alpha \Psi(x_i, y_i) \f$ for the true label of example
+		 * feat_idx to a dense vector. Uses the joint feature vectors cached
+		 * by init_truth_cache() if available.
+		 *
+		 * @param feat_idx index of the example
+		 * @param alpha scalar the joint feature vector is multiplied with
+		 * @param psi dense vector of size get_dim()
+		 */
+		void add_truth_joint_feature_vector(int32_t feat_idx, float64_t alpha,
+				SGVector<float64_t> psi);
+
+		/** computes and caches the (sparse) joint feature vectors of all
+		 * true labels, so that they are not recomputed in every pass of a
+		 * solver. Models call this in init_training. The cache is dropped
+		 * when labels or features change.
+		 */
+		void init_truth_cache();
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
@@ -305,6 +417,9 @@ class StructuredModel : public SGObject
 		/** feature vectors */
 		std::shared_ptr<Features> m_features;
 
+		/** joint feature vectors of the true labels, see init_truth_cache */
+		std::vector<SGSparseVector<float64_t>> m_truth_psi_cache;
+
 }; /* class StructuredModel */
 
 } /* namespace shogun */
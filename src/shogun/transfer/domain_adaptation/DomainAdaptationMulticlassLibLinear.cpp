@@ -114,4 +114,23 @@ std::shared_ptr<BinaryLabels> DomainAdaptationMulticlassLibLinear::get_submachin
 
 	return std::make_shared<BinaryLabels>(result);
 }
+
+std::vector<std::shared_ptr<BinaryLabels>> DomainAdaptationMulticlassLibLinear::get_submachines_outputs()
+{
+	auto target_outputs = MulticlassLibLinear::get_submachines_outputs();
+	auto source_outputs = m_source_machine->get_submachines_outputs();
+	ASSERT(target_outputs.size()==source_outputs.size())
+	for (size_t i=0; i<target_outputs.size(); i++)
+	{
+		int32_t n_target_outputs = target_outputs[i]->get_num_labels();
+		ASSERT(n_target_outputs==source_outputs[i]->get_num_labels())
+		SGVector<float64_t> result(n_target_outputs);
+		for (int32_t j=0; j<result.vlen; j++)
+			result[j] = (1-m_source_bias)*target_outputs[i]->get_value(j) + m_source_bias*source_outputs[i]->get_value(j);
+
+		target_outputs[i] = std::make_shared<BinaryLabels>(result);
+	}
+
+	return target_outputs;
+}
 #endif /* HAVE_LAPACK */
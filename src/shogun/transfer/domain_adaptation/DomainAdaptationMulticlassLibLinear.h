@@ -38,6 +38,9 @@ class DomainAdaptationMulticlassLibLinear : public MulticlassLibLinear
 		/** get submachine outputs */
 		virtual std::shared_ptr<BinaryLabels> get_submachine_outputs(int32_t);
 
+		/** get outputs of all submachines */
+		virtual std::vector<std::shared_ptr<BinaryLabels>> get_submachines_outputs();
+
 		/** get name */
 		virtual const char* get_name() const
 		{
@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+
+#include <shogun/base/Executor.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/TaskScheduler.h>
+#include <shogun/base/progress.h>
+#include <shogun/base/range.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/config.h>
+#include <shogun/machine/Machine.h>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#include <atomic>
+#include <thread>
+
+using namespace shogun;
+using namespace std::chrono_literals;
+
+namespace
+{
+	/** blocks tasks until it is opened */
+	class Gate
+	{
+	public:
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this]() { return m_open; });
+		}
+
+		void open()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_open = true;
+			}
+			m_cv.notify_all();
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		bool m_open = false;
+	};
+
+	/** machine that trains and applies until it is stopped */
+	class EndlessMachine : public Machine
+	{
+	public:
+		MACHINE_PROBLEM_TYPE(PT_BINARY)
+
+		virtual const char* get_name() const
+		{
+			return "EndlessMachine";
+		}
+
+		virtual std::shared_ptr<BinaryLabels>
+		apply_binary(std::shared_ptr<Features> data = NULL)
+		{
+			for (;;)
+			{
+				COMPUTATION_CONTROLLERS
+				num_iterations++;
+				std::this_thread::sleep_for(1ms);
+			}
+			return std::make_shared<BinaryLabels>(0);
+		}
+
+		std::atomic<int32_t> num_iterations{0};
+
+	protected:
+		virtual bool train_require_labels() const
+		{
+			return false;
+		}
+
+		virtual bool train_machine(std::shared_ptr<Features> data = NULL)
+		{
+			for (;;)
+			{
+				COMPUTATION_CONTROLLERS
+				num_iterations++;
+				std::this_thread::sleep_for(1ms);
+			}
+			return true;
+		}
+	};
+} // namespace
+
+TEST(Executor, get_result)
+{
+	Executor executor([]() { return 2; });
+	auto answer = executor.submit<int32_t>([]() { return 42; });
+	EXPECT_EQ(answer.get(), 42);
+	EXPECT_TRUE(answer.is_ready());
+	EXPECT_EQ(answer.get_status(), TASK_FINISHED);
+	EXPECT_EQ(answer.get_progress(), 1.0);
+}
+
+TEST(Executor, failed_task_rethrows)
+{
+	Executor executor([]() { return 2; });
+	auto failed = executor.submit<int32_t>([]() -> int32_t {
+		throw ShogunException("failed");
+	});
+	EXPECT_THROW(failed.get(), ShogunException);
+	EXPECT_EQ(failed.get_status(), TASK_FAILED);
+}
+
+TEST(Executor, tasks_share_num_threads)
+{
+	Executor executor([]() { return 2; });
+	Gate gate;
+	std::atomic<int32_t> used{0};
+	std::atomic<int32_t> max_used{0};
+	std::vector<TaskFuture<bool>> tasks;
+	for (auto i : range(6))
+	{
+		(void)i;
+		tasks.push_back(executor.submit<bool>([&]() {
+#ifdef HAVE_OPENMP
+			int32_t num_threads = omp_get_max_threads();
+#else
+			int32_t num_threads = 1;
+#endif
+			auto now = used += num_threads;
+			auto max = max_used.load();
+			while (now > max && !max_used.compare_exchange_weak(max, now))
+				;
+			gate.wait();
+			used -= num_threads;
+			return true;
+		}));
+	}
+
+	while (executor.get_num_running() < 1)
+		std::this_thread::sleep_for(1ms);
+	EXPECT_LE(executor.get_num_running(), 2);
+	EXPECT_EQ(executor.get_num_running() + executor.get_num_pending(), 6);
+	gate.open();
+	for (const auto& task : tasks)
+		EXPECT_TRUE(task.get());
+	EXPECT_LE(max_used.load(), 2);
+}
+
+TEST(Executor, tasks_share_threads_with_scheduler)
+{
+	TaskScheduler scheduler([]() { return 4; });
+	Executor executor([]() { return 4; }, &scheduler);
+	std::atomic<int32_t> active{0};
+	std::atomic<int32_t> max_active{0};
+	std::vector<TaskFuture<bool>> tasks;
+	for (auto i : range(6))
+	{
+		(void)i;
+		tasks.push_back(executor.submit<bool>([&]() {
+			scheduler.parallel_for(
+			    0, 32,
+			    [&](index_t) {
+				    auto now = ++active;
+				    auto max = max_active.load();
+				    while (now > max &&
+				           !max_active.compare_exchange_weak(max, now))
+					    ;
+				    std::this_thread::sleep_for(100us);
+				    --active;
+			    },
+			    1);
+			return true;
+		}));
+	}
+
+	for (const auto& task : tasks)
+		EXPECT_TRUE(task.get());
+	EXPECT_LE(max_active.load(), 4);
+
+	// the scheduler gets all threads back once the workers are done
+	while (executor.get_num_running() > 0)
+		std::this_thread::sleep_for(1ms);
+	EXPECT_EQ(scheduler.get_num_threads(), 4);
+}
+
+TEST(Executor, cancel_pending)
+{
+	Executor executor([]() { return 1; });
+	Gate gate;
+	auto blocking = executor.submit<bool>([&gate]() {
+		gate.wait();
+		return true;
+	});
+	auto pending = executor.submit<bool>([]() { return true; });
+
+	EXPECT_TRUE(pending.cancel());
+	EXPECT_EQ(pending.get_status(), TASK_CANCELLED);
+	EXPECT_THROW(pending.get(), ShogunException);
+
+	gate.open();
+	EXPECT_TRUE(blocking.get());
+	EXPECT_FALSE(blocking.cancel());
+}
+
+TEST(Executor, timeout_stops_running_task)
+{
+	Executor executor([]() { return 1; });
+	std::atomic<bool> stop{false};
+	auto task = executor.submit<int32_t>(
+	    [&stop]() {
+		    int32_t iterations = 0;
+		    while (!stop.load())
+		    {
+			    iterations++;
+			    std::this_thread::sleep_for(1ms);
+		    }
+		    return iterations;
+	    },
+	    [&stop]() { stop.store(true); }, 20ms);
+
+	EXPECT_GT(task.get(), 0);
+	EXPECT_EQ(task.get_status(), TASK_FINISHED);
+}
+
+TEST(Executor, reports_progress_of_outermost_loop)
+{
+	Executor executor([]() { return 1; });
+	Gate halfway, resume;
+	auto task = executor.submit<bool>([&]() {
+		for (auto i : progress("outer", range(10)))
+		{
+			for (auto j : progress("inner", range(100)))
+				(void)j;
+			if (i == 5)
+			{
+				halfway.open();
+				resume.wait();
+			}
+		}
+		return true;
+	});
+
+	halfway.wait();
+	EXPECT_NEAR(task.get_progress(), 0.5, 0.1);
+	resume.open();
+	EXPECT_TRUE(task.get());
+	EXPECT_EQ(task.get_progress(), 1.0);
+}
+
+TEST(Executor, cancel_train_async)
+{
+	auto machine = std::make_shared<EndlessMachine>();
+	auto trained = machine->train_async();
+	while (machine->num_iterations.load() < 3)
+		std::this_thread::sleep_for(1ms);
+
+	EXPECT_FALSE(trained.wait_for(1ms));
+	EXPECT_TRUE(trained.cancel());
+	EXPECT_TRUE(trained.get());
+	EXPECT_EQ(trained.get_status(), TASK_FINISHED);
+
+	// the stop request must not leak into the next computation
+	machine->stop_computation();
+	auto iterations = machine->num_iterations.load();
+	trained = machine->train_async(nullptr, 50ms);
+	EXPECT_TRUE(trained.get());
+	EXPECT_GT(machine->num_iterations.load(), iterations);
+}
+
+TEST(Executor, cancel_before_train_connects)
+{
+	auto machine = std::make_shared<EndlessMachine>();
+	Executor executor([]() { return 1; });
+	Gate gate;
+	auto trained = executor.submit<bool>(
+	    [&]() {
+		    gate.wait();
+		    return machine->train();
+	    },
+	    [machine]() { machine->stop_computation(); });
+	while (trained.get_status() != TASK_RUNNING)
+		std::this_thread::sleep_for(1ms);
+
+	// the machine is not computing yet, the stop must not be lost
+	EXPECT_TRUE(trained.cancel());
+	gate.open();
+	EXPECT_TRUE(trained.get());
+	EXPECT_EQ(machine->num_iterations.load(), 0);
+}
+
+TEST(Executor, apply_async_timeout)
+{
+	auto machine = std::make_shared<EndlessMachine>();
+	auto applied = machine->apply_async(nullptr, 20ms);
+	EXPECT_TRUE(applied.get() != nullptr);
+	EXPECT_EQ(applied.get_status(), TASK_FINISHED);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <shogun/base/TaskScheduler.h>
+#include <shogun/lib/exception/ShogunException.h>
+
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace shogun;
+
+TEST(TaskScheduler, parallel_for_visits_each_index_once)
+{
+	TaskScheduler scheduler([]() { return 4; });
+	std::vector<std::atomic<int32_t>> visits(10000);
+	for (auto& v : visits)
+		v = 0;
+
+	scheduler.parallel_for(0, visits.size(), [&](index_t i) { visits[i]++; });
+	for (const auto& v : visits)
+		EXPECT_EQ(v.load(), 1);
+
+	// grain of the size of the range and empty range
+	scheduler.parallel_for(
+	    0, visits.size(), [&](index_t i) { visits[i]++; }, visits.size());
+	scheduler.parallel_for(5, 5, [&](index_t i) { visits[i]++; });
+	for (const auto& v : visits)
+		EXPECT_EQ(v.load(), 2);
+}
+
+TEST(TaskScheduler, parallel_reduce)
+{
+	TaskScheduler scheduler([]() { return 4; });
+	auto sum = scheduler.parallel_reduce(
+	    1, 100001, int64_t(0), [](index_t i) { return int64_t(i); },
+	    [](int64_t a, int64_t b) { return a + b; });
+	EXPECT_EQ(sum, int64_t(100000) * 100001 / 2);
+
+	// the result does not depend on the threads for a fixed grain
+	TaskScheduler serial([]() { return 1; });
+	auto map = [](index_t i) { return 1.0 / (i + 1); };
+	auto plus = [](float64_t a, float64_t b) { return a + b; };
+	EXPECT_EQ(
+	    scheduler.parallel_reduce(0, 100000, 0.0, map, plus, 100),
+	    serial.parallel_reduce(0, 100000, 0.0, map, plus, 100));
+
+	EXPECT_EQ(scheduler.parallel_reduce(3, 3, 7.0, map, plus), 7.0);
+}
+
+TEST(TaskScheduler, nested_regions_share_threads)
+{
+	const int32_t num_threads = 3;
+	TaskScheduler scheduler([]() { return num_threads; });
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	std::atomic<int64_t> count(0);
+
+	scheduler.parallel_for(
+	    0, 16,
+	    [&](index_t) {
+		    scheduler.parallel_for(
+		        0, 16,
+		        [&](index_t) {
+			        scheduler.parallel_for(0, 64, [&](index_t) {
+				        count++;
+				        std::lock_guard<std::mutex> lock(mutex);
+				        threads.insert(std::this_thread::get_id());
+			        });
+		        },
+		        1);
+	    },
+	    1);
+
+	EXPECT_EQ(count.load(), 16 * 16 * 64);
+	EXPECT_LE(threads.size(), (size_t)num_threads);
+}
+
+TEST(TaskScheduler, single_thread_runs_on_caller)
+{
+	TaskScheduler scheduler([]() { return 1; });
+	auto caller = std::this_thread::get_id();
+	std::atomic<int32_t> others(0);
+	scheduler.parallel_for(0, 1000, [&](index_t) {
+		if (std::this_thread::get_id() != caller)
+			others++;
+	});
+
+	TaskGroup group(&scheduler);
+	group.run([&]() {
+		if (std::this_thread::get_id() != caller)
+			others++;
+	});
+	group.wait();
+	EXPECT_EQ(others.load(), 0);
+}
+
+TEST(TaskScheduler, task_group_rethrows_first_exception)
+{
+	TaskScheduler scheduler([]() { return 4; });
+	TaskGroup group(&scheduler);
+	std::atomic<int32_t> done(0);
+	for (auto i = 0; i < 100; ++i)
+	{
+		group.run([&done, i]() {
+			if (i == 10)
+				throw ShogunException("task failed");
+			done++;
+		});
+	}
+	EXPECT_THROW(group.wait(), ShogunException);
+	EXPECT_LT(done.load(), 100);
+
+	// the group can be reused after it failed
+	group.run([&done]() { done = -1; });
+	group.wait();
+	EXPECT_EQ(done.load(), -1);
+
+	EXPECT_THROW(
+	    scheduler.parallel_for(
+	        0, 1000,
+	        [](index_t i) {
+		        if (i == 500)
+			        throw ShogunException("index failed");
+	        }),
+	    ShogunException);
+}
+
+TEST(TaskScheduler, waiting_thread_runs_tasks_of_its_group_only)
+{
+	static thread_local bool t_in_scope = false;
+	TaskScheduler scheduler([]() { return 2; });
+	std::atomic<bool> started(false);
+	std::atomic<bool> other_done(false);
+	std::atomic<int32_t> in_scope(0);
+
+	// the worker runs the task of this group until the other caller is done
+	TaskGroup group(&scheduler);
+	group.run([&]() {
+		started = true;
+		while (!other_done)
+			std::this_thread::yield();
+	});
+	while (!started)
+		std::this_thread::yield();
+
+	t_in_scope = true;
+	std::thread other([&]() {
+		scheduler.parallel_for(
+		    0, 1000,
+		    [&](index_t) {
+			    if (t_in_scope)
+				    in_scope++;
+		    },
+		    1);
+		other_done = true;
+	});
+	group.wait();
+	other.join();
+	t_in_scope = false;
+
+	EXPECT_EQ(in_scope.load(), 0);
+}
+
+TEST(TaskScheduler, callers_on_several_threads)
+{
+	TaskScheduler scheduler([]() { return 4; });
+	std::vector<int64_t> sums(8);
+	std::vector<std::thread> callers;
+	for (size_t t = 0; t < sums.size(); ++t)
+	{
+		callers.emplace_back([&scheduler, &sums, t]() {
+			sums[t] = scheduler.parallel_reduce(
+			    0, 10000, int64_t(0), [t](index_t i) { return int64_t(i + t); },
+			    [](int64_t a, int64_t b) { return a + b; });
+		});
+	}
+	for (auto& caller : callers)
+		caller.join();
+
+	for (size_t t = 0; t < sums.size(); ++t)
+		EXPECT_EQ(sums[t], int64_t(9999) * 10000 / 2 + 10000 * int64_t(t));
+}
+
+TEST(TaskScheduler, follows_number_of_threads)
+{
+	std::atomic<int32_t> num_threads(4);
+	TaskScheduler scheduler([&num_threads]() { return num_threads.load(); });
+	EXPECT_EQ(scheduler.get_num_threads(), 4);
+	scheduler.parallel_for(0, 64, [](index_t) {}, 1);
+
+	// let the workers of the previous region go idle
+	num_threads = 2;
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	std::mutex mutex;
+	std::set<std::thread::id> threads;
+	for (auto repeat = 0; repeat < 10; ++repeat)
+	{
+		scheduler.parallel_for(
+		    0, 64,
+		    [&](index_t) {
+			    std::this_thread::sleep_for(std::chrono::microseconds(100));
+			    std::lock_guard<std::mutex> lock(mutex);
+			    threads.insert(std::this_thread::get_id());
+		    },
+		    1);
+	}
+	EXPECT_LE(threads.size(), 2u);
+}
@@ -0,0 +1,122 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/Hierarchical.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+static std::shared_ptr<Hierarchical> train_line(EHierarchicalLinkage linkage)
+{
+	/* points on a line at 0, 1, 3, 7 */
+	SGMatrix<float64_t> data(1, 4);
+	data(0,0)=0;
+	data(0,1)=1;
+	data(0,2)=3;
+	data(0,3)=7;
+
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+	auto clustering=std::make_shared<Hierarchical>(1, distance);
+	clustering->set_linkage(linkage);
+	clustering->train(features);
+	return clustering;
+}
+
+static void check_merge_pairs(const std::shared_ptr<Hierarchical>& clustering)
+{
+	/* the points merge from left to right */
+	SGMatrix<int32_t> pairs=clustering->get_cluster_pairs();
+	ASSERT_EQ(pairs.num_cols, 3);
+	EXPECT_EQ(pairs(0,0), 0);
+	EXPECT_EQ(pairs(1,0), 1);
+	EXPECT_EQ(pairs(0,1), 2);
+	EXPECT_EQ(pairs(1,1), 4);
+	EXPECT_EQ(pairs(0,2), 3);
+	EXPECT_EQ(pairs(1,2), 5);
+
+	SGVector<int32_t> assignment=clustering->get_assignment();
+	ASSERT_EQ(assignment.vlen, 4);
+	for (index_t i=0; i<assignment.vlen; i++)
+		EXPECT_EQ(assignment[i], 6);
+}
+
+TEST(Hierarchical, single_linkage)
+{
+	auto clustering=train_line(HL_SINGLE);
+	check_merge_pairs(clustering);
+
+	SGVector<float64_t> dists=clustering->get_merge_distances();
+	EXPECT_NEAR(dists[0], 1.0, 1e-12);
+	EXPECT_NEAR(dists[1], 2.0, 1e-12);
+	EXPECT_NEAR(dists[2], 4.0, 1e-12);
+}
+
+TEST(Hierarchical, complete_linkage)
+{
+	auto clustering=train_line(HL_COMPLETE);
+	check_merge_pairs(clustering);
+
+	SGVector<float64_t> dists=clustering->get_merge_distances();
+	EXPECT_NEAR(dists[0], 1.0, 1e-12);
+	EXPECT_NEAR(dists[1], 3.0, 1e-12);
+	EXPECT_NEAR(dists[2], 7.0, 1e-12);
+}
+
+TEST(Hierarchical, average_linkage)
+{
+	auto clustering=train_line(HL_AVERAGE);
+	check_merge_pairs(clustering);
+
+	SGVector<float64_t> dists=clustering->get_merge_distances();
+	EXPECT_NEAR(dists[0], 1.0, 1e-12);
+	EXPECT_NEAR(dists[1], 2.5, 1e-12);
+	EXPECT_NEAR(dists[2], 17.0/3, 1e-12);
+}
+
+TEST(Hierarchical, ward_linkage)
+{
+	auto clustering=train_line(HL_WARD);
+	check_merge_pairs(clustering);
+
+	/* sqrt(2|A||B|/(|A|+|B|)) times the distance of the centroids */
+	SGVector<float64_t> dists=clustering->get_merge_distances();
+	EXPECT_NEAR(dists[0], 1.0, 1e-12);
+	EXPECT_NEAR(dists[1], std::sqrt(4.0/3)*2.5, 1e-12);
+	EXPECT_NEAR(dists[2], std::sqrt(1.5)*(7-4.0/3), 1e-12);
+}
+
+TEST(Hierarchical, partial_merges)
+{
+	/* two groups far apart, stopping at two clusters */
+	SGMatrix<float64_t> data(2, 6);
+	for (index_t i=0; i<3; i++)
+	{
+		data(0,i)=i;
+		data(1,i)=0;
+		data(0,i+3)=100+i;
+		data(1,i+3)=1;
+	}
+
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+	for (auto linkage : {HL_SINGLE, HL_COMPLETE, HL_AVERAGE, HL_WARD})
+	{
+		auto clustering=std::make_shared<Hierarchical>(3, distance);
+		clustering->set_linkage(linkage);
+		clustering->train(features);
+
+		SGVector<int32_t> assignment=clustering->get_assignment();
+		EXPECT_EQ(clustering->get_merge_distances().vlen, 4);
+		EXPECT_EQ(assignment[0], assignment[1]);
+		EXPECT_EQ(assignment[0], assignment[2]);
+		EXPECT_EQ(assignment[3], assignment[4]);
+		EXPECT_EQ(assignment[3], assignment[5]);
+		EXPECT_NE(assignment[0], assignment[3]);
+	}
+}
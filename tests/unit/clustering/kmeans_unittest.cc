@@ -13,6 +13,9 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/observers/ParameterObserver.h>
 #include <shogun/lib/observers/ParameterObserverLogger.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
 
 using namespace shogun;
 
@@ -293,3 +296,85 @@ TEST(KMeans, random_centers_assign)
 
 }
 
+static SGMatrix<float64_t> generate_blobs(int32_t num_blobs, int32_t dim, int32_t num_per_blob)
+{
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> data(dim, num_blobs*num_per_blob);
+	for (int32_t b=0; b<num_blobs; b++)
+	{
+		for (int32_t i=0; i<num_per_blob; i++)
+		{
+			for (int32_t j=0; j<dim; j++)
+				data(j, b*num_per_blob+i)=normal_dist(prng)+(j==b%dim ? 8.0*(b+1) : 0.0);
+		}
+	}
+	return data;
+}
+
+TEST(KMeans, bounded_algorithms_match_lloyd)
+{
+	SGMatrix<float64_t> data=generate_blobs(6, 3, 200);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	/* overlapping initial centers, so that it takes a few iterations */
+	SGMatrix<float64_t> initial_centers(3, 6);
+	for (int32_t c=0; c<6; c++)
+	{
+		for (int32_t j=0; j<3; j++)
+			initial_centers(j, c)=data(j, c*7);
+	}
+
+	SGMatrix<float64_t> lloyd_centers;
+	SGVector<float64_t> lloyd_labels;
+	for (auto algorithm : {KMA_LLOYD, KMA_HAMERLY, KMA_ELKAN})
+	{
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=std::make_shared<KMeans>(6, distance, initial_centers);
+		clustering->set_algorithm(algorithm);
+		clustering->train(features);
+
+		SGMatrix<float64_t> centers=clustering->get_cluster_centers();
+		SGVector<float64_t> labels=
+			clustering->apply(features)->as<MulticlassLabels>()->get_labels();
+		if (algorithm==KMA_LLOYD)
+		{
+			lloyd_centers=centers.clone();
+			lloyd_labels=labels.clone();
+			continue;
+		}
+
+		for (index_t i=0; i<centers.num_rows*centers.num_cols; i++)
+			EXPECT_NEAR(centers.matrix[i], lloyd_centers.matrix[i], 1e-10);
+		for (index_t i=0; i<labels.vlen; i++)
+			EXPECT_EQ(labels[i], lloyd_labels[i]);
+	}
+}
+
+TEST(KMeans, kmeans_parallel_init)
+{
+	const int32_t num_blobs=4;
+	const int32_t num_per_blob=100;
+	SGMatrix<float64_t> data=generate_blobs(num_blobs, 4, num_per_blob);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+	auto clustering=std::make_shared<KMeans>(num_blobs, distance);
+	clustering->set_use_kmeans_parallel(true);
+	clustering->put("seed", 3);
+	clustering->train(features);
+
+	/* every blob ends up in a cluster of its own */
+	SGVector<float64_t> labels=
+		clustering->apply(features)->as<MulticlassLabels>()->get_labels();
+	SGVector<int32_t> blob_of_cluster(num_blobs);
+	blob_of_cluster.set_const(-1);
+	for (int32_t b=0; b<num_blobs; b++)
+	{
+		int32_t cluster=labels[b*num_per_blob];
+		EXPECT_EQ(blob_of_cluster[cluster], -1);
+		blob_of_cluster[cluster]=b;
+		for (int32_t i=0; i<num_per_blob; i++)
+			EXPECT_EQ(labels[b*num_per_blob+i], cluster);
+	}
+}
@@ -0,0 +1,75 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distributions/Gaussian.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+#ifdef HAVE_LAPACK
+
+static void check_batch_log_pdf(ECovType cov_type)
+{
+	const int32_t dim=3;
+	const int32_t num=2500;
+
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=normal_dist(prng);
+
+	SGVector<float64_t> mean(dim);
+	mean[0]=0.5;
+	mean[1]=-1.0;
+	mean[2]=2.0;
+
+	SGMatrix<float64_t> cov(dim, dim);
+	cov.zero();
+	cov(0,0)=2.0;
+	cov(1,1)=1.5;
+	cov(2,2)=0.5;
+	if (cov_type==FULL)
+	{
+		cov(0,1)=cov(1,0)=0.3;
+		cov(1,2)=cov(2,1)=-0.2;
+	}
+
+	auto gauss=std::make_shared<Gaussian>(mean, cov, cov_type);
+	SGVector<float64_t> batch=gauss->compute_log_PDF(data);
+	ASSERT_EQ(batch.vlen, num);
+
+	for (int32_t i=0; i<num; i++)
+	{
+		SGVector<float64_t> point(data.get_column_vector(i), dim, false);
+		EXPECT_NEAR(batch[i], gauss->compute_log_PDF(point), 1e-10);
+	}
+
+	gauss->set_features(std::make_shared<DenseFeatures<float64_t>>(data));
+	SGVector<float64_t> log_likelihood=gauss->get_log_likelihood();
+	for (int32_t i=0; i<num; i++)
+		EXPECT_NEAR(log_likelihood[i], batch[i], 1e-12);
+}
+
+TEST(Gaussian,batch_log_pdf_full)
+{
+	check_batch_log_pdf(FULL);
+}
+
+TEST(Gaussian,batch_log_pdf_diag)
+{
+	check_batch_log_pdf(DIAG);
+}
+
+TEST(Gaussian,batch_log_pdf_spherical)
+{
+	check_batch_log_pdf(SPHERICAL);
+}
+
+#endif /* HAVE_LAPACK */
@@ -0,0 +1,116 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/evaluation/PRCEvaluation.h>
+#include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/evaluation/StreamingROCEvaluation.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace shogun;
+
+static void generate_scores(index_t num_labels, SGVector<float64_t>& scores,
+	SGVector<float64_t>& labels, bool with_ties)
+{
+	std::mt19937_64 prng(23);
+	NormalDistribution<float64_t> normal_dist;
+	scores=SGVector<float64_t>(num_labels);
+	labels=SGVector<float64_t>(num_labels);
+	for (index_t i=0; i<num_labels; i++)
+	{
+		labels[i]=i%3==0 ? 1 : -1;
+		scores[i]=normal_dist(prng)+labels[i];
+		if (with_ties)
+			scores[i]=std::round(scores[i]*4)/4;
+	}
+}
+
+TEST(StreamingROCEvaluation,exact_matches_roc)
+{
+	SGVector<float64_t> scores, labels;
+	generate_scores(5000, scores, labels, true);
+
+	auto roc=std::make_shared<ROCEvaluation>();
+	float64_t auc=roc->evaluate(
+		std::make_shared<BinaryLabels>(scores), std::make_shared<BinaryLabels>(labels));
+
+	/* add in batches */
+	auto streaming=std::make_shared<StreamingROCEvaluation>();
+	for (index_t start=0; start<scores.vlen; start+=1000)
+	{
+		streaming->add(SGVector<float64_t>(scores.vector+start, 1000, false),
+			SGVector<float64_t>(labels.vector+start, 1000, false));
+	}
+
+	EXPECT_EQ(streaming->get_num_examples(), 5000);
+	EXPECT_NEAR(streaming->get_auROC(), auc, 1e-12);
+	EXPECT_EQ(streaming->get_auROC_error_bound(), 0);
+
+	SGMatrix<float64_t> expected=roc->get_ROC();
+	SGMatrix<float64_t> graph=streaming->get_ROC();
+	ASSERT_EQ(graph.num_cols, expected.num_cols);
+	for (index_t i=0; i<graph.num_rows*graph.num_cols; i++)
+		EXPECT_NEAR(graph.matrix[i], expected.matrix[i], 1e-12);
+}
+
+TEST(StreamingROCEvaluation,exact_matches_prc)
+{
+	SGVector<float64_t> scores, labels;
+	generate_scores(2000, scores, labels, false);
+
+	auto prc=std::make_shared<PRCEvaluation>();
+	float64_t auc=prc->evaluate(
+		std::make_shared<BinaryLabels>(scores), std::make_shared<BinaryLabels>(labels));
+
+	auto streaming=std::make_shared<StreamingROCEvaluation>();
+	streaming->evaluate(
+		std::make_shared<BinaryLabels>(scores), std::make_shared<BinaryLabels>(labels));
+	EXPECT_NEAR(streaming->get_auPRC(), auc, 1e-12);
+}
+
+TEST(StreamingROCEvaluation,approximate_within_bound)
+{
+	SGVector<float64_t> scores, labels;
+	generate_scores(20000, scores, labels, false);
+
+	auto exact=std::make_shared<StreamingROCEvaluation>();
+	exact->add(scores, labels);
+
+	for (int32_t num_bin_bits : {2, 6, 10})
+	{
+		auto approximate=std::make_shared<StreamingROCEvaluation>(true, num_bin_bits);
+		approximate->add(scores, labels);
+
+		float64_t bound=approximate->get_auROC_error_bound();
+		EXPECT_LE(std::abs(approximate->get_auROC()-exact->get_auROC()), bound+1e-12);
+		EXPECT_LT(approximate->get_thresholds().vlen, scores.vlen);
+	}
+}
+
+TEST(StreamingROCEvaluation,merge)
+{
+	SGVector<float64_t> scores, labels;
+	generate_scores(3000, scores, labels, false);
+
+	for (bool approximate : {false, true})
+	{
+		auto all=std::make_shared<StreamingROCEvaluation>(approximate);
+		all->add(scores, labels);
+
+		auto first=std::make_shared<StreamingROCEvaluation>(approximate);
+		auto second=std::make_shared<StreamingROCEvaluation>(approximate);
+		first->add(SGVector<float64_t>(scores.vector, 1000, false),
+			SGVector<float64_t>(labels.vector, 1000, false));
+		second->add(SGVector<float64_t>(scores.vector+1000, 2000, false),
+			SGVector<float64_t>(labels.vector+1000, 2000, false));
+		first->merge(second);
+
+		EXPECT_EQ(first->get_num_examples(), all->get_num_examples());
+		EXPECT_NEAR(first->get_auROC(), all->get_auROC(), 1e-12);
+		EXPECT_NEAR(first->get_auPRC(), all->get_auPRC(), 1e-12);
+	}
+}
@@ -302,6 +302,82 @@ TEST(DenseFeaturesTest, view)
 	}
 }
 
+TEST(DenseFeaturesTest, feature_matrix_view)
+{
+	auto num_feats = 3;
+	auto num_vectors = 6;
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	for (auto i : range(num_feats * num_vectors))
+		data[i] = i;
+	auto feats_original = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto view_original = feats_original->get_feature_matrix_view();
+	EXPECT_TRUE(view_original.is_contiguous());
+	EXPECT_EQ(view_original.get_column_vector(0), data.matrix);
+
+	SGVector<index_t> subset1{5, 1, 3, 0};
+	SGVector<index_t> subset2{3, 1};
+	auto feats_subset = view(view(feats_original, subset1), subset2);
+	auto view_subset = feats_subset->get_feature_matrix_view();
+	ASSERT_FALSE(view_subset.is_contiguous());
+	ASSERT_EQ(view_subset.num_rows, num_feats);
+	ASSERT_EQ(view_subset.num_cols, subset2.vlen);
+
+	auto feature_matrix_subset = feats_subset->get_feature_matrix();
+	auto materialized = view_subset.materialize();
+	for (auto j : range(subset2.vlen))
+	{
+		// columns are not copied
+		EXPECT_EQ(
+		    view_subset.get_column_vector(j),
+		    data.get_column_vector(subset1[subset2[j]]));
+		for (auto i : range(num_feats))
+		{
+			EXPECT_EQ(view_subset(i, j), feature_matrix_subset(i, j));
+			EXPECT_EQ(materialized(i, j), feature_matrix_subset(i, j));
+		}
+	}
+
+	// batch operations on the subset read it in place
+	auto sum = feats_subset->sum();
+	SGVector<float64_t> weights{0.5, -2.0};
+	auto dot = feats_subset->dot(weights);
+	for (auto i : range(num_feats))
+	{
+		EXPECT_EQ(
+		    sum[i], feature_matrix_subset(i, 0) + feature_matrix_subset(i, 1));
+		EXPECT_EQ(
+		    dot[i], 0.5 * feature_matrix_subset(i, 0) -
+		                2.0 * feature_matrix_subset(i, 1));
+	}
+}
+
+TEST(DenseFeaturesTest, feature_matrix_view_empty_subset)
+{
+	SGMatrix<float64_t> data(3, 4);
+	for (auto i : range(data.num_rows * data.num_cols))
+		data[i] = i + 1;
+	auto feats_original = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	// an empty subset views no vector, not the whole matrix
+	auto feats_empty = view(feats_original, SGVector<index_t>());
+	auto view_empty = feats_empty->get_feature_matrix_view();
+	EXPECT_FALSE(view_empty.is_contiguous());
+	EXPECT_EQ(view_empty.num_rows, data.num_rows);
+	EXPECT_EQ(view_empty.num_cols, 0);
+	EXPECT_EQ(view_empty.materialize().num_cols, 0);
+
+	auto sum = feats_empty->sum();
+	auto dot = feats_empty->dot(SGVector<float64_t>());
+	ASSERT_EQ(sum.vlen, data.num_rows);
+	ASSERT_EQ(dot.vlen, data.num_rows);
+	for (auto i : range(data.num_rows))
+	{
+		EXPECT_EQ(sum[i], 0);
+		EXPECT_EQ(dot[i], 0);
+	}
+}
+
 TEST(DenseFeaturesTest, iterator)
 {
     SGVector<float64_t> vals(20);
@@ -332,4 +408,49 @@ TEST(DenseFeaturesTest, const_iterator)
         for (const auto& [test, truth]: zip_iterator(iter, tmp))
             EXPECT_EQ(test, truth);
     }
-}
\ No newline at end of file
+}
+
+TEST(DenseFeaturesTest, dense_dot_range)
+{
+	const index_t num_dim = 7;
+	const index_t num_vectors = 53;
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGMatrix<float64_t> mat(num_dim, num_vectors);
+	for (index_t i = 0; i < num_dim * num_vectors; i++)
+		mat.matrix[i] = normal_dist(prng);
+	SGVector<float64_t> w(num_dim);
+	for (index_t i = 0; i < num_dim; i++)
+		w[i] = normal_dist(prng);
+	SGVector<float64_t> alphas(num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+		alphas[i] = normal_dist(prng);
+
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(mat);
+	const index_t start = 3;
+	const index_t stop = 50;
+	const float64_t b = 0.3;
+	SGVector<float64_t> out(stop - start);
+
+	feats->dense_dot_range(
+	    out.vector, start, stop, nullptr, w.vector, num_dim, b);
+	for (index_t i = start; i < stop; i++)
+		EXPECT_NEAR(out[i - start], feats->dot(i, w) + b, 1e-12);
+
+	feats->dense_dot_range(
+	    out.vector, start, stop, alphas.vector, w.vector, num_dim, b);
+	for (index_t i = start; i < stop; i++)
+		EXPECT_NEAR(
+		    out[i - start], alphas[i - start] * feats->dot(i, w) + b, 1e-12);
+
+	// with a subset the vectors are read through a view
+	SGVector<index_t> subset(num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+		subset[i] = num_vectors - 1 - i;
+	feats->add_subset(subset);
+	feats->dense_dot_range(
+	    out.vector, start, stop, nullptr, w.vector, num_dim, b);
+	for (index_t i = start; i < stop; i++)
+		EXPECT_NEAR(out[i - start], feats->dot(i, w) + b, 1e-12);
+}
@@ -312,3 +312,69 @@ TEST(HashedDocDotFeaturesTest, quadratic_add_to_dense)
 
 	SG_FREE(hashes);
 }
+
+TEST(HashedDocDotFeaturesTest, cached_hashes)
+{
+	const index_t num_docs = 20;
+	const index_t doc_length = 50;
+	const int32_t hash_bits = 8;
+	const int32_t dimension = 1 << hash_bits;
+
+	std::mt19937_64 prng(12);
+	UniformIntDistribution<char> uniform_int_dist('A', 'E');
+	std::vector<SGVector<char>> list;
+	for (index_t i=0; i<num_docs; i++)
+	{
+		SGVector<char> doc(doc_length);
+		for (index_t j=0; j<doc_length; j++)
+			doc[j] = uniform_int_dist(prng);
+		list.push_back(doc);
+	}
+
+	auto doc_collection = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+	auto tokenizer = std::make_shared<NGramTokenizer>(2);
+	auto hddf = std::make_shared<HashedDocDotFeatures>(hash_bits, doc_collection,
+			tokenizer, true, 2, 1);
+	auto cached = std::make_shared<HashedDocDotFeatures>(hash_bits, doc_collection,
+			tokenizer, true, 2, 1);
+	cached->set_cache_hashes(true);
+	EXPECT_TRUE(cached->get_cache_hashes());
+	EXPECT_FALSE(hddf->get_cache_hashes());
+
+	SGVector<float64_t> w(dimension);
+	w.range_fill();
+
+	for (index_t i=0; i<num_docs; i++)
+	{
+		EXPECT_NEAR(cached->dot(i, w), hddf->dot(i, w), 1e-9);
+		EXPECT_NEAR(cached->dot(i, cached, (i+1) % num_docs),
+			hddf->dot(i, hddf, (i+1) % num_docs), 1e-9);
+
+		SGVector<float64_t> v1(dimension);
+		SGVector<float64_t> v2(dimension);
+		v1.zero();
+		v2.zero();
+		hddf->add_to_dense_vec(-0.5, i, v1.vector, dimension, true);
+		cached->add_to_dense_vec(-0.5, i, v2.vector, dimension, true);
+		for (index_t j=0; j<dimension; j++)
+			EXPECT_NEAR(v1[j], v2[j], 1e-12);
+	}
+
+	SGVector<float64_t> alphas(num_docs);
+	alphas.range_fill(1.0);
+	SGVector<float64_t> out1(num_docs-2);
+	SGVector<float64_t> out2(num_docs-2);
+	hddf->dense_dot_range(out1.vector, 2, num_docs, alphas.vector, w.vector,
+		dimension, 3.0);
+	cached->dense_dot_range(out2.vector, 2, num_docs, alphas.vector, w.vector,
+		dimension, 3.0);
+	for (index_t i=0; i<num_docs-2; i++)
+	{
+		EXPECT_NEAR(out2[i], alphas[i]*hddf->dot(i+2, w)+3.0, 1e-9);
+		EXPECT_NEAR(out1[i], out2[i], 1e-9);
+	}
+
+	cached->set_cache_hashes(false);
+	EXPECT_FALSE(cached->get_cache_hashes());
+	EXPECT_EQ(cached->dot(3, w), hddf->dot(3, w));
+}
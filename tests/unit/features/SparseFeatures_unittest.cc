@@ -412,3 +412,45 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 
 }
+
+TEST(SparseFeaturesTest, dense_dot_range)
+{
+	SGMatrix<float64_t> data(3, 5);
+	data.zero();
+	data(0, 0) = 1.5;
+	data(2, 0) = -2.0;
+	data(1, 1) = 3.0;
+	data(0, 3) = 0.5;
+	data(1, 3) = 1.0;
+	data(2, 3) = 4.0;
+	data(2, 4) = -1.0;
+
+	auto features = std::make_shared<SparseFeatures<float64_t>>(data);
+
+	SGVector<float64_t> w(3);
+	w[0] = 2.0;
+	w[1] = -1.0;
+	w[2] = 0.5;
+	SGVector<float64_t> alphas(5);
+	alphas.range_fill(1.0);
+
+	SGVector<float64_t> out(5);
+	features->dense_dot_range(out.vector, 0, 5, nullptr, w.vector, 3, 1.0);
+	for (index_t i = 0; i < 5; i++)
+		EXPECT_DOUBLE_EQ(out[i], features->dot(i, w) + 1.0);
+
+	features->dense_dot_range(out.vector, 1, 4, alphas.vector, w.vector, 3, 0.0);
+	for (index_t i = 1; i < 4; i++)
+		EXPECT_DOUBLE_EQ(out[i - 1], alphas[i - 1] * features->dot(i, w));
+
+	SGVector<index_t> subset_idx(3);
+	subset_idx[0] = 4;
+	subset_idx[1] = 0;
+	subset_idx[2] = 3;
+	features->add_subset(subset_idx);
+
+	features->dense_dot_range(out.vector, 0, 3, nullptr, w.vector, 3, 0.0);
+	EXPECT_DOUBLE_EQ(out[0], -0.5);
+	EXPECT_DOUBLE_EQ(out[1], 2.0);
+	EXPECT_DOUBLE_EQ(out[2], 2.0);
+}
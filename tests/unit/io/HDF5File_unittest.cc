@@ -0,0 +1,175 @@
+#include <shogun/lib/config.h>
+#include <gtest/gtest.h>
+
+#ifdef HAVE_HDF5
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/io/HDF5File.h>
+#include <shogun/io/streaming/StreamingHDF5File.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include "../utils/Utils.h"
+
+#include <cstdio>
+
+using namespace shogun;
+
+class HDF5FileTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		generate_temp_filename(fname);
+
+		data = SGMatrix<float64_t>(num_feat, num_vec);
+		for (index_t i = 0; i < num_feat * num_vec; i++)
+			data.matrix[i] = i % 7 + i / 100;
+	}
+
+	void TearDown()
+	{
+		std::remove(fname);
+	}
+
+	char fname[22] = "HDF5File_test.XXXXXX";
+	const index_t num_feat = 5;
+	const index_t num_vec = 1000;
+	SGMatrix<float64_t> data;
+};
+
+TEST_F(HDF5FileTest, write_read_vectors)
+{
+	auto fout = std::make_shared<HDF5File>(fname, 'w', "/vectors");
+	fout->write_vectors(data);
+	fout.reset();
+
+	auto fin = std::make_shared<HDF5File>(fname, 'r', "/vectors");
+	EXPECT_EQ(fin->get_num_vectors(), num_vec);
+	EXPECT_EQ(fin->get_num_features(), num_feat);
+	EXPECT_FALSE(fin->is_sparse());
+	EXPECT_TRUE(fin->read_vectors<float64_t>().equals(data));
+}
+
+TEST_F(HDF5FileTest, read_range_of_chunks)
+{
+	auto fout = std::make_shared<HDF5File>(fname, 'w', "/group/vectors");
+	fout->set_chunk_shape(64, 2);
+	fout->set_compression(HDF5_GZIP, 4);
+	fout->write_vectors(data);
+	fout.reset();
+
+	auto fin = std::make_shared<HDF5File>(fname, 'r', "/group/vectors");
+	EXPECT_TRUE(fin->read_vectors<float64_t>().equals(data));
+
+	for (auto range : {std::make_pair(10, 200), std::make_pair(63, 65),
+	                   std::make_pair(999, 1000), std::make_pair(500, 500)})
+	{
+		auto part = fin->read_vectors<float64_t>(range.first, range.second);
+		ASSERT_EQ(part.num_rows, num_feat);
+		ASSERT_EQ(part.num_cols, range.second - range.first);
+		for (index_t j = 0; j < part.num_cols; j++)
+			for (index_t i = 0; i < num_feat; i++)
+				EXPECT_EQ(part(i, j), data(i, j + range.first));
+	}
+
+	EXPECT_THROW(fin->read_vectors<float64_t>(5, num_vec + 1), ShogunException);
+}
+
+TEST_F(HDF5FileTest, dense_features_from_range)
+{
+	auto fout = std::make_shared<HDF5File>(fname, 'w', "/vectors");
+	fout->set_compression(HDF5_GZIP);
+	fout->write_vectors(data);
+	fout.reset();
+
+	auto fin = std::make_shared<HDF5File>(fname, 'r', "/vectors");
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(
+	    fin->read_vectors<float64_t>(100, 150));
+	EXPECT_EQ(feats->get_num_vectors(), 50);
+	auto vec = feats->get_feature_vector(3);
+	for (index_t i = 0; i < num_feat; i++)
+		EXPECT_EQ(vec[i], data(i, 103));
+}
+
+TEST_F(HDF5FileTest, write_read_sparse_vectors)
+{
+	SGSparseMatrix<float64_t> sparse(50, 30);
+	for (index_t i = 0; i < sparse.num_vectors; i++)
+	{
+		SGSparseVector<float64_t> vec(i % 4);
+		for (index_t j = 0; j < vec.num_feat_entries; j++)
+		{
+			vec.features[j].feat_index = j * 7 + i % 5;
+			vec.features[j].entry = i * 10 + j;
+		}
+		sparse[i] = vec;
+	}
+
+	auto fout = std::make_shared<HDF5File>(fname, 'w', "/sparse");
+	fout->set_compression(HDF5_GZIP);
+	fout->write_sparse_vectors(sparse);
+	fout.reset();
+
+	auto fin = std::make_shared<HDF5File>(fname, 'r', "/sparse");
+	EXPECT_TRUE(fin->is_sparse());
+	EXPECT_EQ(fin->get_num_vectors(), 30);
+	EXPECT_EQ(fin->get_num_features(), 50);
+
+	auto part = fin->read_sparse_vectors<float64_t>(5, 17);
+	ASSERT_EQ(part.num_vectors, 12);
+	EXPECT_EQ(part.num_features, 50);
+	for (index_t i = 0; i < part.num_vectors; i++)
+	{
+		ASSERT_EQ(
+		    part[i].num_feat_entries, sparse[i + 5].num_feat_entries);
+		for (index_t j = 0; j < part[i].num_feat_entries; j++)
+		{
+			EXPECT_EQ(
+			    part[i].features[j].feat_index,
+			    sparse[i + 5].features[j].feat_index);
+			EXPECT_EQ(
+			    part[i].features[j].entry, sparse[i + 5].features[j].entry);
+		}
+	}
+}
+
+TEST_F(HDF5FileTest, streaming_with_labels)
+{
+	SGVector<float64_t> labels(num_vec);
+	labels.range_fill();
+
+	auto fout = std::make_shared<HDF5File>(fname, 'w', "/vectors");
+	fout->set_chunk_shape(100);
+	fout->set_compression(HDF5_GZIP);
+	fout->write_vectors(data);
+	fout->set_variable_name("/labels");
+	fout->set_vector(labels.vector, labels.vlen);
+	fout.reset();
+
+	auto input = std::make_shared<StreamingHDF5File<float64_t>>(
+	    fname, "/vectors", "/labels", 128);
+	auto feats =
+	    std::make_shared<StreamingDenseFeatures<float64_t>>(input, true, 16);
+
+	index_t i = 0;
+	feats->start_parser();
+	while (feats->get_next_example())
+	{
+		auto example = feats->get_vector();
+		ASSERT_EQ(example.vlen, num_feat);
+		for (index_t j = 0; j < num_feat; j++)
+			EXPECT_EQ(example[j], data(j, i));
+		EXPECT_EQ(feats->get_label(), labels[i]);
+
+		feats->release_example();
+		i++;
+	}
+	feats->end_parser();
+	EXPECT_EQ(i, num_vec);
+}
+#else
+TEST(HDF5FileTest, DISABLED_write_read_vectors)
+{
+}
+#endif
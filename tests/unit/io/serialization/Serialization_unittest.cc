@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
 
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/serialization/BitserySerializer.h>
@@ -11,6 +14,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include "../../utils/Utils.h"
 
 using namespace shogun;
 using namespace shogun::io;
@@ -145,3 +149,116 @@ TYPED_TEST(SerializationTest, serialize)
 
 	ASSERT_TRUE(obj->equals(deser_obj));
 }
+
+#ifdef __linux__
+/** @return whether the memory lies in a mapping of the file */
+static bool is_file_mapping(const void* ptr, const string& fname)
+{
+	auto address = reinterpret_cast<uintptr_t>(ptr);
+	std::ifstream maps("/proc/self/maps");
+	string line;
+	while (std::getline(maps, line))
+	{
+		uintptr_t begin = 0, end = 0;
+		if (std::sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &begin, &end) != 2)
+			continue;
+		if (address >= begin && address < end)
+			return line.size() >= fname.size() &&
+				line.compare(line.size() - fname.size(), fname.size(), fname) == 0;
+	}
+	return false;
+}
+#endif
+
+class BitserySectionsTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		SGMatrix<float64_t> data(20, 100);
+		for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+			data.matrix[i] = i * 0.5;
+		auto df = std::make_shared<DenseFeatures<float64_t>>(data);
+		obj = std::make_shared<GaussianKernel>(df, df, 2.0);
+	}
+
+	string serialize(size_t threshold)
+	{
+		auto serializer = std::make_shared<BitserySerializer>();
+		serializer->set_section_threshold(threshold);
+		auto stream = std::make_shared<DummyOutputStream>();
+		serializer->attach(stream);
+		serializer->write(obj);
+		return stream->buffer();
+	}
+
+	std::shared_ptr<SGObject> deserialize(const string& buffer, bool verify = true)
+	{
+		auto deserializer = std::make_shared<BitseryDeserializer>();
+		deserializer->set_verify_checksums(verify);
+		deserializer->attach(std::make_shared<DummyInputStream>(buffer));
+		return deserializer->read_object();
+	}
+
+	std::shared_ptr<GaussianKernel> obj;
+};
+
+TEST_F(BitserySectionsTest, read_object)
+{
+	auto buffer = serialize(1024);
+	EXPECT_NE(buffer, serialize(0));
+	ASSERT_TRUE(obj->equals(deserialize(buffer)));
+}
+
+TEST_F(BitserySectionsTest, read_mapped)
+{
+	char fname[] = "Serialization_test.XXXXXX";
+	generate_temp_filename(fname);
+
+	for (auto threshold : {0, 1024})
+	{
+		auto buffer = serialize(threshold);
+		std::ofstream(fname, std::ios::binary).write(buffer.data(), buffer.size());
+
+		auto deserializer = std::make_shared<BitseryDeserializer>();
+		auto deser_obj = deserializer->read_mapped(fname);
+		ASSERT_TRUE(obj->equals(deser_obj));
+
+		auto features = deser_obj->as<GaussianKernel>()->get_lhs()
+			->as<DenseFeatures<float64_t>>();
+		auto matrix = features->get_feature_matrix();
+#ifdef __linux__
+		// sections are used in place, without sections the file is read
+		EXPECT_EQ(is_file_mapping(matrix.matrix, fname), threshold > 0);
+#endif
+
+		// the features stay valid after their vectors are modified
+		matrix(0, 0) = -1;
+		EXPECT_EQ(features->get_feature_matrix()(0, 0), -1);
+	}
+	std::remove(fname);
+}
+
+TEST_F(BitserySectionsTest, checksum_mismatch)
+{
+	auto buffer = serialize(1024);
+	buffer.back() ^= 1;
+	EXPECT_THROW(deserialize(buffer), ShogunException);
+	EXPECT_FALSE(obj->equals(deserialize(buffer, false)));
+}
+
+TEST_F(BitserySectionsTest, read_mapped_checksum_mismatch)
+{
+	char fname[] = "Serialization_test.XXXXXX";
+	generate_temp_filename(fname);
+
+	auto buffer = serialize(1024);
+	buffer.back() ^= 1;
+	std::ofstream(fname, std::ios::binary).write(buffer.data(), buffer.size());
+
+	// mapped loads only verify checksums on request
+	auto deserializer = std::make_shared<BitseryDeserializer>();
+	EXPECT_FALSE(obj->equals(deserializer->read_mapped(fname)));
+	EXPECT_THROW(deserializer->read_mapped(fname, true), ShogunException);
+	std::remove(fname);
+}
@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <shogun/lib/Allocator.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/memory.h>
+
+#include <cstdint>
+
+using namespace shogun;
+
+TEST(MemoryArena, allocate_aligned)
+{
+	MemoryArena arena(1024, 64);
+	for (size_t size : {1, 10, 100, 1000})
+	{
+		auto p = arena.allocate(size, 16);
+		ASSERT_NE(p, nullptr);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+		EXPECT_TRUE(arena.owns(p));
+		EXPECT_EQ(arena.get_size(p), size);
+	}
+	EXPECT_EQ(arena.get_bytes_used(), 1111u);
+
+	int32_t on_stack;
+	EXPECT_FALSE(arena.owns(&on_stack));
+}
+
+TEST(MemoryArena, reset_reuses_chunks)
+{
+	MemoryArena arena(1024);
+	auto first = arena.allocate(100, 16);
+	arena.allocate(5000, 16);
+	auto reserved = arena.get_bytes_reserved();
+
+	arena.reset();
+	EXPECT_EQ(arena.get_bytes_used(), 0u);
+	EXPECT_EQ(arena.allocate(100, 16), first);
+	arena.allocate(5000, 16);
+	EXPECT_EQ(arena.get_bytes_reserved(), reserved);
+}
+
+TEST(MemoryArena, reallocate_last_in_place)
+{
+	MemoryArena arena(1024);
+	auto p = static_cast<int32_t*>(arena.allocate(4 * sizeof(int32_t), 16));
+	for (int32_t i = 0; i < 4; i++)
+		p[i] = i;
+
+	EXPECT_EQ(arena.reallocate(p, 8 * sizeof(int32_t)), p);
+	EXPECT_EQ(arena.get_size(p), 8 * sizeof(int32_t));
+
+	arena.allocate(16, 16);
+	auto q = static_cast<int32_t*>(arena.reallocate(p, 16 * sizeof(int32_t)));
+	EXPECT_NE(q, p);
+	for (int32_t i = 0; i < 4; i++)
+		EXPECT_EQ(q[i], i);
+}
+
+TEST(PoolAllocator, reuse_freed_blocks)
+{
+	PoolAllocator pool;
+	auto p = pool.allocate(24, 16);
+	ASSERT_NE(p, nullptr);
+	EXPECT_TRUE(pool.owns(p));
+	EXPECT_EQ(pool.get_size(p), 32u);
+	EXPECT_EQ(pool.get_num_fresh(), 1);
+
+	pool.deallocate(p);
+	EXPECT_EQ(pool.allocate(20, 16), p);
+	EXPECT_EQ(pool.get_num_reused(), 1);
+
+	// blocks of another size class do not share memory
+	auto q = pool.allocate(100, 16);
+	EXPECT_NE(q, p);
+	EXPECT_EQ(pool.get_size(q), 128u);
+}
+
+TEST(PoolAllocator, decline_large_blocks)
+{
+	PoolAllocator pool;
+	EXPECT_EQ(pool.allocate(10000, 16), nullptr);
+	EXPECT_EQ(pool.allocate(16, 8192), nullptr);
+}
+
+TEST(ScopedAllocator, routes_sg_malloc)
+{
+	MemoryArena arena;
+	auto before = SG_MALLOC(float64_t, 10);
+	{
+		ScopedAllocator scope(arena);
+		EXPECT_EQ(ScopedAllocator::current(), &arena);
+
+		SGVector<float64_t> vec(10);
+		EXPECT_TRUE(arena.owns(vec.vector));
+		auto zeros = SG_CALLOC(int32_t, 10);
+		EXPECT_TRUE(arena.owns(zeros));
+		for (int32_t i = 0; i < 10; i++)
+			EXPECT_EQ(zeros[i], 0);
+		SG_FREE(zeros);
+
+		// memory from before the scope stays with the system allocator
+		EXPECT_EQ(ScopedAllocator::owner(before), nullptr);
+		before = SG_REALLOC(float64_t, before, 10, 20);
+		EXPECT_FALSE(arena.owns(before));
+	}
+	EXPECT_EQ(ScopedAllocator::current(), nullptr);
+	SG_FREE(before);
+
+	SGVector<float64_t> vec(10);
+	EXPECT_FALSE(arena.owns(vec.vector));
+}
+
+TEST(ScopedAllocator, nested_scopes)
+{
+	MemoryArena arena;
+	PoolAllocator pool;
+	ScopedAllocator outer(arena);
+	auto p = SG_MALLOC(uint8_t, 10);
+	{
+		ScopedAllocator inner(pool);
+		auto q = SG_MALLOC(uint8_t, 10);
+		EXPECT_TRUE(pool.owns(q));
+		EXPECT_EQ(ScopedAllocator::owner(p), &arena);
+		SG_FREE(p);
+		SG_FREE(q);
+	}
+	EXPECT_EQ(ScopedAllocator::current(), &arena);
+}
+
+TEST(ScopedAllocator, system_scope)
+{
+	MemoryArena arena;
+	ScopedAllocator scope(arena);
+	auto p = SG_MALLOC(uint8_t, 10);
+	{
+		ScopedAllocator system(nullptr);
+		EXPECT_EQ(ScopedAllocator::current(), nullptr);
+		auto q = SG_MALLOC(uint8_t, 10);
+		EXPECT_FALSE(arena.owns(q));
+		EXPECT_EQ(ScopedAllocator::owner(p), &arena);
+		SG_FREE(q);
+	}
+	EXPECT_EQ(ScopedAllocator::current(), &arena);
+	SG_FREE(p);
+}
+
+TEST(ScopedAllocator, resize_vector_keeps_owner)
+{
+	MemoryArena arena;
+	SGVector<float64_t> outside({1.0, 2.0, 3.0});
+	{
+		ScopedAllocator scope(arena);
+		SGVector<float64_t> inside({1.0, 2.0, 3.0});
+
+		// the vector from before the scope must not pick up arena memory
+		outside.resize_vector(100);
+		inside.resize_vector(100);
+		EXPECT_FALSE(arena.owns(outside.vector));
+		EXPECT_TRUE(arena.owns(inside.vector));
+		for (index_t i = 0; i < 3; i++)
+		{
+			EXPECT_EQ(outside[i], i + 1.0);
+			EXPECT_EQ(inside[i], i + 1.0);
+		}
+	}
+	arena.reset();
+	EXPECT_EQ(outside.vlen, 100);
+	EXPECT_EQ(outside[2], 3.0);
+	EXPECT_EQ(outside[99], 0.0);
+}
+
+TEST(ScopedAllocator, realloc_moves_to_system)
+{
+	PoolAllocator pool;
+	ScopedAllocator scope(pool);
+	auto p = SG_MALLOC(int32_t, 4);
+	for (int32_t i = 0; i < 4; i++)
+		p[i] = i;
+
+	p = SG_REALLOC(int32_t, p, 4, 10000);
+	EXPECT_FALSE(pool.owns(p));
+	for (int32_t i = 0; i < 4; i++)
+		EXPECT_EQ(p[i], i);
+	SG_FREE(p);
+}
+
+#ifdef HAVE_ALIGNED_MALLOC
+TEST(ScopedAllocator, aligned_malloc)
+{
+	MemoryArena arena;
+	ScopedAllocator scope(arena);
+	auto p = SG_ALIGNED_MALLOC(float64_t, 10, 64);
+	EXPECT_TRUE(arena.owns(p));
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+	SG_FREE(p);
+}
+#endif // HAVE_ALIGNED_MALLOC
+
+TEST(MemoryTest, allocation_statistics)
+{
+	reset_allocation_statistics();
+	set_allocation_statistics_enabled(true);
+	auto p = SG_MALLOC(uint8_t, 100);
+	p = SG_REALLOC(uint8_t, p, 100, 200);
+	SG_FREE(p);
+	set_allocation_statistics_enabled(false);
+
+	auto stats = get_allocation_statistics();
+	EXPECT_EQ(stats.num_allocations, 1);
+	EXPECT_EQ(stats.num_reallocations, 1);
+	EXPECT_EQ(stats.num_deallocations, 1);
+	EXPECT_EQ(stats.bytes_allocated, 300);
+
+	SG_FREE(SG_MALLOC(uint8_t, 100));
+	EXPECT_EQ(get_allocation_statistics().num_allocations, 1);
+	reset_allocation_statistics();
+	EXPECT_EQ(get_allocation_statistics().num_allocations, 0);
+}
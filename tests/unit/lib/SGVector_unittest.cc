@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <shogun/base/range.h>
+#include <shogun/lib/RefCount.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/Math.h>
@@ -489,3 +490,57 @@ TEST(SGVectorTest, slice)
 			EXPECT_EQ(vec[i], sliced_vec2[i - l - l2]);
 	}
 }
+
+TEST(SGVectorTest, resize_vector_shared)
+{
+	SGVector<index_t> a({0, 1, 2});
+	SGVector<index_t> b(a);
+	EXPECT_EQ(a.ref_count(), 2);
+
+	a.resize_vector(5);
+	EXPECT_EQ(a.ref_count(), 1);
+	EXPECT_EQ(b.ref_count(), 1);
+	EXPECT_EQ(b.vlen, 3);
+	for (index_t i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(a[i], i);
+		EXPECT_EQ(b[i], i);
+	}
+	EXPECT_EQ(a[3], 0);
+	EXPECT_EQ(a[4], 0);
+}
+
+TEST(SGVectorTest, matrix_outlives_vector)
+{
+	SGMatrix<float64_t> m;
+	{
+		SGVector<float64_t> v(6);
+		for (index_t i = 0; i < v.vlen; i++)
+			v[i] = i;
+		m = SGMatrix<float64_t>(v, 2, 3);
+		EXPECT_EQ(v.ref_count(), 2);
+	}
+	EXPECT_EQ(m.ref_count(), 1);
+	for (index_t i = 0; i < 6; i++)
+		EXPECT_EQ(m.matrix[i], i);
+}
+
+TEST(SGVectorTest, single_threaded_refcount)
+{
+	SGVector<float64_t> a(3);
+	{
+		SingleThreadedRefCountScope scope;
+		SGVector<float64_t> b(a);
+		EXPECT_EQ(a.ref_count(), 2);
+		{
+			auto c = b;
+			EXPECT_EQ(a.ref_count(), 3);
+		}
+		EXPECT_EQ(a.ref_count(), 2);
+	}
+	EXPECT_EQ(a.ref_count(), 1);
+
+	auto cloned = a.clone();
+	EXPECT_EQ(cloned.ref_count(), 1);
+	EXPECT_NE(cloned.vector, a.vector);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <shogun/lib/Trace.h>
+
+#include <thread>
+
+using namespace shogun;
+
+namespace
+{
+	void traced_work(int64_t num_inner)
+	{
+		SG_TRACE_NAMED_SCOPE(trace, "outer");
+		for (int64_t i = 0; i < num_inner; i++)
+		{
+			SG_TRACE_SCOPE("inner");
+		}
+		trace.set_counter(num_inner);
+	}
+} // namespace
+
+TEST(Trace, disabled_records_nothing)
+{
+	Trace::enable();
+	Trace::disable();
+	traced_work(10);
+	Trace::counter("counter", 1);
+	EXPECT_TRUE(Trace::collect().empty());
+}
+
+TEST(Trace, record_and_summary)
+{
+	Trace::enable();
+	Trace::record(TRACE_BEGIN, "outer");
+	Trace::record(TRACE_BEGIN, "inner");
+	Trace::record(TRACE_END, "inner");
+	Trace::record(TRACE_END, "outer", 5);
+	Trace::counter("bytes", 100);
+	Trace::counter("bytes", 20);
+	Trace::disable();
+
+	auto events = Trace::collect();
+	ASSERT_EQ(events.size(), 6u);
+	for (size_t i = 1; i < events.size(); i++)
+		EXPECT_GE(events[i].timestamp, events[i - 1].timestamp);
+
+	auto summary = Trace::summary(events);
+	EXPECT_EQ(summary["outer"].calls, 1);
+	EXPECT_EQ(summary["outer"].counter, 5);
+	EXPECT_GE(summary["outer"].total_ns, summary["inner"].total_ns);
+	EXPECT_EQ(summary["inner"].durations.size(), 1u);
+	EXPECT_EQ(summary["bytes"].calls, 2);
+	EXPECT_EQ(summary["bytes"].counter, 120);
+	EXPECT_TRUE(summary["bytes"].durations.empty());
+
+	auto json = Trace::to_chrome_json(events);
+	EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"B\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"C\""), std::string::npos);
+}
+
+TEST(Trace, full_buffer_keeps_latest_events)
+{
+	Trace::enable(16);
+	for (int32_t i = 0; i < 100; i++)
+		Trace::record(TRACE_COUNTER, "counter", i);
+	Trace::disable();
+
+	auto events = Trace::collect();
+	ASSERT_EQ(events.size(), 16u);
+	EXPECT_EQ(events.front().counter, 84);
+	EXPECT_EQ(events.back().counter, 99);
+	EXPECT_EQ(Trace::get_num_dropped(), 84);
+
+	// a new trace starts empty
+	Trace::enable();
+	EXPECT_TRUE(Trace::collect().empty());
+	Trace::disable();
+}
+
+#ifdef USE_TRACING
+TEST(Trace, scopes_of_threads)
+{
+	Trace::enable();
+	traced_work(3);
+	std::thread([]() { traced_work(7); }).join();
+	Trace::disable();
+
+	auto events = Trace::collect();
+	auto summary = Trace::summary(events);
+	EXPECT_EQ(summary["outer"].calls, 2);
+	EXPECT_EQ(summary["outer"].counter, 10);
+	EXPECT_EQ(summary["inner"].calls, 10);
+
+	EXPECT_EQ(events.front().thread, 0);
+	EXPECT_EQ(events.back().thread, 1);
+}
+#endif // USE_TRACING
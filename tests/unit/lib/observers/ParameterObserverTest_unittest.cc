@@ -42,6 +42,14 @@ public:
 		observe<int32_t>(1, "b", 1, p2);
 		observe<int32_t>(1, "None", 1, p3);
 	}
+
+	void emit_steps(int64_t num_steps)
+	{
+		AnyParameterProperties p(
+		    "Name of the observed value", ParameterProperties::READONLY);
+		for (int64_t step = 0; step < num_steps; step++)
+			observe<int64_t>(step, "a", step, p);
+	}
 };
 
 class ParameterObserverTest : public ::testing::Test
@@ -140,4 +148,63 @@ TEST_F(ParameterObserverTest, filter_all_property)
 
 	EXPECT_EQ(observer->get<int32_t>("num_observations"), 4);
 	emitter.unsubscribe(observer);
-}
\ No newline at end of file
+}
+
+TEST_F(ParameterObserverTest, step_interval)
+{
+	auto observer = std::make_shared<ParameterObserverLogger>(test_params);
+	observer->put("step_interval", (int64_t)3);
+	emitter.subscribe(observer);
+	emitter.emit_steps(10);
+
+	ASSERT_EQ(observer->get<int32_t>("num_observations"), 4);
+	for (index_t i = 0; i < 4; i++)
+		EXPECT_EQ(observer->get_observation(i)->get<int64_t>("step"), i * 3);
+	emitter.unsubscribe(observer);
+}
+
+TEST_F(ParameterObserverTest, time_interval)
+{
+	auto observer = std::make_shared<ParameterObserverLogger>(test_params);
+	observer->put("time_interval", (int64_t)3600000);
+	emitter.subscribe(observer);
+	emitter.emit_steps(10);
+
+	ASSERT_EQ(observer->get<int32_t>("num_observations"), 1);
+	EXPECT_EQ(observer->get_observation(0)->get<int64_t>("step"), 0);
+	emitter.unsubscribe(observer);
+}
+
+TEST_F(ParameterObserverTest, asynchronous)
+{
+	auto observer = std::make_shared<ParameterObserverLogger>();
+	observer->set_asynchronous();
+	EXPECT_TRUE(observer->is_asynchronous());
+	emitter.subscribe(observer);
+	emitter.emit_value();
+	observer->flush();
+	EXPECT_EQ(observer->get<int32_t>("num_observations"), 4);
+	EXPECT_EQ(observer->get<int64_t>("num_dropped"), 0);
+
+	observer->set_asynchronous(0);
+	EXPECT_FALSE(observer->is_asynchronous());
+	emitter.emit_value();
+	EXPECT_EQ(observer->get<int32_t>("num_observations"), 8);
+	emitter.unsubscribe(observer);
+}
+
+TEST_F(ParameterObserverTest, asynchronous_drops_when_full)
+{
+	auto observer = std::make_shared<ParameterObserverLogger>(test_params);
+	observer->set_asynchronous(2);
+	emitter.subscribe(observer);
+	emitter.emit_steps(1000);
+	observer->flush();
+
+	// emitting never waits for the queue, values that do not fit are lost
+	EXPECT_EQ(
+	    observer->get<int32_t>("num_observations") +
+	        observer->get<int64_t>("num_dropped"),
+	    1000);
+	emitter.unsubscribe(observer);
+}
@@ -0,0 +1,118 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/StreamingStatistics.h>
+
+#include <random>
+
+using namespace shogun;
+
+static SGMatrix<float64_t> random_data(index_t num_features, index_t num_vectors)
+{
+	std::mt19937_64 prng(3);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		for (index_t j = 0; j < num_features; j++)
+			data(j, i) = 100.0 * j + (j + 1) * normal_dist(prng);
+	}
+	return data;
+}
+
+static void expect_matches_data(
+    std::shared_ptr<StreamingStatistics> stats, const SGMatrix<float64_t>& data)
+{
+	const index_t d = data.num_rows;
+	const index_t n = data.num_cols;
+	ASSERT_EQ(stats->get_num_examples(), n);
+	ASSERT_EQ(stats->get_num_features(), d);
+
+	SGVector<float64_t> mean(d);
+	mean.zero();
+	for (index_t i = 0; i < n; i++)
+		for (index_t j = 0; j < d; j++)
+			mean[j] += data(j, i) / n;
+
+	auto result_mean = stats->get_mean();
+	auto result_var = stats->get_variance(true);
+	auto result_min = stats->get_min();
+	auto result_max = stats->get_max();
+	for (index_t j = 0; j < d; j++)
+	{
+		float64_t var = 0, min = data(j, 0), max = data(j, 0);
+		for (index_t i = 0; i < n; i++)
+		{
+			var += (data(j, i) - mean[j]) * (data(j, i) - mean[j]);
+			min = std::min(min, data(j, i));
+			max = std::max(max, data(j, i));
+		}
+		var /= n - 1;
+
+		EXPECT_NEAR(result_mean[j], mean[j], 1e-10);
+		EXPECT_NEAR(result_var[j], var, 1e-10 * var);
+		EXPECT_EQ(result_min[j], min);
+		EXPECT_EQ(result_max[j], max);
+	}
+
+	if (!stats->get_compute_cov())
+		return;
+
+	auto result_cov = stats->get_cov();
+	for (index_t k = 0; k < d; k++)
+	{
+		for (index_t j = 0; j < d; j++)
+		{
+			float64_t cov = 0;
+			for (index_t i = 0; i < n; i++)
+				cov += (data(j, i) - mean[j]) * (data(k, i) - mean[k]);
+			cov /= n;
+			EXPECT_NEAR(result_cov(j, k), cov, 1e-9);
+		}
+	}
+}
+
+TEST(StreamingStatistics, single_batch)
+{
+	auto data = random_data(5, 1000);
+	auto stats = std::make_shared<StreamingStatistics>(true);
+	stats->update(data);
+	expect_matches_data(stats, data);
+}
+
+TEST(StreamingStatistics, batches_and_merge)
+{
+	auto data = random_data(4, 700);
+
+	auto first = std::make_shared<StreamingStatistics>(true);
+	auto second = std::make_shared<StreamingStatistics>(true);
+	for (index_t begin = 0; begin < data.num_cols; begin += 100)
+	{
+		auto target = begin < 300 ? first : second;
+		target->update(
+		    SGMatrix<float64_t>(
+		        data.get_column_vector(begin), data.num_rows, 100, false));
+	}
+	first->merge(second);
+	expect_matches_data(first, data);
+
+	first->reset();
+	EXPECT_EQ(first->get_num_examples(), 0);
+}
+
+TEST(StreamingStatistics, streaming_features)
+{
+	auto data = random_data(3, 250);
+	auto stream = std::make_shared<StreamingDenseFeatures<float64_t>>(
+	    std::make_shared<DenseFeatures<float64_t>>(data));
+
+	auto stats = std::make_shared<StreamingStatistics>();
+	stats->update(stream, 64);
+	expect_matches_data(stats, data);
+	EXPECT_THROW(stats->get_cov(), ShogunException);
+}
@@ -0,0 +1,100 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/RandomizedDecompositions.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* matrix of the given rank with singular values rank, rank-1, ..., 1 */
+static SGMatrix<float64_t>
+low_rank_matrix(index_t num_rows, index_t num_cols, index_t rank, bool symmetric)
+{
+	std::mt19937_64 prng(7);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> left(num_rows, rank);
+	for (index_t i=0; i<num_rows*rank; i++)
+		left.matrix[i]=normal_dist(prng);
+	SGMatrix<float64_t> right=left;
+	if (!symmetric)
+	{
+		right=SGMatrix<float64_t>(num_cols, rank);
+		for (index_t i=0; i<num_cols*rank; i++)
+			right.matrix[i]=normal_dist(prng);
+	}
+
+	SGVector<float64_t> s(rank);
+	SGMatrix<float64_t> Q_left(num_rows, rank);
+	linalg::svd(left, s, Q_left);
+	SGMatrix<float64_t> Q_right(num_cols, rank);
+	linalg::svd(right, s, Q_right);
+
+	for (index_t j=0; j<rank; j++)
+	{
+		for (index_t i=0; i<num_rows; i++)
+			Q_left(i,j)*=rank-j;
+	}
+	return linalg::matrix_prod(Q_left, Q_right, false, true);
+}
+
+TEST(RandomizedDecompositions, svd_low_rank)
+{
+	const index_t k=3;
+	auto A=low_rank_matrix(60, 40, 5, false);
+
+	std::mt19937_64 prng(11);
+	SGVector<float64_t> s(k);
+	SGMatrix<float64_t> U(A.num_rows, k);
+	SGMatrix<float64_t> V(A.num_cols, k);
+	linalg::randomized_svd(A, s, U, V, prng);
+
+	for (index_t j=0; j<k; j++)
+		EXPECT_NEAR(s[j], 5-j, 1e-10);
+
+	/* U^T A V recovers the singular values */
+	auto UtAV=linalg::matrix_prod(
+		linalg::matrix_prod(U, A, true, false), V);
+	for (index_t i=0; i<k; i++)
+	{
+		for (index_t j=0; j<k; j++)
+			EXPECT_NEAR(UtAV(i,j), i==j ? s[i] : 0.0, 1e-10);
+	}
+
+	/* right singular vectors are optional */
+	SGMatrix<float64_t> no_V;
+	SGVector<float64_t> s2(k);
+	SGMatrix<float64_t> U2(A.num_rows, k);
+	linalg::randomized_svd(A, s2, U2, no_V, prng);
+	for (index_t j=0; j<k; j++)
+		EXPECT_NEAR(s2[j], s[j], 1e-10);
+}
+
+TEST(RandomizedDecompositions, eigen_solver_symmetric_matches_exact)
+{
+	const index_t k=4;
+	auto A=low_rank_matrix(50, 50, 6, true);
+
+	SGVector<float64_t> exact_values(k);
+	SGMatrix<float64_t> exact_vectors(A.num_rows, k);
+	linalg::eigen_solver_symmetric(A, exact_values, exact_vectors, k);
+
+	std::mt19937_64 prng(11);
+	SGVector<float64_t> values(k);
+	SGMatrix<float64_t> vectors(A.num_rows, k);
+	linalg::randomized_eigen_solver_symmetric(A, values, vectors, prng);
+
+	for (index_t j=0; j<k; j++)
+	{
+		EXPECT_NEAR(values[j], exact_values[j], 1e-10);
+		auto sign=linalg::dot(vectors.get_column(j), exact_vectors.get_column(j));
+		EXPECT_NEAR(std::abs(sign), 1.0, 1e-8);
+	}
+}
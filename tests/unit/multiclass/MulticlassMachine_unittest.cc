@@ -0,0 +1,166 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/AveragedPerceptron.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/lib/exception/ShogunException.h>
+#include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+#include <random>
+
+using namespace shogun;
+
+class MulticlassMachineTest : public ::testing::Test
+{
+protected:
+	void SetUp()
+	{
+		const index_t num_vec = 60;
+		const index_t num_class = 4;
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> normal_dist;
+
+		SGMatrix<float64_t> matrix(num_class, num_vec);
+		labels = std::make_shared<MulticlassLabels>(num_vec);
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			index_t label = i % num_class;
+			for (index_t j = 0; j < num_class; ++j)
+				matrix(j, i) = normal_dist(prng);
+			matrix(label, i) += 10;
+			labels->set_label(i, label);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+		num_threads = env()->get_num_threads();
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(num_threads);
+	}
+
+	std::shared_ptr<LinearMulticlassMachine>
+	train_linear(std::shared_ptr<MulticlassStrategy> strategy, int32_t threads)
+	{
+		env()->set_num_threads(threads);
+		auto machine = std::make_shared<LinearMulticlassMachine>(
+		    strategy, features, std::make_shared<AveragedPerceptron>(),
+		    labels);
+		machine->train();
+		return machine;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<MulticlassLabels> labels;
+	int32_t num_threads;
+};
+
+/* perceptron whose training fails */
+class FailingPerceptron : public AveragedPerceptron
+{
+public:
+	virtual const char* get_name() const
+	{
+		return "FailingPerceptron";
+	}
+
+	virtual std::shared_ptr<SGObject> create_empty() const
+	{
+		return std::make_shared<FailingPerceptron>();
+	}
+
+protected:
+	virtual void init_model(std::shared_ptr<Features> data)
+	{
+		error("Training of submachine failed");
+	}
+};
+
+static void expect_fused_outputs_equal(std::shared_ptr<MulticlassMachine> machine)
+{
+	auto outputs = machine->get_submachines_outputs();
+	ASSERT_EQ(
+	    (int32_t)outputs.size(),
+	    machine->get_multiclass_strategy()->get_num_machines());
+	for (int32_t i = 0; i < (int32_t)outputs.size(); ++i)
+	{
+		auto expected = machine->get_submachine_outputs(i);
+		ASSERT_EQ(outputs[i]->get_num_labels(), expected->get_num_labels());
+		for (int32_t j = 0; j < expected->get_num_labels(); ++j)
+			EXPECT_NEAR(outputs[i]->get_value(j), expected->get_value(j), 1e-10);
+	}
+}
+
+TEST_F(MulticlassMachineTest, linear_parallel_training_matches_sequential)
+{
+	std::vector<std::shared_ptr<MulticlassStrategy>> strategies = {
+	    std::make_shared<MulticlassOneVsRestStrategy>(),
+	    std::make_shared<MulticlassOneVsOneStrategy>()};
+	for (auto strategy : strategies)
+	{
+		auto sequential = train_linear(strategy, 1);
+		auto parallel = train_linear(strategy, 4);
+
+		ASSERT_EQ(
+		    sequential->get_multiclass_strategy()->get_num_machines(),
+		    parallel->get_multiclass_strategy()->get_num_machines());
+		for (int32_t i = 0;
+		     i < sequential->get_multiclass_strategy()->get_num_machines();
+		     ++i)
+		{
+			auto w = sequential->get_machine(i)->as<LinearMachine>()->get_w();
+			auto w_parallel =
+			    parallel->get_machine(i)->as<LinearMachine>()->get_w();
+			ASSERT_EQ(w.vlen, w_parallel.vlen);
+			for (index_t j = 0; j < w.vlen; ++j)
+				EXPECT_NEAR(w[j], w_parallel[j], 1e-12);
+		}
+
+		auto predicted = parallel->apply_multiclass(features);
+		for (index_t i = 0; i < labels->get_num_labels(); ++i)
+			EXPECT_EQ(predicted->get_label(i), labels->get_label(i));
+	}
+}
+
+TEST_F(MulticlassMachineTest, parallel_training_rethrows)
+{
+	env()->set_num_threads(4);
+	auto machine = std::make_shared<LinearMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), features,
+	    std::make_shared<FailingPerceptron>(), labels);
+	EXPECT_THROW(machine->train(), ShogunException);
+	EXPECT_EQ(machine->get_num_machines(), 0);
+}
+
+TEST_F(MulticlassMachineTest, linear_fused_outputs)
+{
+	auto machine = train_linear(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), 4);
+	machine->apply_multiclass(features);
+	expect_fused_outputs_equal(machine);
+}
+
+TEST_F(MulticlassMachineTest, kernel_fused_outputs)
+{
+	auto kernel = std::make_shared<GaussianKernel>(10, 2.0);
+	kernel->init(features, features);
+	auto machine = std::make_shared<KernelMulticlassMachine>(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), kernel,
+	    std::make_shared<LibSVM>(), labels);
+	machine->train();
+
+	auto predicted = machine->apply_multiclass(features);
+	for (index_t i = 0; i < labels->get_num_labels(); ++i)
+		EXPECT_EQ(predicted->get_label(i), labels->get_label(i));
+
+	expect_fused_outputs_equal(machine);
+}
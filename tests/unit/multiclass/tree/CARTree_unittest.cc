@@ -457,6 +457,43 @@ TEST(CARTree, handle_missing_nominal)
 	EXPECT_EQ(3.0,right->data.total_weight);
 }
 
+TEST(CARTree, classify_nominal_many_categories)
+{
+	// a single nominal attribute with more categories than attributes, so
+	// that the categories sent to each child do not fit in vectors of the
+	// number of attributes
+	int32_t num_categories=8;
+	int32_t num_vecs=2*num_categories;
+	SGMatrix<float64_t> data(1,num_vecs);
+	SGVector<float64_t> lab(num_vecs);
+	for (int32_t i=0;i<num_vecs;i++)
+	{
+		data(0,i)=i%num_categories+1;
+		lab[i]=(int32_t(data(0,i))%3==0) ? 1.0 : 0.0;
+	}
+
+	SGVector<bool> ft=SGVector<bool>(1);
+	ft[0]=true;
+
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels=std::make_shared<MulticlassLabels>(lab);
+
+	auto c=std::make_shared<CARTree>();
+	c->set_labels(labels);
+	c->set_feature_types(ft);
+	c->train(feats);
+
+	auto root=c->get_root()->as<BinaryTreeMachineNode<CARTreeNodeData>>();
+	EXPECT_EQ(num_categories,
+		root->left()->data.transit_into_values.vlen+
+		root->right()->data.transit_into_values.vlen);
+
+	auto result=c->apply(feats)->as<MulticlassLabels>();
+	SGVector<float64_t> res_vector=result->get_labels();
+	for (int32_t i=0;i<num_vecs;i++)
+		EXPECT_EQ(lab[i],res_vector[i]);
+}
+
 TEST(CARTree, handle_missing_continuous)
 {
 	SGMatrix<float64_t> data(3,9);
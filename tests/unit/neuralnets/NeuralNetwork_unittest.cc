@@ -146,6 +146,49 @@ TEST(NeuralNetwork, backpropagation_logistic)
 
 }
 
+/** Tests gradients computed using backpropagation with single precision
+ * products against gradients computed by numerical approximation and against
+ * the double precision path. Uses a NeuralLogisticLayer-based network.
+ */
+TEST(NeuralNetwork, backpropagation_single_precision)
+{
+	int32_t seed = 10;
+	float64_t tolerance = 1e-4;
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(std::make_shared<NeuralInputLayer>(5));
+	layers.push_back(std::make_shared<NeuralInputLayer>(7));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(3));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(6));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(5));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(4));
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", seed);
+
+	network->connect(0,2);
+	network->connect(1,2);
+	network->connect(2,3);
+	network->connect(2,4);
+	network->connect(3,5);
+	network->connect(4,5);
+
+	network->initialize_neural_network();
+	network->set_l1_coefficient(0.03);
+	network->set_l2_coefficient(0.01);
+
+	// the step of the numerical approximation has to be well above the
+	// float32 rounding error of the outputs
+	network->set_single_precision(true);
+	float64_t single_error = network->check_gradients(1e-2, 1e-3);
+
+	network->put("seed", seed);
+	network->set_single_precision(false);
+	float64_t double_error = network->check_gradients(1e-2, 1e-3);
+
+	EXPECT_NEAR(single_error, 0.0, tolerance);
+	EXPECT_NEAR(single_error, double_error, tolerance);
+}
+
 /** Tests gradients computed using backpropagation against gradients computed
  * by numerical approximation. Uses a NeuralSoftmaxLayer-based network.
  */
@@ -156,6 +156,38 @@ TEST(RBM, free_energy_gradients)
 		EXPECT_NEAR(gradients_numerical[i], gradients[i], 1e-6);
 }
 
+TEST(RBM, free_energy_gradients_single_precision)
+{
+	int32_t seed = 100;
+	int32_t num_visible = 15;
+	int32_t num_hidden = 6;
+	int32_t batch_size = 3;
+
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
+
+	RBM rbm(num_hidden);
+	rbm.put("seed", seed);
+	rbm.add_visible_group(4, RBMVUT_BINARY);
+	rbm.add_visible_group(6, RBMVUT_GAUSSIAN);
+	rbm.add_visible_group(5, RBMVUT_BINARY);
+	rbm.initialize_neural_network();
+
+	SGMatrix<float64_t> V(num_visible, batch_size);
+	for (int32_t i=0; i<V.num_rows*V.num_cols; i++)
+		V[i] = uniform_real_dist(prng) < 0.7;
+
+	SGVector<float64_t> gradients(rbm.get_num_parameters());
+	rbm.free_energy_gradients(V, gradients);
+
+	SGVector<float64_t> gradients_single(rbm.get_num_parameters());
+	rbm.single_precision = true;
+	rbm.free_energy_gradients(V, gradients_single);
+
+	for (int32_t i=0; i<gradients.vlen; i++)
+		EXPECT_NEAR(gradients[i], gradients_single[i], 1e-6);
+}
+
 TEST(RBM, pseudo_likelihood_binary)
 {
 	int32_t seed = 20;
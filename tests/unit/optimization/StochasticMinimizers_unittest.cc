@@ -49,6 +49,11 @@
 #include <shogun/optimization/ElasticNetPenalty.h>
 #include <shogun/optimization/SMIDASMinimizer.h>
 #include <shogun/optimization/PNormMappingFunction.h>
+#include <shogun/optimization/MarginLossCostFunction.h>
+#include <shogun/optimization/AdaGradUpdater.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/loss/LogLoss.h>
 using namespace shogun;
 using namespace Eigen;
 
@@ -208,6 +213,11 @@ SGVector<float64_t> RegressionForTestCostFunction::obtain_variable_reference()
 }
 
 SGVector<float64_t> RegressionForTestCostFunction::get_gradient()
+{
+	return get_sample_gradient(m_idx);
+}
+
+SGVector<float64_t> RegressionForTestCostFunction::get_sample_gradient(index_t idx)
 {
 	require(m_obj,"object not set");
 	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> parameters;
@@ -218,7 +228,7 @@ SGVector<float64_t> RegressionForTestCostFunction::get_gradient()
 	for(const auto& param: parameters)
 	{
 		if(param.second==m_obj)
-			grad=m_obj->get_gradient(param.first, m_idx);
+			grad=m_obj->get_gradient(param.first, idx);
 	}
 
 	return grad;
@@ -473,6 +483,159 @@ TEST(SGDMinimizer,test1)
 	EXPECT_NEAR(cost,0.491198269864709, 1e-10);
 }
 
+TEST(SGDMinimizer,mini_batch_of_one_matches_sequential)
+{
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+
+	RegressionFixture data;
+	auto aa=std::make_shared<CRegressionExample>();
+
+	aa->set_x(data.x);
+	aa->set_y(data.y);
+	aa->set_init_w(w);
+	auto fun=std::make_shared<RegressionForTestCostFunction>();
+	fun->set_target(aa);
+
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.01);
+
+	auto updater=std::make_shared<GradientDescendUpdater>();
+	opt->set_gradient_updater(updater);
+	opt->set_learning_rate(rate);
+	opt->set_parallel_mode(SPM_MINI_BATCH);
+	opt->set_mini_batch_size(1);
+	EXPECT_TRUE(opt->supports_batch_update());
+
+	int32_t num_passes=20;
+	opt->set_number_passes(num_passes);
+
+	float64_t cost=opt->minimize()/data.y.vlen;
+
+	//same updates in the same order as SGDMinimizer.test1
+	EXPECT_NEAR(cost,0.491198269864709, 1e-10);
+}
+
+TEST(SGDMinimizer,mini_batch)
+{
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+
+	RegressionFixture data;
+	auto aa=std::make_shared<CRegressionExample>();
+
+	aa->set_x(data.x);
+	aa->set_y(data.y);
+	aa->set_init_w(w);
+	auto fun=std::make_shared<RegressionForTestCostFunction>();
+	fun->set_target(aa);
+
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.005);
+
+	auto updater=std::make_shared<GradientDescendUpdater>();
+	opt->set_gradient_updater(updater);
+	opt->set_learning_rate(rate);
+	opt->set_parallel_mode(SPM_MINI_BATCH);
+	opt->set_mini_batch_size(5);
+
+	int32_t num_passes=500;
+	opt->set_number_passes(num_passes);
+
+	float64_t cost=opt->minimize()/data.y.vlen;
+
+	//the least squares optimum is 0.161618924085484
+	EXPECT_NEAR(cost,0.161618924085484, 1e-2);
+}
+
+TEST(SGDMinimizer,hogwild)
+{
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+
+	RegressionFixture data;
+	auto aa=std::make_shared<CRegressionExample>();
+
+	aa->set_x(data.x);
+	aa->set_y(data.y);
+	aa->set_init_w(w);
+	auto fun=std::make_shared<RegressionForTestCostFunction>();
+	fun->set_target(aa);
+
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.001);
+
+	auto updater=std::make_shared<GradientDescendUpdater>();
+	opt->set_gradient_updater(updater);
+	opt->set_learning_rate(rate);
+	opt->set_parallel_mode(SPM_HOGWILD);
+
+	int32_t num_passes=100;
+	opt->set_number_passes(num_passes);
+
+	float64_t cost=opt->minimize()/data.y.vlen;
+
+	//the order of the updates depends on the scheduling of the threads,
+	//the least squares optimum is 0.161618924085484
+	EXPECT_NEAR(cost,0.161618924085484, 1e-2);
+	EXPECT_EQ(opt->get_iteration_counter(), num_passes*data.y.vlen);
+}
+
+TEST(SGDMinimizer,hogwild_sparse_gradient)
+{
+	//every sample has two of the eight features, the label is the sign of
+	//the first one of them
+	const index_t num_features=8;
+	const index_t num_vectors=64;
+	SGMatrix<float64_t> x(num_features, num_vectors);
+	SGVector<float64_t> y(num_vectors);
+	x.zero();
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		float64_t sign=(i%2==0) ? 1.0 : -1.0;
+		x(i%num_features, i)=sign*(1.0+0.1*(i%5));
+		x((i+3)%num_features, i)=0.5-0.1*(i%3);
+		y[i]=sign;
+	}
+	auto features=std::make_shared<SparseFeatures<float64_t>>(x);
+	auto labels=std::make_shared<BinaryLabels>(y);
+
+	SGVector<float64_t> costs(2);
+	for (index_t mode=0; mode<2; mode++)
+	{
+		auto fun=std::make_shared<MarginLossCostFunction>(
+			features, labels, std::make_shared<LogLoss>());
+		EXPECT_TRUE(fun->supports_sparse_sample_gradient());
+		float64_t init_cost=fun->get_cost();
+
+		auto opt=std::make_shared<SGDMinimizer>(fun);
+		auto rate=std::make_shared<ConstLearningRate>();
+		rate->set_const_learning_rate(0.1);
+		opt->set_gradient_updater(std::make_shared<AdaGradUpdater>());
+		opt->set_learning_rate(rate);
+		if (mode==1)
+			opt->set_parallel_mode(SPM_HOGWILD);
+		opt->set_number_passes(50);
+
+		costs[mode]=opt->minimize();
+		EXPECT_LT(costs[mode], 0.1*init_cost);
+
+		//the weights only change through the sparse gradients
+		SGVector<float64_t> w=fun->obtain_variable_reference();
+		for (index_t i=0; i<num_vectors; i++)
+			EXPECT_GT(y[i]*features->dot(i, w), 0.0);
+	}
+
+	//the order of the updates depends on the scheduling of the threads
+	EXPECT_NEAR(costs[1], costs[0], 0.5*costs[0]);
+}
+
 TEST(SGDMinimizer,test2)
 {
 	SGVector<float64_t> w(3);
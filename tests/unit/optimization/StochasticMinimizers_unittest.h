@@ -51,6 +51,8 @@ public:
 	virtual SGVector<float64_t> get_gradient();
 	virtual SGVector<float64_t> get_average_gradient();
 	virtual int32_t get_sample_size();
+	virtual bool supports_sample_gradient() const { return true; }
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx);
 	virtual void begin_sample();
 	virtual bool next_sample();
 	virtual const char* get_name() const { return "RegressionForTestCostFunction"; }
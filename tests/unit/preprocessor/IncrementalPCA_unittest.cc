@@ -0,0 +1,125 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/preprocessor/IncrementalPCA.h>
+#include <shogun/preprocessor/PCA.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* data spread mostly along a few directions, with a non-zero mean */
+static SGMatrix<float64_t> low_rank_data(index_t num_features, index_t num_vectors)
+{
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		for (index_t j = 0; j < num_features; j++)
+			data(j, i) = 1.0 + j +
+			             normal_dist(prng) * (j < 4 ? 10.0 * (4 - j) : 0.01);
+	}
+	return data;
+}
+
+static void expect_same_subspace(
+    std::shared_ptr<IncrementalPCA> incremental, std::shared_ptr<PCA> exact,
+    int32_t target_dim)
+{
+	auto exact_eigenvalues = exact->get_eigenvalues();
+	auto eigenvalues = incremental->get_eigenvalues();
+	auto exact_transmat = exact->get_transformation_matrix();
+	auto transmat = incremental->get_transformation_matrix();
+	ASSERT_EQ(eigenvalues.vlen, target_dim);
+	ASSERT_EQ(transmat.num_cols, target_dim);
+
+	for (index_t i = 0; i < target_dim; i++)
+	{
+		EXPECT_NEAR(
+		    eigenvalues[i], exact_eigenvalues[i], 1e-2 * exact_eigenvalues[i]);
+		auto sign = linalg::dot(
+		    transmat.get_column(i), exact_transmat.get_column(i));
+		EXPECT_NEAR(std::abs(sign), 1.0, 1e-4);
+	}
+
+	auto exact_mean = exact->get_mean();
+	auto mean = incremental->get_mean();
+	for (index_t j = 0; j < mean.vlen; j++)
+		EXPECT_NEAR(mean[j], exact_mean[j], 1e-10);
+}
+
+TEST(IncrementalPCA, matches_PCA)
+{
+	const int32_t target_dim = 3;
+	auto data = low_rank_data(20, 500);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto exact = std::make_shared<PCA>(SVD);
+	exact->set_target_dim(target_dim);
+	exact->fit(features);
+
+	auto incremental = std::make_shared<IncrementalPCA>(target_dim, 64);
+	incremental->fit(features);
+	EXPECT_EQ(incremental->get_num_examples(), data.num_cols);
+
+	expect_same_subspace(incremental, exact, target_dim);
+
+	auto embedded = incremental->transform(features)
+	                    ->as<DenseFeatures<float64_t>>()
+	                    ->get_feature_matrix();
+	EXPECT_EQ(embedded.num_rows, target_dim);
+	EXPECT_EQ(embedded.num_cols, data.num_cols);
+}
+
+TEST(IncrementalPCA, streaming_matches_PCA)
+{
+	const int32_t target_dim = 2;
+	auto data = low_rank_data(10, 300);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto exact = std::make_shared<PCA>(SVD);
+	exact->set_target_dim(target_dim);
+	exact->fit(features);
+
+	auto stream = std::make_shared<StreamingDenseFeatures<float64_t>>(
+	    std::make_shared<DenseFeatures<float64_t>>(data));
+	auto incremental = std::make_shared<IncrementalPCA>(target_dim, 50);
+	incremental->fit(stream);
+	EXPECT_EQ(incremental->get_num_examples(), data.num_cols);
+
+	expect_same_subspace(incremental, exact, target_dim);
+}
+
+TEST(IncrementalPCA, merge)
+{
+	const int32_t target_dim = 3;
+	const index_t half = 200;
+	auto data = low_rank_data(15, 2 * half);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto exact = std::make_shared<PCA>(SVD);
+	exact->set_target_dim(target_dim);
+	exact->fit(features);
+
+	auto first = std::make_shared<IncrementalPCA>(target_dim, 32);
+	first->partial_fit(
+	    SGMatrix<float64_t>(data.matrix, data.num_rows, half, false));
+	auto second = std::make_shared<IncrementalPCA>(target_dim, 32);
+	second->partial_fit(
+	    SGMatrix<float64_t>(
+	        data.get_column_vector(half), data.num_rows, half, false));
+
+	first->merge(second);
+	EXPECT_EQ(first->get_num_examples(), data.num_cols);
+
+	expect_same_subspace(first, exact, target_dim);
+}
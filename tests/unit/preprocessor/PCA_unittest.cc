@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
@@ -13,6 +14,8 @@
 
 #include <shogun/preprocessor/PCA.h>
 
+#include <random>
+
 using namespace shogun;
 
 /** Check eigenvector equality
@@ -603,3 +606,49 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+TEST(PCA, PCA_RANDOMIZED_matches_SVD)
+{
+	// data spread mostly along a few directions
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+	const index_t num_features = 30;
+	const index_t num_vectors = 200;
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		for (index_t j = 0; j < num_features; j++)
+			data(j, i) = normal_dist(prng) * (j < 4 ? 10.0 * (4 - j) : 0.01);
+	}
+
+	const int32_t target_dim = 3;
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto exact = std::make_shared<PCA>(SVD);
+	exact->set_target_dim(target_dim);
+	exact->fit(features);
+
+	auto randomized = std::make_shared<PCA>(RANDOMIZED, true);
+	randomized->put(random::kSeed, 23);
+	randomized->set_target_dim(target_dim);
+	randomized->fit(features);
+
+	auto exact_eigenvalues = exact->get_eigenvalues();
+	auto eigenvalues = randomized->get_eigenvalues();
+	auto exact_transmat = exact->get_transformation_matrix();
+	auto transmat = randomized->get_transformation_matrix();
+	ASSERT_EQ(eigenvalues.vlen, target_dim);
+	ASSERT_EQ(transmat.num_cols, target_dim);
+
+	for (index_t i = 0; i < target_dim; i++)
+	{
+		EXPECT_NEAR(
+		    eigenvalues[i], exact_eigenvalues[i],
+		    1e-8 * exact_eigenvalues[i]);
+
+		// whitened columns are scaled by the inverse singular values
+		auto column = transmat.get_column(i).clone();
+		linalg::scale(
+		    column, column, std::sqrt(eigenvalues[i] * (num_vectors - 1)));
+		check_eigenvector_eq(column, exact_transmat.get_column(i), 1e-6);
+	}
+}
@@ -0,0 +1,54 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+TEST(PruneVarSubMean, transform)
+{
+	// the second feature is constant and the others have different
+	// variances
+	SGMatrix<float64_t> m(3, 4);
+	float64_t first[] = {1.0, 2.0, 3.0, 6.0};
+	float64_t third[] = {-10.0, 10.0, 0.0, 40.0};
+	for (index_t i = 0; i < m.num_cols; i++)
+	{
+		m(0, i) = first[i];
+		m(1, i) = 7.0;
+		m(2, i) = third[i];
+	}
+
+	// population mean and standard deviation of the kept features
+	float64_t mean[] = {3.0, 10.0};
+	float64_t std[] = {std::sqrt(14.0 / 4), std::sqrt(1400.0 / 4)};
+	index_t kept[] = {0, 2};
+
+	for (bool divide : {true, false})
+	{
+		auto feats = std::make_shared<DenseFeatures<float64_t>>(m.clone());
+		auto preproc = std::make_shared<PruneVarSubMean>(divide);
+		preproc->fit(feats);
+		auto result = preproc->transform(feats)
+		                  ->as<DenseFeatures<float64_t>>()
+		                  ->get_feature_matrix();
+
+		ASSERT_EQ(result.num_rows, 2);
+		ASSERT_EQ(result.num_cols, m.num_cols);
+		for (index_t i = 0; i < m.num_cols; i++)
+		{
+			for (index_t j = 0; j < 2; j++)
+			{
+				float64_t e = m(kept[j], i) - mean[j];
+				if (divide)
+					e /= std[j];
+				EXPECT_NEAR(e, result(j, i), 1e-12);
+			}
+		}
+	}
+}
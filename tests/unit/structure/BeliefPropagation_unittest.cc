@@ -168,3 +168,34 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 
 }
 
+
+TEST(BeliefPropagation, tree_max_product_batch)
+{
+	int32_t num_fgs = 6;
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+
+	std::vector<std::shared_ptr<FactorGraph>> fgs;
+	std::vector<SGVector<int32_t>> assignments_expected(num_fgs);
+	SGVector<float64_t> min_energies_expected(num_fgs);
+	for (int32_t i = 0; i < num_fgs; i++)
+	{
+		fgs.push_back(fg_test_data->random_chain_graph(
+			assignments_expected[i], min_energies_expected[i]));
+	}
+
+	SGVector<float64_t> energies(num_fgs);
+	auto outputs = MAPInference::batch_inference(fgs, TREE_MAX_PROD, energies);
+	ASSERT_EQ(outputs->get_num_labels(), num_fgs);
+
+	for (int32_t i = 0; i < num_fgs; i++)
+	{
+		SGVector<int32_t> assignment =
+			outputs->get_label(i)->as<FactorGraphObservation>()->get_data();
+
+		EXPECT_EQ(assignment.size(), assignments_expected[i].size());
+		for (int32_t j = 0; j < assignment.size(); j++)
+			EXPECT_EQ(assignment[j], assignments_expected[i][j]);
+
+		EXPECT_NEAR(min_energies_expected[i], energies[i], 1E-10);
+	}
+}
@@ -159,12 +159,18 @@ TEST(FactorGraph, evaluate_energy_data_indep)
 	state[1] = 1;
 	EXPECT_NEAR(1.3, fg.evaluate_energy(state), 1E-10);
 
+	FactorTable table;
+	fg.build_factor_table(table);
+	EXPECT_EQ(table.get_num_factors(), 3);
+	EXPECT_EQ(table.energies.size(), 8);
+	EXPECT_EQ(table.variables.size(), 4);
 
-
-
-
-
-
+	for (int32_t ei = 0; ei < 4; ++ei)
+	{
+		state[0] = table.state_from_index(0, ei, 0);
+		state[1] = table.state_from_index(0, ei, 1);
+		EXPECT_NEAR(fg.evaluate_energy(state), table.evaluate_energy(state), 1E-10);
+	}
 }
 
 TEST(FactorGraph, evaluate_energy_data_dep)
@@ -284,3 +284,60 @@ TEST(MultilabelModel, argmax)
 
 }
 
+
+TEST(MultilabelModel, add_argmax_subgradient)
+{
+	SGMatrix<float64_t> feats(DIMS, NUM_SAMPLES);
+	feats[0] = 1;
+	feats[1] = 0;
+	feats[2] = 2;
+	feats[3] = 6;
+	feats[4] = 5;
+	feats[5] = 4;
+
+	auto features = std::make_shared<SparseFeatures<float64_t>>(feats);
+
+	auto labels = std::make_shared<MultilabelSOLabels>(2, 3);
+
+	SGVector<int32_t> lab_1(1);
+	lab_1[0] = 2;
+	SGVector<int32_t> lab_2(2);
+	lab_2[0] = 0;
+	lab_2[1] = 1;
+	labels->set_sparse_label(0, lab_1);
+	labels->set_sparse_label(1, lab_2);
+
+	auto model = std::make_shared<MultilabelModel>(features, labels);
+	model->init_training();
+
+	SGVector<float64_t> w(model->get_dim());
+	for (index_t i = 0; i < w.vlen; i++)
+		w[i] = 0.5 * (i % 3) - 0.7;
+
+	for (index_t n = 0; n < NUM_SAMPLES; n++)
+	{
+		auto ret = model->argmax(w, n, true);
+
+		SGVector<float64_t> subgrad(model->get_dim());
+		subgrad.zero();
+		float64_t delta = model->add_argmax_subgradient(w, n, subgrad);
+
+		EXPECT_NEAR(delta, ret->delta, 1E-10);
+		for (index_t i = 0; i < subgrad.vlen; i++)
+			EXPECT_NEAR(subgrad[i], ret->psi_truth[i] - ret->psi_pred[i], 1E-10);
+
+		SGVector<float64_t> psi(model->get_dim());
+		psi.zero();
+		model->add_joint_feature_vector(n, ret->argmax, 2.0, psi);
+		SGVector<float64_t> psi_pred = model->get_joint_feature_vector(n, ret->argmax);
+
+		float64_t score = 0;
+		for (index_t i = 0; i < psi.vlen; i++)
+		{
+			EXPECT_NEAR(psi[i], 2.0 * psi_pred[i], 1E-10);
+			score += w[i] * psi_pred[i];
+		}
+
+		EXPECT_NEAR(model->dot_joint_feature_vector(w, n, ret->argmax), score, 1E-10);
+	}
+}
@@ -0,0 +1,40 @@
+#include <shogun/mathematics/Math.h>
+#include <shogun/structure/Plif.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(Plif, lookup_penalty)
+{
+	SGVector<float64_t> limits(4);
+	limits[0] = 1.0;
+	limits[1] = 2.0;
+	limits[2] = 4.0;
+	limits[3] = 8.0;
+	SGVector<float64_t> penalties(4);
+	penalties[0] = -1.0;
+	penalties[1] = 1.0;
+	penalties[2] = 3.0;
+	penalties[3] = 0.0;
+
+	auto plif = std::make_shared<Plif>(4);
+	plif->set_plif_limits(limits);
+	plif->set_plif_penalty(penalties);
+	plif->set_min_value(0.0);
+	plif->set_max_value(10.0);
+
+	// clamped below the first and above the last limit
+	EXPECT_NEAR(plif->lookup_penalty(0.5, NULL), -1.0, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(9.0, NULL), 0.0, 1E-10);
+
+	// exact limits and linear interpolation in between
+	EXPECT_NEAR(plif->lookup_penalty(1.0, NULL), -1.0, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(2.0, NULL), 1.0, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(1.5, NULL), 0.0, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(3.0, NULL), 2.0, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(6.0, NULL), 1.5, 1E-10);
+	EXPECT_NEAR(plif->lookup_penalty(int32_t(6), NULL), 1.5, 1E-10);
+
+	// outside of [min_value, max_value]
+	EXPECT_EQ(plif->lookup_penalty(11.0, NULL), -Math::INFTY);
+}
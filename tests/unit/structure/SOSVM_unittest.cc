@@ -9,6 +9,9 @@
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/structure/FWSOSVM.h>
 #include <shogun/structure/SOSVMHelper.h>
+#include <shogun/structure/MulticlassModel.h>
+#include <shogun/structure/MulticlassSOLabels.h>
+#include <shogun/features/DenseFeatures.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -176,4 +179,143 @@ TEST(SOSVM, fw_check_w_helper)
 
 
 
+}
+
+static std::shared_ptr<MulticlassModel> create_multiclass_model(int32_t num_samples)
+{
+	int32_t num_classes = 3;
+	int32_t dim = 2;
+
+	SGMatrix<float64_t> feats(dim, num_samples);
+	SGVector<float64_t> labs(num_samples);
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		labs[i] = i % num_classes;
+		feats(0, i) = labs[i] + 0.1 * (i % 7);
+		feats(1, i) = 1.0 - 0.5 * labs[i] + 0.05 * (i % 5);
+	}
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(feats);
+	auto labels = std::make_shared<MulticlassSOLabels>(labs);
+	return std::make_shared<MulticlassModel>(features, labels);
+}
+
+TEST(SOSVM, argmax_batch)
+{
+	int32_t num_samples = 30;
+	auto model = create_multiclass_model(num_samples);
+	model->init_training();
+	ASSERT_TRUE(model->is_argmax_thread_safe());
+
+	SGVector<float64_t> w(model->get_dim());
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = 0.3 * (i % 4) - 0.5;
+
+	SGVector<index_t> idx(num_samples);
+	idx.range_fill();
+	SGVector<float64_t> subgrad(model->get_dim());
+	subgrad.zero();
+	float64_t loss = model->argmax_batch(w, idx, subgrad);
+
+	SGVector<float64_t> expected(model->get_dim());
+	expected.zero();
+	float64_t expected_loss = 0;
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		auto result = model->argmax(w, i);
+		for (index_t j = 0; j < expected.vlen; ++j)
+			expected[j] += result->psi_truth[j] - result->psi_pred[j];
+		expected_loss += result->delta;
+	}
+
+	EXPECT_NEAR(expected_loss, loss, 1E-10);
+	for (index_t j = 0; j < expected.vlen; ++j)
+		EXPECT_NEAR(expected[j], subgrad[j], 1E-10);
+}
+
+/* multiclass model whose inference fails for one example */
+class FailingMulticlassModel : public MulticlassModel
+{
+public:
+	FailingMulticlassModel(std::shared_ptr<Features> features,
+		std::shared_ptr<StructuredLabels> labels, int32_t failing_idx)
+		: MulticlassModel(features, labels), m_failing_idx(failing_idx)
+	{
+	}
+
+	virtual float64_t add_argmax_subgradient(SGVector<float64_t> w,
+		int32_t feat_idx, SGVector<float64_t> subgrad)
+	{
+		if (feat_idx == m_failing_idx)
+			error("Inference failed for example {}", feat_idx);
+		return MulticlassModel::add_argmax_subgradient(w, feat_idx, subgrad);
+	}
+
+private:
+	int32_t m_failing_idx;
+};
+
+TEST(SOSVM, argmax_batch_exception)
+{
+	int32_t num_samples = 30;
+	auto base = create_multiclass_model(num_samples);
+	auto model = std::make_shared<FailingMulticlassModel>(
+		base->get_features(), base->get_labels(), 17);
+	// init_training is not called, argmax_batch fetches the number of
+	// classes before going parallel
+	SGVector<float64_t> w(model->get_dim());
+	w.set_const(0.1);
+
+	SGVector<index_t> idx(num_samples);
+	idx.range_fill();
+	SGVector<float64_t> subgrad(model->get_dim());
+	subgrad.zero();
+	EXPECT_THROW(model->argmax_batch(w, idx, subgrad), ShogunException);
+
+	idx = SGVector<index_t>(10);
+	idx.range_fill();
+	subgrad.zero();
+	EXPECT_NO_THROW(model->argmax_batch(w, idx, subgrad));
+}
+
+TEST(SOSVM, apply_untrained_throws)
+{
+	auto model = create_multiclass_model(30);
+	auto fw = std::make_shared<FWSOSVM>(model, model->get_labels(), true, false);
+	SGVector<float64_t> w(model->get_dim());
+	w.zero();
+	fw->set_w(w);
+	// the error of the parallel prediction reaches the caller
+	EXPECT_THROW(fw->apply_structured(model->get_features()), ShogunException);
+}
+
+TEST(SOSVM, fw_oracle_times)
+{
+	auto model = create_multiclass_model(30);
+
+	auto fw = std::make_shared<FWSOSVM>(model, model->get_labels(), true, false);
+	fw->set_num_iter(5);
+	fw->set_gap_threshold(0.0);
+	fw->train();
+
+	SGVector<float64_t> times = fw->get_oracle_times();
+	EXPECT_GT(times.vlen, 0);
+	EXPECT_LE(times.vlen, 5);
+	for (index_t i = 0; i < times.vlen; ++i)
+		EXPECT_GE(times[i], 0.0);
+}
+
+TEST(SOSVM, sgd_mini_batch)
+{
+	int32_t num_samples = 30;
+	auto model = create_multiclass_model(num_samples);
+
+	auto sgd = std::make_shared<StochasticSOSVM>(model, model->get_labels(), true, false);
+	sgd->set_num_iter(20);
+	sgd->set_batch_size(4);
+	sgd->put("seed", 17);
+	sgd->train();
+
+	EXPECT_EQ(sgd->get_oracle_times().vlen, 20);
+	EXPECT_LT(SOSVMHelper::average_loss(sgd->get_w(), model), 0.5);
 }